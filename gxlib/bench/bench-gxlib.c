@@ -0,0 +1,1488 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+/*
+ * bench-gxlib: measure the time and the number of allocations per element for
+ * the gxlib functions, for input sizes 10^2 .. 10^8, and write the results as
+ * JSON, e.g.:
+ *
+ * { "gxlib-version": "2.0.1",
+ *   "glib-version": "2.50.3",
+ *   "results": [
+ *     { "name": "gx_list_filter", "size": 100, "reps": 20000,
+ *       "ns-per-element": 6.1, "allocs-per-element": 0.5 },
+ *     ...
+ * ]}
+ *
+ * Allocations are counted by interposing malloc() and friends, which works
+ * with GNU libc; G_SLICE=always-malloc must be set in the environment (as
+ * meson's benchmark target does) for GSlice allocations to be counted as
+ * well. Elsewhere, "allocs-per-element" is null.
+ */
+
+#include <gxlib/gxlib.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef GXLIB_VERSION
+#define GXLIB_VERSION "unknown"
+#endif /*GXLIB_VERSION*/
+
+#define DEFAULT_MAX_SIZE 100000000 /* 10^8 */
+#define DEFAULT_MIN_TIME 200       /* msec */
+
+/*
+ * allocation counting
+ */
+#if defined(__GLIBC__)
+#define HAVE_ALLOC_COUNT 1
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+extern void *__libc_memalign (size_t alignment, size_t size);
+
+static volatile guint64 alloc_count;
+
+#define COUNT_ALLOC() __sync_fetch_and_add (&alloc_count, 1)
+
+void*
+malloc (size_t size)
+{
+  COUNT_ALLOC ();
+  return __libc_malloc (size);
+}
+
+void*
+calloc (size_t nmemb, size_t size)
+{
+  COUNT_ALLOC ();
+  return __libc_calloc (nmemb, size);
+}
+
+void*
+realloc (void *ptr, size_t size)
+{
+  COUNT_ALLOC ();
+  return __libc_realloc (ptr, size);
+}
+
+void*
+memalign (size_t alignment, size_t size)
+{
+  COUNT_ALLOC ();
+  return __libc_memalign (alignment, size);
+}
+
+int
+posix_memalign (void **memptr, size_t alignment, size_t size)
+{
+  void *ptr;
+
+  COUNT_ALLOC ();
+  ptr = __libc_memalign (alignment, size);
+  if (!ptr)
+    return ENOMEM;
+
+  *memptr = ptr;
+  return 0;
+}
+
+static guint64
+get_alloc_count (void)
+{
+  return __sync_fetch_and_add (&alloc_count, 0);
+}
+
+#else
+
+static guint64
+get_alloc_count (void)
+{
+  return 0;
+}
+
+#endif /*__GLIBC__*/
+
+
+/*
+ * the benchmarks
+ */
+typedef struct {
+  const char *name;
+  gsize       max_size;
+  gboolean    consumes_input;  /* run() takes over the input */
+  gpointer  (*setup) (gsize n);
+  gpointer  (*run) (gpointer input, gsize n);
+  void      (*free_input) (gpointer input);
+  void      (*free_output) (gpointer output);
+} Bench;
+
+static volatile gpointer sink;
+
+static gpointer
+setup_nothing (gsize n)
+{
+  return NULL;
+}
+
+static gpointer
+setup_int_list (gsize n)
+{
+  return gx_list_iota (n, 0, 1);
+}
+
+static void
+free_list (gpointer list)
+{
+  g_list_free ((GList*)list);
+}
+
+static void
+free_strlist (gpointer list)
+{
+  g_list_free_full ((GList*)list, g_free);
+}
+
+static gboolean
+is_even (gint n)
+{
+  return n % 2 == 0;
+}
+
+static gboolean
+is_non_negative (gint n)
+{
+  return n >= 0;
+}
+
+static gboolean
+is_negative (gint n)
+{
+  return n < 0;
+}
+
+static gint
+plus_one (gint n)
+{
+  return n + 1;
+}
+
+static gpointer
+run_iota (gpointer input, gsize n)
+{
+  return gx_list_iota (n, 0, 1);
+}
+
+static gpointer
+run_filter (gpointer input, gsize n)
+{
+  return gx_list_filter (input, (GXPred)is_even, NULL);
+}
+
+static gpointer
+run_filter_in_place (gpointer input, gsize n)
+{
+  return gx_list_filter_in_place (input, (GXPred)is_even, NULL, NULL);
+}
+
+static gpointer
+run_partition (gpointer input, gsize n)
+{
+  GList *rejected;
+
+  sink = gx_list_partition (input, (GXPred)is_even, NULL, &rejected);
+  g_list_free (rejected);
+
+  return sink;
+}
+
+static gpointer
+run_partition_in_place (gpointer input, gsize n)
+{
+  GList *rejected;
+
+  sink = gx_list_partition_in_place (input, (GXPred)is_even, NULL, &rejected,
+                                     NULL);
+  g_list_free (rejected);
+
+  return sink;
+}
+
+static gpointer
+run_every (gpointer input, gsize n)
+{
+  sink = GINT_TO_POINTER (gx_list_every (input, (GXPred)is_non_negative,
+                                         NULL));
+  return NULL;
+}
+
+static gpointer
+run_any (gpointer input, gsize n)
+{
+  sink = GINT_TO_POINTER (gx_list_any (input, (GXPred)is_negative, NULL));
+  return NULL;
+}
+
+static gpointer
+run_take (gpointer input, gsize n)
+{
+  return gx_list_take (input, n / 2);
+}
+
+static gpointer
+run_take_in_place (gpointer input, gsize n)
+{
+  return gx_list_take_in_place (input, n / 2, NULL);
+}
+
+static gpointer
+run_skip (gpointer input, gsize n)
+{
+  return gx_list_skip (input, n / 2);
+}
+
+static gpointer
+run_skip_in_place (gpointer input, gsize n)
+{
+  return gx_list_skip_in_place (input, n / 2, NULL);
+}
+
+static gpointer
+setup_int_vec (gsize n)
+{
+  return gx_vec_iota (n, 0, 1);
+}
+
+static void
+free_vec (gpointer vec)
+{
+  gx_vec_free ((GXVec*)vec, NULL);
+}
+
+static gpointer
+run_vec_iota (gpointer input, gsize n)
+{
+  return gx_vec_iota (n, 0, 1);
+}
+
+static gpointer
+run_vec_filter (gpointer input, gsize n)
+{
+  return gx_vec_filter (input, (GXPred)is_even, NULL);
+}
+
+static gpointer
+run_vec_filter_in_place (gpointer input, gsize n)
+{
+  return gx_vec_filter_in_place (input, (GXPred)is_even, NULL, NULL);
+}
+
+static gpointer
+run_vec_take (gpointer input, gsize n)
+{
+  return gx_vec_take (input, n / 2);
+}
+
+static gpointer
+run_vec_take_in_place (gpointer input, gsize n)
+{
+  return gx_vec_take_in_place (input, n / 2, NULL);
+}
+
+static gpointer
+run_vec_skip (gpointer input, gsize n)
+{
+  return gx_vec_skip (input, n / 2);
+}
+
+static gpointer
+run_vec_skip_in_place (gpointer input, gsize n)
+{
+  return gx_vec_skip_in_place (input, n / 2, NULL);
+}
+
+static gpointer
+run_vec_map (gpointer input, gsize n)
+{
+  return gx_vec_map (input, (GXBinaryFunc)plus_one, NULL);
+}
+
+static gpointer
+run_vec_map_in_place (gpointer input, gsize n)
+{
+  return gx_vec_map_in_place (input, (GXBinaryFunc)plus_one, NULL, NULL);
+}
+
+static gpointer
+run_vec_fold (gpointer input, gsize n)
+{
+  sink = gx_vec_fold (input, (GXTernaryFunc)gx_plus, GINT_TO_POINTER(0),
+                      NULL, NULL);
+  return NULL;
+}
+
+static gpointer
+setup_int_plist (gsize n)
+{
+  GList   *list;
+  GXPList *plist;
+
+  list  = gx_list_iota (n, 0, 1);
+  plist = gx_plist_from_list (list);
+  g_list_free (list);
+
+  return plist;
+}
+
+static void
+free_plist (gpointer plist)
+{
+  gx_plist_unref ((GXPList*)plist);
+}
+
+static gpointer
+run_plist_skip (gpointer input, gsize n)
+{
+  return gx_plist_skip (input, n / 2);
+}
+
+static gpointer
+run_plist_filter (gpointer input, gsize n)
+{
+  return gx_plist_filter (input, (GXPred)is_even, NULL);
+}
+
+static gpointer
+setup_int_slist (gsize n)
+{
+  return gx_slist_iota (n, 0, 1);
+}
+
+static void
+free_slist (gpointer list)
+{
+  g_slist_free ((GSList*)list);
+}
+
+static gpointer
+run_slist_filter (gpointer input, gsize n)
+{
+  return gx_slist_filter (input, (GXPred)is_even, NULL);
+}
+
+static gpointer
+run_slist_filter_in_place (gpointer input, gsize n)
+{
+  return gx_slist_filter_in_place (input, (GXPred)is_even, NULL, NULL);
+}
+
+static gpointer
+run_slist_fold (gpointer input, gsize n)
+{
+  sink = gx_slist_fold (input, (GXTernaryFunc)gx_plus, GINT_TO_POINTER(0),
+                        NULL, NULL);
+  return NULL;
+}
+
+static gpointer
+setup_int_queue (gsize n)
+{
+  return gx_queue_iota (n, 0, 1);
+}
+
+static void
+free_queue (gpointer queue)
+{
+  g_queue_free ((GQueue*)queue);
+}
+
+static gpointer
+run_queue_filter_in_place (gpointer input, gsize n)
+{
+  return gx_queue_filter_in_place (input, (GXPred)is_even, NULL, NULL);
+}
+
+static gpointer
+setup_int_ptr_array (gsize n)
+{
+  return gx_ptr_array_iota (n, 0, 1);
+}
+
+static void
+free_ptr_array (gpointer array)
+{
+  g_ptr_array_free ((GPtrArray*)array, TRUE);
+}
+
+static gpointer
+run_ptr_array_filter (gpointer input, gsize n)
+{
+  return gx_ptr_array_filter (input, (GXPred)is_even, NULL);
+}
+
+static gpointer
+run_ptr_array_filter_in_place (gpointer input, gsize n)
+{
+  return gx_ptr_array_filter_in_place (input, (GXPred)is_even, NULL, NULL);
+}
+
+static gpointer
+run_ptr_array_fold (gpointer input, gsize n)
+{
+  sink = gx_ptr_array_fold (input, (GXTernaryFunc)gx_plus, GINT_TO_POINTER(0),
+                            NULL, NULL);
+  return NULL;
+}
+
+static gpointer
+setup_int_sequence (gsize n)
+{
+  return gx_sequence_iota (n, 0, 1);
+}
+
+static void
+free_sequence (gpointer seq)
+{
+  g_sequence_free ((GSequence*)seq);
+}
+
+static gpointer
+run_sequence_take (gpointer input, gsize n)
+{
+  return gx_sequence_take (input, n / 2);
+}
+
+static gpointer
+run_sequence_fold (gpointer input, gsize n)
+{
+  sink = gx_sequence_fold (input, (GXTernaryFunc)gx_plus, GINT_TO_POINTER(0),
+                           NULL, NULL);
+  return NULL;
+}
+
+static gpointer
+run_map (gpointer input, gsize n)
+{
+  return gx_list_map (input, (GXBinaryFunc)plus_one, NULL);
+}
+
+static gpointer
+run_map_in_place (gpointer input, gsize n)
+{
+  return gx_list_map_in_place (input, (GXBinaryFunc)plus_one, NULL, NULL);
+}
+
+static gpointer
+run_fold (gpointer input, gsize n)
+{
+  sink = gx_list_fold (input, (GXTernaryFunc)gx_plus, GINT_TO_POINTER(0),
+                       NULL, NULL);
+  return NULL;
+}
+
+static gpointer
+run_sum (gpointer input, gsize n)
+{
+  sink = GINT_TO_POINTER (gx_list_sum (input));
+  return NULL;
+}
+
+static gpointer
+run_product (gpointer input, gsize n)
+{
+  sink = GINT_TO_POINTER (gx_list_product (input));
+  return NULL;
+}
+
+static gpointer
+run_scan (gpointer input, gsize n)
+{
+  return gx_list_scan (input, (GXTernaryFunc)gx_plus, GINT_TO_POINTER (0),
+                       NULL, GX_SCAN_INCLUSIVE);
+}
+
+static gpointer
+run_windowed_fold (gpointer input, gsize n)
+{
+  return gx_list_windowed_fold (input, 100, (GXTernaryFunc)gx_plus,
+                                GINT_TO_POINTER (0), NULL, NULL);
+}
+
+static gpointer
+run_sliding_max (gpointer input, gsize n)
+{
+  return gx_list_sliding_max (input, 100, (GCompareFunc)gx_cmp_int);
+}
+
+static gpointer
+run_stats (gpointer input, gsize n)
+{
+  GXStats *stats;
+
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+  sink  = gx_list_fold (input, (GXTernaryFunc)gx_stats_fold_int, stats,
+                        NULL, NULL);
+  return stats;
+}
+
+static gpointer
+run_stats_percentiles (gpointer input, gsize n)
+{
+  GXStats *stats;
+
+  stats = gx_stats_new (GX_STATS_FLAGS_PERCENTILES);
+  sink  = gx_list_fold (input, (GXTernaryFunc)gx_stats_fold_int, stats,
+                        NULL, NULL);
+  return stats;
+}
+
+/* structures in a GList, and the same with an embedded GXLink */
+typedef struct {
+  GXLink link;
+  gint   n;
+} BenchItem;
+
+static gpointer
+setup_item_list (gsize n)
+{
+  GList *list;
+
+  for (list = NULL; n > 0; --n)
+    {
+      BenchItem *item;
+
+      item    = g_new0 (BenchItem, 1);
+      item->n = n;
+      list    = g_list_prepend (list, item);
+    }
+
+  return list;
+}
+
+static void
+free_item_list (gpointer list)
+{
+  g_list_free_full ((GList*)list, g_free);
+}
+
+static gpointer
+setup_item_links (gsize n)
+{
+  GXLink *list;
+
+  for (list = NULL; n > 0; --n)
+    {
+      BenchItem *item;
+
+      item    = g_new0 (BenchItem, 1);
+      item->n = n;
+      list    = gx_link_prepend (list, &item->link);
+    }
+
+  return list;
+}
+
+static void
+free_item_links (gpointer list)
+{
+  /* the link is the first member, so this frees the items */
+  gx_link_free ((GXLink*)list, g_free);
+}
+
+static gpointer
+sum_item (gpointer acc, BenchItem *item, gpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (acc) + item->n);
+}
+
+static gpointer
+sum_item_link (gpointer acc, GXLink *link, gpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (acc) +
+                          GX_CONTAINER_OF (link, BenchItem, link)->n);
+}
+
+static gpointer
+run_item_list_fold (gpointer input, gsize n)
+{
+  sink = gx_list_fold (input, (GXTernaryFunc)sum_item, GINT_TO_POINTER (0),
+                       NULL, NULL);
+  return NULL;
+}
+
+static gpointer
+run_item_link_fold (gpointer input, gsize n)
+{
+  sink = gx_link_fold (input, (GXTernaryFunc)sum_item_link,
+                       GINT_TO_POINTER (0), NULL, NULL);
+  return NULL;
+}
+
+static gpointer
+run_par_map (gpointer input, gsize n)
+{
+  return gx_list_par_map (input, (GXBinaryFunc)plus_one, NULL, -1);
+}
+
+static gpointer
+run_par_map_in_place (gpointer input, gsize n)
+{
+  return gx_list_par_map_in_place (input, (GXBinaryFunc)plus_one, NULL,
+                                   NULL, -1);
+}
+
+static gpointer
+run_par_filter (gpointer input, gsize n)
+{
+  return gx_list_par_filter (input, (GXPred)is_even, NULL, -1);
+}
+
+static gpointer
+run_par_filter_in_place (gpointer input, gsize n)
+{
+  return gx_list_par_filter_in_place (input, (GXPred)is_even, NULL, NULL, -1);
+}
+
+static gpointer
+run_par_fold (gpointer input, gsize n)
+{
+  sink = gx_list_par_fold (input, (GXTernaryFunc)gx_plus, GINT_TO_POINTER(0),
+                           NULL, NULL, NULL, -1);
+  return NULL;
+}
+
+/* the set operations, on a list and itself */
+static gpointer
+run_uniq (gpointer input, gsize n)
+{
+  return gx_list_uniq (input, NULL, NULL);
+}
+
+static gpointer
+run_intersect (gpointer input, gsize n)
+{
+  return gx_list_intersect (input, input, NULL, NULL);
+}
+
+static gpointer
+run_union (gpointer input, gsize n)
+{
+  return gx_list_union (input, input, NULL, NULL);
+}
+
+static gpointer
+run_difference (gpointer input, gsize n)
+{
+  return gx_list_difference (input, input, NULL, NULL);
+}
+
+static gpointer
+run_sorted_uniq (gpointer input, gsize n)
+{
+  return gx_list_sorted_uniq (input, (GCompareFunc)gx_cmp_int);
+}
+
+static gpointer
+run_sorted_intersect (gpointer input, gsize n)
+{
+  return gx_list_sorted_intersect (input, input, (GCompareFunc)gx_cmp_int);
+}
+
+static gpointer
+run_sorted_union (gpointer input, gsize n)
+{
+  return gx_list_sorted_union (input, input, (GCompareFunc)gx_cmp_int);
+}
+
+static gpointer
+run_sorted_difference (gpointer input, gsize n)
+{
+  return gx_list_sorted_difference (input, input, (GCompareFunc)gx_cmp_int);
+}
+
+static gpointer
+join_first (gconstpointer p1, gconstpointer p2, gconstpointer user_data)
+{
+  return (gpointer)p1;
+}
+
+static gpointer
+run_join_by_key (gpointer input, gsize n)
+{
+  return gx_list_join_by_key (input, input, NULL, NULL, NULL, NULL, NULL,
+                              join_first, NULL);
+}
+
+static gpointer
+mod_1000 (gconstpointer ptr, gconstpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (ptr) % 1000);
+}
+
+static gpointer
+run_group_by (gpointer input, gsize n)
+{
+  return gx_list_group_by (input, mod_1000, NULL, NULL, NULL,
+                           (GXTernaryFunc)gx_plus, GINT_TO_POINTER (0), NULL,
+                           NULL);
+}
+
+static void
+free_hash_table (gpointer table)
+{
+  g_hash_table_destroy ((GHashTable*)table);
+}
+
+static gpointer
+run_top_k (gpointer input, gsize n)
+{
+  return gx_list_top_k (input, 100, (GCompareFunc)gx_cmp_int);
+}
+
+static gpointer
+run_top_k_in_place (gpointer input, gsize n)
+{
+  return gx_list_top_k_in_place (input, 100, (GCompareFunc)gx_cmp_int, NULL);
+}
+
+static gpointer
+run_merge_sorted (gpointer input, gsize n)
+{
+  GList *lists[4] = { input, input, input, input };
+
+  return gx_list_merge_sorted (lists, G_N_ELEMENTS (lists),
+                               (GCompareFunc)gx_cmp_int);
+}
+
+static gpointer
+run_is_prime (gpointer input, gsize n)
+{
+  gsize u, primes;
+
+  for (u = primes = 0; u != n; ++u)
+    primes += gx_is_prime ((gint)u) ? 1 : 0;
+
+  sink = GSIZE_TO_POINTER (primes);
+  return NULL;
+}
+
+static gpointer
+run_is_prime64 (gpointer input, gsize n)
+{
+  gsize u, primes;
+
+  for (u = primes = 0; u != n; ++u)
+    primes += gx_is_prime64 (u) ? 1 : 0;
+
+  sink = GSIZE_TO_POINTER (primes);
+  return NULL;
+}
+
+static gpointer
+setup_random_int_list (gsize n)
+{
+  GRand *rand;
+  GList *list;
+
+  rand = g_rand_new_with_seed (42);
+  for (list = NULL; n != 0; --n)
+    list = g_list_prepend (list, GINT_TO_POINTER (g_rand_int (rand)));
+  g_rand_free (rand);
+
+  return list;
+}
+
+static gpointer
+setup_random_str_list (gsize n)
+{
+  GRand *rand;
+  GList *list;
+
+  rand = g_rand_new_with_seed (42);
+  for (list = NULL; n != 0; --n)
+    list = g_list_prepend (list, g_strdup_printf ("Path/To/%08X",
+                                                  g_rand_int (rand)));
+  g_rand_free (rand);
+
+  return list;
+}
+
+static gpointer
+run_g_list_sort_int (gpointer input, gsize n)
+{
+  return g_list_sort (input, (GCompareFunc)gx_cmp_int);
+}
+
+static gpointer
+run_sort_by_key_int (gpointer input, gsize n)
+{
+  return gx_list_sort_by_key (input, NULL, NULL, (GCompareFunc)gx_cmp_int,
+                              NULL);
+}
+
+static gpointer
+run_sort_int (gpointer input, gsize n)
+{
+  return gx_list_sort_int (input);
+}
+
+static gpointer
+run_sort_parallel (gpointer input, gsize n)
+{
+  return gx_list_sort_parallel (input, (GCompareFunc)gx_cmp_int, -1);
+}
+
+static gpointer
+setup_random_int_array (gsize n)
+{
+  GXIntArray *array;
+  GRand      *rand;
+  gsize       u;
+
+  rand  = g_rand_new_with_seed (42);
+  array = gx_int_array_sized_new (n);
+  for (u = 0; u != n; ++u)
+    gx_int_array_append (array, (gint64)((guint64)g_rand_int (rand) << 32 |
+                                         g_rand_int (rand)));
+  g_rand_free (rand);
+
+  return array;
+}
+
+static void
+free_int_array (gpointer array)
+{
+  gx_int_array_free ((GXIntArray*)array);
+}
+
+static gpointer
+run_int_array_sort (gpointer input, gsize n)
+{
+  return gx_int_array_sort (input);
+}
+
+static gpointer
+run_int_array_scan (gpointer input, gsize n)
+{
+  return gx_int_array_scan_in_place (input, (GXIntFoldFunc)gx_plus, 0, NULL);
+}
+
+static gint
+cmp_casefold (const char *s1, const char *s2)
+{
+  gchar *f1, *f2;
+  gint   cmp;
+
+  f1  = g_utf8_casefold (s1, -1);
+  f2  = g_utf8_casefold (s2, -1);
+  cmp = strcmp (f1, f2);
+
+  g_free (f1);
+  g_free (f2);
+
+  return cmp;
+}
+
+static gpointer
+run_g_list_sort_casefold (gpointer input, gsize n)
+{
+  return g_list_sort (input, (GCompareFunc)cmp_casefold);
+}
+
+static gpointer
+run_sort_by_key_casefold (gpointer input, gsize n)
+{
+  return gx_list_sort_by_key (input, (GXBinaryFunc)g_utf8_casefold,
+                              GINT_TO_POINTER (-1), (GCompareFunc)strcmp,
+                              g_free);
+}
+
+static gpointer
+setup_random64 (gsize n)
+{
+  GRand   *rand;
+  guint64 *nums;
+  gsize    u;
+
+  rand = g_rand_new_with_seed (42);
+  nums = g_new (guint64, n);
+  for (u = 0; u != n; ++u)
+    nums[u] = ((guint64)g_rand_int (rand) << 32 | g_rand_int (rand)) | 1;
+  g_rand_free (rand);
+
+  return nums;
+}
+
+static gpointer
+run_is_prime64_random (gpointer input, gsize n)
+{
+  const guint64 *nums;
+  gsize          u, primes;
+
+  nums = input;
+  for (u = primes = 0; u != n; ++u)
+    primes += gx_is_prime64 (nums[u]) ? 1 : 0;
+
+  sink = GSIZE_TO_POINTER (primes);
+  return NULL;
+}
+
+static gpointer
+run_is_prime64_batch (gpointer input, gsize n)
+{
+  sink = GSIZE_TO_POINTER (gx_is_prime64_batch (input, n, NULL));
+  return NULL;
+}
+
+static gpointer
+run_prime_table_new (gpointer input, gsize n)
+{
+  return gx_prime_table_new ((guint)n, GX_PRIME_TABLE_FLAGS_NONE, -1);
+}
+
+static gpointer
+setup_prime_table (gsize n)
+{
+  GXPrimeTable *table;
+
+  table = gx_prime_table_new ((guint)n, GX_PRIME_TABLE_FLAGS_NONE, -1);
+  gx_prime_table_set_default (table);
+
+  return table;
+}
+
+static void
+free_prime_table (gpointer table)
+{
+  gx_prime_table_set_default (NULL);
+  gx_prime_table_unref (table);
+}
+
+/* n bytes of sample, repeated */
+static gchar*
+repeat_sample (const char *sample, gsize n)
+{
+  GString *gstr;
+
+  gstr = g_string_sized_new (n + 32);
+  while (gstr->len < n)
+    g_string_append (gstr, sample);
+
+  /* cut at a character boundary at or before n */
+  g_string_truncate (gstr, g_utf8_find_prev_char (gstr->str,
+                                                  gstr->str + n + 1) -
+                     gstr->str);
+
+  return g_string_free (gstr, FALSE);
+}
+
+static gpointer
+setup_utf8 (gsize n)
+{
+  return repeat_sample ("Ça va? Ünïcödé ✓ Ærøskøbing ", n);
+}
+
+/* file names: ASCII only */
+static gpointer
+setup_utf8_ascii (gsize n)
+{
+  return repeat_sample ("src/GxList-Arena.c README.md Makefile.AM "
+                        "docs/Reference/GXLIB-Docs.xml ", n);
+}
+
+/* mail headers: now and then a non-ASCII character */
+static gpointer
+setup_utf8_mostly_ascii (gsize n)
+{
+  return repeat_sample ("From: Jörg Schmidt <jschmidt@example.org> "
+                        "Subject: Re: Meeting notes for Thursday, agenda "
+                        "and action items To: Dirk-Jan <djcb@example.com> "
+                        "Date: Mon, 12 Jun 2017 10:30:00 +0200 ", n);
+}
+
+/* n short strings, mostly ASCII */
+static gpointer
+setup_utf8_names (gsize n)
+{
+  const char *names[] = { "Makefile.am", "gxlist.c", "README", "Ærøskøbing",
+                          "Photo 2017-06-12.JPG", "Notes (Draft).TXT",
+                          "café.html", "index.HTML" };
+  gchar     **strv;
+  gsize       u;
+
+  strv = g_new (gchar*, n + 1);
+  for (u = 0; u != n; ++u)
+    strv[u] = (gchar*)names[u % G_N_ELEMENTS (names)];
+  strv[n] = NULL;
+
+  return strv;
+}
+
+static gpointer
+run_utf8_flatten (gpointer input, gsize n)
+{
+  return gx_utf8_flatten (input, -1);
+}
+
+static gpointer
+run_utf8_flatten_names (gpointer input, gsize n)
+{
+  gchar **strv;
+  gsize   u;
+
+  for (strv = input, u = 0; u != n; ++u)
+    g_free (gx_utf8_flatten (strv[u], -1));
+
+  return NULL;
+}
+
+static gpointer
+run_utf8_flatten_append_names (gpointer input, gsize n)
+{
+  GString *gstr;
+  gchar  **strv;
+  gsize    u;
+
+  gstr = g_string_sized_new (64);
+  for (strv = input, u = 0; u != n; ++u)
+    {
+      g_string_truncate (gstr, 0);
+      if (!gx_utf8_flatten_append (gstr, strv[u], -1))
+        g_assert_not_reached ();
+    }
+  g_string_free (gstr, TRUE);
+
+  return NULL;
+}
+
+static gpointer
+run_utf8_flatten_into_names (gpointer input, gsize n)
+{
+  gchar **strv, buf[64];
+  gsize   u;
+
+  for (strv = input, u = 0; u != n; ++u)
+    if (gx_utf8_flatten_into (strv[u], -1, buf, sizeof (buf)) < 0)
+      g_assert_not_reached ();
+
+  return NULL;
+}
+
+static gpointer
+run_utf8_flatten_hash_names (gpointer input, gsize n)
+{
+  gchar **strv;
+  gsize   u;
+  guint   h;
+
+  for (strv = input, h = 0, u = 0; u != n; ++u)
+    h ^= gx_utf8_flatten_hash (strv[u]);
+
+  return GUINT_TO_POINTER (h);
+}
+
+static gpointer
+run_utf8_flatten_strv_names (gpointer input, gsize n)
+{
+  return gx_utf8_flatten_strv (input, (gssize)n, -1);
+}
+
+/* each name against the next one, which mostly differ early on */
+static gpointer
+run_utf8_flatten_cmp_names (gpointer input, gsize n)
+{
+  gchar **strv;
+  gsize   u;
+  gint    sum;
+
+  for (strv = input, sum = 0, u = 0; u + 1 < n; ++u)
+    sum += gx_utf8_flatten_cmp (strv[u], strv[u + 1]);
+
+  return GINT_TO_POINTER (sum);
+}
+
+static gpointer
+setup_strv (gsize n)
+{
+  gchar **strv;
+  gsize   u;
+
+  strv = g_new (gchar*, n + 1);
+  for (u = 0; u != n; ++u)
+    strv[u] = (gchar*)"gxlib";
+  strv[n] = NULL;
+
+  return strv;
+}
+
+static gpointer
+run_strv_to_list (gpointer input, gsize n)
+{
+  return gx_strv_to_list (input, n);
+}
+
+static gpointer
+run_strv_to_list_copy (gpointer input, gsize n)
+{
+  return gx_strv_to_list_copy (input, n);
+}
+
+static gpointer
+run_path_resolve (gpointer input, gsize n)
+{
+  gsize u;
+
+  for (u = 0; u != n; ++u)
+    g_free (gx_path_resolve ("~/."));
+
+  return NULL;
+}
+
+#define LIST_MAX DEFAULT_MAX_SIZE
+
+static const Bench benches[] = {
+  { "gx_list_iota", LIST_MAX, FALSE, setup_nothing, run_iota,
+    NULL, free_list },
+  { "gx_list_filter", LIST_MAX, FALSE, setup_int_list, run_filter,
+    free_list, free_list },
+  { "gx_list_filter_in_place", LIST_MAX, TRUE, setup_int_list,
+    run_filter_in_place, free_list, free_list },
+  { "gx_list_partition", LIST_MAX, FALSE, setup_int_list, run_partition,
+    free_list, free_list },
+  { "gx_list_partition_in_place", LIST_MAX, TRUE, setup_int_list,
+    run_partition_in_place, free_list, free_list },
+  { "gx_list_every", LIST_MAX, FALSE, setup_int_list, run_every,
+    free_list, NULL },
+  { "gx_list_any", LIST_MAX, FALSE, setup_int_list, run_any,
+    free_list, NULL },
+  { "gx_list_take", LIST_MAX, FALSE, setup_int_list, run_take,
+    free_list, free_list },
+  { "gx_list_take_in_place", LIST_MAX, TRUE, setup_int_list,
+    run_take_in_place, free_list, free_list },
+  { "gx_list_skip", LIST_MAX, FALSE, setup_int_list, run_skip,
+    free_list, free_list },
+  { "gx_list_skip_in_place", LIST_MAX, TRUE, setup_int_list,
+    run_skip_in_place, free_list, free_list },
+  { "gx_plist_skip", LIST_MAX, FALSE, setup_int_plist, run_plist_skip,
+    free_plist, free_plist },
+  { "gx_plist_filter", LIST_MAX, FALSE, setup_int_plist, run_plist_filter,
+    free_plist, free_plist },
+  { "gx_slist_filter", LIST_MAX, FALSE, setup_int_slist, run_slist_filter,
+    free_slist, free_slist },
+  { "gx_slist_filter_in_place", LIST_MAX, TRUE, setup_int_slist,
+    run_slist_filter_in_place, free_slist, free_slist },
+  { "gx_slist_fold", LIST_MAX, FALSE, setup_int_slist, run_slist_fold,
+    free_slist, NULL },
+  { "gx_queue_filter_in_place", LIST_MAX, TRUE, setup_int_queue,
+    run_queue_filter_in_place, free_queue, free_queue },
+  { "gx_ptr_array_filter", LIST_MAX, FALSE, setup_int_ptr_array,
+    run_ptr_array_filter, free_ptr_array, free_ptr_array },
+  { "gx_ptr_array_filter_in_place", LIST_MAX, TRUE, setup_int_ptr_array,
+    run_ptr_array_filter_in_place, free_ptr_array, free_ptr_array },
+  { "gx_ptr_array_fold", LIST_MAX, FALSE, setup_int_ptr_array,
+    run_ptr_array_fold, free_ptr_array, NULL },
+  { "gx_sequence_take", LIST_MAX, FALSE, setup_int_sequence,
+    run_sequence_take, free_sequence, free_sequence },
+  { "gx_sequence_fold", LIST_MAX, FALSE, setup_int_sequence,
+    run_sequence_fold, free_sequence, NULL },
+  { "gx_list_map", LIST_MAX, FALSE, setup_int_list, run_map,
+    free_list, free_list },
+  { "gx_list_map_in_place", LIST_MAX, TRUE, setup_int_list,
+    run_map_in_place, free_list, free_list },
+  { "gx_list_fold", LIST_MAX, FALSE, setup_int_list, run_fold,
+    free_list, NULL },
+  { "gx_vec_iota", LIST_MAX, FALSE, setup_nothing, run_vec_iota,
+    NULL, free_vec },
+  { "gx_vec_filter", LIST_MAX, FALSE, setup_int_vec, run_vec_filter,
+    free_vec, free_vec },
+  { "gx_vec_filter_in_place", LIST_MAX, TRUE, setup_int_vec,
+    run_vec_filter_in_place, free_vec, free_vec },
+  { "gx_vec_take", LIST_MAX, FALSE, setup_int_vec, run_vec_take,
+    free_vec, free_vec },
+  { "gx_vec_take_in_place", LIST_MAX, TRUE, setup_int_vec,
+    run_vec_take_in_place, free_vec, free_vec },
+  { "gx_vec_skip", LIST_MAX, FALSE, setup_int_vec, run_vec_skip,
+    free_vec, free_vec },
+  { "gx_vec_skip_in_place", LIST_MAX, TRUE, setup_int_vec,
+    run_vec_skip_in_place, free_vec, free_vec },
+  { "gx_vec_map", LIST_MAX, FALSE, setup_int_vec, run_vec_map,
+    free_vec, free_vec },
+  { "gx_vec_map_in_place", LIST_MAX, TRUE, setup_int_vec,
+    run_vec_map_in_place, free_vec, free_vec },
+  { "gx_vec_fold", LIST_MAX, FALSE, setup_int_vec, run_vec_fold,
+    free_vec, NULL },
+  { "gx_list_sum", LIST_MAX, FALSE, setup_int_list, run_sum,
+    free_list, NULL },
+  { "gx_list_product", LIST_MAX, FALSE, setup_int_list, run_product,
+    free_list, NULL },
+  { "gx_list_scan", LIST_MAX, FALSE, setup_int_list, run_scan,
+    free_list, free_list },
+  { "gx_list_windowed_fold (gx_plus, w=100)", LIST_MAX, FALSE, setup_int_list,
+    run_windowed_fold, free_list, free_list },
+  { "gx_list_sliding_max (w=100)", LIST_MAX, FALSE, setup_int_list,
+    run_sliding_max, free_list, free_list },
+  { "gx_stats_fold_int", LIST_MAX, FALSE, setup_int_list, run_stats,
+    free_list, (GDestroyNotify)gx_stats_free },
+  { "gx_stats_fold_int (percentiles)", LIST_MAX, FALSE, setup_int_list,
+    run_stats_percentiles, free_list, (GDestroyNotify)gx_stats_free },
+  { "gx_list_fold (structs)", LIST_MAX, FALSE, setup_item_list,
+    run_item_list_fold, free_item_list, NULL },
+  { "gx_link_fold (structs)", LIST_MAX, FALSE, setup_item_links,
+    run_item_link_fold, free_item_links, NULL },
+  { "gx_list_uniq", LIST_MAX, FALSE, setup_int_list, run_uniq,
+    free_list, free_list },
+  { "gx_list_intersect", LIST_MAX, FALSE, setup_int_list, run_intersect,
+    free_list, free_list },
+  { "gx_list_union", LIST_MAX, FALSE, setup_int_list, run_union,
+    free_list, free_list },
+  { "gx_list_difference", LIST_MAX, FALSE, setup_int_list, run_difference,
+    free_list, free_list },
+  { "gx_list_sorted_uniq", LIST_MAX, FALSE, setup_int_list, run_sorted_uniq,
+    free_list, free_list },
+  { "gx_list_sorted_intersect", LIST_MAX, FALSE, setup_int_list,
+    run_sorted_intersect, free_list, free_list },
+  { "gx_list_sorted_union", LIST_MAX, FALSE, setup_int_list, run_sorted_union,
+    free_list, free_list },
+  { "gx_list_sorted_difference", LIST_MAX, FALSE, setup_int_list,
+    run_sorted_difference, free_list, free_list },
+  { "gx_list_join_by_key", LIST_MAX, FALSE, setup_int_list, run_join_by_key,
+    free_list, free_list },
+  { "gx_list_group_by", LIST_MAX, FALSE, setup_int_list, run_group_by,
+    free_list, free_hash_table },
+  { "gx_list_top_k (k=100)", LIST_MAX, FALSE, setup_int_list, run_top_k,
+    free_list, free_list },
+  { "gx_list_top_k_in_place (k=100)", LIST_MAX, TRUE, setup_int_list,
+    run_top_k_in_place, free_list, free_list },
+  { "g_list_sort (int)", LIST_MAX, TRUE, setup_random_int_list,
+    run_g_list_sort_int, free_list, free_list },
+  { "gx_list_sort_by_key (int)", LIST_MAX, TRUE, setup_random_int_list,
+    run_sort_by_key_int, free_list, free_list },
+  { "gx_list_sort_int", LIST_MAX, TRUE, setup_random_int_list,
+    run_sort_int, free_list, free_list },
+  { "gx_list_sort_parallel (int)", LIST_MAX, TRUE, setup_random_int_list,
+    run_sort_parallel, free_list, free_list },
+  { "gx_int_array_sort", LIST_MAX, TRUE, setup_random_int_array,
+    run_int_array_sort, free_int_array, free_int_array },
+  { "gx_int_array_scan_in_place (gx_plus)", LIST_MAX, TRUE,
+    setup_random_int_array, run_int_array_scan, free_int_array,
+    free_int_array },
+  { "g_list_sort (casefold)", 1000000, TRUE, setup_random_str_list,
+    run_g_list_sort_casefold, free_strlist, free_strlist },
+  { "gx_list_sort_by_key (casefold)", 1000000, TRUE, setup_random_str_list,
+    run_sort_by_key_casefold, free_strlist, free_strlist },
+  { "gx_list_merge_sorted (4 lists)", LIST_MAX, FALSE, setup_int_list,
+    run_merge_sorted, free_list, free_list },
+  { "gx_list_par_map", LIST_MAX, FALSE, setup_int_list, run_par_map,
+    free_list, free_list },
+  { "gx_list_par_map_in_place", LIST_MAX, TRUE, setup_int_list,
+    run_par_map_in_place, free_list, free_list },
+  { "gx_list_par_filter", LIST_MAX, FALSE, setup_int_list, run_par_filter,
+    free_list, free_list },
+  { "gx_list_par_filter_in_place", LIST_MAX, TRUE, setup_int_list,
+    run_par_filter_in_place, free_list, free_list },
+  { "gx_list_par_fold", LIST_MAX, FALSE, setup_int_list, run_par_fold,
+    free_list, NULL },
+  { "gx_is_prime", 10000000, FALSE, setup_nothing, run_is_prime,
+    NULL, NULL },
+  { "gx_is_prime64", 10000000, FALSE, setup_nothing, run_is_prime64,
+    NULL, NULL },
+  { "gx_is_prime64 (random)", 10000000, FALSE, setup_random64,
+    run_is_prime64_random, g_free, NULL },
+  { "gx_is_prime64_batch (random)", 10000000, FALSE, setup_random64,
+    run_is_prime64_batch, g_free, NULL },
+  { "gx_is_prime (default table)", LIST_MAX, FALSE, setup_prime_table,
+    run_is_prime, free_prime_table, NULL },
+  { "gx_prime_table_new", LIST_MAX, FALSE, setup_nothing,
+    run_prime_table_new, NULL, (GDestroyNotify)gx_prime_table_unref },
+  { "gx_utf8_flatten", 10000000, FALSE, setup_utf8, run_utf8_flatten,
+    g_free, g_free },
+  { "gx_utf8_flatten (ascii)", 10000000, FALSE, setup_utf8_ascii,
+    run_utf8_flatten, g_free, g_free },
+  { "gx_utf8_flatten (mostly ascii)", 10000000, FALSE,
+    setup_utf8_mostly_ascii, run_utf8_flatten, g_free, g_free },
+  { "gx_utf8_flatten (names)", 1000000, FALSE, setup_utf8_names,
+    run_utf8_flatten_names, g_free, NULL },
+  { "gx_utf8_flatten_append (names)", 1000000, FALSE, setup_utf8_names,
+    run_utf8_flatten_append_names, g_free, NULL },
+  { "gx_utf8_flatten_into (names)", 1000000, FALSE, setup_utf8_names,
+    run_utf8_flatten_into_names, g_free, NULL },
+  { "gx_utf8_flatten_hash (names)", 1000000, FALSE, setup_utf8_names,
+    run_utf8_flatten_hash_names, g_free, NULL },
+  { "gx_utf8_flatten_cmp (names)", 1000000, FALSE, setup_utf8_names,
+    run_utf8_flatten_cmp_names, g_free, NULL },
+  { "gx_utf8_flatten_strv (names)", 1000000, FALSE, setup_utf8_names,
+    run_utf8_flatten_strv_names, g_free, g_free },
+  { "gx_strv_to_list", 10000000, FALSE, setup_strv, run_strv_to_list,
+    g_free, free_list },
+  { "gx_strv_to_list_copy", 10000000, FALSE, setup_strv,
+    run_strv_to_list_copy, g_free, free_strlist },
+  { "gx_path_resolve", 10000, FALSE, setup_nothing, run_path_resolve,
+    NULL, NULL }
+};
+
+
+/*
+ * the driver
+ */
+static gint64
+now_ns (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (gint64)ts.tv_sec * G_GINT64_CONSTANT(1000000000) + ts.tv_nsec;
+}
+
+static void
+run_bench (const Bench *bench, gsize n, gint64 min_time_ns, GString *json)
+{
+  gpointer input, output;
+  gint64   elapsed;
+  guint64  allocs;
+  gsize    reps;
+
+  input = bench->setup (n);
+
+  for (reps = 0, elapsed = 0, allocs = 0; elapsed < min_time_ns; ++reps)
+    {
+      gint64  start;
+      guint64 allocs_start;
+
+      if (bench->consumes_input && reps > 0)
+        input = bench->setup (n);
+
+      allocs_start = get_alloc_count ();
+      start        = now_ns ();
+
+      output = bench->run (input, n);
+
+      elapsed += now_ns () - start;
+      allocs  += get_alloc_count () - allocs_start;
+
+      if (bench->consumes_input)
+        input = NULL;
+      if (output && bench->free_output)
+        bench->free_output (output);
+    }
+
+  if (input && bench->free_input)
+    bench->free_input (input);
+
+  g_string_append_printf (json,
+                          "%s\n    { \"name\": \"%s\", \"size\": %"
+                          G_GSIZE_FORMAT ", \"reps\": %" G_GSIZE_FORMAT
+                          ", \"ns-per-element\": %.3f, "
+                          "\"allocs-per-element\": ",
+                          json->str[json->len - 1] == '[' ? "" : ",",
+                          bench->name, n, reps,
+                          (gdouble)elapsed / ((gdouble)reps * n));
+#ifdef HAVE_ALLOC_COUNT
+  g_string_append_printf (json, "%.3f }",
+                          (gdouble)allocs / ((gdouble)reps * n));
+#else
+  g_string_append (json, "null }");
+#endif /*HAVE_ALLOC_COUNT*/
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *ctx;
+  GError         *err;
+  GString        *json;
+  guint           u;
+  gsize           n;
+  gint64          max_size, min_time;
+  gchar          *filter, *output;
+
+  static GOptionEntry entries[] = {
+    { "max-size", 's', 0, G_OPTION_ARG_INT64, NULL,
+      "largest input size (default: 10^8)", "<n>" },
+    { "min-time", 't', 0, G_OPTION_ARG_INT64, NULL,
+      "minimum time per measurement in msec (default: 200)", "<msec>" },
+    { "filter", 'f', 0, G_OPTION_ARG_STRING, NULL,
+      "only run benchmarks whose name contains this string", "<str>" },
+    { "output", 'o', 0, G_OPTION_ARG_FILENAME, NULL,
+      "write the results to a file rather than to stdout", "<file>" },
+    { NULL }
+  };
+
+  max_size = DEFAULT_MAX_SIZE;
+  min_time = DEFAULT_MIN_TIME;
+  filter   = output = NULL;
+
+  entries[0].arg_data = &max_size;
+  entries[1].arg_data = &min_time;
+  entries[2].arg_data = &filter;
+  entries[3].arg_data = &output;
+
+  ctx = g_option_context_new ("- benchmark gxlib functions");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+
+  err = NULL;
+  if (!g_option_context_parse (ctx, &argc, &argv, &err))
+    {
+      g_printerr ("bench-gxlib: %s\n", err->message);
+      g_error_free (err);
+      return 1;
+    }
+  g_option_context_free (ctx);
+
+  json = g_string_new (NULL);
+  g_string_append_printf (json,
+                          "{ \"gxlib-version\": \"%s\",\n"
+                          "  \"glib-version\": \"%u.%u.%u\",\n"
+                          "  \"results\": [",
+                          GXLIB_VERSION, glib_major_version,
+                          glib_minor_version, glib_micro_version);
+
+  for (u = 0; u != G_N_ELEMENTS(benches); ++u)
+    {
+      if (filter && !strstr (benches[u].name, filter))
+        continue;
+
+      for (n = 100; n <= benches[u].max_size && n <= (gsize)max_size; n *= 10)
+        run_bench (&benches[u], n, min_time * 1000 * 1000, json);
+    }
+
+  g_string_append (json, "\n]}\n");
+
+  if (output)
+    {
+      if (!g_file_set_contents (output, json->str, json->len, &err))
+        {
+          g_printerr ("bench-gxlib: %s\n", err->message);
+          g_error_free (err);
+          return 1;
+        }
+    }
+  else
+    fputs (json->str, stdout);
+
+  g_string_free (json, TRUE);
+  g_free (filter);
+  g_free (output);
+
+  return 0;
+}
@@ -0,0 +1,190 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+/* gen-flatten-table: generate the lookup table for gx_utf8_flatten()
+ *
+ * For each character, the table has its flattened form: the character is
+ * decomposed (NFKD), the combining marks are dropped and the rest is
+ * lowercased; this uses the Unicode data of the GLib we are built with. The
+ * table has two levels: an index of blocks of (1 << FLATTEN_BLOCK_BITS)
+ * characters, and the distinct blocks, with for each character either 0 (it
+ * flattens to itself) or the offset and length of its flattened form in a
+ * pool of UTF-8 strings.
+ *
+ * The Hangul syllables are left out, since they are decomposed
+ * algorithmically.
+ *
+ * usage: gen-flatten-table <output-file>
+ */
+
+#include <glib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FLATTEN_BLOCK_BITS 7
+#define FLATTEN_BLOCK_SIZE (1 << FLATTEN_BLOCK_BITS)
+#define FLATTEN_LEN_BITS   7
+#define N_CHARS            0x110000
+
+#define HANGUL_S_BASE  0xac00
+#define HANGUL_S_COUNT 11172
+
+static void
+flatten_char (gunichar uc, GString *flat)
+{
+  gunichar decomp[G_UNICHAR_MAX_DECOMPOSITION_LENGTH];
+  gsize    n, u;
+
+  g_string_truncate (flat, 0);
+
+  n = g_unichar_fully_decompose (uc, TRUE, decomp, G_N_ELEMENTS (decomp));
+  for (u = 0; u != n; ++u)
+    if (g_unichar_combining_class (decomp[u]) == 0)
+      g_string_append_unichar (flat, g_unichar_tolower (decomp[u]));
+}
+
+/* the table entry for uc, adding its flattened form to the pool if needed */
+static guint32
+make_entry (gunichar uc, GString *pool, GHashTable *offsets)
+{
+  static GString *flat;
+  gchar           utf8[6];
+  gint            len;
+  gpointer        offset;
+
+  if (!flat)
+    flat = g_string_new (NULL);
+
+  if ((uc >= 0xd800 && uc <= 0xdfff) ||
+      (uc >= HANGUL_S_BASE && uc < HANGUL_S_BASE + HANGUL_S_COUNT))
+    return 0;
+
+  flatten_char (uc, flat);
+  len = g_unichar_to_utf8 (uc, utf8);
+  if (flat->len == (gsize)len && memcmp (flat->str, utf8, len) == 0)
+    return 0;
+
+  g_assert (flat->len < (1 << FLATTEN_LEN_BITS));
+
+  if (!g_hash_table_lookup_extended (offsets, flat->str, NULL, &offset))
+    {
+      /* the pool starts with a dummy byte, so entries are never 0 */
+      if (pool->len == 0)
+        g_string_append_c (pool, '\0');
+
+      offset = GSIZE_TO_POINTER (pool->len);
+      g_string_append_len (pool, flat->str, flat->len);
+      g_hash_table_insert (offsets, g_strdup (flat->str), offset);
+    }
+
+  return (guint32)(GPOINTER_TO_SIZE (offset) << FLATTEN_LEN_BITS) |
+    (guint32)flat->len;
+}
+
+int
+main (int argc, char *argv[])
+{
+  GArray     *blocks;
+  GHashTable *offsets;
+  GString    *pool;
+  guint16    *index;
+  guint32     block[FLATTEN_BLOCK_SIZE];
+  gsize       n_blocks, b, u;
+  FILE       *out;
+
+  if (argc != 2)
+    {
+      g_printerr ("usage: %s <output-file>\n", argv[0]);
+      return 1;
+    }
+
+  blocks  = g_array_new (FALSE, FALSE, sizeof (block));
+  offsets = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  pool    = g_string_new (NULL);
+  index   = g_new (guint16, N_CHARS / FLATTEN_BLOCK_SIZE);
+
+  for (b = 0; b != N_CHARS / FLATTEN_BLOCK_SIZE; ++b)
+    {
+      for (u = 0; u != FLATTEN_BLOCK_SIZE; ++u)
+        block[u] = make_entry ((gunichar)(b * FLATTEN_BLOCK_SIZE + u), pool,
+                               offsets);
+
+      /* re-use an identical block, if any; most are all-zero */
+      for (n_blocks = 0; n_blocks != blocks->len; ++n_blocks)
+        if (memcmp (&g_array_index (blocks, guint32,
+                                    n_blocks * FLATTEN_BLOCK_SIZE),
+                    block, sizeof (block)) == 0)
+          break;
+
+      if (n_blocks == blocks->len)
+        g_array_append_vals (blocks, block, 1);
+
+      g_assert (n_blocks <= G_MAXUINT16);
+      index[b] = (guint16)n_blocks;
+    }
+
+  out = fopen (argv[1], "w");
+  if (!out)
+    {
+      g_printerr ("%s: cannot write %s\n", argv[0], argv[1]);
+      return 1;
+    }
+
+  fprintf (out,
+           "/* generated by gen-flatten-table with the Unicode data of "
+           "GLib %u.%u.%u; do not edit */\n\n",
+           glib_major_version, glib_minor_version, glib_micro_version);
+
+  fprintf (out, "#define FLATTEN_BLOCK_BITS %d\n", FLATTEN_BLOCK_BITS);
+  fprintf (out, "#define FLATTEN_LEN_BITS   %d\n\n", FLATTEN_LEN_BITS);
+
+  fprintf (out, "static const guint16 flatten_index[%u] = {",
+           N_CHARS / FLATTEN_BLOCK_SIZE);
+  for (b = 0; b != N_CHARS / FLATTEN_BLOCK_SIZE; ++b)
+    fprintf (out, "%s%u,", b % 16 ? " " : "\n  ", index[b]);
+  fprintf (out, "\n};\n\n");
+
+  fprintf (out, "static const guint32 flatten_blocks[%u] = {",
+           blocks->len * FLATTEN_BLOCK_SIZE);
+  for (u = 0; u != blocks->len * FLATTEN_BLOCK_SIZE; ++u)
+    fprintf (out, "%s0x%x,", u % 8 ? " " : "\n  ",
+             g_array_index (blocks, guint32, u));
+  fprintf (out, "\n};\n\n");
+
+  /* as octal escapes, so any byte can follow */
+  fprintf (out, "static const gchar flatten_pool[%u] =", (guint)pool->len + 1);
+  for (u = 0; u != pool->len; ++u)
+    fprintf (out, "%s\\%03o%s", u % 16 ? "" : "\n  \"",
+             (guchar)pool->str[u], u % 16 == 15 ? "\"" : "");
+  fprintf (out, "%s;\n", u % 16 ? "\"" : "");
+
+  if (fclose (out) != 0)
+    {
+      g_printerr ("%s: cannot write %s\n", argv[0], argv[1]);
+      return 1;
+    }
+
+  g_array_free (blocks, TRUE);
+  g_hash_table_destroy (offsets);
+  g_string_free (pool, TRUE);
+  g_free (index);
+
+  return 0;
+}
@@ -0,0 +1,441 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxarena.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxarena
+ * @title: List arenas
+ * @short_description: bulk allocation of #GList nodes
+ *
+ * Functions like gx_list_iota(), gx_list_map() or gx_list_filter() allocate a
+ * node for every element of the list they build, and those nodes are normally
+ * freed one-by-one again with g_list_free(). For big, short-lived lists, a
+ * #GXListArena is much cheaper: while it is the thread-default arena (see
+ * gx_list_arena_push_thread_default()), the gxlib functions that create lists
+ * take their nodes from large blocks owned by the arena, and all of them are
+ * released at once with gx_list_arena_clear() or gx_list_arena_free().
+ *
+ * The gxlib functions that remove nodes from a list (such as
+ * gx_list_filter_in_place()) recognize nodes from any arena, whether or not
+ * it is the thread-default, and leave those for the arena to reclaim. Lists
+ * allocated from an arena must <emphasis>not</emphasis> be freed with
+ * g_list_free() or g_list_free_full(), or passed to GLib functions that free
+ * nodes; to free the elements of such a list, use g_list_foreach() instead.
+ *
+ * Each thread that pushes an arena gets its own magazine, a range of free
+ * nodes that it can allocate from without taking any locks, so the same arena
+ * can be used from multiple threads at the same time.
+ *
+ * |[<!-- language="C" -->
+ * GXListArena *arena;
+ * GList *nums;
+ *
+ * arena = gx_list_arena_new ();
+ * gx_list_arena_push_thread_default (arena);
+ *
+ * nums = gx_list_iota (1000 * 1000, 1, 1);
+ * nums = gx_list_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+ * g_assert_cmpuint (g_list_length (nums), ==, 78498);
+ *
+ * gx_list_arena_pop_thread_default (arena);
+ * gx_list_arena_free (arena); // frees all nodes of nums
+ * ]|
+ */
+
+/* blocks are aligned to their size, so we can find the block for a node by
+ * masking its address */
+#define BLOCK_SIZE      (64 * 1024)
+#define NODES_PER_BLOCK (BLOCK_SIZE / sizeof (GList))
+#define BLOCK_OF(node)  ((gpointer)((guintptr)(node) & ~(guintptr)(BLOCK_SIZE - 1)))
+
+/* blocks are carved out of chunks of memory, with room for aligning them */
+#define CHUNK_BLOCKS    8
+#define CHUNK_SIZE      ((CHUNK_BLOCKS + 1) * BLOCK_SIZE)
+
+typedef struct {
+  GList *cur;
+  GList *end;
+} NodeRange;
+
+struct _GXListArena {
+  GMutex      lock;
+  GPtrArray  *chunks;       /* the memory for the blocks */
+  GPtrArray  *blocks;       /* all blocks, in order of allocation */
+  guint       next_block;   /* first block not handed out yet */
+  GArray     *spares;       /* NodeRanges left over by popped magazines */
+  guint       users;        /* number of pushes without a pop */
+};
+
+static GPrivate magazine_key = G_PRIVATE_INIT (NULL);
+
+/* the blocks of all arenas, mapped to their arena; this way, we can recognize
+ * arena nodes no matter what the thread-default arena is */
+static GRWLock     registry_lock;
+static GHashTable *registry;
+static gint        registry_size; /* atomic; for a lock-free fast path */
+
+static void
+registry_add (GXListArena *arena, gpointer block)
+{
+  g_rw_lock_writer_lock (&registry_lock);
+
+  if (!registry)
+    registry = g_hash_table_new (g_direct_hash, g_direct_equal);
+  g_hash_table_insert (registry, block, arena);
+  g_atomic_int_inc (&registry_size);
+
+  g_rw_lock_writer_unlock (&registry_lock);
+}
+
+static void
+registry_remove (gpointer block)
+{
+  g_rw_lock_writer_lock (&registry_lock);
+
+  g_hash_table_remove (registry, block);
+  g_atomic_int_add (&registry_size, -1);
+
+  g_rw_lock_writer_unlock (&registry_lock);
+}
+
+/* the arena that owns block, or NULL if there is none */
+static GXListArena*
+registry_lookup (gpointer block)
+{
+  GXListArena *arena;
+
+  if (g_atomic_int_get (&registry_size) == 0)
+    return NULL;
+
+  g_rw_lock_reader_lock (&registry_lock);
+  arena = registry ? g_hash_table_lookup (registry, block) : NULL;
+  g_rw_lock_reader_unlock (&registry_lock);
+
+  return arena;
+}
+
+/**
+ * gx_list_arena_new:
+ *
+ * Create a new, empty #GXListArena. Memory is only allocated once nodes are
+ * taken from the arena.
+ *
+ * Returns: (transfer full): a new #GXListArena; free with
+ * gx_list_arena_free().
+ */
+GXListArena*
+gx_list_arena_new (void)
+{
+  GXListArena *arena;
+
+  arena = g_slice_new0 (GXListArena);
+
+  g_mutex_init (&arena->lock);
+  arena->chunks = g_ptr_array_new_with_free_func (g_free);
+  arena->blocks = g_ptr_array_new ();
+  arena->spares = g_array_new (FALSE, FALSE, sizeof (NodeRange));
+
+  return arena;
+}
+
+
+/**
+ * gx_list_arena_free:
+ * @arena: a #GXListArena
+ *
+ * Free @arena, and all the list nodes that were allocated from it. The arena
+ * must not be the thread-default arena of any thread.
+ */
+void
+gx_list_arena_free (GXListArena *arena)
+{
+  guint users, u;
+
+  if (!arena)
+    return;
+
+  g_mutex_lock (&arena->lock);
+  users = arena->users;
+  g_mutex_unlock (&arena->lock);
+
+  g_return_if_fail (users == 0);
+
+  for (u = 0; u != arena->blocks->len; ++u)
+    registry_remove (g_ptr_array_index (arena->blocks, u));
+
+  g_ptr_array_free (arena->blocks, TRUE);
+  g_ptr_array_free (arena->chunks, TRUE);
+  g_array_free (arena->spares, TRUE);
+  g_mutex_clear (&arena->lock);
+
+  g_slice_free (GXListArena, arena);
+}
+
+
+/**
+ * gx_list_arena_clear:
+ * @arena: a #GXListArena
+ *
+ * Release all the list nodes that were allocated from @arena in constant
+ * time, after which any lists built from them are invalid. Unlike
+ * gx_list_arena_free(), the memory is kept for re-use, so clearing and
+ * re-using an arena for a series of temporary lists needs no allocations at
+ * all after the first round.
+ *
+ * The arena must not be the thread-default arena of any thread.
+ */
+void
+gx_list_arena_clear (GXListArena *arena)
+{
+  guint users;
+
+  g_return_if_fail (arena);
+
+  g_mutex_lock (&arena->lock);
+  users = arena->users;
+  if (users == 0)
+    {
+      arena->next_block = 0;
+      g_array_set_size (arena->spares, 0);
+    }
+  g_mutex_unlock (&arena->lock);
+
+  g_return_if_fail (users == 0);
+}
+
+
+/**
+ * gx_list_arena_push_thread_default:
+ * @arena: a #GXListArena
+ *
+ * Make @arena the thread-default arena for the calling thread; until the
+ * matching gx_list_arena_pop_thread_default(), lists created by gxlib in this
+ * thread take their nodes from @arena. Pushes can be nested, also with
+ * different arenas.
+ */
+void
+gx_list_arena_push_thread_default (GXListArena *arena)
+{
+  GXListMagazine *mag;
+
+  g_return_if_fail (arena);
+
+  g_mutex_lock (&arena->lock);
+  ++arena->users;
+  g_mutex_unlock (&arena->lock);
+
+  mag        = g_slice_new0 (GXListMagazine);
+  mag->arena = arena;
+  mag->prev  = g_private_get (&magazine_key);
+
+  g_private_set (&magazine_key, mag);
+}
+
+
+/**
+ * gx_list_arena_pop_thread_default:
+ * @arena: a #GXListArena
+ *
+ * Undo the last gx_list_arena_push_thread_default() for @arena in the calling
+ * thread. The nodes allocated from @arena stay valid until @arena is cleared
+ * or freed.
+ */
+void
+gx_list_arena_pop_thread_default (GXListArena *arena)
+{
+  GXListMagazine *mag;
+
+  mag = g_private_get (&magazine_key);
+
+  g_return_if_fail (arena);
+  g_return_if_fail (mag && mag->arena == arena);
+
+  g_mutex_lock (&arena->lock);
+
+  /* give the unused part of our magazine back to the arena */
+  if (mag->cur != mag->end)
+    {
+      NodeRange range;
+
+      range.cur = mag->cur;
+      range.end = mag->end;
+      g_array_append_val (arena->spares, range);
+    }
+  --arena->users;
+
+  g_mutex_unlock (&arena->lock);
+
+  g_private_set (&magazine_key, mag->prev);
+  g_slice_free (GXListMagazine, mag);
+}
+
+
+/**
+ * gx_list_arena_get_thread_default:
+ *
+ * Get the thread-default arena for the calling thread, if any.
+ *
+ * Returns: (transfer none): the thread-default #GXListArena or %NULL.
+ */
+GXListArena*
+gx_list_arena_get_thread_default (void)
+{
+  GXListMagazine *mag;
+
+  mag = g_private_get (&magazine_key);
+
+  return mag ? mag->arena : NULL;
+}
+
+
+/**
+ * gx_list_arena_owns:
+ * @arena: a #GXListArena
+ * @node: a #GList node
+ *
+ * Check whether @node was allocated from @arena.
+ *
+ * Returns: %TRUE if @node belongs to @arena, %FALSE otherwise.
+ */
+gboolean
+gx_list_arena_owns (GXListArena *arena, GList *node)
+{
+  g_return_val_if_fail (arena, FALSE);
+
+  if (!node)
+    return FALSE;
+
+  return registry_lookup (BLOCK_OF (node)) == arena;
+}
+
+
+GXListMagazine*
+gx_list_magazine_get (void)
+{
+  return g_private_get (&magazine_key);
+}
+
+
+GList*
+gx_list_magazine_refill (GXListMagazine *mag)
+{
+  GXListArena *arena;
+
+  arena = mag->arena;
+  g_mutex_lock (&arena->lock);
+
+  if (arena->spares->len > 0)
+    {
+      NodeRange *range;
+
+      range = &g_array_index (arena->spares, NodeRange,
+                              arena->spares->len - 1);
+      mag->cur = range->cur;
+      mag->end = range->end;
+      g_array_set_size (arena->spares, arena->spares->len - 1);
+    }
+  else
+    {
+      gpointer block;
+
+      if (arena->next_block == arena->blocks->len)
+        {
+          gpointer chunk;
+          guint    u;
+
+          /* there's no portable aligned allocator in the GLib versions we
+           * support, so align the blocks within a slightly bigger chunk */
+          chunk = g_malloc (CHUNK_SIZE);
+          g_ptr_array_add (arena->chunks, chunk);
+
+          block = BLOCK_OF ((guint8*)chunk + BLOCK_SIZE - 1);
+          for (u = 0; u != CHUNK_BLOCKS; ++u)
+            {
+              g_ptr_array_add (arena->blocks, block);
+              registry_add (arena, block);
+              block = (guint8*)block + BLOCK_SIZE;
+            }
+        }
+
+      block    = g_ptr_array_index (arena->blocks, arena->next_block++);
+      mag->cur = (GList*)block;
+      mag->end = mag->cur + NODES_PER_BLOCK;
+    }
+
+  g_mutex_unlock (&arena->lock);
+
+  mag->block = BLOCK_OF (mag->cur);
+
+  return mag->cur++;
+}
+
+
+gboolean
+gx_list_node_in_arena (GXListMagazine *mag, GList *node)
+{
+  GXListArena *arena;
+  gpointer     block;
+
+  block = BLOCK_OF (node);
+  if (mag && (block == mag->block || block == mag->seen))
+    return TRUE;
+
+  arena = registry_lookup (block);
+  if (!arena)
+    return FALSE;
+
+  /* only cache blocks of mag's own arena; that one cannot go away while mag
+   * is alive, unlike the others */
+  if (mag && arena == mag->arena)
+    mag->seen = block;
+
+  return TRUE;
+}
+
+
+void
+gx_list_free_nodes (GList *list, GDestroyNotify free_func)
+{
+  GXListMagazine *mag;
+
+  /* no arenas with blocks, so all of them are normal nodes */
+  if (g_atomic_int_get (&registry_size) == 0)
+    {
+      if (free_func)
+        g_list_free_full (list, free_func);
+      else
+        g_list_free (list);
+      return;
+    }
+
+  mag = gx_list_magazine_get ();
+  while (list)
+    {
+      GList *next;
+
+      next = list->next;
+      if (free_func)
+        (*free_func) (list->data);
+
+      gx_list_node_free (mag, list);
+      list = next;
+    }
+}
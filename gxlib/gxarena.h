@@ -0,0 +1,53 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_ARENA_H__
+#define __GX_ARENA_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXListArena:
+ *
+ * A #GXListArena is a bulk allocator for #GList nodes. While an arena is the
+ * thread-default arena, the gxlib functions that create lists allocate their
+ * nodes from it, and all of those nodes are released at once with
+ * gx_list_arena_clear() or gx_list_arena_free().
+ *
+ * The struct has only private fields and should not be directly accessed.
+ */
+struct _GXListArena;
+typedef struct _GXListArena GXListArena;
+
+GXListArena *gx_list_arena_new (void) G_GNUC_WARN_UNUSED_RESULT;
+void gx_list_arena_free (GXListArena *arena);
+void gx_list_arena_clear (GXListArena *arena);
+
+void gx_list_arena_push_thread_default (GXListArena *arena);
+void gx_list_arena_pop_thread_default (GXListArena *arena);
+GXListArena *gx_list_arena_get_thread_default (void);
+
+gboolean gx_list_arena_owns (GXListArena *arena, GList *node);
+
+G_END_DECLS
+
+#endif /* __GX_ARENA_H__ */
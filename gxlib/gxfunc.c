@@ -18,6 +18,7 @@
 */
 
 #include <gxlib.h>
+#include "gxlib-private.h"
 
 
 char*
@@ -28,3 +29,292 @@ gx_str_chain (const char *s1, const char *s2, const char *sepa)
   else
     return g_strconcat (s1, sepa, s2, NULL);
 }
+
+
+gint
+gx_plus (gint i, gint j)
+{
+  return i + j;
+}
+
+
+gint
+gx_times (gint i, gint j)
+{
+  return i * j;
+}
+
+
+gint
+gx_max (gint i, gint j)
+{
+  return MAX(i,j);
+}
+
+
+gint
+gx_min (gint i, gint j)
+{
+  return MIN(i,j);
+}
+
+
+gint
+gx_cmp_int (gint i, gint j)
+{
+  return (i > j) - (i < j);
+}
+
+
+/**
+ * gx_reducer_for_func:
+ * @func: a function pointer
+ *
+ * Find out whether @func is one of the integer reducers gxlib knows about:
+ * gx_plus(), gx_times(), gx_max() or gx_min().
+ *
+ * |[<!-- language="C" -->
+ * g_assert (gx_reducer_for_func ((GCallback)gx_max) == GX_REDUCER_MAX);
+ * g_assert (gx_reducer_for_func ((GCallback)gx_str_chain) == GX_REDUCER_NONE);
+ * ]|
+ *
+ * Returns: the #GXReducer for @func, or %GX_REDUCER_NONE.
+ */
+GXReducer
+gx_reducer_for_func (GCallback func)
+{
+  if (func == (GCallback)gx_plus)
+    return GX_REDUCER_PLUS;
+  else if (func == (GCallback)gx_times)
+    return GX_REDUCER_TIMES;
+  else if (func == (GCallback)gx_max)
+    return GX_REDUCER_MAX;
+  else if (func == (GCallback)gx_min)
+    return GX_REDUCER_MIN;
+  else
+    return GX_REDUCER_NONE;
+}
+
+
+/*
+ * the built-in kernels for the gx_plus() etc. on GINT_TO_POINTER() values;
+ * these use independent accumulators, so the operations can overlap. Sums and
+ * products use unsigned integers, so overflow wraps around in the same way for
+ * every order of evaluation.
+ */
+static gpointer
+plus_kernel (gpointer acc, gpointer *data, gsize n, gpointer user_data)
+{
+  guint s0, s1, s2, s3;
+  gsize u;
+
+  s0 = (guint)GPOINTER_TO_INT (acc);
+  s1 = s2 = s3 = 0;
+  for (u = 0; u + 4 <= n; u += 4)
+    {
+      s0 += (guint)GPOINTER_TO_INT (data[u]);
+      s1 += (guint)GPOINTER_TO_INT (data[u + 1]);
+      s2 += (guint)GPOINTER_TO_INT (data[u + 2]);
+      s3 += (guint)GPOINTER_TO_INT (data[u + 3]);
+    }
+  for (; u != n; ++u)
+    s0 += (guint)GPOINTER_TO_INT (data[u]);
+
+  return GINT_TO_POINTER ((gint)(s0 + s1 + s2 + s3));
+}
+
+static gpointer
+times_kernel (gpointer acc, gpointer *data, gsize n, gpointer user_data)
+{
+  guint p0, p1, p2, p3;
+  gsize u;
+
+  p0 = (guint)GPOINTER_TO_INT (acc);
+  p1 = p2 = p3 = 1;
+  for (u = 0; u + 4 <= n; u += 4)
+    {
+      p0 *= (guint)GPOINTER_TO_INT (data[u]);
+      p1 *= (guint)GPOINTER_TO_INT (data[u + 1]);
+      p2 *= (guint)GPOINTER_TO_INT (data[u + 2]);
+      p3 *= (guint)GPOINTER_TO_INT (data[u + 3]);
+    }
+  for (; u != n; ++u)
+    p0 *= (guint)GPOINTER_TO_INT (data[u]);
+
+  return GINT_TO_POINTER ((gint)(p0 * p1 * p2 * p3));
+}
+
+static gpointer
+max_kernel (gpointer acc, gpointer *data, gsize n, gpointer user_data)
+{
+  gint  m0, m1, m2, m3;
+  gsize u;
+
+  m0 = m1 = m2 = m3 = GPOINTER_TO_INT (acc);
+  for (u = 0; u + 4 <= n; u += 4)
+    {
+      m0 = MAX (m0, GPOINTER_TO_INT (data[u]));
+      m1 = MAX (m1, GPOINTER_TO_INT (data[u + 1]));
+      m2 = MAX (m2, GPOINTER_TO_INT (data[u + 2]));
+      m3 = MAX (m3, GPOINTER_TO_INT (data[u + 3]));
+    }
+  for (; u != n; ++u)
+    m0 = MAX (m0, GPOINTER_TO_INT (data[u]));
+
+  return GINT_TO_POINTER (MAX (MAX (m0, m1), MAX (m2, m3)));
+}
+
+static gpointer
+min_kernel (gpointer acc, gpointer *data, gsize n, gpointer user_data)
+{
+  gint  m0, m1, m2, m3;
+  gsize u;
+
+  m0 = m1 = m2 = m3 = GPOINTER_TO_INT (acc);
+  for (u = 0; u + 4 <= n; u += 4)
+    {
+      m0 = MIN (m0, GPOINTER_TO_INT (data[u]));
+      m1 = MIN (m1, GPOINTER_TO_INT (data[u + 1]));
+      m2 = MIN (m2, GPOINTER_TO_INT (data[u + 2]));
+      m3 = MIN (m3, GPOINTER_TO_INT (data[u + 3]));
+    }
+  for (; u != n; ++u)
+    m0 = MIN (m0, GPOINTER_TO_INT (data[u]));
+
+  return GINT_TO_POINTER (MIN (MIN (m0, m1), MIN (m2, m3)));
+}
+
+
+/* kernels registered by the application; these take precedence over the
+ * built-in ones */
+static GRWLock     kernel_lock;
+static GHashTable *kernel_table;
+static gint        kernel_count;
+
+/**
+ * gx_fold_kernel_register:
+ * @fold_func: a fold function
+ * @kernel: a #GXFoldKernel that computes the same as @fold_func
+ *
+ * Register @kernel as a fast implementation of @fold_func. After this, folds
+ * with @fold_func, such as gx_list_fold(), gx_vec_fold() and gx_iter_fold(),
+ * call @kernel for whole batches of elements rather than calling @fold_func
+ * for each element. Kernels are only used when no @free_func is passed to the
+ * fold, since intermediate values never surface.
+ *
+ * gxlib has built-in kernels for gx_plus(), gx_times(), gx_max(), gx_min(),
+ * gx_stats_fold_int() and gx_stats_fold_double(); registering a kernel for
+ * one of those replaces the built-in one.
+ *
+ * |[<!-- language="C" -->
+ * static gpointer
+ * xor_func (gpointer p1, gpointer p2, gpointer user_data)
+ * {
+ *   return GUINT_TO_POINTER (GPOINTER_TO_UINT (p1) ^ GPOINTER_TO_UINT (p2));
+ * }
+ *
+ * static gpointer
+ * xor_kernel (gpointer acc, gpointer *data, gsize n, gpointer user_data)
+ * {
+ *   guint x;
+ *   gsize u;
+ *
+ *   for (x = GPOINTER_TO_UINT (acc), u = 0; u != n; ++u)
+ *     x ^= GPOINTER_TO_UINT (data[u]);
+ *
+ *   return GUINT_TO_POINTER (x);
+ * }
+ *
+ * gx_fold_kernel_register ((GXTernaryFunc)xor_func, xor_kernel);
+ * ]|
+ */
+void
+gx_fold_kernel_register (GXTernaryFunc fold_func, GXFoldKernel kernel)
+{
+  g_return_if_fail (fold_func);
+  g_return_if_fail (kernel);
+
+  g_rw_lock_writer_lock (&kernel_lock);
+
+  if (!kernel_table)
+    kernel_table = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  g_hash_table_insert (kernel_table, (gpointer)fold_func, (gpointer)kernel);
+  g_atomic_int_set (&kernel_count, g_hash_table_size (kernel_table));
+
+  g_rw_lock_writer_unlock (&kernel_lock);
+}
+
+
+/**
+ * gx_fold_kernel_unregister:
+ * @fold_func: a fold function
+ *
+ * Remove the kernel registered for @fold_func with gx_fold_kernel_register(),
+ * if any. For gx_plus() etc., this restores the built-in kernel.
+ */
+void
+gx_fold_kernel_unregister (GXTernaryFunc fold_func)
+{
+  g_return_if_fail (fold_func);
+
+  g_rw_lock_writer_lock (&kernel_lock);
+
+  if (kernel_table)
+    {
+      g_hash_table_remove (kernel_table, (gpointer)fold_func);
+      g_atomic_int_set (&kernel_count, g_hash_table_size (kernel_table));
+    }
+
+  g_rw_lock_writer_unlock (&kernel_lock);
+}
+
+
+/**
+ * gx_fold_kernel_lookup:
+ * @fold_func: a fold function
+ *
+ * Find the #GXFoldKernel for @fold_func; either one registered with
+ * gx_fold_kernel_register(), or a built-in one.
+ *
+ * Returns: the kernel for @fold_func, or %NULL if there is none.
+ */
+GXFoldKernel
+gx_fold_kernel_lookup (GXTernaryFunc fold_func)
+{
+  if (!fold_func)
+    return NULL;
+
+  /* avoid the lock in the common case where nothing was registered */
+  if (g_atomic_int_get (&kernel_count) > 0)
+    {
+      GXFoldKernel kernel;
+
+      g_rw_lock_reader_lock (&kernel_lock);
+      kernel = (GXFoldKernel)g_hash_table_lookup (kernel_table,
+                                                  (gpointer)fold_func);
+      g_rw_lock_reader_unlock (&kernel_lock);
+
+      if (kernel)
+        return kernel;
+    }
+
+  if (fold_func == (GXTernaryFunc)gx_stats_fold_int)
+    return gx_stats_fold_int_kernel;
+  if (fold_func == (GXTernaryFunc)gx_stats_fold_double)
+    return gx_stats_fold_double_kernel;
+
+  switch (gx_reducer_for_func ((GCallback)fold_func))
+    {
+    case GX_REDUCER_PLUS:
+      return plus_kernel;
+    case GX_REDUCER_TIMES:
+      return times_kernel;
+    case GX_REDUCER_MAX:
+      return max_kernel;
+    case GX_REDUCER_MIN:
+      return min_kernel;
+    default:
+      return NULL;
+    }
+}
@@ -134,11 +134,7 @@ char* gx_str_chain (const char *s1, const char *s2, const char *sepa)
  *
  * Return value: i + j
  */
-static inline gint
-gx_plus (gint i, gint j)
-{
-  return i + j;
-}
+gint gx_plus (gint i, gint j);
 
 /**
  * gx_times:
@@ -154,11 +150,7 @@ gx_plus (gint i, gint j)
  *
  * Return value: i ✕ j
  */
-static inline gint
-gx_times (gint i, gint j)
-{
-  return i * j;
-}
+gint gx_times (gint i, gint j);
 
 
 /**
@@ -175,11 +167,7 @@ gx_times (gint i, gint j)
  *
  * Return value: the greatest of @i and @j.
  */
-static inline gint
-gx_max (gint i, gint j)
-{
-  return MAX(i,j);
-}
+gint gx_max (gint i, gint j);
 
 /**
  * gx_min:
@@ -195,11 +183,67 @@ gx_max (gint i, gint j)
  *
  * Return value: the smallest of @i and @j.
  */
-static inline gint
-gx_min (gint i, gint j)
-{
-  return MIN(i,j);
-}
+gint gx_min (gint i, gint j);
+
+/**
+ * gx_cmp_int:
+ * @i: an integer value
+ * @j: another integer value
+ *
+ * Compare @i and @j. Cast to #GCompareFunc, this compares the integers stored
+ * in pointers with GINT_TO_POINTER(), e.g. for g_list_sort() or
+ * gx_list_sorted_union().
+ *
+ * |[<!-- language="C" -->
+ *   g_assert_cmpint (gx_cmp_int (-5, 3),<, 0);
+ * ]|
+ *
+ * Return value: a negative value if @i < @j, 0 if they are equal, and a
+ * positive value if @i > @j.
+ */
+gint gx_cmp_int (gint i, gint j);
+
+/**
+ * GXReducer:
+ * @GX_REDUCER_NONE: not one of the known reducers
+ * @GX_REDUCER_PLUS: gx_plus()
+ * @GX_REDUCER_TIMES: gx_times()
+ * @GX_REDUCER_MAX: gx_max()
+ * @GX_REDUCER_MIN: gx_min()
+ *
+ * The integer functions that gxlib recognizes as reducers; when passed to e.g.
+ * gx_int_array_fold(), these are computed with specialized loops rather than
+ * by calling the function for every element.
+ */
+typedef enum {
+  GX_REDUCER_NONE,
+  GX_REDUCER_PLUS,
+  GX_REDUCER_TIMES,
+  GX_REDUCER_MAX,
+  GX_REDUCER_MIN
+} GXReducer;
+
+GXReducer gx_reducer_for_func (GCallback func);
+
+/**
+ * GXFoldKernel:
+ * @acc: the accumulated value so far
+ * @data: an array of elements
+ * @n: the number of elements in @data
+ * @user_data: (allow-none): the user pointer passed to the fold function
+ *
+ * Prototype for a fold kernel: a function that computes the same as calling
+ * some #GXTernaryFunc for each of the @n elements in @data in turn, starting
+ * with @acc, but (presumably) faster. See gx_fold_kernel_register().
+ *
+ * Return value: the accumulated value after folding all elements of @data.
+ */
+typedef gpointer (*GXFoldKernel) (gpointer acc, gpointer *data, gsize n,
+                                  gpointer user_data);
+
+void gx_fold_kernel_register (GXTernaryFunc fold_func, GXFoldKernel kernel);
+void gx_fold_kernel_unregister (GXTernaryFunc fold_func);
+GXFoldKernel gx_fold_kernel_lookup (GXTernaryFunc fold_func);
 
 G_END_DECLS
 
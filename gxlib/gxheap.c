@@ -0,0 +1,596 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxheap.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxheap
+ * @title: Heaps
+ * @short_description: a priority queue, and the list functions built on it
+ *
+ * A #GXHeap keeps its elements partially ordered by a comparison function, so
+ * that the smallest element is always at the top: gx_heap_peek() takes
+ * constant time, gx_heap_push() and gx_heap_pop() logarithmic time.
+ *
+ * The heap is stored in a single array, with each element having up to four
+ * children; compared to a binary heap, this halves the depth of the tree,
+ * and the children of an element are next to each other in memory.
+ *
+ * |[<!-- language="C" -->
+ * GXHeap *heap;
+ *
+ * heap = gx_heap_new ((GCompareFunc)gx_cmp_int);
+ * gx_heap_push (heap, GINT_TO_POINTER (3));
+ * gx_heap_push (heap, GINT_TO_POINTER (1));
+ * gx_heap_push (heap, GINT_TO_POINTER (2));
+ *
+ * g_assert_cmpint (GPOINTER_TO_INT (gx_heap_pop (heap)), ==, 1);
+ * g_assert_cmpint (GPOINTER_TO_INT (gx_heap_pop (heap)), ==, 2);
+ * g_assert_cmpuint (gx_heap_get_size (heap), ==, 1);
+ *
+ * gx_heap_free (heap, NULL);
+ * ]|
+ *
+ * The heap is what makes gx_list_top_k() and gx_list_merge_sorted() cheap:
+ * the former keeps only the k best elements seen so far, the latter only the
+ * first remaining element of each list.
+ */
+
+#define HEAP_ARITY    4
+#define MIN_HEAP_SIZE 16
+
+struct _GXHeap {
+  gpointer         *items;
+  gsize             len;
+  gsize             alloc;
+  GCompareDataFunc  cmp_func;
+  gpointer          user_data;
+};
+
+#define HEAP_CMP(heap,a,b) ((*(heap)->cmp_func) ((a), (b), (heap)->user_data))
+
+static void
+heap_sift_up (GXHeap *heap, gsize i, gpointer data)
+{
+  while (i > 0)
+    {
+      gsize parent;
+
+      parent = (i - 1) / HEAP_ARITY;
+      if (HEAP_CMP (heap, data, heap->items[parent]) >= 0)
+        break;
+
+      heap->items[i] = heap->items[parent];
+      i              = parent;
+    }
+
+  heap->items[i] = data;
+}
+
+static void
+heap_sift_down (GXHeap *heap, gsize i, gpointer data)
+{
+  for (;;)
+    {
+      gsize first, last, best, c;
+
+      first = i * HEAP_ARITY + 1;
+      if (first >= heap->len)
+        break;
+
+      last = MIN (first + HEAP_ARITY, heap->len);
+      for (best = first, c = first + 1; c < last; ++c)
+        if (HEAP_CMP (heap, heap->items[c], heap->items[best]) < 0)
+          best = c;
+
+      if (HEAP_CMP (heap, heap->items[best], data) >= 0)
+        break;
+
+      heap->items[i] = heap->items[best];
+      i              = best;
+    }
+
+  heap->items[i] = data;
+}
+
+
+/**
+ * gx_heap_new:
+ * @cmp_func: a function to compare the elements
+ *
+ * Create a new, empty #GXHeap, ordered by @cmp_func.
+ *
+ * Returns: (transfer full): a new #GXHeap; free with gx_heap_free().
+ */
+GXHeap*
+gx_heap_new (GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  /* like g_ptr_array_sort(), rely on the extra argument being ignored */
+  return gx_heap_sized_new ((GCompareDataFunc)cmp_func, NULL, 0);
+}
+
+
+/**
+ * gx_heap_new_with_data:
+ * @cmp_func: a function to compare the elements
+ * @user_data: (allow-none): a user pointer passed to @cmp_func
+ *
+ * Like gx_heap_new(), but with a comparison function that takes a user
+ * pointer.
+ *
+ * Returns: (transfer full): a new #GXHeap; free with gx_heap_free().
+ */
+GXHeap*
+gx_heap_new_with_data (GCompareDataFunc cmp_func, gpointer user_data)
+{
+  return gx_heap_sized_new (cmp_func, user_data, 0);
+}
+
+
+/**
+ * gx_heap_sized_new:
+ * @cmp_func: a function to compare the elements
+ * @user_data: (allow-none): a user pointer passed to @cmp_func
+ * @reserved_size: number of elements to pre-allocate space for
+ *
+ * Like gx_heap_new_with_data(), but with room for @reserved_size elements.
+ * This avoids re-allocations when the number of elements is known in
+ * advance.
+ *
+ * Returns: (transfer full): a new #GXHeap; free with gx_heap_free().
+ */
+GXHeap*
+gx_heap_sized_new (GCompareDataFunc cmp_func, gpointer user_data,
+                   gsize reserved_size)
+{
+  GXHeap *heap;
+
+  g_return_val_if_fail (cmp_func, NULL);
+
+  heap            = g_slice_new0 (GXHeap);
+  heap->cmp_func  = cmp_func;
+  heap->user_data = user_data;
+  heap->alloc     = MAX (reserved_size, MIN_HEAP_SIZE);
+  heap->items     = g_new (gpointer, heap->alloc);
+
+  return heap;
+}
+
+
+/**
+ * gx_heap_free:
+ * @heap: a #GXHeap
+ * @free_func: (allow-none): function to free the elements in @heap
+ *
+ * Free @heap, after freeing each of its elements with @free_func, if it is
+ * not %NULL.
+ */
+void
+gx_heap_free (GXHeap *heap, GDestroyNotify free_func)
+{
+  gsize u;
+
+  if (!heap)
+    return;
+
+  if (free_func)
+    for (u = 0; u != heap->len; ++u)
+      (*free_func) (heap->items[u]);
+
+  g_free (heap->items);
+  g_slice_free (GXHeap, heap);
+}
+
+
+/**
+ * gx_heap_get_size:
+ * @heap: a #GXHeap
+ *
+ * Get the number of elements in @heap.
+ *
+ * Returns: the number of elements.
+ */
+gsize
+gx_heap_get_size (GXHeap *heap)
+{
+  g_return_val_if_fail (heap, 0);
+
+  return heap->len;
+}
+
+
+/**
+ * gx_heap_push:
+ * @heap: a #GXHeap
+ * @data: a pointer
+ *
+ * Add @data to @heap. This takes O(log n) time.
+ */
+void
+gx_heap_push (GXHeap *heap, gpointer data)
+{
+  g_return_if_fail (heap);
+
+  if (G_UNLIKELY (heap->len == heap->alloc))
+    {
+      heap->alloc *= 2;
+      heap->items  = g_renew (gpointer, heap->items, heap->alloc);
+    }
+
+  heap_sift_up (heap, heap->len++, data);
+}
+
+
+/**
+ * gx_heap_peek:
+ * @heap: a #GXHeap
+ *
+ * Get the smallest element of @heap, without removing it.
+ *
+ * Returns: (transfer none): the smallest element, or %NULL if @heap is
+ * empty.
+ */
+gpointer
+gx_heap_peek (GXHeap *heap)
+{
+  g_return_val_if_fail (heap, NULL);
+
+  return heap->len > 0 ? heap->items[0] : NULL;
+}
+
+
+/**
+ * gx_heap_pop:
+ * @heap: a #GXHeap
+ *
+ * Remove the smallest element from @heap. This takes O(log n) time.
+ *
+ * Returns: (transfer full): the smallest element, or %NULL if @heap is
+ * empty.
+ */
+gpointer
+gx_heap_pop (GXHeap *heap)
+{
+  gpointer top;
+
+  g_return_val_if_fail (heap, NULL);
+
+  if (heap->len == 0)
+    return NULL;
+
+  top = heap->items[0];
+  if (--heap->len > 0)
+    heap_sift_down (heap, 0, heap->items[heap->len]);
+
+  return top;
+}
+
+
+/**
+ * gx_heap_replace:
+ * @heap: a non-empty #GXHeap
+ * @data: a pointer
+ *
+ * Remove the smallest element from @heap, and add @data. This is equivalent
+ * to gx_heap_pop() followed by gx_heap_push(), but about twice as fast.
+ *
+ * Returns: (transfer full): the element that was the smallest before @data
+ * was added.
+ */
+gpointer
+gx_heap_replace (GXHeap *heap, gpointer data)
+{
+  gpointer top;
+
+  g_return_val_if_fail (heap, NULL);
+  g_return_val_if_fail (heap->len > 0, NULL);
+
+  top = heap->items[0];
+  heap_sift_down (heap, 0, data);
+
+  return top;
+}
+
+
+static gint
+cmp_nodes (GList *node1, GList *node2, GCompareFunc cmp_func)
+{
+  return (*cmp_func) (node1->data, node2->data);
+}
+
+/* drop the node from an in-place operation */
+static void
+node_drop (GXListMagazine *mag, GList *node, GDestroyNotify free_func)
+{
+  if (free_func)
+    (*free_func) (node->data);
+
+  gx_list_node_free (mag, node);
+}
+
+/**
+ * gx_list_top_k:
+ * @list: a #GList
+ * @k: the number of elements to get
+ * @cmp_func: a function to compare the elements
+ *
+ * Get the @k largest elements of @list according to @cmp_func, largest
+ * first; if @list has fewer than @k elements, get all of them, sorted.
+ *
+ * This is equivalent to sorting @list in descending order and taking the
+ * first @k elements, but takes only O(n log k) time and O(k) memory. Which of
+ * a number of equal elements are chosen is not specified.
+ *
+ * |[<!-- language="C" -->
+ * GList *nums, *top;
+ *
+ * nums = gx_list_iota (100, 1, 1);
+ * top  = gx_list_top_k (nums, 3, (GCompareFunc)gx_cmp_int); // 100, 99, 98
+ * g_assert_cmpint (gx_list_sum (top), ==, 100 + 99 + 98);
+ * g_assert_cmpint (GPOINTER_TO_INT (top->data), ==, 100);
+ *
+ * g_list_free (nums);
+ * g_list_free (top);
+ * ]|
+ *
+ * Returns: (transfer full): a list with the @k largest elements; free with
+ * g_list_free().
+ */
+GList*
+gx_list_top_k (GList *list, gsize k, GCompareFunc cmp_func)
+{
+  GXListBuilder   builder;
+  GXHeap         *heap;
+  gpointer       *items;
+  gsize           n, u;
+
+  g_return_val_if_fail (cmp_func, NULL);
+
+  if (k == 0)
+    return NULL;
+
+  heap = gx_heap_sized_new ((GCompareDataFunc)cmp_func, NULL, MIN (k, 4096));
+
+  for (; list; list = list->next)
+    if (heap->len < k)
+      gx_heap_push (heap, list->data);
+    else if ((*cmp_func) (list->data, heap->items[0]) > 0)
+      gx_heap_replace (heap, list->data);
+
+  /* the heap pops the smallest first */
+  n     = heap->len;
+  items = g_new (gpointer, n);
+  for (u = n; u != 0; --u)
+    items[u - 1] = gx_heap_pop (heap);
+
+  gx_list_builder_init (&builder);
+  for (u = 0; u != n; ++u)
+    gx_list_builder_append (&builder, items[u]);
+
+  g_free (items);
+  gx_heap_free (heap, NULL);
+
+  return builder.head;
+}
+
+/**
+ * gx_list_top_k_in_place:
+ * @list: a #GList
+ * @k: the number of elements to keep
+ * @cmp_func: a function to compare the elements
+ * @free_func: (allow-none): function to free the elements that are removed
+ *
+ * Like gx_list_top_k(), but keep the @k largest elements in @list itself,
+ * re-using their nodes, and remove the others, freeing them with @free_func.
+ *
+ * Returns: the list with the @k largest elements, largest first.
+ */
+GList*
+gx_list_top_k_in_place (GList *list, gsize k, GCompareFunc cmp_func,
+                        GDestroyNotify free_func)
+{
+  GXListMagazine *mag;
+  GXHeap         *heap;
+  GList          *node, *next;
+
+  g_return_val_if_fail (cmp_func, list);
+
+  if (k == 0)
+    {
+      gx_list_free_nodes (list, free_func);
+      return NULL;
+    }
+
+  mag  = gx_list_magazine_get ();
+  heap = gx_heap_sized_new ((GCompareDataFunc)cmp_nodes, cmp_func,
+                            MIN (k, 4096));
+
+  for (node = list; node; node = next)
+    {
+      next = node->next;
+
+      if (heap->len < k)
+        gx_heap_push (heap, node);
+      else if ((*cmp_func) (node->data, ((GList*)heap->items[0])->data) > 0)
+        node_drop (mag, gx_heap_replace (heap, node), free_func);
+      else
+        node_drop (mag, node, free_func);
+    }
+
+  /* the heap pops the smallest first, so prepend */
+  for (list = NULL; (node = gx_heap_pop (heap));)
+    {
+      node->prev = NULL;
+      node->next = list;
+      if (list)
+        list->prev = node;
+      list = node;
+    }
+
+  gx_heap_free (heap, NULL);
+
+  return list;
+}
+
+
+/* the remaining part of one of the lists being merged; the heap holds
+ * pointers into an array of these, so equal elements can be taken from the
+ * earlier list first */
+typedef struct {
+  GList *node;
+} MergeCursor;
+
+static gint
+cmp_cursors (MergeCursor *cur1, MergeCursor *cur2, GCompareFunc cmp_func)
+{
+  gint cmp;
+
+  cmp = (*cmp_func) (cur1->node->data, cur2->node->data);
+  if (cmp != 0)
+    return cmp;
+
+  return cur1 < cur2 ? -1 : cur1 > cur2;
+}
+
+static GList*
+list_merge_sorted (GList **lists, gsize n_lists, GCompareFunc cmp_func,
+                   gboolean in_place)
+{
+  GXListBuilder  builder;
+  GXHeap        *heap;
+  MergeCursor   *cursors, *cur;
+  GList         *head, *tail;
+  gsize          u;
+
+  cursors = g_new (MergeCursor, n_lists);
+  heap    = gx_heap_sized_new ((GCompareDataFunc)cmp_cursors, cmp_func,
+                               n_lists);
+
+  for (u = 0; u != n_lists; ++u)
+    {
+      cursors[u].node = lists[u];
+      if (lists[u])
+        gx_heap_push (heap, &cursors[u]);
+      if (in_place)
+        lists[u] = NULL;
+    }
+
+  gx_list_builder_init (&builder);
+  head = tail = NULL;
+
+  while ((cur = gx_heap_peek (heap)))
+    {
+      GList *node;
+
+      node      = cur->node;
+      cur->node = node->next;
+
+      if (cur->node)
+        gx_heap_replace (heap, cur);
+      else
+        gx_heap_pop (heap);
+
+      if (!in_place)
+        {
+          gx_list_builder_append (&builder, node->data);
+          continue;
+        }
+
+      node->prev = tail;
+      node->next = NULL;
+      if (tail)
+        tail->next = node;
+      else
+        head = node;
+      tail = node;
+    }
+
+  gx_heap_free (heap, NULL);
+  g_free (cursors);
+
+  return in_place ? head : builder.head;
+}
+
+/**
+ * gx_list_merge_sorted:
+ * @lists: (array length=n_lists): an array of #GList, each sorted with
+ * @cmp_func
+ * @n_lists: the number of lists
+ * @cmp_func: the function the lists are sorted with
+ *
+ * Merge @n_lists sorted lists into a single sorted list. The merge is
+ * stable: equal elements keep their order, with the ones from earlier lists
+ * first.
+ *
+ * This takes O(n log k) time for n elements in k lists, by keeping the first
+ * remaining element of each list in a #GXHeap.
+ *
+ * |[<!-- language="C" -->
+ * GList *lists[3], *merged;
+ *
+ * lists[0] = gx_list_iota (3, 1, 3); // 1, 4, 7
+ * lists[1] = gx_list_iota (3, 2, 3); // 2, 5, 8
+ * lists[2] = gx_list_iota (3, 3, 3); // 3, 6, 9
+ *
+ * merged = gx_list_merge_sorted (lists, 3, (GCompareFunc)gx_cmp_int);
+ * g_assert_cmpint (GPOINTER_TO_INT (g_list_nth_data (merged, 4)), ==, 5);
+ *
+ * g_list_free (lists[0]);
+ * g_list_free (lists[1]);
+ * g_list_free (lists[2]);
+ * g_list_free (merged);
+ * ]|
+ *
+ * Returns: (transfer full): the merged list; free with g_list_free().
+ */
+GList*
+gx_list_merge_sorted (GList **lists, gsize n_lists, GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (lists || n_lists == 0, NULL);
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_merge_sorted (lists, n_lists, cmp_func, FALSE);
+}
+
+/**
+ * gx_list_merge_sorted_in_place:
+ * @lists: (array length=n_lists): an array of #GList, each sorted with
+ * @cmp_func
+ * @n_lists: the number of lists
+ * @cmp_func: the function the lists are sorted with
+ *
+ * Like gx_list_merge_sorted(), but link the nodes of the lists themselves
+ * into the result, rather than copying them. The lists in @lists are set to
+ * %NULL, as their nodes are now part of the result.
+ *
+ * Returns: the merged list.
+ */
+GList*
+gx_list_merge_sorted_in_place (GList **lists, gsize n_lists,
+                               GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (lists || n_lists == 0, NULL);
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_merge_sorted (lists, n_lists, cmp_func, TRUE);
+}
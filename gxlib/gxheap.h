@@ -0,0 +1,67 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_HEAP_H__
+#define __GX_HEAP_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXHeap:
+ *
+ * A #GXHeap is a priority queue of pointers, ordered by a comparison
+ * function; the element at the top is the smallest one.
+ *
+ * The struct has only private fields and should not be directly accessed.
+ */
+struct _GXHeap;
+typedef struct _GXHeap GXHeap;
+
+GXHeap *gx_heap_new (GCompareFunc cmp_func) G_GNUC_WARN_UNUSED_RESULT;
+GXHeap *gx_heap_new_with_data (GCompareDataFunc cmp_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXHeap *gx_heap_sized_new (GCompareDataFunc cmp_func, gpointer user_data,
+                           gsize reserved_size) G_GNUC_WARN_UNUSED_RESULT;
+void gx_heap_free (GXHeap *heap, GDestroyNotify free_func);
+
+gsize gx_heap_get_size (GXHeap *heap);
+
+void gx_heap_push (GXHeap *heap, gpointer data);
+gpointer gx_heap_peek (GXHeap *heap);
+gpointer gx_heap_pop (GXHeap *heap);
+gpointer gx_heap_replace (GXHeap *heap, gpointer data);
+
+GList *gx_list_top_k (GList *list, gsize k, GCompareFunc cmp_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_top_k_in_place (GList *list, gsize k, GCompareFunc cmp_func,
+                               GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GList *gx_list_merge_sorted (GList **lists, gsize n_lists,
+                             GCompareFunc cmp_func) G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_merge_sorted_in_place (GList **lists, gsize n_lists,
+                                      GCompareFunc cmp_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
+
+#endif /* __GX_HEAP_H__ */
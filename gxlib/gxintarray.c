@@ -0,0 +1,1169 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <string.h>
+
+#include "gxintarray.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GX_X86_SIMD 1
+#include <immintrin.h>
+#endif /*__GNUC__ && x86*/
+
+/**
+ * SECTION:gxintarray
+ * @title: Integer arrays
+ * @short_description: unboxed sequences of 64-bit integers
+ *
+ * The integer functions for #GList and #GXVec, such as gx_list_sum(), store
+ * their numbers in pointers and compute with #gint, which silently overflows
+ * for many real-world inputs. A #GXIntArray stores #gint64 values unboxed in a
+ * contiguous buffer instead, and offers the familiar iota, filter, map and
+ * fold operations.
+ *
+ * The reductions gx_int_array_sum(), gx_int_array_min() and
+ * gx_int_array_max() use SSE2 or AVX2 instructions when the processor
+ * supports them; this is detected at runtime. gx_int_array_fold() recognizes
+ * gx_plus(), gx_times(), gx_max() and gx_min() (see #GXReducer) and uses the
+ * same fast loops for those.
+ *
+ * The plain sum and product wrap around on overflow, like unsigned arithmetic
+ * does. To detect overflow, use gx_int_array_sum_checked() and
+ * gx_int_array_product_checked(); to clamp the result to the #gint64 range,
+ * use gx_int_array_sum_saturated() and gx_int_array_product_saturated().
+ *
+ * |[<!-- language="C" -->
+ * static gint64 square (gint64 n, gpointer user_data) { return n * n; }
+ *
+ * GXIntArray *nums;
+ * gint64      sum;
+ *
+ * // numbers 1..1000000 (inclusive)
+ * nums = gx_int_array_iota (1000000, 1, 1);
+ * // the sum of their squares does not fit in a gint, but does fit in a gint64
+ * nums = gx_int_array_map_in_place (nums, square, NULL);
+ * g_assert (gx_int_array_sum_checked (nums, &sum));
+ * g_assert_cmpint (sum, ==, G_GINT64_CONSTANT(333333833333500000));
+ *
+ * gx_int_array_free (nums);
+ * ]|
+ */
+
+typedef struct {
+  gint64 *data;
+  gsize   len;
+  gsize   alloc;
+} GXRealIntArray;
+
+#define MIN_ARRAY_SIZE 16
+
+static void
+array_maybe_expand (GXRealIntArray *rarray, gsize extra)
+{
+  gsize want;
+
+  want = rarray->len + extra;
+  if (want <= rarray->alloc)
+    return;
+
+  rarray->alloc = MAX (rarray->alloc, MIN_ARRAY_SIZE);
+  while (rarray->alloc < want)
+    rarray->alloc *= 2;
+
+  rarray->data = g_renew (gint64, rarray->data, rarray->alloc);
+}
+
+
+/**
+ * gx_int_array_new:
+ *
+ * Create a new, empty #GXIntArray.
+ *
+ * Returns: (transfer full): a new #GXIntArray; free with gx_int_array_free().
+ */
+GXIntArray*
+gx_int_array_new (void)
+{
+  return gx_int_array_sized_new (0);
+}
+
+
+/**
+ * gx_int_array_sized_new:
+ * @reserved_size: number of elements to pre-allocate space for
+ *
+ * Create a new, empty #GXIntArray with room for @reserved_size elements.
+ *
+ * Returns: (transfer full): a new #GXIntArray; free with gx_int_array_free().
+ */
+GXIntArray*
+gx_int_array_sized_new (gsize reserved_size)
+{
+  GXRealIntArray *rarray;
+
+  rarray = g_slice_new0 (GXRealIntArray);
+  array_maybe_expand (rarray, reserved_size);
+
+  return (GXIntArray*)rarray;
+}
+
+
+/**
+ * gx_int_array_free:
+ * @array: a #GXIntArray
+ *
+ * Free @array.
+ */
+void
+gx_int_array_free (GXIntArray *array)
+{
+  if (!array)
+    return;
+
+  g_free (array->data);
+  g_slice_free (GXRealIntArray, (GXRealIntArray*)array);
+}
+
+
+/**
+ * gx_int_array_append:
+ * @array: a #GXIntArray
+ * @value: an integer
+ *
+ * Add @value to the end of @array, expanding its buffer if needed.
+ */
+void
+gx_int_array_append (GXIntArray *array, gint64 value)
+{
+  GXRealIntArray *rarray;
+
+  g_return_if_fail (array);
+
+  rarray = (GXRealIntArray*)array;
+  if (G_UNLIKELY (rarray->len == rarray->alloc))
+    array_maybe_expand (rarray, 1);
+
+  rarray->data[rarray->len++] = value;
+}
+
+
+/**
+ * gx_int_array_from_list:
+ * @list: a #GList of integers, as used by e.g. gx_list_iota()
+ *
+ * Create a #GXIntArray with the integers stored in @list (with
+ * GINT_TO_POINTER()), in the same order.
+ *
+ * Returns: (transfer full): a new #GXIntArray; free with gx_int_array_free().
+ */
+GXIntArray*
+gx_int_array_from_list (GList *list)
+{
+  GXIntArray *array;
+
+  array = gx_int_array_sized_new (g_list_length (list));
+  for (; list; list = g_list_next (list))
+    array->data[array->len++] = GPOINTER_TO_INT (list->data);
+
+  return array;
+}
+
+
+/**
+ * gx_int_array_iota:
+ * @count: number of elements to generate
+ * @start: the start value
+ * @step: the step size
+ *
+ * Create a #GXIntArray with @count numbers starting at @start, and then
+ * increasing by @step; this is the #GXIntArray equivalent of gx_list_iota(),
+ * except that @step can be zero or negative as well.
+ *
+ * Returns: (transfer full): an array with numbers. Free with
+ * gx_int_array_free().
+ */
+GXIntArray*
+gx_int_array_iota (gsize count, gint64 start, gint64 step)
+{
+  GXIntArray *array;
+  guint64     val;
+  gsize       u;
+
+  array = gx_int_array_sized_new (count);
+  for (val = (guint64)start, u = 0; u != count; ++u, val += (guint64)step)
+    array->data[u] = (gint64)val;
+  array->len = count;
+
+  return array;
+}
+
+
+/**
+ * gx_int_array_filter:
+ * @array: a #GXIntArray
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Create a #GXIntArray consisting of the elements of @array for which the
+ * predicate function @pred_func returns %TRUE.
+ *
+ * Returns: (transfer full): the filtered array; free with
+ * gx_int_array_free().
+ */
+GXIntArray*
+gx_int_array_filter (GXIntArray *array, GXIntPred pred_func,
+                     gpointer user_data)
+{
+  GXIntArray *filtered;
+  gsize       u;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  filtered = gx_int_array_sized_new (array->len);
+  for (u = 0; u != array->len; ++u)
+    if ((*pred_func) (array->data[u], user_data))
+      filtered->data[filtered->len++] = array->data[u];
+
+  return filtered;
+}
+
+
+/**
+ * gx_int_array_filter_in_place:
+ * @array: a #GXIntArray
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Remove the elements from @array for which @pred_func does not return
+ * %TRUE. The remaining elements keep their order.
+ *
+ * Returns: @array
+ */
+GXIntArray*
+gx_int_array_filter_in_place (GXIntArray *array, GXIntPred pred_func,
+                              gpointer user_data)
+{
+  gsize u, kept;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  for (u = kept = 0; u != array->len; ++u)
+    if ((*pred_func) (array->data[u], user_data))
+      array->data[kept++] = array->data[u];
+
+  array->len = kept;
+
+  return array;
+}
+
+
+/**
+ * gx_int_array_map:
+ * @array: a #GXIntArray
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Create a new #GXIntArray consisting of the values obtained by applying
+ * @map_func to the corresponding elements in @array.
+ *
+ * Returns: (transfer full): the array with mapped values; free with
+ * gx_int_array_free().
+ */
+GXIntArray*
+gx_int_array_map (GXIntArray *array, GXIntFunc map_func, gpointer user_data)
+{
+  GXIntArray *mapped;
+  gsize       u;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  mapped = gx_int_array_sized_new (array->len);
+  for (u = 0; u != array->len; ++u)
+    mapped->data[u] = (*map_func) (array->data[u], user_data);
+  mapped->len = array->len;
+
+  return mapped;
+}
+
+
+/**
+ * gx_int_array_map_in_place:
+ * @array: a #GXIntArray
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Replace each element in @array with the value obtained from applying
+ * @map_func to it.
+ *
+ * Returns: @array
+ */
+GXIntArray*
+gx_int_array_map_in_place (GXIntArray *array, GXIntFunc map_func,
+                           gpointer user_data)
+{
+  gsize u;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  for (u = 0; u != array->len; ++u)
+    array->data[u] = (*map_func) (array->data[u], user_data);
+
+  return array;
+}
+
+
+/**
+ * gx_int_array_sort:
+ * @array: a #GXIntArray
+ *
+ * Sort the elements of @array in ascending order. This uses an LSD radix
+ * sort, which takes O(n) time and never compares two elements; it skips the
+ * passes for the bytes that are the same for all elements, so arrays with a
+ * small range of values take fewer passes.
+ *
+ * |[<!-- language="C" -->
+ * GXIntArray *nums;
+ *
+ * nums = gx_int_array_iota (5, 10, -3); // 10, 7, 4, 1, -2
+ * gx_int_array_sort (nums);
+ * g_assert_cmpint (gx_int_array_index (nums, 0), ==, -2);
+ * g_assert_cmpint (gx_int_array_index (nums, 4), ==, 10);
+ *
+ * gx_int_array_free (nums);
+ * ]|
+ *
+ * Returns: @array
+ */
+GXIntArray*
+gx_int_array_sort (GXIntArray *array)
+{
+  gsize    (*counts)[256];
+  guint64 *src, *dst, *swap;
+  gsize    n, u;
+  guint    pass;
+
+  g_return_val_if_fail (array, NULL);
+
+  n = array->len;
+  if (n < 2)
+    return array;
+
+  /* flipping the sign bit makes the values sort as unsigned numbers */
+  src = (guint64*)array->data;
+  for (u = 0; u != n; ++u)
+    src[u] ^= G_GUINT64_CONSTANT (1) << 63;
+
+  /* the counts for all the passes, in one go */
+  counts = g_malloc0 (8 * sizeof (*counts));
+  for (u = 0; u != n; ++u)
+    for (pass = 0; pass != 8; ++pass)
+      ++counts[pass][(src[u] >> (pass * 8)) & 0xff];
+
+  dst = g_new (guint64, n);
+  for (pass = 0; pass != 8; ++pass)
+    {
+      gsize *count, offset, c;
+      guint  shift;
+
+      count = counts[pass];
+      shift = pass * 8;
+
+      /* skip the pass if all values have the same byte */
+      if (count[(src[0] >> shift) & 0xff] == n)
+        continue;
+
+      for (offset = 0, u = 0; u != 256; ++u)
+        {
+          c        = count[u];
+          count[u] = offset;
+          offset  += c;
+        }
+
+      for (u = 0; u != n; ++u)
+        dst[count[(src[u] >> shift) & 0xff]++] = src[u];
+
+      swap = src;
+      src  = dst;
+      dst  = swap;
+    }
+
+  for (u = 0; u != n; ++u)
+    src[u] ^= G_GUINT64_CONSTANT (1) << 63;
+
+  /* the sorted values are in our buffer; swap it with the array's */
+  if (src != (guint64*)array->data)
+    {
+      g_free (array->data);
+      array->data = (gint64*)src;
+      ((GXRealIntArray*)array)->alloc = n;
+    }
+  else
+    g_free (dst);
+
+  g_free (counts);
+
+  return array;
+}
+
+
+/*
+ * the reduction kernels; the portable versions use independent accumulators,
+ * so the operations can overlap. Sums and products are computed with
+ * unsigned integers, so overflow wraps around in the same way for every order
+ * of evaluation.
+ */
+typedef gint64 (*ReduceKernel) (const gint64 *data, gsize len);
+
+static gint64
+sum_portable (const gint64 *data, gsize len)
+{
+  guint64 s0, s1, s2, s3;
+  gsize   u;
+
+  s0 = s1 = s2 = s3 = 0;
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      s0 += (guint64)data[u];
+      s1 += (guint64)data[u + 1];
+      s2 += (guint64)data[u + 2];
+      s3 += (guint64)data[u + 3];
+    }
+  for (; u != len; ++u)
+    s0 += (guint64)data[u];
+
+  return (gint64)(s0 + s1 + s2 + s3);
+}
+
+/* there is no vector instruction for 64-bit multiplication before AVX-512,
+ * so the product is always computed this way */
+static gint64
+product_portable (const gint64 *data, gsize len)
+{
+  guint64 p0, p1, p2, p3;
+  gsize   u;
+
+  p0 = p1 = p2 = p3 = 1;
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      p0 *= (guint64)data[u];
+      p1 *= (guint64)data[u + 1];
+      p2 *= (guint64)data[u + 2];
+      p3 *= (guint64)data[u + 3];
+    }
+  for (; u != len; ++u)
+    p0 *= (guint64)data[u];
+
+  return (gint64)(p0 * p1 * p2 * p3);
+}
+
+static gint64
+min_portable (const gint64 *data, gsize len)
+{
+  gint64 m0, m1, m2, m3;
+  gsize  u;
+
+  m0 = m1 = m2 = m3 = G_MAXINT64;
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      m0 = MIN (m0, data[u]);
+      m1 = MIN (m1, data[u + 1]);
+      m2 = MIN (m2, data[u + 2]);
+      m3 = MIN (m3, data[u + 3]);
+    }
+  for (; u != len; ++u)
+    m0 = MIN (m0, data[u]);
+
+  return MIN (MIN (m0, m1), MIN (m2, m3));
+}
+
+static gint64
+max_portable (const gint64 *data, gsize len)
+{
+  gint64 m0, m1, m2, m3;
+  gsize  u;
+
+  m0 = m1 = m2 = m3 = G_MININT64;
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      m0 = MAX (m0, data[u]);
+      m1 = MAX (m1, data[u + 1]);
+      m2 = MAX (m2, data[u + 2]);
+      m3 = MAX (m3, data[u + 3]);
+    }
+  for (; u != len; ++u)
+    m0 = MAX (m0, data[u]);
+
+  return MAX (MAX (m0, m1), MAX (m2, m3));
+}
+
+/* the prefix-sum (inclusive scan) kernels, in place, starting from init */
+typedef void (*ScanKernel) (gint64 *data, gsize len, gint64 init);
+
+static void
+prefix_sum_portable (gint64 *data, gsize len, gint64 init)
+{
+  guint64 sum;
+  gsize   u;
+
+  for (sum = (guint64)init, u = 0; u != len; ++u)
+    data[u] = (gint64)(sum += (guint64)data[u]);
+}
+
+#ifdef GX_X86_SIMD
+
+__attribute__((target("sse2")))
+static gint64
+sum_sse2 (const gint64 *data, gsize len)
+{
+  __m128i acc0, acc1;
+  gint64  lanes[2];
+  guint64 sum;
+  gsize   u;
+
+  acc0 = acc1 = _mm_setzero_si128 ();
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      acc0 = _mm_add_epi64 (acc0,
+                            _mm_loadu_si128 ((const __m128i*)(data + u)));
+      acc1 = _mm_add_epi64 (acc1,
+                            _mm_loadu_si128 ((const __m128i*)(data + u + 2)));
+    }
+
+  _mm_storeu_si128 ((__m128i*)lanes, _mm_add_epi64 (acc0, acc1));
+  sum = (guint64)lanes[0] + (guint64)lanes[1];
+  for (; u != len; ++u)
+    sum += (guint64)data[u];
+
+  return (gint64)sum;
+}
+
+__attribute__((target("avx2")))
+static gint64
+sum_avx2 (const gint64 *data, gsize len)
+{
+  __m256i acc0, acc1;
+  gint64  lanes[4];
+  guint64 sum;
+  gsize   u;
+
+  acc0 = acc1 = _mm256_setzero_si256 ();
+  for (u = 0; u + 8 <= len; u += 8)
+    {
+      acc0 = _mm256_add_epi64
+        (acc0, _mm256_loadu_si256 ((const __m256i*)(data + u)));
+      acc1 = _mm256_add_epi64
+        (acc1, _mm256_loadu_si256 ((const __m256i*)(data + u + 4)));
+    }
+
+  _mm256_storeu_si256 ((__m256i*)lanes, _mm256_add_epi64 (acc0, acc1));
+  sum = (guint64)lanes[0] + (guint64)lanes[1] +
+    (guint64)lanes[2] + (guint64)lanes[3];
+  for (; u != len; ++u)
+    sum += (guint64)data[u];
+
+  return (gint64)sum;
+}
+
+/* SSE2 has no 64-bit comparisons, so min/max only get an AVX2 version */
+__attribute__((target("avx2")))
+static gint64
+min_avx2 (const gint64 *data, gsize len)
+{
+  __m256i acc;
+  gint64  lanes[4], min;
+  gsize   u;
+
+  acc = _mm256_set1_epi64x (G_MAXINT64);
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      __m256i vals;
+
+      vals = _mm256_loadu_si256 ((const __m256i*)(data + u));
+      acc  = _mm256_blendv_epi8 (acc, vals, _mm256_cmpgt_epi64 (acc, vals));
+    }
+
+  _mm256_storeu_si256 ((__m256i*)lanes, acc);
+  min = MIN (MIN (lanes[0], lanes[1]), MIN (lanes[2], lanes[3]));
+  for (; u != len; ++u)
+    min = MIN (min, data[u]);
+
+  return min;
+}
+
+__attribute__((target("avx2")))
+static gint64
+max_avx2 (const gint64 *data, gsize len)
+{
+  __m256i acc;
+  gint64  lanes[4], max;
+  gsize   u;
+
+  acc = _mm256_set1_epi64x (G_MININT64);
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      __m256i vals;
+
+      vals = _mm256_loadu_si256 ((const __m256i*)(data + u));
+      acc  = _mm256_blendv_epi8 (acc, vals, _mm256_cmpgt_epi64 (vals, acc));
+    }
+
+  _mm256_storeu_si256 ((__m256i*)lanes, acc);
+  max = MAX (MAX (lanes[0], lanes[1]), MAX (lanes[2], lanes[3]));
+  for (; u != len; ++u)
+    max = MAX (max, data[u]);
+
+  return max;
+}
+
+/* within a vector, add each lane to the ones after it (shifting by one lane,
+ * then by two), and then add the carry: the last sum of the previous vector,
+ * in all lanes */
+__attribute__((target("sse2")))
+static void
+prefix_sum_sse2 (gint64 *data, gsize len, gint64 init)
+{
+  __m128i carry;
+  gsize   u;
+
+  carry = _mm_set1_epi64x (init);
+  for (u = 0; u + 2 <= len; u += 2)
+    {
+      __m128i vals;
+
+      vals = _mm_loadu_si128 ((const __m128i*)(data + u));
+      vals = _mm_add_epi64 (vals, _mm_slli_si128 (vals, 8));
+      vals = _mm_add_epi64 (vals, carry);
+      _mm_storeu_si128 ((__m128i*)(data + u), vals);
+
+      carry = _mm_shuffle_epi32 (vals, _MM_SHUFFLE (3, 2, 3, 2));
+    }
+
+  prefix_sum_portable (data + u, len - u, u > 0 ? data[u - 1] : init);
+}
+
+__attribute__((target("avx2")))
+static void
+prefix_sum_avx2 (gint64 *data, gsize len, gint64 init)
+{
+  __m256i carry, zero;
+  gsize   u;
+
+  carry = _mm256_set1_epi64x (init);
+  zero  = _mm256_setzero_si256 ();
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      __m256i vals, low;
+
+      vals = _mm256_loadu_si256 ((const __m256i*)(data + u));
+      /* a, a+b, c, c+d: the shift stays within the 128-bit halves */
+      vals = _mm256_add_epi64 (vals, _mm256_slli_si256 (vals, 8));
+      /* 0, 0, a+b, a+b */
+      low  = _mm256_blend_epi32 (_mm256_permute4x64_epi64 (vals, 0x50), zero,
+                                 0x0f);
+      vals = _mm256_add_epi64 (_mm256_add_epi64 (vals, low), carry);
+      _mm256_storeu_si256 ((__m256i*)(data + u), vals);
+
+      carry = _mm256_permute4x64_epi64 (vals, 0xff);
+    }
+
+  prefix_sum_portable (data + u, len - u, u > 0 ? data[u - 1] : init);
+}
+
+#endif /*GX_X86_SIMD*/
+
+static struct {
+  ReduceKernel sum;
+  ReduceKernel min;
+  ReduceKernel max;
+  ScanKernel   prefix_sum;
+} kernels;
+
+static void
+init_kernels (void)
+{
+  static gsize inited = 0;
+
+  if (!g_once_init_enter (&inited))
+    return;
+
+  kernels.sum = sum_portable;
+  kernels.min = min_portable;
+  kernels.max = max_portable;
+
+  kernels.prefix_sum = prefix_sum_portable;
+
+#ifdef GX_X86_SIMD
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2"))
+    {
+      kernels.sum        = sum_avx2;
+      kernels.min        = min_avx2;
+      kernels.max        = max_avx2;
+      kernels.prefix_sum = prefix_sum_avx2;
+    }
+  else if (__builtin_cpu_supports ("sse2"))
+    {
+      kernels.sum        = sum_sse2;
+      kernels.prefix_sum = prefix_sum_sse2;
+    }
+#endif /*GX_X86_SIMD*/
+
+  g_once_init_leave (&inited, 1);
+}
+
+
+static gint64
+reduce (GXReducer reducer, const gint64 *data, gsize len, gint64 init)
+{
+  init_kernels ();
+
+  switch (reducer)
+    {
+    case GX_REDUCER_PLUS:
+      return (gint64)((guint64)init + (guint64)kernels.sum (data, len));
+    case GX_REDUCER_TIMES:
+      return (gint64)((guint64)init * (guint64)product_portable (data, len));
+    case GX_REDUCER_MIN:
+      return MIN (init, kernels.min (data, len));
+    case GX_REDUCER_MAX:
+      return MAX (init, kernels.max (data, len));
+    default:
+      g_return_val_if_reached (init);
+    }
+}
+
+
+/**
+ * gx_int_array_fold:
+ * @array: a #GXIntArray
+ * @fold_func: a fold function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ *
+ * Given an array (a, b, c), compute
+ *      fold_func (fold_func (fold_func (@init, a), b), c)
+ *
+ * If @fold_func is one of gx_plus(), gx_times(), gx_max() or gx_min() (cast to
+ * #GXIntFoldFunc), the result is computed with the same fast loops as
+ * gx_int_array_sum() etc., using 64-bit arithmetic, and @fold_func is not
+ * called.
+ *
+ * |[<!-- language="C" -->
+ * GXIntArray *nums;
+ *
+ * nums = gx_int_array_iota (20, 1, 1);
+ * g_assert_cmpint (gx_int_array_fold (nums, (GXIntFoldFunc)gx_times, 1, NULL),
+ *                  ==, G_GINT64_CONSTANT(2432902008176640000));
+ * gx_int_array_free (nums);
+ * ]|
+ *
+ * Returns: the computed value; @init if @array is empty.
+ */
+gint64
+gx_int_array_fold (GXIntArray *array, GXIntFoldFunc fold_func, gint64 init,
+                   gpointer user_data)
+{
+  GXReducer reducer;
+  gsize     u;
+
+  g_return_val_if_fail (array, init);
+  g_return_val_if_fail (fold_func, init);
+
+  reducer = gx_reducer_for_func ((GCallback)fold_func);
+  if (reducer != GX_REDUCER_NONE)
+    return reduce (reducer, array->data, array->len, init);
+
+  for (u = 0; u != array->len; ++u)
+    init = (*fold_func) (init, array->data[u], user_data);
+
+  return init;
+}
+
+
+static void
+scan (GXReducer reducer, gint64 *data, gsize len, gint64 init)
+{
+  gsize u;
+
+  init_kernels ();
+
+  switch (reducer)
+    {
+    case GX_REDUCER_PLUS:
+      kernels.prefix_sum (data, len, init);
+      break;
+    case GX_REDUCER_TIMES:
+      for (u = 0; u != len; ++u)
+        data[u] = init = (gint64)((guint64)init * (guint64)data[u]);
+      break;
+    case GX_REDUCER_MIN:
+      for (u = 0; u != len; ++u)
+        data[u] = init = MIN (init, data[u]);
+      break;
+    case GX_REDUCER_MAX:
+      for (u = 0; u != len; ++u)
+        data[u] = init = MAX (init, data[u]);
+      break;
+    default:
+      g_return_if_reached ();
+    }
+}
+
+/**
+ * gx_int_array_scan_in_place:
+ * @array: a #GXIntArray
+ * @fold_func: a fold function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ *
+ * Replace each element of @array with the fold (see gx_int_array_fold()) of
+ * the elements up to and including it; that is, an inclusive prefix scan.
+ *
+ * As with gx_int_array_fold(), gx_plus(), gx_times(), gx_max() and gx_min()
+ * are recognized, and not called; for gx_plus(), this uses a vectorized
+ * prefix sum where the CPU supports it.
+ *
+ * |[<!-- language="C" -->
+ * GXIntArray *nums;
+ *
+ * nums = gx_int_array_iota (5, 1, 1); // 1, 2, 3, 4, 5
+ * gx_int_array_scan_in_place (nums, (GXIntFoldFunc)gx_plus, 0, NULL);
+ * // 1, 3, 6, 10, 15
+ * g_assert_cmpint (gx_int_array_index (nums, 4), ==, 15);
+ *
+ * gx_int_array_free (nums);
+ * ]|
+ *
+ * Returns: @array
+ */
+GXIntArray*
+gx_int_array_scan_in_place (GXIntArray *array, GXIntFoldFunc fold_func,
+                            gint64 init, gpointer user_data)
+{
+  GXReducer reducer;
+  gsize     u;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (fold_func, NULL);
+
+  reducer = gx_reducer_for_func ((GCallback)fold_func);
+  if (reducer != GX_REDUCER_NONE)
+    {
+      scan (reducer, array->data, array->len, init);
+      return array;
+    }
+
+  for (u = 0; u != array->len; ++u)
+    array->data[u] = init = (*fold_func) (init, array->data[u], user_data);
+
+  return array;
+}
+
+
+/**
+ * gx_int_array_scan:
+ * @array: a #GXIntArray
+ * @fold_func: a fold function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ *
+ * Like gx_int_array_scan_in_place(), but put the results in a new array.
+ *
+ * Returns: (transfer full): the array with the scanned values; free with
+ * gx_int_array_free().
+ */
+GXIntArray*
+gx_int_array_scan (GXIntArray *array, GXIntFoldFunc fold_func, gint64 init,
+                   gpointer user_data)
+{
+  GXIntArray *scanned;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (fold_func, NULL);
+
+  scanned = gx_int_array_sized_new (array->len);
+  if (array->len > 0)
+    memcpy (scanned->data, array->data, array->len * sizeof (gint64));
+  scanned->len = array->len;
+
+  return gx_int_array_scan_in_place (scanned, fold_func, init, user_data);
+}
+
+
+/**
+ * gx_int_array_sum:
+ * @array: a #GXIntArray
+ *
+ * Calculate the sum of the integers in @array. If the sum does not fit in a
+ * #gint64, it wraps around; see gx_int_array_sum_checked() and
+ * gx_int_array_sum_saturated() for alternatives.
+ *
+ * Returns: the sum of the integers in @array, or 0 if it is empty.
+ */
+gint64
+gx_int_array_sum (GXIntArray *array)
+{
+  g_return_val_if_fail (array, 0);
+
+  return reduce (GX_REDUCER_PLUS, array->data, array->len, 0);
+}
+
+
+/**
+ * gx_int_array_product:
+ * @array: a #GXIntArray
+ *
+ * Calculate the product of the integers in @array. If the product does not fit
+ * in a #gint64, it wraps around; see gx_int_array_product_checked() and
+ * gx_int_array_product_saturated() for alternatives.
+ *
+ * Returns: the product of the integers in @array, or 1 if it is empty.
+ */
+gint64
+gx_int_array_product (GXIntArray *array)
+{
+  g_return_val_if_fail (array, 1);
+
+  return reduce (GX_REDUCER_TIMES, array->data, array->len, 1);
+}
+
+
+/**
+ * gx_int_array_min:
+ * @array: a non-empty #GXIntArray
+ *
+ * Get the smallest integer in @array.
+ *
+ * Returns: the smallest value.
+ */
+gint64
+gx_int_array_min (GXIntArray *array)
+{
+  g_return_val_if_fail (array, 0);
+  g_return_val_if_fail (array->len > 0, 0);
+
+  return reduce (GX_REDUCER_MIN, array->data, array->len, G_MAXINT64);
+}
+
+
+/**
+ * gx_int_array_max:
+ * @array: a non-empty #GXIntArray
+ *
+ * Get the greatest integer in @array.
+ *
+ * Returns: the greatest value.
+ */
+gint64
+gx_int_array_max (GXIntArray *array)
+{
+  g_return_val_if_fail (array, 0);
+  g_return_val_if_fail (array->len > 0, 0);
+
+  return reduce (GX_REDUCER_MAX, array->data, array->len, G_MININT64);
+}
+
+
+static inline gboolean
+add_overflows (gint64 a, gint64 b, gint64 *res)
+{
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+  return __builtin_add_overflow (a, b, res);
+#else
+  *res = (gint64)((guint64)a + (guint64)b);
+  return (b > 0 && a > G_MAXINT64 - b) || (b < 0 && a < G_MININT64 - b);
+#endif /*__GNUC__ >= 5*/
+}
+
+/* the exact sum is the (wrapped-around) *sum + wraps * 2^64; returns that
+ * number of wraps, i.e., 0 if the sum fits, > 0 if it is too big and < 0 if
+ * it is too small */
+static gint64
+sum_exact (GXIntArray *array, gint64 *sum)
+{
+  gint64 wraps;
+  gsize  u;
+
+  for (*sum = 0, wraps = 0, u = 0; u != array->len; ++u)
+    {
+      gint64 val;
+
+      val = array->data[u];
+      if (add_overflows (*sum, val, sum))
+        wraps += val > 0 ? 1 : -1;
+    }
+
+  return wraps;
+}
+
+/* compute the product as a sign and a magnitude; returns FALSE if the
+ * magnitude exceeds 2^63. */
+static gboolean
+product_exact (GXIntArray *array, gboolean *negative, guint64 *magnitude)
+{
+  const guint64 limit = (guint64)G_MAXINT64 + 1;
+  gboolean      fits;
+  gsize         u;
+
+  *negative  = FALSE;
+  *magnitude = 1;
+
+  for (fits = TRUE, u = 0; u != array->len; ++u)
+    {
+      gint64  val;
+      guint64 absval;
+
+      val = array->data[u];
+      if (val == 0)
+        {
+          *negative  = FALSE;
+          *magnitude = 0;
+          return TRUE;
+        }
+
+      absval     = val < 0 ? (guint64)0 - (guint64)val : (guint64)val;
+      *negative ^= val < 0;
+
+      /* even if it does not fit, keep looking for a zero */
+      if (fits && *magnitude > limit / absval)
+        fits = FALSE;
+      else if (fits)
+        *magnitude *= absval;
+    }
+
+  return fits;
+}
+
+
+/**
+ * gx_int_array_sum_checked:
+ * @array: a #GXIntArray
+ * @sum: (out): receives the sum
+ *
+ * Calculate the sum of the integers in @array, checking whether it fits in a
+ * #gint64. Intermediate results may be out of range, as long as the final
+ * sum fits.
+ *
+ * Returns: %TRUE if the sum fits in a #gint64 and was stored in @sum; %FALSE
+ * otherwise, in which case @sum is not changed.
+ */
+gboolean
+gx_int_array_sum_checked (GXIntArray *array, gint64 *sum)
+{
+  gint64 result;
+
+  g_return_val_if_fail (array, FALSE);
+  g_return_val_if_fail (sum, FALSE);
+
+  if (sum_exact (array, &result) != 0)
+    return FALSE;
+
+  *sum = result;
+  return TRUE;
+}
+
+
+/**
+ * gx_int_array_product_checked:
+ * @array: a #GXIntArray
+ * @product: (out): receives the product
+ *
+ * Calculate the product of the integers in @array, checking whether it fits in
+ * a #gint64.
+ *
+ * Returns: %TRUE if the product fits in a #gint64 and was stored in @product;
+ * %FALSE otherwise, in which case @product is not changed.
+ */
+gboolean
+gx_int_array_product_checked (GXIntArray *array, gint64 *product)
+{
+  gboolean negative;
+  guint64  magnitude;
+
+  g_return_val_if_fail (array, FALSE);
+  g_return_val_if_fail (product, FALSE);
+
+  if (!product_exact (array, &negative, &magnitude))
+    return FALSE;
+
+  /* -2^63 fits, 2^63 does not */
+  if (!negative && magnitude > (guint64)G_MAXINT64)
+    return FALSE;
+
+  *product = negative ? -(gint64)(magnitude - 1) - 1 : (gint64)magnitude;
+  return TRUE;
+}
+
+
+/**
+ * gx_int_array_sum_saturated:
+ * @array: a #GXIntArray
+ *
+ * Calculate the sum of the integers in @array, clamped to the range of
+ * #gint64. Only the final sum is clamped, so the result does not depend on
+ * the order of the elements.
+ *
+ * Returns: the sum, or %G_MAXINT64 / %G_MININT64 if it is too big / too small.
+ */
+gint64
+gx_int_array_sum_saturated (GXIntArray *array)
+{
+  gint64 sum, wraps;
+
+  g_return_val_if_fail (array, 0);
+
+  wraps = sum_exact (array, &sum);
+  if (wraps > 0)
+    return G_MAXINT64;
+  else if (wraps < 0)
+    return G_MININT64;
+  else
+    return sum;
+}
+
+
+/**
+ * gx_int_array_product_saturated:
+ * @array: a #GXIntArray
+ *
+ * Calculate the product of the integers in @array, clamped to the range of
+ * #gint64.
+ *
+ * Returns: the product, or %G_MAXINT64 / %G_MININT64 if it is too big / too
+ * small.
+ */
+gint64
+gx_int_array_product_saturated (GXIntArray *array)
+{
+  gboolean negative;
+  guint64  magnitude;
+
+  g_return_val_if_fail (array, 1);
+
+  if (!product_exact (array, &negative, &magnitude))
+    return negative ? G_MININT64 : G_MAXINT64;
+  else if (negative)
+    return -(gint64)(magnitude - 1) - 1;
+  else
+    return magnitude > (guint64)G_MAXINT64 ? G_MAXINT64 : (gint64)magnitude;
+}
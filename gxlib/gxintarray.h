@@ -0,0 +1,140 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_INT_ARRAY_H__
+#define __GX_INT_ARRAY_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXIntArray:
+ * @data: points to the contiguous array of integers
+ * @len: the number of integers in the array
+ *
+ * A #GXIntArray is a sequence of 64-bit integers, stored unboxed in a single
+ * contiguous buffer. Elements can be accessed directly through @data, or with
+ * gx_int_array_index().
+ */
+struct _GXIntArray {
+  gint64 *data;
+  gsize   len;
+};
+
+/**
+ * gx_int_array_index:
+ * @array: a #GXIntArray
+ * @index_: the index of the element
+ *
+ * Get the element at @index_ of @array. @index_ must be smaller than the
+ * length of @array.
+ *
+ * Returns: the integer at @index_.
+ */
+#define gx_int_array_index(array,index_) ((array)->data)[index_]
+
+/**
+ * GXIntPred:
+ * @value: an integer
+ * @user_data: (allow-none): a user-provided data pointer
+ *
+ * Prototype for a predicate on integers, as used in gx_int_array_filter().
+ *
+ * Returns: %TRUE if the predicate holds for @value, %FALSE otherwise.
+ */
+typedef gboolean (*GXIntPred) (gint64 value, gpointer user_data);
+
+/**
+ * GXIntFunc:
+ * @value: an integer
+ * @user_data: (allow-none): a user-provided data pointer
+ *
+ * Prototype for a function that maps an integer to another one, as used in
+ * gx_int_array_map().
+ *
+ * Returns: the mapped value.
+ */
+typedef gint64 (*GXIntFunc) (gint64 value, gpointer user_data);
+
+/**
+ * GXIntFoldFunc:
+ * @acc: the accumulated value
+ * @value: the next integer
+ * @user_data: (allow-none): a user-provided data pointer
+ *
+ * Prototype for a function that combines an accumulated value with the next
+ * integer, as used in gx_int_array_fold().
+ *
+ * Returns: the new accumulated value.
+ */
+typedef gint64 (*GXIntFoldFunc) (gint64 acc, gint64 value, gpointer user_data);
+
+GXIntArray *gx_int_array_new (void) G_GNUC_WARN_UNUSED_RESULT;
+GXIntArray *gx_int_array_sized_new (gsize reserved_size)
+  G_GNUC_WARN_UNUSED_RESULT;
+void gx_int_array_free (GXIntArray *array);
+
+void gx_int_array_append (GXIntArray *array, gint64 value);
+
+GXIntArray *gx_int_array_from_list (GList *list) G_GNUC_WARN_UNUSED_RESULT;
+
+GXIntArray *gx_int_array_iota (gsize count, gint64 start, gint64 step)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GXIntArray *gx_int_array_filter (GXIntArray *array, GXIntPred pred_func,
+                                 gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXIntArray *gx_int_array_filter_in_place (GXIntArray *array,
+                                          GXIntPred pred_func,
+                                          gpointer user_data);
+
+GXIntArray *gx_int_array_map (GXIntArray *array, GXIntFunc map_func,
+                              gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXIntArray *gx_int_array_map_in_place (GXIntArray *array, GXIntFunc map_func,
+                                       gpointer user_data);
+
+GXIntArray *gx_int_array_sort (GXIntArray *array);
+
+gint64 gx_int_array_fold (GXIntArray *array, GXIntFoldFunc fold_func,
+                          gint64 init, gpointer user_data);
+
+GXIntArray *gx_int_array_scan (GXIntArray *array, GXIntFoldFunc fold_func,
+                               gint64 init, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXIntArray *gx_int_array_scan_in_place (GXIntArray *array,
+                                        GXIntFoldFunc fold_func, gint64 init,
+                                        gpointer user_data);
+
+gint64 gx_int_array_sum (GXIntArray *array);
+gint64 gx_int_array_product (GXIntArray *array);
+gint64 gx_int_array_min (GXIntArray *array);
+gint64 gx_int_array_max (GXIntArray *array);
+
+gboolean gx_int_array_sum_checked (GXIntArray *array, gint64 *sum);
+gboolean gx_int_array_product_checked (GXIntArray *array, gint64 *product);
+
+gint64 gx_int_array_sum_saturated (GXIntArray *array);
+gint64 gx_int_array_product_saturated (GXIntArray *array);
+
+G_END_DECLS
+
+#endif /* __GX_INT_ARRAY_H__ */
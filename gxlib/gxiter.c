@@ -0,0 +1,691 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxiter.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxiter
+ * @title: Lazy iterators
+ * @short_description: fused, pull-based pipelines of functional operations
+ *
+ * Chaining gx_list_iota(), gx_list_filter() and gx_list_map() builds a
+ * complete intermediate #GList for every step. A #GXIter on the other hand
+ * produces its elements one at a time, on demand; a chain of sources, adapters
+ * and a sink runs in a single pass, using a constant amount of memory, and
+ * without allocating any list nodes (unless you ask for them with
+ * gx_iter_collect()).
+ *
+ * Adapters such as gx_iter_filter() take ownership of the iterator they are
+ * passed, and sinks such as gx_iter_fold() consume and free the iterator, so
+ * a pipeline can be written as a single expression.
+ *
+ * For example, the product of the prime numbers up to 20:
+ * |[<!-- language="C" -->
+ * gint prod;
+ *
+ * prod = gx_iter_product (
+ *         gx_iter_filter (gx_iter_iota (20, 1, 1), (GXPred)gx_is_prime, NULL));
+ *
+ * g_assert_cmpint (prod, ==, 9699690);
+ * ]|
+ */
+
+struct _GXIter {
+  GXIterNextFunc next_func;
+  gpointer       state;
+  GDestroyNotify state_free_func;
+  gboolean       done;
+};
+
+
+/**
+ * gx_iter_new:
+ * @next_func: function that produces the next element
+ * @state: (allow-none): state pointer passed to @next_func
+ * @state_free_func: (allow-none): function to free @state
+ *
+ * Create a new #GXIter that gets its elements from @next_func. This allows for
+ * defining custom sources for iterator pipelines. Once @next_func has returned
+ * %FALSE, it is not called again.
+ *
+ * Returns: (transfer full): a new #GXIter; free with gx_iter_free() or pass it
+ * on to an adapter or sink.
+ */
+GXIter*
+gx_iter_new (GXIterNextFunc next_func, gpointer state,
+             GDestroyNotify state_free_func)
+{
+  GXIter *iter;
+
+  g_return_val_if_fail (next_func, NULL);
+
+  iter                  = g_slice_new (GXIter);
+  iter->next_func       = next_func;
+  iter->state           = state;
+  iter->state_free_func = state_free_func;
+  iter->done            = FALSE;
+
+  return iter;
+}
+
+
+/**
+ * gx_iter_next:
+ * @iter: a #GXIter
+ * @data: (out): receives the next element
+ *
+ * Get the next element from @iter.
+ *
+ * Returns: %TRUE if an element was stored in @data, %FALSE if @iter is
+ * exhausted.
+ */
+gboolean
+gx_iter_next (GXIter *iter, gpointer *data)
+{
+  g_return_val_if_fail (iter, FALSE);
+  g_return_val_if_fail (data, FALSE);
+
+  if (G_UNLIKELY (iter->done))
+    return FALSE;
+
+  if ((*iter->next_func) (iter->state, data))
+    return TRUE;
+
+  iter->done = TRUE;
+  return FALSE;
+}
+
+
+/**
+ * gx_iter_free:
+ * @iter: (allow-none): a #GXIter
+ *
+ * Free @iter, and any iterators it was built upon.
+ */
+void
+gx_iter_free (GXIter *iter)
+{
+  if (!iter)
+    return;
+
+  if (iter->state_free_func)
+    (*iter->state_free_func) (iter->state);
+
+  g_slice_free (GXIter, iter);
+}
+
+
+
+/* unsigned, so that stepping past the last element (or beyond G_MAXINT)
+ * wraps around instead of overflowing */
+typedef struct {
+  gsize count;
+  guint cur;
+  guint step;
+} IotaState;
+
+static gboolean
+iota_next (IotaState *state, gpointer *data)
+{
+  if (state->count == 0)
+    return FALSE;
+
+  *data = GINT_TO_POINTER ((gint)state->cur);
+  state->cur += state->step;
+  --state->count;
+
+  return TRUE;
+}
+
+static void
+iota_state_free (IotaState *state)
+{
+  g_slice_free (IotaState, state);
+}
+
+
+static GXIter*
+iota_iter_new (gsize count, gint start, gint step)
+{
+  IotaState *state;
+
+  state        = g_slice_new (IotaState);
+  state->count = count;
+  state->cur   = (guint)start;
+  state->step  = (guint)step;
+
+  return gx_iter_new ((GXIterNextFunc)iota_next, state,
+                      (GDestroyNotify)iota_state_free);
+}
+
+
+/**
+ * gx_iter_iota:
+ * @count: number of elements to generate
+ * @start: the start value
+ * @step: the step size, must be > 0
+ *
+ * Create a #GXIter producing @count numbers starting at @start, and then
+ * increasing by @step; this is the lazy equivalent of gx_list_iota().
+ *
+ * Returns: (transfer full): a new #GXIter.
+ */
+GXIter*
+gx_iter_iota (gsize count, gint start, gsize step)
+{
+  g_return_val_if_fail (step > 0, NULL);
+
+  return iota_iter_new (count, start, (gint)step);
+}
+
+
+/**
+ * gx_iter_range:
+ * @start: the start value
+ * @end: the end value (exclusive)
+ * @step: the step size, must not be 0
+ *
+ * Create a #GXIter producing the numbers from @start up to, but not including,
+ * @end, in steps of @step. If @step is negative, the numbers count down.
+ *
+ * |[<!-- language="C" -->
+ * // 10, 7, 4, 1
+ * iter = gx_iter_range (10, 0, -3);
+ * ]|
+ *
+ * Returns: (transfer full): a new #GXIter.
+ */
+GXIter*
+gx_iter_range (gint start, gint end, gint step)
+{
+  gint64 span;
+  gsize  count;
+
+  g_return_val_if_fail (step != 0, NULL);
+
+  span = step > 0 ? (gint64)end - start : (gint64)start - end;
+  if (span <= 0)
+    count = 0;
+  else
+    count = (span + ABS((gint64)step) - 1) / ABS((gint64)step);
+
+  return iota_iter_new (count, start, step);
+}
+
+
+static gboolean
+list_next (GList **cur, gpointer *data)
+{
+  if (!*cur)
+    return FALSE;
+
+  *data = (*cur)->data;
+  *cur  = (*cur)->next;
+
+  return TRUE;
+}
+
+static void
+list_state_free (GList **cur)
+{
+  g_slice_free (GList*, cur);
+}
+
+/**
+ * gx_iter_list:
+ * @list: a #GList
+ *
+ * Create a #GXIter producing the elements of @list. The list is not copied,
+ * so it must not be changed or freed while the iterator is in use.
+ *
+ * Returns: (transfer full): a new #GXIter.
+ */
+GXIter*
+gx_iter_list (GList *list)
+{
+  GList **cur;
+
+  cur  = g_slice_new (GList*);
+  *cur = list;
+
+  return gx_iter_new ((GXIterNextFunc)list_next, cur,
+                      (GDestroyNotify)list_state_free);
+}
+
+
+typedef struct {
+  gpointer *cur;
+  gpointer *end;
+  gboolean  bounded; /* if not, the array is NULL-terminated */
+} ArrayState;
+
+static gboolean
+array_next (ArrayState *state, gpointer *data)
+{
+  if (state->bounded ? state->cur == state->end : !*state->cur)
+    return FALSE;
+
+  *data = *state->cur++;
+
+  return TRUE;
+}
+
+static void
+array_state_free (ArrayState *state)
+{
+  g_slice_free (ArrayState, state);
+}
+
+static GXIter*
+array_iter_new (gpointer *array, gssize n)
+{
+  ArrayState *state;
+
+  state          = g_slice_new (ArrayState);
+  state->cur     = array;
+  state->end     = n < 0 ? NULL : array + n;
+  state->bounded = n >= 0;
+
+  return gx_iter_new ((GXIterNextFunc)array_next, state,
+                      (GDestroyNotify)array_state_free);
+}
+
+
+/**
+ * gx_iter_strv:
+ * @strv: an array of strings
+ * @n: the number of strings in the array, or < 0 if it is %NULL-terminated.
+ *
+ * Create a #GXIter producing the strings in @strv. The strings are not copied.
+ *
+ * Returns: (transfer full): a new #GXIter.
+ */
+GXIter*
+gx_iter_strv (gchar **strv, gssize n)
+{
+  g_return_val_if_fail (strv || n == 0, NULL);
+
+  return array_iter_new ((gpointer*)strv, n);
+}
+
+
+/**
+ * gx_iter_ptr_array:
+ * @array: a #GPtrArray
+ *
+ * Create a #GXIter producing the elements of @array. The array is not copied,
+ * so it must not be changed or freed while the iterator is in use.
+ *
+ * Returns: (transfer full): a new #GXIter.
+ */
+GXIter*
+gx_iter_ptr_array (GPtrArray *array)
+{
+  g_return_val_if_fail (array, NULL);
+
+  return array_iter_new (array->pdata, array->len);
+}
+
+
+
+typedef struct {
+  GXIter   *inner;
+  gpointer  func;
+  gpointer  user_data;
+  gsize     n;
+} AdapterState;
+
+static void
+adapter_state_free (AdapterState *state)
+{
+  gx_iter_free (state->inner);
+  g_slice_free (AdapterState, state);
+}
+
+static GXIter*
+adapter_new (GXIterNextFunc next_func, GXIter *inner, gpointer func,
+             gpointer user_data, gsize n)
+{
+  AdapterState *state;
+
+  state            = g_slice_new (AdapterState);
+  state->inner     = inner;
+  state->func      = func;
+  state->user_data = user_data;
+  state->n         = n;
+
+  return gx_iter_new (next_func, state, (GDestroyNotify)adapter_state_free);
+}
+
+
+static gboolean
+filter_next (AdapterState *state, gpointer *data)
+{
+  GXPred pred_func;
+
+  pred_func = (GXPred)state->func;
+  while (gx_iter_next (state->inner, data))
+    if ((*pred_func) (*data, state->user_data))
+      return TRUE;
+
+  return FALSE;
+}
+
+/**
+ * gx_iter_filter:
+ * @iter: a #GXIter
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Create a #GXIter producing the elements of @iter for which @pred_func
+ * returns %TRUE; this is the lazy equivalent of gx_list_filter().
+ *
+ * Returns: (transfer full): a new #GXIter, which takes ownership of @iter.
+ */
+GXIter*
+gx_iter_filter (GXIter *iter, GXPred pred_func, gpointer user_data)
+{
+  g_return_val_if_fail (iter, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  return adapter_new ((GXIterNextFunc)filter_next, iter, pred_func,
+                      user_data, 0);
+}
+
+
+static gboolean
+map_next (AdapterState *state, gpointer *data)
+{
+  if (!gx_iter_next (state->inner, data))
+    return FALSE;
+
+  *data = (*(GXBinaryFunc)state->func) (*data, state->user_data);
+
+  return TRUE;
+}
+
+/**
+ * gx_iter_map:
+ * @iter: a #GXIter
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Create a #GXIter producing the results of applying @map_func to the
+ * elements of @iter; this is the lazy equivalent of gx_list_map().
+ *
+ * Note that values produced by @map_func that are dropped further down the
+ * pipeline (e.g. by gx_iter_filter()) are not freed.
+ *
+ * Returns: (transfer full): a new #GXIter, which takes ownership of @iter.
+ */
+GXIter*
+gx_iter_map (GXIter *iter, GXBinaryFunc map_func, gpointer user_data)
+{
+  g_return_val_if_fail (iter, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  return adapter_new ((GXIterNextFunc)map_next, iter, map_func,
+                      user_data, 0);
+}
+
+
+static gboolean
+take_next (AdapterState *state, gpointer *data)
+{
+  if (state->n == 0 || !gx_iter_next (state->inner, data))
+    return FALSE;
+
+  --state->n;
+
+  return TRUE;
+}
+
+/**
+ * gx_iter_take:
+ * @iter: a #GXIter
+ * @n: the number of elements to take
+ *
+ * Create a #GXIter producing (up to) the first @n elements of @iter; this is
+ * the lazy equivalent of gx_list_take(). Elements beyond the first @n are
+ * never pulled from @iter.
+ *
+ * Returns: (transfer full): a new #GXIter, which takes ownership of @iter.
+ */
+GXIter*
+gx_iter_take (GXIter *iter, gsize n)
+{
+  g_return_val_if_fail (iter, NULL);
+
+  return adapter_new ((GXIterNextFunc)take_next, iter, NULL, NULL, n);
+}
+
+
+static gboolean
+skip_next (AdapterState *state, gpointer *data)
+{
+  for (; state->n > 0; --state->n)
+    if (!gx_iter_next (state->inner, data))
+      return FALSE;
+
+  return gx_iter_next (state->inner, data);
+}
+
+/**
+ * gx_iter_skip:
+ * @iter: a #GXIter
+ * @n: the number of elements to skip
+ *
+ * Create a #GXIter producing all but the first @n elements of @iter; this is
+ * the lazy equivalent of gx_list_skip().
+ *
+ * Returns: (transfer full): a new #GXIter, which takes ownership of @iter.
+ */
+GXIter*
+gx_iter_skip (GXIter *iter, gsize n)
+{
+  g_return_val_if_fail (iter, NULL);
+
+  return adapter_new ((GXIterNextFunc)skip_next, iter, NULL, NULL, n);
+}
+
+
+static gboolean
+take_while_next (AdapterState *state, gpointer *data)
+{
+  if (!gx_iter_next (state->inner, data))
+    return FALSE;
+
+  return (*(GXPred)state->func) (*data, state->user_data);
+}
+
+/**
+ * gx_iter_take_while:
+ * @iter: a #GXIter
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Create a #GXIter producing the elements of @iter up to (but not including)
+ * the first one for which @pred_func returns %FALSE. This makes it possible
+ * to use unbounded sources, e.g.
+ *
+ * |[<!-- language="C" -->
+ * static gboolean below_1000 (gint n) { return n < 1000; }
+ *
+ * // the sum of the even numbers below 1000
+ * sum = gx_iter_sum (
+ *         gx_iter_take_while (gx_iter_iota (G_MAXSIZE, 0, 2),
+ *                             (GXPred)below_1000, NULL));
+ * ]|
+ *
+ * Returns: (transfer full): a new #GXIter, which takes ownership of @iter.
+ */
+GXIter*
+gx_iter_take_while (GXIter *iter, GXPred pred_func, gpointer user_data)
+{
+  g_return_val_if_fail (iter, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  return adapter_new ((GXIterNextFunc)take_while_next, iter, pred_func,
+                      user_data, 0);
+}
+
+
+
+/**
+ * gx_iter_fold:
+ * @iter: a #GXIter
+ * @fold_func: a ternary function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Consume @iter, computing the fold over its elements in the same way as
+ * gx_list_fold(), including the use of a #GXFoldKernel for @fold_func if
+ * there is one. @iter is freed afterwards.
+ *
+ * Returns: (transfer full): the computed value.
+ */
+gpointer
+gx_iter_fold (GXIter *iter, GXTernaryFunc fold_func, gpointer init,
+              gpointer user_data, GDestroyNotify free_func)
+{
+  gpointer     result, first, data;
+  GXFoldKernel kernel;
+
+  g_return_val_if_fail (iter, NULL);
+  g_return_val_if_fail (fold_func, NULL);
+
+  kernel = free_func ? NULL : gx_fold_kernel_lookup (fold_func);
+  if (kernel)
+    {
+      gpointer batch[FOLD_BATCH_SIZE];
+      gsize    n;
+
+      for (result = NULL, first = init;;)
+        {
+          for (n = 0; n != FOLD_BATCH_SIZE && gx_iter_next (iter, &data);)
+            batch[n++] = data;
+          if (n == 0)
+            break;
+
+          result = kernel (first, batch, n, user_data);
+          first  = result;
+        }
+
+      gx_iter_free (iter);
+      return result;
+    }
+
+  for (result = NULL, first = init; gx_iter_next (iter, &data);)
+    {
+      gpointer tmp;
+
+      tmp = (*fold_func) (first, data, user_data);
+      if (free_func)
+        (*free_func) (result);
+
+      result = tmp;
+      first  = result;
+    }
+
+  gx_iter_free (iter);
+
+  return result;
+}
+
+
+/**
+ * gx_iter_sum:
+ * @iter: a #GXIter
+ *
+ * Consume @iter, calculating the sum of its elements, which are interpreted
+ * as integers; see gx_list_sum(). @iter is freed afterwards.
+ *
+ * Returns: the sum of the integers produced by @iter.
+ */
+gint
+gx_iter_sum (GXIter *iter)
+{
+  gpointer data;
+  gint     sum;
+
+  g_return_val_if_fail (iter, 0);
+
+  for (sum = 0; gx_iter_next (iter, &data);)
+    sum += GPOINTER_TO_INT (data);
+
+  gx_iter_free (iter);
+
+  return sum;
+}
+
+
+/**
+ * gx_iter_product:
+ * @iter: a #GXIter
+ *
+ * Consume @iter, calculating the product of its elements, which are
+ * interpreted as integers; see gx_list_product(). @iter is freed afterwards.
+ *
+ * Returns: the product of the integers produced by @iter.
+ */
+gint
+gx_iter_product (GXIter *iter)
+{
+  gpointer data;
+  gint     product;
+
+  g_return_val_if_fail (iter, 1);
+
+  for (product = 1; gx_iter_next (iter, &data);)
+    product *= GPOINTER_TO_INT (data);
+
+  gx_iter_free (iter);
+
+  return product;
+}
+
+
+/**
+ * gx_iter_collect:
+ * @iter: a #GXIter
+ *
+ * Consume @iter, collecting its elements in a #GList, in order. @iter is freed
+ * afterwards.
+ *
+ * Returns: (transfer full): a new list; free with g_list_free() or
+ * g_list_free_full(), depending on the elements.
+ */
+GList*
+gx_iter_collect (GXIter *iter)
+{
+  GXListBuilder lst;
+  gpointer      data;
+
+  g_return_val_if_fail (iter, NULL);
+
+  gx_list_builder_init (&lst);
+  while (gx_iter_next (iter, &data))
+    gx_list_builder_append (&lst, data);
+
+  gx_iter_free (iter);
+
+  return lst.head;
+}
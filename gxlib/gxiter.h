@@ -0,0 +1,85 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_ITER_H__
+#define __GX_ITER_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXIter:
+ *
+ * A #GXIter is a lazy, pull-based sequence of pointers. Iterators are created
+ * from sources such as gx_iter_iota() or gx_iter_list(), chained through
+ * adapters such as gx_iter_filter() and gx_iter_map(), and finally consumed by
+ * sinks such as gx_iter_fold() or gx_iter_collect().
+ *
+ * The struct has only private fields and should not be directly accessed.
+ */
+struct _GXIter;
+
+/**
+ * GXIterNextFunc:
+ * @state: the state pointer passed to gx_iter_new()
+ * @data: (out): receives the next element
+ *
+ * Prototype for a function that produces the next element of a #GXIter.
+ *
+ * Returns: %TRUE if an element was stored in @data, %FALSE if the sequence
+ * is exhausted.
+ */
+typedef gboolean (*GXIterNextFunc) (gpointer state, gpointer *data);
+
+GXIter *gx_iter_new (GXIterNextFunc next_func, gpointer state,
+                     GDestroyNotify state_free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+gboolean gx_iter_next (GXIter *iter, gpointer *data);
+void gx_iter_free (GXIter *iter);
+
+GXIter *gx_iter_iota (gsize count, gint start, gsize step)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXIter *gx_iter_range (gint start, gint end, gint step)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXIter *gx_iter_list (GList *list) G_GNUC_WARN_UNUSED_RESULT;
+GXIter *gx_iter_strv (gchar **strv, gssize n) G_GNUC_WARN_UNUSED_RESULT;
+GXIter *gx_iter_ptr_array (GPtrArray *array) G_GNUC_WARN_UNUSED_RESULT;
+
+GXIter *gx_iter_filter (GXIter *iter, GXPred pred_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXIter *gx_iter_map (GXIter *iter, GXBinaryFunc map_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXIter *gx_iter_take (GXIter *iter, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GXIter *gx_iter_skip (GXIter *iter, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GXIter *gx_iter_take_while (GXIter *iter, GXPred pred_func,
+                            gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gpointer gx_iter_fold (GXIter *iter, GXTernaryFunc fold_func, gpointer init,
+                       gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+gint gx_iter_sum (GXIter *iter);
+gint gx_iter_product (GXIter *iter);
+GList *gx_iter_collect (GXIter *iter) G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
+
+#endif /* __GX_ITER_H__ */
@@ -0,0 +1,134 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_LIB_PRIVATE_H__
+#define __GX_LIB_PRIVATE_H__
+
+/* helpers shared between the gxlib modules; not installed */
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/* run job_func (0 .. n_jobs - 1, user_data) on up to n_threads threads (or
+ * the number of processors if n_threads <= 0), and wait for all of them to
+ * finish */
+typedef void (*GXJobFunc) (gsize job, gpointer user_data);
+
+G_GNUC_INTERNAL void gx_run_jobs (gsize n_jobs, gint n_threads,
+                                  GXJobFunc job_func, gpointer user_data);
+
+G_GNUC_INTERNAL guint gx_get_n_threads (gint n_threads);
+
+/* the number of elements passed to a GXFoldKernel at a time, when folding a
+ * sequence that is not contiguous already */
+#define FOLD_BATCH_SIZE 256
+
+/* the built-in fold kernels for gx_stats_fold_int() and
+ * gx_stats_fold_double() */
+G_GNUC_INTERNAL gpointer gx_stats_fold_int_kernel (gpointer acc, gpointer *data,
+                                                   gsize n,
+                                                   gpointer user_data);
+G_GNUC_INTERNAL gpointer gx_stats_fold_double_kernel (gpointer acc,
+                                                      gpointer *data, gsize n,
+                                                      gpointer user_data);
+
+/* look up n in the default GXPrimeTable; returns FALSE if there is no
+ * default table, or n is beyond its limit */
+G_GNUC_INTERNAL gboolean gx_prime_table_lookup_default (guint n,
+                                                        gboolean *is_prime);
+
+/* a per-thread range of free nodes from the thread-default GXListArena */
+typedef struct _GXListMagazine GXListMagazine;
+struct _GXListMagazine {
+  GXListArena    *arena;
+  GList          *cur;     /* next free node */
+  GList          *end;
+  gpointer        block;   /* the block cur points into */
+  gpointer        seen;    /* last other block found to be in arena */
+  GXListMagazine *prev;    /* the previous thread-default */
+};
+
+/* the magazine for the thread-default arena, or NULL if there is none */
+G_GNUC_INTERNAL GXListMagazine *gx_list_magazine_get (void);
+G_GNUC_INTERNAL GList *gx_list_magazine_refill (GXListMagazine *mag);
+/* whether node comes from any GXListArena; mag (if not NULL) is only used
+ * for caching */
+G_GNUC_INTERNAL gboolean gx_list_node_in_arena (GXListMagazine *mag,
+                                                GList *node);
+
+/* free a list and (if free_func is not NULL) its elements, leaving the nodes
+ * from arenas alone */
+G_GNUC_INTERNAL void gx_list_free_nodes (GList *list,
+                                         GDestroyNotify free_func);
+
+/* allocate an uninitialized node, from mag if it is not NULL */
+static inline GList*
+gx_list_node_new (GXListMagazine *mag)
+{
+  if (!mag)
+    return g_list_alloc ();
+  else if (G_LIKELY (mag->cur != mag->end))
+    return mag->cur++;
+  else
+    return gx_list_magazine_refill (mag);
+}
+
+static inline void
+gx_list_node_free (GXListMagazine *mag, GList *node)
+{
+  if (!gx_list_node_in_arena (mag, node))
+    g_list_free_1 (node);
+}
+
+/* build a list front-to-back, using the thread-default arena if any */
+typedef struct {
+  GList          *head;
+  GList          *tail;
+  GXListMagazine *mag;
+} GXListBuilder;
+
+static inline void
+gx_list_builder_init (GXListBuilder *builder)
+{
+  builder->head = builder->tail = NULL;
+  builder->mag  = gx_list_magazine_get ();
+}
+
+static inline void
+gx_list_builder_append (GXListBuilder *builder, gpointer data)
+{
+  GList *node;
+
+  node       = gx_list_node_new (builder->mag);
+  node->data = data;
+  node->next = NULL;
+  node->prev = builder->tail;
+
+  if (builder->tail)
+    builder->tail->next = node;
+  else
+    builder->head = node;
+
+  builder->tail = node;
+}
+
+G_END_DECLS
+
+#endif /* __GX_LIB_PRIVATE_H__ */
@@ -22,11 +22,27 @@
 
 #include <glib.h>
 
+#include <gxlib/gxtypes.h>
 #include <gxlib/gxstr.h>
 #include <gxlib/gxfunc.h>
 #include <gxlib/gxoption.h>
 #include <gxlib/gxpath.h>
 #include <gxlib/gxpred.h>
 #include <gxlib/gxlist.h>
+#include <gxlib/gxvec.h>
+#include <gxlib/gxiter.h>
+#include <gxlib/gxparallel.h>
+#include <gxlib/gxarena.h>
+#include <gxlib/gxintarray.h>
+#include <gxlib/gxprime.h>
+#include <gxlib/gxheap.h>
+#include <gxlib/gxsort.h>
+#include <gxlib/gxstats.h>
+#include <gxlib/gxlink.h>
+#include <gxlib/gxplist.h>
+#include <gxlib/gxslist.h>
+#include <gxlib/gxqueue.h>
+#include <gxlib/gxptrarray.h>
+#include <gxlib/gxsequence.h>
 
 #endif /* __GX_LIB_H__ */
@@ -0,0 +1,481 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxlink.h"
+
+/**
+ * SECTION:gxlink
+ * @title: Intrusive lists
+ * @short_description: lists of structures that embed their own list node
+ *
+ * A #GList node points to its element, so a list of structures costs two
+ * allocations per element, and walking it touches two cache lines per
+ * element. With an intrusive list, the node (a #GXLink) is a member of the
+ * structure itself: building a list allocates nothing, and the functions here
+ * never allocate either. GX_CONTAINER_OF() gets back from a link to the
+ * structure that contains it.
+ *
+ * The functions mirror their #GList counterparts, such as
+ * gx_list_filter_in_place(); the predicates, map and fold functions receive
+ * the #GXLink of each element, and the @free_func arguments are called with
+ * the links that are removed from the list.
+ *
+ * |[<!-- language="C" -->
+ * typedef struct {
+ *   GXLink link;
+ *   gint   n;
+ * } Item;
+ *
+ * static gboolean
+ * item_is_even (GXLink *link, gpointer user_data)
+ * {
+ *   return GX_CONTAINER_OF (link, Item, link)->n % 2 == 0;
+ * }
+ *
+ * Item    items[10];
+ * GXLink *list;
+ * gint    i;
+ *
+ * for (list = NULL, i = 9; i >= 0; --i)
+ *   {
+ *     items[i].n = i;
+ *     list = gx_link_prepend (list, &items[i].link);
+ *   }
+ *
+ * list = gx_link_filter_in_place (list, (GXPred)item_is_even, NULL, NULL);
+ * g_assert_cmpuint (gx_link_length (list), ==, 5);
+ * g_assert_cmpint (GX_CONTAINER_OF (list->next, Item, link)->n, ==, 2);
+ * ]|
+ *
+ * A link can only be in one list at a time; a structure that needs to be in
+ * several lists at once needs a #GXLink member for each of them.
+ */
+
+
+/**
+ * gx_link_prepend:
+ * @list: a list of #GXLink<!-- -->s
+ * @link: a #GXLink that is not in any list
+ *
+ * Add @link at the start of @list, in constant time.
+ *
+ * Returns: the new start of the list, i.e., @link.
+ */
+GXLink*
+gx_link_prepend (GXLink *list, GXLink *link)
+{
+  g_return_val_if_fail (link, list);
+
+  link->next = list;
+  link->prev = NULL;
+  if (list)
+    list->prev = link;
+
+  return link;
+}
+
+
+/**
+ * gx_link_append:
+ * @list: a list of #GXLink<!-- -->s
+ * @link: a #GXLink that is not in any list
+ *
+ * Add @link at the end of @list. As with g_list_append(), this has to walk
+ * the whole list; to build a long list, prepend the links and then call
+ * gx_link_reverse().
+ *
+ * Returns: the new start of the list.
+ */
+GXLink*
+gx_link_append (GXLink *list, GXLink *link)
+{
+  GXLink *last;
+
+  g_return_val_if_fail (link, list);
+
+  link->next = NULL;
+  if (!list)
+    {
+      link->prev = NULL;
+      return link;
+    }
+
+  for (last = list; last->next; last = last->next);
+
+  last->next = link;
+  link->prev = last;
+
+  return list;
+}
+
+
+/**
+ * gx_link_remove:
+ * @list: a list of #GXLink<!-- -->s
+ * @link: a #GXLink in @list
+ *
+ * Remove @link from @list, in constant time. Afterwards, @link is not in any
+ * list.
+ *
+ * Returns: the new start of the list.
+ */
+GXLink*
+gx_link_remove (GXLink *list, GXLink *link)
+{
+  g_return_val_if_fail (link, list);
+
+  if (link->prev)
+    link->prev->next = link->next;
+  else
+    list = link->next;
+
+  if (link->next)
+    link->next->prev = link->prev;
+
+  link->next = link->prev = NULL;
+
+  return list;
+}
+
+
+/**
+ * gx_link_reverse:
+ * @list: a list of #GXLink<!-- -->s
+ *
+ * Reverse the order of the links in @list.
+ *
+ * Returns: the new start of the list, i.e., the last link of @list.
+ */
+GXLink*
+gx_link_reverse (GXLink *list)
+{
+  GXLink *last;
+
+  for (last = NULL; list;)
+    {
+      last       = list;
+      list       = last->next;
+      last->next = last->prev;
+      last->prev = list;
+    }
+
+  return last;
+}
+
+
+/**
+ * gx_link_length:
+ * @list: a list of #GXLink<!-- -->s
+ *
+ * Get the number of links in @list.
+ *
+ * Returns: the length of @list.
+ */
+gsize
+gx_link_length (GXLink *list)
+{
+  gsize n;
+
+  for (n = 0; list; list = list->next)
+    ++n;
+
+  return n;
+}
+
+
+/**
+ * gx_link_free:
+ * @list: a list of #GXLink<!-- -->s
+ * @free_func: (allow-none): a function to free the elements
+ *
+ * Call @free_func for each link in @list, in order; this can safely free the
+ * structure the link is embedded in. The links themselves are not
+ * allocated separately, so there is nothing else to free.
+ */
+void
+gx_link_free (GXLink *list, GDestroyNotify free_func)
+{
+  if (!free_func)
+    return;
+
+  while (list)
+    {
+      GXLink *next;
+
+      next = list->next;
+      (*free_func) (list);
+      list = next;
+    }
+}
+
+
+/**
+ * gx_link_every:
+ * @list: a list of #GXLink<!-- -->s
+ * @pred_func: a predicate function, called with each link
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Check if the predicate is true for every link in @list, like
+ * gx_list_every(). If @list is empty, this is considered %TRUE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for every link in @list; %FALSE
+ * otherwise.
+ */
+gboolean
+gx_link_every (GXLink *list, GXPred pred_func, gpointer user_data)
+{
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (; list; list = list->next)
+    if (!(*pred_func) (list, user_data))
+      return FALSE;
+
+  return TRUE;
+}
+
+
+/**
+ * gx_link_any:
+ * @list: a list of #GXLink<!-- -->s
+ * @pred_func: a predicate function, called with each link
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Check if the predicate is true for any link in @list, like gx_list_any().
+ * If @list is empty, this is considered %FALSE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for at least one link in @list;
+ * %FALSE otherwise.
+ */
+gboolean
+gx_link_any (GXLink *list, GXPred pred_func, gpointer user_data)
+{
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (; list; list = list->next)
+    if ((*pred_func) (list, user_data))
+      return TRUE;
+
+  return FALSE;
+}
+
+
+/**
+ * gx_link_filter_in_place:
+ * @list: a list of #GXLink<!-- -->s
+ * @pred_func: a predicate function, called with each link
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @free_func: (allow-none): function to free the links that are filtered out
+ *
+ * Remove the links from @list for which @pred_func does not return %TRUE,
+ * like gx_list_filter_in_place(). The removed links are passed to
+ * @free_func, if it is not %NULL.
+ *
+ * Returns: the new start of the list.
+ */
+GXLink*
+gx_link_filter_in_place (GXLink *list, GXPred pred_func,
+                         gpointer user_data, GDestroyNotify free_func)
+{
+  GXLink *cur, *last;
+
+  g_return_val_if_fail (pred_func, list);
+
+  /* relink the links we keep as we go, rather than unlinking the others one
+   * by one */
+  for (last = NULL, cur = list, list = NULL; cur;)
+    {
+      GXLink *next;
+
+      next = cur->next;
+      if ((*pred_func) (cur, user_data))
+        {
+          cur->prev = last;
+          if (last)
+            last->next = cur;
+          else
+            list = cur;
+          last = cur;
+        }
+      else if (free_func)
+        (*free_func) (cur);
+
+      cur = next;
+    }
+
+  if (last)
+    last->next = NULL;
+
+  return list;
+}
+
+
+/**
+ * gx_link_take_in_place:
+ * @list: a list of #GXLink<!-- -->s
+ * @n: the number of links to keep
+ * @free_func: (allow-none): function to free the removed links
+ *
+ * Reduce @list to its first @n links, like gx_list_take_in_place(); the
+ * removed links are passed to @free_func, if it is not %NULL.
+ *
+ * Returns: the list reduced to up to @n links.
+ */
+GXLink*
+gx_link_take_in_place (GXLink *list, gsize n, GDestroyNotify free_func)
+{
+  GXLink *cur, *rest;
+
+  if (n == 0)
+    {
+      gx_link_free (list, free_func);
+      return NULL;
+    }
+
+  for (cur = list; n > 1 && cur; cur = cur->next, --n);
+
+  if (cur && cur->next)
+    {
+      rest      = cur->next;
+      cur->next = NULL;
+      gx_link_free (rest, free_func);
+    }
+
+  return list;
+}
+
+
+/**
+ * gx_link_skip_in_place:
+ * @list: a list of #GXLink<!-- -->s
+ * @n: the number of links to remove
+ * @free_func: (allow-none): function to free the removed links
+ *
+ * Remove the first @n links from @list, like gx_list_skip_in_place(); the
+ * removed links are passed to @free_func, if it is not %NULL.
+ *
+ * Returns: the new start of the list.
+ */
+GXLink*
+gx_link_skip_in_place (GXLink *list, gsize n, GDestroyNotify free_func)
+{
+  GXLink *cur;
+
+  for (cur = list; cur && n != 0; cur = cur->next, --n);
+
+  if (cur && cur->prev)
+    {
+      cur->prev->next = NULL;
+      cur->prev       = NULL;
+      gx_link_free (list, free_func);
+    }
+  else if (!cur)
+    gx_link_free (list, free_func);
+
+  return cur;
+}
+
+
+/**
+ * gx_link_map_in_place:
+ * @list: a list of #GXLink<!-- -->s
+ * @map_func: a function, called with each link
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ * @free_func: (allow-none): a function to free the replaced links
+ *
+ * Apply @map_func to each link in @list, like gx_list_map_in_place().
+ * @map_func can update the structure in place and return the same link, or
+ * return a different link (not in any list) to take its place, in which case
+ * the replaced link is passed to @free_func, if it is not %NULL.
+ *
+ * Returns: the new start of the list.
+ */
+GXLink*
+gx_link_map_in_place (GXLink *list, GXBinaryFunc map_func, gpointer user_data,
+                      GDestroyNotify free_func)
+{
+  GXLink *cur;
+
+  g_return_val_if_fail (map_func, list);
+
+  for (cur = list; cur; cur = cur->next)
+    {
+      GXLink *mapped;
+
+      mapped = (*map_func) (cur, user_data);
+      if (mapped == cur)
+        continue;
+
+      g_return_val_if_fail (mapped, list);
+
+      mapped->next = cur->next;
+      mapped->prev = cur->prev;
+      if (cur->prev)
+        cur->prev->next = mapped;
+      else
+        list = mapped;
+      if (cur->next)
+        cur->next->prev = mapped;
+
+      if (free_func)
+        (*free_func) (cur);
+
+      cur = mapped;
+    }
+
+  return list;
+}
+
+
+/**
+ * gx_link_fold:
+ * @list: a list of #GXLink<!-- -->s
+ * @fold_func: a ternary function, called with the accumulated value and each
+ * link
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Given a list of links (a, b, c), compute
+ *      fold_func (fold_func (fold_func (@init, a), b), c)
+ * like gx_list_fold().
+ *
+ * Returns: (transfer full): the computed value; %NULL if @list is empty.
+ */
+gpointer
+gx_link_fold (GXLink *list, GXTernaryFunc fold_func, gpointer init,
+              gpointer user_data, GDestroyNotify free_func)
+{
+  gpointer result, acc;
+
+  g_return_val_if_fail (fold_func, NULL);
+
+  for (result = NULL, acc = init; list; list = list->next)
+    {
+      gpointer tmp;
+
+      tmp = (*fold_func) (acc, list, user_data);
+      if (free_func)
+        (*free_func) (result);
+
+      result = acc = tmp;
+    }
+
+  return result;
+}
@@ -0,0 +1,88 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_LINK_H__
+#define __GX_LINK_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXLink:
+ * @next: the next link in the list, or %NULL
+ * @prev: the previous link in the list, or %NULL
+ *
+ * A #GXLink is a list node that is embedded in the structure it links,
+ * rather than pointing to it. A list of links is represented by its first
+ * link, or %NULL for the empty list, just like a #GList.
+ */
+typedef struct _GXLink GXLink;
+struct _GXLink {
+  GXLink *next;
+  GXLink *prev;
+};
+
+/**
+ * GX_CONTAINER_OF:
+ * @ptr: a pointer to a member of a structure
+ * @type: the type of the structure
+ * @member: the name of the member within @type
+ *
+ * Get a pointer to the structure of type @type that contains the member
+ * @member at @ptr; typically, to get from a #GXLink to the structure it is
+ * embedded in.
+ *
+ * Returns: a pointer to the containing structure.
+ */
+#define GX_CONTAINER_OF(ptr,type,member)                                \
+  ((type*)(void*)((gchar*)(ptr) - G_STRUCT_OFFSET (type, member)))
+
+GXLink *gx_link_prepend (GXLink *list, GXLink *link)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXLink *gx_link_append (GXLink *list, GXLink *link) G_GNUC_WARN_UNUSED_RESULT;
+GXLink *gx_link_remove (GXLink *list, GXLink *link) G_GNUC_WARN_UNUSED_RESULT;
+GXLink *gx_link_reverse (GXLink *list) G_GNUC_WARN_UNUSED_RESULT;
+gsize gx_link_length (GXLink *list);
+void gx_link_free (GXLink *list, GDestroyNotify free_func);
+
+gboolean gx_link_every (GXLink *list, GXPred pred_func, gpointer user_data);
+gboolean gx_link_any (GXLink *list, GXPred pred_func, gpointer user_data);
+
+GXLink *gx_link_filter_in_place (GXLink *list, GXPred pred_func,
+                                 gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXLink *gx_link_take_in_place (GXLink *list, gsize n,
+                               GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXLink *gx_link_skip_in_place (GXLink *list, gsize n,
+                               GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXLink *gx_link_map_in_place (GXLink *list, GXBinaryFunc map_func,
+                              gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gpointer gx_link_fold (GXLink *list, GXTernaryFunc fold_func, gpointer init,
+                       gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
+
+#endif /* __GX_LINK_H__ */
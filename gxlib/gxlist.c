@@ -18,6 +18,7 @@
 */
 
 #include "gxlist.h"
+#include "gxlib-private.h"
 
 /**
  * SECTION:gxlist
@@ -90,17 +91,19 @@
 GList*
 gx_list_filter (GList *list, GXPred pred_func, gpointer user_data)
 {
-  GList *cur, *filtered;
+  GList         *cur;
+  GXListBuilder  filtered;
 
   g_return_val_if_fail (pred_func, FALSE);
-  
-  for (filtered = NULL, cur = list; cur; cur = g_list_next (cur))
+
+  gx_list_builder_init (&filtered);
+  for (cur = list; cur; cur = g_list_next (cur))
     {
       if ((*pred_func) (cur->data, user_data))
-	  filtered = g_list_prepend (filtered, cur->data);
+        gx_list_builder_append (&filtered, cur->data);
     }
 
-  return g_list_reverse (filtered);
+  return filtered.head;
 }
 
 
@@ -200,10 +203,12 @@ GList*
 gx_list_filter_in_place (GList *list, GXPred pred_func,
                          gpointer user_data, GDestroyNotify free_func)
 {
-  GList *cur, *prev;
+  GList          *cur, *prev;
+  GXListMagazine *mag;
 
   g_return_val_if_fail (pred_func, NULL);
 
+  mag  = gx_list_magazine_get ();
   prev = NULL;
   cur = list;
   
@@ -230,7 +235,7 @@ gx_list_filter_in_place (GList *list, GXPred pred_func,
       if (free_func) 
 	(*free_func) (cur->data);
 
-      g_list_free_1 (cur);
+      gx_list_node_free (mag, cur);
       
       cur = next;
     }
@@ -239,6 +244,123 @@ gx_list_filter_in_place (GList *list, GXPred pred_func,
 }
 
 
+/**
+ * gx_list_partition:
+ * @list: a #GList
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @rejected: (out) (transfer full): receives a list of the elements for which
+ * @pred_func returns %FALSE
+ *
+ * Split @list in a single pass: the elements for which @pred_func returns
+ * %TRUE go to the returned list, the others to @rejected, both in their
+ * original order. @pred_func is called once for each element. This is like
+ * calling gx_list_filter() twice, with @pred_func and with its negation.
+ *
+ * |[<!-- language="C" -->
+ * GList *nums, *even, *odd;
+ *
+ * nums = gx_list_iota (10, 1, 1);
+ * even = gx_list_partition (nums, (GXPred)gx_is_even, NULL, &odd);
+ *
+ * g_assert_cmpint (gx_list_sum (even), ==, 2 + 4 + 6 + 8 + 10);
+ * g_assert_cmpint (gx_list_sum (odd), ==, 1 + 3 + 5 + 7 + 9);
+ *
+ * g_list_free (nums);
+ * g_list_free (even);
+ * g_list_free (odd);
+ * ]|
+ *
+ * Returns: (transfer full): a list of the elements for which @pred_func
+ * returns %TRUE; free with g_list_free().
+ */
+GList*
+gx_list_partition (GList *list, GXPred pred_func, gpointer user_data,
+                   GList **rejected)
+{
+  GList         *cur;
+  GXListBuilder  sides[2];
+
+  g_return_val_if_fail (pred_func, NULL);
+  g_return_val_if_fail (rejected, NULL);
+
+  gx_list_builder_init (&sides[0]);
+  gx_list_builder_init (&sides[1]);
+
+  for (cur = list; cur; cur = g_list_next (cur))
+    gx_list_builder_append (&sides[(*pred_func) (cur->data, user_data) ? 0 : 1],
+                            cur->data);
+
+  *rejected = sides[1].head;
+
+  return sides[0].head;
+}
+
+
+/**
+ * gx_list_partition_in_place:
+ * @list: a #GList
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @rejected: (out) (transfer full) (allow-none): receives a list of the
+ * elements for which @pred_func returns %FALSE, or %NULL
+ * @free_func: (allow-none): function to free the rejected elements when
+ * @rejected is %NULL
+ *
+ * Like gx_list_partition(), but rather than creating new lists, move the
+ * nodes of @list into the two result lists; this does not allocate
+ * anything.
+ *
+ * If @rejected is %NULL, the rejected elements are removed and freed with
+ * @free_func, just like with gx_list_filter_in_place().
+ *
+ * Returns: the list of the elements for which @pred_func returns %TRUE. Note
+ * that the start of the list may have changed.
+ */
+GList*
+gx_list_partition_in_place (GList *list, GXPred pred_func, gpointer user_data,
+                            GList **rejected, GDestroyNotify free_func)
+{
+  GList          *heads[2], *tails[2], *cur, *next;
+  GXListMagazine *mag;
+
+  g_return_val_if_fail (pred_func, NULL);
+
+  mag      = rejected ? NULL : gx_list_magazine_get ();
+  heads[0] = heads[1] = tails[0] = tails[1] = NULL;
+
+  for (cur = list; cur; cur = next)
+    {
+      guint side;
+
+      next = cur->next;
+      side = (*pred_func) (cur->data, user_data) ? 0 : 1;
+
+      if (side == 1 && !rejected)
+        {
+          if (free_func)
+            (*free_func) (cur->data);
+          gx_list_node_free (mag, cur);
+          continue;
+        }
+
+      /* relink cur at the end of its side */
+      cur->prev = tails[side];
+      cur->next = NULL;
+      if (tails[side])
+        tails[side]->next = cur;
+      else
+        heads[side] = cur;
+      tails[side] = cur;
+    }
+
+  if (rejected)
+    *rejected = heads[1];
+
+  return heads[0];
+}
+
+
 /**
  * gx_list_take:
  * @list: a #GList
@@ -269,22 +391,13 @@ gx_list_filter_in_place (GList *list, GXPred pred_func,
 GList*
 gx_list_take (GList *list, gsize n)
 {
-  GList *taken;
-
-  for (taken = NULL; n > 0 && list; list = g_list_next (list), --n)
-    taken = g_list_prepend (taken, list->data);
-
-  return g_list_reverse (taken);
-}
+  GXListBuilder taken;
 
+  gx_list_builder_init (&taken);
+  for (; n > 0 && list; list = g_list_next (list), --n)
+    gx_list_builder_append (&taken, list->data);
 
-static void
-gx_list_free_full (GList *lst, GDestroyNotify free_func)
-{
-  if (free_func)
-    g_list_free_full (lst, free_func);
-  else
-    g_list_free (lst);
+  return taken.head;
 }
 
 
@@ -311,7 +424,7 @@ gx_list_take_in_place (GList *list, gsize n, GDestroyNotify free_func)
   
   if (n == 0)
     {
-      gx_list_free_full (list, free_func);
+      gx_list_free_nodes (list, free_func);
       return NULL;
     }
 
@@ -319,7 +432,7 @@ gx_list_take_in_place (GList *list, gsize n, GDestroyNotify free_func)
 
   if (cur && cur->next)
     {
-      gx_list_free_full (cur->next, free_func);
+      gx_list_free_nodes (cur->next, free_func);
       cur->next = NULL;
     }
 
@@ -349,11 +462,16 @@ gx_list_take_in_place (GList *list, gsize n, GDestroyNotify free_func)
 GList*
 gx_list_skip (GList *list, gsize n)
 {
-  GList *cur;
+  GList         *cur;
+  GXListBuilder  skipped;
 
   for (cur = list; cur && n != 0; cur = g_list_next(cur), --n);
 
-  return g_list_copy (cur);
+  gx_list_builder_init (&skipped);
+  for (; cur; cur = g_list_next (cur))
+    gx_list_builder_append (&skipped, cur->data);
+
+  return skipped.head;
 }
 
 
@@ -383,7 +501,7 @@ gx_list_skip_in_place (GList *list, gsize n, GDestroyNotify free_func)
   if (cur && cur->prev)
     {
       cur->prev->next = NULL;
-      gx_list_free_full (list, free_func);
+      gx_list_free_nodes (list, free_func);
     }
   
   return cur;
@@ -419,16 +537,16 @@ gx_list_skip_in_place (GList *list, gsize n, GDestroyNotify free_func)
 GList*
 gx_list_map (GList *list, GXBinaryFunc map_func, gpointer user_data)
 {
-  GList *cur, *mapped;
+  GList         *cur;
+  GXListBuilder  mapped;
 
   g_return_val_if_fail (map_func, NULL);
 
-  for (mapped = NULL, cur = list; cur; cur = g_list_next (cur))
-    {
-      mapped = g_list_prepend (mapped, (*map_func) (cur->data, user_data));
-    }
+  gx_list_builder_init (&mapped);
+  for (cur = list; cur; cur = g_list_next (cur))
+    gx_list_builder_append (&mapped, (*map_func) (cur->data, user_data));
 
-  return g_list_reverse (mapped);
+  return mapped.head;
 }
 
 
@@ -466,6 +584,30 @@ gx_list_map_in_place (GList *list, GXBinaryFunc map_func, gpointer user_data,
   return list;
 }
 
+static gpointer
+list_fold_kernel (GList *list, GXFoldKernel kernel, gpointer init,
+                  gpointer user_data)
+{
+  gpointer batch[FOLD_BATCH_SIZE];
+  gpointer result;
+
+  if (!list)
+    return NULL;
+
+  for (result = init; list;)
+    {
+      gsize n;
+
+      for (n = 0; list && n != FOLD_BATCH_SIZE; list = list->next)
+        batch[n++] = list->data;
+
+      result = kernel (result, batch, n, user_data);
+    }
+
+  return result;
+}
+
+
 /**
  * gx_list_fold:
  * @list: a #GList
@@ -505,7 +647,13 @@ gx_list_map_in_place (GList *list, GXBinaryFunc map_func, gpointer user_data,
  * g_free (str);
  * g_list_free (lst);
  * ]|
- * Returns: (transfer full): the computed value.
+ *
+ * If there is a #GXFoldKernel for @fold_func (see gx_fold_kernel_register())
+ * and @free_func is %NULL, the elements are folded in batches by the kernel
+ * instead; gxlib has built-in kernels for gx_plus(), gx_times(), gx_max() and
+ * gx_min().
+ *
+ * Returns: (transfer full): the computed value; %NULL if @list is empty.
  */
 gpointer
 gx_list_fold (GList *list, GXTernaryFunc fold_func,
@@ -513,8 +661,13 @@ gx_list_fold (GList *list, GXTernaryFunc fold_func,
 {
   GList *cur;
   gpointer result, first;
+  GXFoldKernel kernel;
 
   g_return_val_if_fail (fold_func, NULL);
+
+  kernel = free_func ? NULL : gx_fold_kernel_lookup (fold_func);
+  if (kernel)
+    return list_fold_kernel (list, kernel, init, user_data);
   
   result = NULL;
   for (result = NULL, first = init, cur = list; cur; cur = g_list_next (cur))
@@ -533,6 +686,350 @@ gx_list_fold (GList *list, GXTernaryFunc fold_func,
 }
 
 
+/**
+ * gx_list_scan:
+ * @list: a #GList
+ * @fold_func: a ternary function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @mode: whether the scan is inclusive or exclusive
+ *
+ * Like gx_list_fold(), but get all the intermediate values rather than only
+ * the last one. That is, given a list (a, b, c), an inclusive scan gives
+ *      (fold_func (@init, a), fold_func (fold_func (@init, a), b), ...)
+ * while an exclusive scan gives
+ *      (@init, fold_func (@init, a), fold_func (fold_func (@init, a), b))
+ *
+ * So, element i of the result covers the elements up to and including i
+ * (inclusive), or up to but not including i (exclusive). Either way, the
+ * result has as many elements as @list, and @fold_func is called once per
+ * element (except for the last one, in an exclusive scan).
+ *
+ * |[<!-- language="C" -->
+ * GList *nums, *totals;
+ *
+ * nums   = gx_list_iota (5, 1, 1); // 1, 2, 3, 4, 5
+ * totals = gx_list_scan (nums, (GXTernaryFunc)gx_plus, GINT_TO_POINTER (0),
+ *                        NULL, GX_SCAN_INCLUSIVE); // 1, 3, 6, 10, 15
+ * g_assert_cmpint (GPOINTER_TO_INT (g_list_last (totals)->data), ==, 15);
+ *
+ * g_list_free (nums);
+ * g_list_free (totals);
+ * ]|
+ *
+ * Returns: (transfer full): a list with the intermediate values. Whether to
+ * free with g_list_free() or with g_list_free_full() depends on @fold_func;
+ * note that the first element of an exclusive scan is @init itself.
+ */
+GList*
+gx_list_scan (GList *list, GXTernaryFunc fold_func, gpointer init,
+              gpointer user_data, GXScanMode mode)
+{
+  GXListBuilder  builder;
+  gpointer       acc;
+
+  g_return_val_if_fail (fold_func, NULL);
+
+  gx_list_builder_init (&builder);
+
+  for (acc = init; list; list = list->next)
+    {
+      if (mode == GX_SCAN_EXCLUSIVE)
+        {
+          gx_list_builder_append (&builder, acc);
+          /* the fold of the whole list is not part of the result */
+          if (!list->next)
+            break;
+        }
+
+      acc = (*fold_func) (acc, list->data, user_data);
+
+      if (mode == GX_SCAN_INCLUSIVE)
+        gx_list_builder_append (&builder, acc);
+    }
+
+  return builder.head;
+}
+
+
+/* a double-ended queue of the elements of a window, with their positions, in
+ * a ring buffer; for the sliding minimum/maximum, it only holds the elements
+ * that can still become the extreme value, so it is monotonic */
+typedef struct {
+  gpointer *data;
+  gsize    *pos;
+  gsize     size;   /* the capacity: the window size */
+  gsize     first;  /* index of the front */
+  gsize     len;
+} WindowDeque;
+
+static void
+window_deque_init (WindowDeque *deque, gsize size)
+{
+  deque->data  = g_new (gpointer, size);
+  deque->pos   = g_new (gsize, size);
+  deque->size  = size;
+  deque->first = deque->len = 0;
+}
+
+static void
+window_deque_clear (WindowDeque *deque)
+{
+  g_free (deque->data);
+  g_free (deque->pos);
+}
+
+#define DEQUE_INDEX(deque,i) (((deque)->first + (i)) % (deque)->size)
+
+/* add the element at pos, dropping the ones it makes irrelevant at the back
+ * (sign > 0 for the maximum, < 0 for the minimum), and the one that falls out
+ * of the window at the front; then return the front */
+static gpointer
+window_deque_push (WindowDeque *deque, gpointer data, gsize pos,
+                   GCompareFunc cmp_func, gint sign)
+{
+  gsize back;
+
+  while (deque->len > 0)
+    {
+      gint cmp;
+
+      back = DEQUE_INDEX (deque, deque->len - 1);
+      cmp  = (*cmp_func) (deque->data[back], data);
+      if (sign > 0 ? cmp > 0 : cmp < 0)
+        break;
+      --deque->len;
+    }
+
+  if (deque->len > 0 && deque->pos[deque->first] + deque->size <= pos)
+    {
+      deque->first = (deque->first + 1) % deque->size;
+      --deque->len;
+    }
+
+  back               = DEQUE_INDEX (deque, deque->len++);
+  deque->data[back]  = data;
+  deque->pos[back]   = pos;
+
+  return deque->data[deque->first];
+}
+
+static GList*
+list_sliding_extreme (GList *list, gsize window, GCompareFunc cmp_func,
+                      gint sign)
+{
+  GXListBuilder builder;
+  WindowDeque   deque;
+  gsize         pos;
+
+  window_deque_init (&deque, window);
+  gx_list_builder_init (&builder);
+
+  for (pos = 0; list; list = list->next, ++pos)
+    {
+      gpointer extreme;
+
+      extreme = window_deque_push (&deque, list->data, pos, cmp_func, sign);
+      if (pos + 1 >= window)
+        gx_list_builder_append (&builder, extreme);
+    }
+
+  window_deque_clear (&deque);
+
+  return builder.head;
+}
+
+/**
+ * gx_list_sliding_min:
+ * @list: a #GList
+ * @window: the size of the window, > 0
+ * @cmp_func: a function to compare the elements
+ *
+ * Get the smallest element of each run of @window consecutive elements in
+ * @list; for a list of n elements, that is n - @window + 1 values (or none,
+ * if @list has fewer than @window elements). If a window has several equal
+ * smallest elements, the last of them is taken.
+ *
+ * This takes O(n) time, independent of @window: it uses a deque of the
+ * elements that can still become the smallest one.
+ *
+ * |[<!-- language="C" -->
+ * GList *nums, *mins;
+ *
+ * nums = gx_list_iota (6, 1, 1); // 1, 2, 3, 4, 5, 6
+ * nums = g_list_reverse (nums);
+ * mins = gx_list_sliding_min (nums, 3, (GCompareFunc)gx_cmp_int);
+ * // 4, 3, 2, 1
+ * g_assert_cmpint (gx_list_sum (mins), ==, 4 + 3 + 2 + 1);
+ *
+ * g_list_free (nums);
+ * g_list_free (mins);
+ * ]|
+ *
+ * Returns: (transfer full): a list of the smallest element of each window;
+ * free with g_list_free().
+ */
+GList*
+gx_list_sliding_min (GList *list, gsize window, GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (window > 0, NULL);
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sliding_extreme (list, window, cmp_func, -1);
+}
+
+/**
+ * gx_list_sliding_max:
+ * @list: a #GList
+ * @window: the size of the window, > 0
+ * @cmp_func: a function to compare the elements
+ *
+ * Like gx_list_sliding_min(), but get the largest element of each window.
+ *
+ * Returns: (transfer full): a list of the largest element of each window;
+ * free with g_list_free().
+ */
+GList*
+gx_list_sliding_max (GList *list, gsize window, GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (window > 0, NULL);
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sliding_extreme (list, window, cmp_func, 1);
+}
+
+
+/* a windowed fold with gx_plus(): keep a running sum; the sum wraps around
+ * like the gint additions would */
+static GList*
+list_windowed_sum (GList *list, gsize window, gint init)
+{
+  GXListBuilder  builder;
+  GList         *old;
+  guint          sum;
+  gsize          pos;
+
+  gx_list_builder_init (&builder);
+
+  for (sum = 0, old = list, pos = 0; list; list = list->next, ++pos)
+    {
+      sum += (guint)GPOINTER_TO_INT (list->data);
+      if (pos + 1 < window)
+        continue;
+
+      gx_list_builder_append (&builder,
+                              GINT_TO_POINTER ((gint)((guint)init + sum)));
+      sum -= (guint)GPOINTER_TO_INT (old->data);
+      old  = old->next;
+    }
+
+  return builder.head;
+}
+
+static GList*
+list_windowed_extreme (GList *list, gsize window, gint init, gint sign)
+{
+  GList *extremes, *cur;
+
+  extremes = list_sliding_extreme (list, window, (GCompareFunc)gx_cmp_int,
+                                   sign);
+  for (cur = extremes; cur; cur = cur->next)
+    if (sign > 0 ? init > GPOINTER_TO_INT (cur->data) :
+        init < GPOINTER_TO_INT (cur->data))
+      cur->data = GINT_TO_POINTER (init);
+
+  return extremes;
+}
+
+/**
+ * gx_list_windowed_fold:
+ * @list: a #GList
+ * @window: the size of the window, > 0
+ * @fold_func: a ternary function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Fold each run of @window consecutive elements of @list, as gx_list_fold()
+ * would; for a list of n elements, that gives n - @window + 1 values (or
+ * none, if @list has fewer than @window elements).
+ *
+ * In general, this calls @fold_func @window times per value. However, for
+ * gx_plus() this keeps a running sum, and for gx_max() and gx_min() it uses
+ * the same deque as gx_list_sliding_max() and gx_list_sliding_min(); either
+ * way, that takes O(n) time, independent of @window, and @fold_func is not
+ * called.
+ *
+ * |[<!-- language="C" -->
+ * GList *nums, *sums;
+ *
+ * nums = gx_list_iota (5, 1, 1); // 1, 2, 3, 4, 5
+ * sums = gx_list_windowed_fold (nums, 2, (GXTernaryFunc)gx_plus,
+ *                               GINT_TO_POINTER (0), NULL, NULL);
+ * // 3, 5, 7, 9
+ * g_assert_cmpint (gx_list_sum (sums), ==, 3 + 5 + 7 + 9);
+ *
+ * g_list_free (nums);
+ * g_list_free (sums);
+ * ]|
+ *
+ * Returns: (transfer full): a list with the value for each window. Whether to
+ * free with g_list_free() or with g_list_free_full() depends on @fold_func.
+ */
+GList*
+gx_list_windowed_fold (GList *list, gsize window, GXTernaryFunc fold_func,
+                       gpointer init, gpointer user_data,
+                       GDestroyNotify free_func)
+{
+  GXListBuilder builder;
+
+  g_return_val_if_fail (window > 0, NULL);
+  g_return_val_if_fail (fold_func, NULL);
+
+  switch (gx_reducer_for_func ((GCallback)fold_func))
+    {
+    case GX_REDUCER_PLUS:
+      return list_windowed_sum (list, window, GPOINTER_TO_INT (init));
+    case GX_REDUCER_MAX:
+      return list_windowed_extreme (list, window, GPOINTER_TO_INT (init), 1);
+    case GX_REDUCER_MIN:
+      return list_windowed_extreme (list, window, GPOINTER_TO_INT (init), -1);
+    default:
+      break;
+    }
+
+  gx_list_builder_init (&builder);
+
+  for (; list; list = list->next)
+    {
+      GList    *cur;
+      gpointer  acc, prev;
+      gsize     u;
+
+      for (acc = init, cur = list, u = 0; cur && u != window;
+           cur = cur->next, ++u)
+        {
+          prev = acc;
+          acc  = (*fold_func) (acc, cur->data, user_data);
+          if (free_func && u > 0)
+            (*free_func) (prev);
+        }
+
+      /* the window ran off the end of the list */
+      if (u != window)
+        {
+          if (free_func && u > 0)
+            (*free_func) (acc);
+          break;
+        }
+
+      gx_list_builder_append (&builder, acc);
+    }
+
+  return builder.head;
+}
+
+
 /**
  * gx_list_iota:
  * @count: number of elements to generate
@@ -555,14 +1052,15 @@ gx_list_fold (GList *list, GXTernaryFunc fold_func,
 GList*
 gx_list_iota (gsize count, gint start, gsize step)
 {
-  GList *lst;
+  GXListBuilder lst;
 
   g_return_val_if_fail (step > 0, NULL);
-  
-  for (lst = 0; count > 0; --count, start += step)
-    lst = g_list_prepend (lst, GINT_TO_POINTER(start));
 
-  return g_list_reverse (lst);
+  gx_list_builder_init (&lst);
+  for (; count > 0; --count, start += step)
+    gx_list_builder_append (&lst, GINT_TO_POINTER(start));
+
+  return lst.head;
 }
 
 
@@ -611,3 +1109,1201 @@ gx_list_product (GList *list)
   return product;
 }
 
+
+
+/*
+ * set operations
+ */
+
+/* collects the result of a set operation; either by copying the elements of
+ * the nodes that are kept to a new list, or (in_place) by relinking those
+ * nodes into a result list, and freeing the others */
+typedef struct {
+  gboolean        in_place;
+  GXListBuilder   builder;
+  GList          *head, *tail;
+  GXListMagazine *mag;
+  GDestroyNotify  free_func;
+} SetResult;
+
+static void
+set_result_init (SetResult *res, gboolean in_place, GDestroyNotify free_func)
+{
+  res->in_place  = in_place;
+  res->head      = res->tail = NULL;
+  res->mag       = in_place ? gx_list_magazine_get () : NULL;
+  res->free_func = free_func;
+
+  gx_list_builder_init (&res->builder);
+}
+
+/* for in_place results, the caller must get node->next beforehand */
+static void
+set_result_keep (SetResult *res, GList *node)
+{
+  if (!res->in_place)
+    {
+      gx_list_builder_append (&res->builder, node->data);
+      return;
+    }
+
+  node->prev = res->tail;
+  node->next = NULL;
+  if (res->tail)
+    res->tail->next = node;
+  else
+    res->head = node;
+  res->tail = node;
+}
+
+static void
+set_result_drop (SetResult *res, GList *node)
+{
+  if (!res->in_place)
+    return;
+
+  if (res->free_func)
+    (*res->free_func) (node->data);
+
+  gx_list_node_free (res->mag, node);
+}
+
+static void
+set_result_drop_all (SetResult *res, GList *list)
+{
+  GList *next;
+
+  for (; list && res->in_place; list = next)
+    {
+      next = list->next;
+      set_result_drop (res, list);
+    }
+}
+
+static GList*
+set_result_finish (SetResult *res)
+{
+  return res->in_place ? res->head : res->builder.head;
+}
+
+
+/* an open-addressing hash set; unlike GHashTable, it can be allocated at its
+ * final size, and its slots can carry some extra data */
+typedef enum {
+  SLOT_EMPTY = 0,
+  SLOT_OTHER,  /* an element of the second list */
+  SLOT_SEEN    /* an element that was seen before */
+} SlotState;
+
+typedef struct {
+  gpointer  key;
+  gpointer  value;
+  guint     hash;
+  SlotState state;
+} HashSlot;
+
+typedef struct {
+  HashSlot   *slots;
+  guint       bits;
+  gsize       n_used;  /* only maintained by hash_set_insert */
+  GHashFunc   hash_func;
+  GEqualFunc  equal_func;
+} HashSet;
+
+static void
+hash_set_init (HashSet *set, gsize n, GHashFunc hash_func,
+               GEqualFunc equal_func)
+{
+  /* keep the load factor <= 0.5 */
+  for (set->bits = 3; ((gsize)1 << set->bits) < 2 * n; ++set->bits);
+
+  set->slots      = g_new0 (HashSlot, (gsize)1 << set->bits);
+  set->n_used     = 0;
+  set->hash_func  = hash_func  ? hash_func  : g_direct_hash;
+  set->equal_func = equal_func ? equal_func : g_direct_equal;
+}
+
+static void
+hash_set_clear (HashSet *set)
+{
+  g_free (set->slots);
+}
+
+/* find the slot for key with the given hash; if key is not in the set yet,
+ * this is an empty slot that key can be stored in */
+static HashSlot*
+hash_set_probe (HashSet *set, gpointer key, guint hash)
+{
+  gsize     mask, i;
+  HashSlot *slot;
+
+  mask = ((gsize)1 << set->bits) - 1;
+
+  /* Fibonacci hashing, so that regular keys (e.g. aligned pointers) do not
+   * end up in the same few slots */
+  i = (gsize)((hash * 2654435769U) >> (32 - MIN (set->bits, 32))) & mask;
+
+  for (;; i = (i + 1) & mask)
+    {
+      slot = &set->slots[i];
+      if (slot->state == SLOT_EMPTY)
+        {
+          slot->key  = key;
+          slot->hash = hash;
+          return slot;
+        }
+      else if (slot->hash == hash && (*set->equal_func) (slot->key, key))
+        return slot;
+    }
+}
+
+static HashSlot*
+hash_set_find (HashSet *set, gpointer key)
+{
+  return hash_set_probe (set, key, (*set->hash_func) (key));
+}
+
+/* like hash_set_find, but mark a new key as SLOT_SEEN, and grow the set when
+ * needed */
+static HashSlot*
+hash_set_insert (HashSet *set, gpointer key, gboolean *is_new)
+{
+  HashSlot *slot;
+
+  if ((set->n_used + 1) * 2 > ((gsize)1 << set->bits))
+    {
+      HashSlot *old_slots;
+      gsize     u, n_old;
+
+      old_slots  = set->slots;
+      n_old      = (gsize)1 << set->bits;
+      set->slots = g_new0 (HashSlot, n_old * 2);
+      ++set->bits;
+
+      for (u = 0; u != n_old; ++u)
+        if (old_slots[u].state != SLOT_EMPTY)
+          *hash_set_probe (set, old_slots[u].key, old_slots[u].hash) =
+            old_slots[u];
+
+      g_free (old_slots);
+    }
+
+  slot    = hash_set_find (set, key);
+  *is_new = slot->state == SLOT_EMPTY;
+  if (*is_new)
+    {
+      slot->state = SLOT_SEEN;
+      ++set->n_used;
+    }
+
+  return slot;
+}
+
+static void
+hash_set_add_list (HashSet *set, GList *list, SlotState state)
+{
+  for (; list; list = list->next)
+    hash_set_find (set, list->data)->state = state;
+}
+
+
+static GList*
+list_uniq (GList *list, GHashFunc hash_func, GEqualFunc equal_func,
+           gboolean in_place, GDestroyNotify free_func)
+{
+  SetResult  res;
+  HashSet    set;
+  GList     *next;
+
+  set_result_init (&res, in_place, free_func);
+  hash_set_init (&set, g_list_length (list), hash_func, equal_func);
+
+  for (; list; list = next)
+    {
+      HashSlot *slot;
+
+      next = list->next;
+      slot = hash_set_find (&set, list->data);
+      if (slot->state == SLOT_EMPTY)
+        {
+          slot->state = SLOT_SEEN;
+          set_result_keep (&res, list);
+        }
+      else
+        set_result_drop (&res, list);
+    }
+
+  hash_set_clear (&set);
+
+  return set_result_finish (&res);
+}
+
+/**
+ * gx_list_uniq:
+ * @list: a #GList
+ * @hash_func: (allow-none): a function to hash the elements, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the elements for
+ * equality, or %NULL for g_direct_equal()
+ *
+ * Get the distinct elements of @list, in the order of their first
+ * occurrence. This takes O(n) time, using a hash set.
+ *
+ * |[<!-- language="C" -->
+ * GList *words, *uniq;
+ *
+ * words = gx_strv_to_list ((gchar*[]){ "a", "b", "a", "c", "b", NULL }, -1);
+ * uniq  = gx_list_uniq (words, g_str_hash, g_str_equal); // a, b, c
+ * g_assert_cmpuint (g_list_length (uniq), ==, 3);
+ *
+ * g_list_free (words);
+ * g_list_free (uniq);
+ * ]|
+ *
+ * Returns: (transfer full): a list with the distinct elements of @list; free
+ * with g_list_free().
+ */
+GList*
+gx_list_uniq (GList *list, GHashFunc hash_func, GEqualFunc equal_func)
+{
+  return list_uniq (list, hash_func, equal_func, FALSE, NULL);
+}
+
+/**
+ * gx_list_uniq_in_place:
+ * @list: a #GList
+ * @hash_func: (allow-none): a function to hash the elements, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the elements for
+ * equality, or %NULL for g_direct_equal()
+ * @free_func: (allow-none): function to free the elements that are removed
+ *
+ * Like gx_list_uniq(), but remove the duplicate elements from @list itself,
+ * freeing them with @free_func. Note that with g_direct_equal(), the removed
+ * elements are the very same pointers as the ones that are kept, so
+ * @free_func should be %NULL.
+ *
+ * Returns: the list with the distinct elements. Note that the start of the
+ * list may have changed.
+ */
+GList*
+gx_list_uniq_in_place (GList *list, GHashFunc hash_func, GEqualFunc equal_func,
+                       GDestroyNotify free_func)
+{
+  return list_uniq (list, hash_func, equal_func, TRUE, free_func);
+}
+
+
+static GList*
+list_intersect (GList *list1, GList *list2, GHashFunc hash_func,
+                GEqualFunc equal_func, gboolean in_place,
+                GDestroyNotify free_func)
+{
+  SetResult  res;
+  HashSet    set;
+  GList     *next;
+
+  set_result_init (&res, in_place, free_func);
+  hash_set_init (&set, g_list_length (list2), hash_func, equal_func);
+  hash_set_add_list (&set, list2, SLOT_OTHER);
+
+  for (; list1; list1 = next)
+    {
+      HashSlot *slot;
+
+      next = list1->next;
+      slot = hash_set_find (&set, list1->data);
+      if (slot->state == SLOT_OTHER)
+        {
+          slot->state = SLOT_SEEN;
+          set_result_keep (&res, list1);
+        }
+      else
+        set_result_drop (&res, list1);
+    }
+
+  hash_set_clear (&set);
+
+  return set_result_finish (&res);
+}
+
+/**
+ * gx_list_intersect:
+ * @list1: a #GList
+ * @list2: another #GList
+ * @hash_func: (allow-none): a function to hash the elements, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the elements for
+ * equality, or %NULL for g_direct_equal()
+ *
+ * Get the distinct elements of @list1 that also occur in @list2, in the
+ * order of their first occurrence in @list1. This takes O(n + m) time,
+ * using a hash set.
+ *
+ * Returns: (transfer full): a list with the intersection of @list1 and
+ * @list2; free with g_list_free().
+ */
+GList*
+gx_list_intersect (GList *list1, GList *list2, GHashFunc hash_func,
+                   GEqualFunc equal_func)
+{
+  return list_intersect (list1, list2, hash_func, equal_func, FALSE, NULL);
+}
+
+/**
+ * gx_list_intersect_in_place:
+ * @list1: a #GList
+ * @list2: another #GList
+ * @hash_func: (allow-none): a function to hash the elements, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the elements for
+ * equality, or %NULL for g_direct_equal()
+ * @free_func: (allow-none): function to free the elements that are removed
+ * from @list1
+ *
+ * Like gx_list_intersect(), but remove the elements that are not in the
+ * intersection from @list1 itself, freeing them with @free_func. @list2 is
+ * not changed.
+ *
+ * Returns: the intersection. Note that the start of the list may have
+ * changed.
+ */
+GList*
+gx_list_intersect_in_place (GList *list1, GList *list2, GHashFunc hash_func,
+                            GEqualFunc equal_func, GDestroyNotify free_func)
+{
+  return list_intersect (list1, list2, hash_func, equal_func, TRUE, free_func);
+}
+
+
+static GList*
+list_union (GList *list1, GList *list2, GHashFunc hash_func,
+            GEqualFunc equal_func, gboolean in_place, GDestroyNotify free_func)
+{
+  SetResult  res;
+  HashSet    set;
+  GList     *lists[2], *next;
+  guint      u;
+
+  set_result_init (&res, in_place, free_func);
+  hash_set_init (&set, g_list_length (list1) + g_list_length (list2),
+                 hash_func, equal_func);
+
+  lists[0] = list1;
+  lists[1] = list2;
+
+  for (u = 0; u != G_N_ELEMENTS (lists); ++u)
+    for (; lists[u]; lists[u] = next)
+      {
+        HashSlot *slot;
+
+        next = lists[u]->next;
+        slot = hash_set_find (&set, lists[u]->data);
+        if (slot->state == SLOT_EMPTY)
+          {
+            slot->state = SLOT_SEEN;
+            set_result_keep (&res, lists[u]);
+          }
+        else
+          set_result_drop (&res, lists[u]);
+      }
+
+  hash_set_clear (&set);
+
+  return set_result_finish (&res);
+}
+
+/**
+ * gx_list_union:
+ * @list1: a #GList
+ * @list2: another #GList
+ * @hash_func: (allow-none): a function to hash the elements, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the elements for
+ * equality, or %NULL for g_direct_equal()
+ *
+ * Get the distinct elements that occur in @list1 or @list2, in the order of
+ * their first occurrence in @list1 followed by @list2. This takes O(n + m)
+ * time, using a hash set.
+ *
+ * Returns: (transfer full): a list with the union of @list1 and @list2; free
+ * with g_list_free().
+ */
+GList*
+gx_list_union (GList *list1, GList *list2, GHashFunc hash_func,
+               GEqualFunc equal_func)
+{
+  return list_union (list1, list2, hash_func, equal_func, FALSE, NULL);
+}
+
+/**
+ * gx_list_union_in_place:
+ * @list1: a #GList
+ * @list2: (transfer full): another #GList
+ * @hash_func: (allow-none): a function to hash the elements, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the elements for
+ * equality, or %NULL for g_direct_equal()
+ * @free_func: (allow-none): function to free the elements that are removed
+ *
+ * Like gx_list_union(), but build the union from the nodes of @list1 and
+ * @list2, and free the duplicates with @free_func. This takes ownership of
+ * @list2.
+ *
+ * Returns: the union. Note that the start of the list may have changed.
+ */
+GList*
+gx_list_union_in_place (GList *list1, GList *list2, GHashFunc hash_func,
+                        GEqualFunc equal_func, GDestroyNotify free_func)
+{
+  return list_union (list1, list2, hash_func, equal_func, TRUE, free_func);
+}
+
+
+static GList*
+list_difference (GList *list1, GList *list2, GHashFunc hash_func,
+                 GEqualFunc equal_func, gboolean in_place,
+                 GDestroyNotify free_func)
+{
+  SetResult  res;
+  HashSet    set;
+  GList     *next;
+
+  set_result_init (&res, in_place, free_func);
+  hash_set_init (&set, g_list_length (list1) + g_list_length (list2),
+                 hash_func, equal_func);
+  hash_set_add_list (&set, list2, SLOT_OTHER);
+
+  for (; list1; list1 = next)
+    {
+      HashSlot *slot;
+
+      next = list1->next;
+      slot = hash_set_find (&set, list1->data);
+      if (slot->state == SLOT_EMPTY)
+        {
+          slot->state = SLOT_SEEN;
+          set_result_keep (&res, list1);
+        }
+      else
+        set_result_drop (&res, list1);
+    }
+
+  hash_set_clear (&set);
+
+  return set_result_finish (&res);
+}
+
+/**
+ * gx_list_difference:
+ * @list1: a #GList
+ * @list2: another #GList
+ * @hash_func: (allow-none): a function to hash the elements, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the elements for
+ * equality, or %NULL for g_direct_equal()
+ *
+ * Get the distinct elements of @list1 that do not occur in @list2, in the
+ * order of their first occurrence in @list1. This takes O(n + m) time,
+ * using a hash set.
+ *
+ * |[<!-- language="C" -->
+ * GList *nums, *primes, *composites;
+ *
+ * nums       = gx_list_iota (20, 1, 1);
+ * primes     = gx_list_filter (nums, (GXPred)gx_is_prime, NULL);
+ * composites = gx_list_difference (nums, primes, NULL, NULL);
+ * g_assert_cmpuint (g_list_length (composites), ==, 12);
+ *
+ * g_list_free (nums);
+ * g_list_free (primes);
+ * g_list_free (composites);
+ * ]|
+ *
+ * Returns: (transfer full): a list with the difference of @list1 and
+ * @list2; free with g_list_free().
+ */
+GList*
+gx_list_difference (GList *list1, GList *list2, GHashFunc hash_func,
+                    GEqualFunc equal_func)
+{
+  return list_difference (list1, list2, hash_func, equal_func, FALSE, NULL);
+}
+
+/**
+ * gx_list_difference_in_place:
+ * @list1: a #GList
+ * @list2: another #GList
+ * @hash_func: (allow-none): a function to hash the elements, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the elements for
+ * equality, or %NULL for g_direct_equal()
+ * @free_func: (allow-none): function to free the elements that are removed
+ * from @list1
+ *
+ * Like gx_list_difference(), but remove the elements that are not in the
+ * difference from @list1 itself, freeing them with @free_func. @list2 is
+ * not changed.
+ *
+ * Returns: the difference. Note that the start of the list may have changed.
+ */
+GList*
+gx_list_difference_in_place (GList *list1, GList *list2, GHashFunc hash_func,
+                             GEqualFunc equal_func, GDestroyNotify free_func)
+{
+  return list_difference (list1, list2, hash_func, equal_func, TRUE,
+                          free_func);
+}
+
+
+/*
+ * set operations on sorted lists
+ */
+
+/* keep node, unless it is equal to the last node we kept */
+static void
+set_result_keep_distinct (SetResult *res, GList *node, GCompareFunc cmp_func,
+                          gpointer *last, gboolean *have_last)
+{
+  if (*have_last && (*cmp_func) (*last, node->data) == 0)
+    set_result_drop (res, node);
+  else
+    {
+      *last      = node->data;
+      *have_last = TRUE;
+      set_result_keep (res, node);
+    }
+}
+
+static GList*
+list_sorted_uniq (GList *list, GCompareFunc cmp_func, gboolean in_place,
+                  GDestroyNotify free_func)
+{
+  SetResult res;
+  GList    *next;
+  gpointer  last;
+  gboolean  have_last;
+
+  set_result_init (&res, in_place, free_func);
+
+  for (last = NULL, have_last = FALSE; list; list = next)
+    {
+      next = list->next;
+      set_result_keep_distinct (&res, list, cmp_func, &last, &have_last);
+    }
+
+  return set_result_finish (&res);
+}
+
+/**
+ * gx_list_sorted_uniq:
+ * @list: a #GList, sorted with @cmp_func
+ * @cmp_func: the function @list is sorted with
+ *
+ * Like gx_list_uniq(), but for a sorted list; this needs no hash set, and
+ * the result is sorted as well.
+ *
+ * Returns: (transfer full): a list with the distinct elements of @list; free
+ * with g_list_free().
+ */
+GList*
+gx_list_sorted_uniq (GList *list, GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sorted_uniq (list, cmp_func, FALSE, NULL);
+}
+
+/**
+ * gx_list_sorted_uniq_in_place:
+ * @list: a #GList, sorted with @cmp_func
+ * @cmp_func: the function @list is sorted with
+ * @free_func: (allow-none): function to free the elements that are removed
+ *
+ * Like gx_list_sorted_uniq(), but remove the duplicate elements from @list
+ * itself, freeing them with @free_func.
+ *
+ * Returns: the list with the distinct elements.
+ */
+GList*
+gx_list_sorted_uniq_in_place (GList *list, GCompareFunc cmp_func,
+                              GDestroyNotify free_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sorted_uniq (list, cmp_func, TRUE, free_func);
+}
+
+
+static GList*
+list_sorted_intersect (GList *list1, GList *list2, GCompareFunc cmp_func,
+                       gboolean in_place, GDestroyNotify free_func)
+{
+  SetResult res;
+  GList    *next;
+  gpointer  last;
+  gboolean  have_last;
+
+  set_result_init (&res, in_place, free_func);
+
+  for (last = NULL, have_last = FALSE; list1 && list2;)
+    {
+      gint cmp;
+
+      cmp = (*cmp_func) (list1->data, list2->data);
+      if (cmp > 0)
+        {
+          list2 = list2->next;
+          continue;
+        }
+
+      next = list1->next;
+      if (cmp < 0)
+        set_result_drop (&res, list1);
+      else
+        set_result_keep_distinct (&res, list1, cmp_func, &last, &have_last);
+      list1 = next;
+    }
+
+  set_result_drop_all (&res, list1);
+
+  return set_result_finish (&res);
+}
+
+/**
+ * gx_list_sorted_intersect:
+ * @list1: a #GList, sorted with @cmp_func
+ * @list2: another #GList, sorted with @cmp_func
+ * @cmp_func: the function the lists are sorted with
+ *
+ * Like gx_list_intersect(), but for sorted lists; this merges the lists
+ * rather than using a hash set, and the result is sorted as well.
+ *
+ * Returns: (transfer full): a list with the intersection of @list1 and
+ * @list2; free with g_list_free().
+ */
+GList*
+gx_list_sorted_intersect (GList *list1, GList *list2, GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sorted_intersect (list1, list2, cmp_func, FALSE, NULL);
+}
+
+/**
+ * gx_list_sorted_intersect_in_place:
+ * @list1: a #GList, sorted with @cmp_func
+ * @list2: another #GList, sorted with @cmp_func
+ * @cmp_func: the function the lists are sorted with
+ * @free_func: (allow-none): function to free the elements that are removed
+ * from @list1
+ *
+ * Like gx_list_sorted_intersect(), but remove the elements that are not in
+ * the intersection from @list1 itself, freeing them with @free_func. @list2
+ * is not changed.
+ *
+ * Returns: the intersection.
+ */
+GList*
+gx_list_sorted_intersect_in_place (GList *list1, GList *list2,
+                                   GCompareFunc cmp_func,
+                                   GDestroyNotify free_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sorted_intersect (list1, list2, cmp_func, TRUE, free_func);
+}
+
+
+static GList*
+list_sorted_union (GList *list1, GList *list2, GCompareFunc cmp_func,
+                   gboolean in_place, GDestroyNotify free_func)
+{
+  SetResult res;
+  GList    *next;
+  gpointer  last;
+  gboolean  have_last;
+
+  set_result_init (&res, in_place, free_func);
+
+  for (last = NULL, have_last = FALSE; list1 || list2;)
+    {
+      GList **cur;
+
+      /* on ties, take the element of list1 first */
+      if (!list2 || (list1 && (*cmp_func) (list1->data, list2->data) <= 0))
+        cur = &list1;
+      else
+        cur = &list2;
+
+      next = (*cur)->next;
+      set_result_keep_distinct (&res, *cur, cmp_func, &last, &have_last);
+      *cur = next;
+    }
+
+  return set_result_finish (&res);
+}
+
+/**
+ * gx_list_sorted_union:
+ * @list1: a #GList, sorted with @cmp_func
+ * @list2: another #GList, sorted with @cmp_func
+ * @cmp_func: the function the lists are sorted with
+ *
+ * Like gx_list_union(), but for sorted lists; this merges the lists rather
+ * than using a hash set, and the result is sorted as well.
+ *
+ * |[<!-- language="C" -->
+ * GList *odd, *threes, *merged;
+ *
+ * odd    = gx_list_iota (5, 1, 2); // 1, 3, 5, 7, 9
+ * threes = gx_list_iota (3, 3, 3); // 3, 6, 9
+ * merged = gx_list_sorted_union (odd, threes, (GCompareFunc)gx_cmp_int);
+ * g_assert_cmpint (gx_list_sum (merged), ==, 1 + 3 + 5 + 6 + 7 + 9);
+ *
+ * g_list_free (odd);
+ * g_list_free (threes);
+ * g_list_free (merged);
+ * ]|
+ *
+ * Returns: (transfer full): a list with the union of @list1 and @list2; free
+ * with g_list_free().
+ */
+GList*
+gx_list_sorted_union (GList *list1, GList *list2, GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sorted_union (list1, list2, cmp_func, FALSE, NULL);
+}
+
+/**
+ * gx_list_sorted_union_in_place:
+ * @list1: a #GList, sorted with @cmp_func
+ * @list2: (transfer full): another #GList, sorted with @cmp_func
+ * @cmp_func: the function the lists are sorted with
+ * @free_func: (allow-none): function to free the elements that are removed
+ *
+ * Like gx_list_sorted_union(), but merge the nodes of @list1 and @list2, and
+ * free the duplicates with @free_func. This takes ownership of @list2.
+ *
+ * Returns: the union.
+ */
+GList*
+gx_list_sorted_union_in_place (GList *list1, GList *list2,
+                               GCompareFunc cmp_func, GDestroyNotify free_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sorted_union (list1, list2, cmp_func, TRUE, free_func);
+}
+
+
+static GList*
+list_sorted_difference (GList *list1, GList *list2, GCompareFunc cmp_func,
+                        gboolean in_place, GDestroyNotify free_func)
+{
+  SetResult res;
+  GList    *next;
+  gpointer  last;
+  gboolean  have_last;
+
+  set_result_init (&res, in_place, free_func);
+
+  for (last = NULL, have_last = FALSE; list1;)
+    {
+      gint cmp;
+
+      cmp = list2 ? (*cmp_func) (list1->data, list2->data) : -1;
+      if (cmp > 0)
+        {
+          list2 = list2->next;
+          continue;
+        }
+
+      next = list1->next;
+      if (cmp < 0)
+        set_result_keep_distinct (&res, list1, cmp_func, &last, &have_last);
+      else
+        set_result_drop (&res, list1);
+      list1 = next;
+    }
+
+  return set_result_finish (&res);
+}
+
+/**
+ * gx_list_sorted_difference:
+ * @list1: a #GList, sorted with @cmp_func
+ * @list2: another #GList, sorted with @cmp_func
+ * @cmp_func: the function the lists are sorted with
+ *
+ * Like gx_list_difference(), but for sorted lists; this merges the lists
+ * rather than using a hash set, and the result is sorted as well.
+ *
+ * Returns: (transfer full): a list with the difference of @list1 and
+ * @list2; free with g_list_free().
+ */
+GList*
+gx_list_sorted_difference (GList *list1, GList *list2, GCompareFunc cmp_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sorted_difference (list1, list2, cmp_func, FALSE, NULL);
+}
+
+/**
+ * gx_list_sorted_difference_in_place:
+ * @list1: a #GList, sorted with @cmp_func
+ * @list2: another #GList, sorted with @cmp_func
+ * @cmp_func: the function the lists are sorted with
+ * @free_func: (allow-none): function to free the elements that are removed
+ * from @list1
+ *
+ * Like gx_list_sorted_difference(), but remove the elements that are not in
+ * the difference from @list1 itself, freeing them with @free_func. @list2
+ * is not changed.
+ *
+ * Returns: the difference.
+ */
+GList*
+gx_list_sorted_difference_in_place (GList *list1, GList *list2,
+                                    GCompareFunc cmp_func,
+                                    GDestroyNotify free_func)
+{
+  g_return_val_if_fail (cmp_func, NULL);
+
+  return list_sorted_difference (list1, list2, cmp_func, TRUE, free_func);
+}
+
+
+/*
+ * joins and grouping
+ */
+
+/* an element of one of the lists being joined; for the build side, the
+ * elements with the same key are chained in list order through 'next', and
+ * the first of them also knows the last, for appending */
+typedef struct {
+  gpointer data;
+  gpointer key;
+  guint    hash;
+  gsize    next; /* index + 1 of the next element with this key, or 0 */
+  gsize    last; /* index + 1 of the last element with this key */
+} JoinEntry;
+
+static void
+join_entry_init (JoinEntry *entry, gpointer data, GXBinaryFunc key_func,
+                 GHashFunc hash_func, gpointer user_data)
+{
+  entry->data = data;
+  entry->key  = key_func ? (*key_func) (data, user_data) : data;
+  entry->hash = (*hash_func) (entry->key);
+  entry->next = entry->last = 0;
+}
+
+static void
+join_probe (HashSet *set, JoinEntry *build, JoinEntry *entry,
+            gboolean build_is_first, GXTernaryFunc join_func,
+            gpointer user_data, GXListBuilder *builder)
+{
+  HashSlot *slot;
+  gsize     i;
+
+  slot = hash_set_probe (set, entry->key, entry->hash);
+  if (slot->state != SLOT_SEEN)
+    return;
+
+  for (i = GPOINTER_TO_SIZE (slot->value); i != 0; i = build[i - 1].next)
+    {
+      gpointer joined;
+
+      if (build_is_first)
+        joined = (*join_func) (build[i - 1].data, entry->data, user_data);
+      else
+        joined = (*join_func) (entry->data, build[i - 1].data, user_data);
+
+      gx_list_builder_append (builder, joined);
+    }
+}
+
+/**
+ * gx_list_join_by_key:
+ * @list1: a #GList
+ * @list2: another #GList
+ * @key_func1: (allow-none): a function to get the key of an element of
+ * @list1, or %NULL to use the element itself
+ * @key_func2: (allow-none): a function to get the key of an element of
+ * @list2, or %NULL to use the element itself
+ * @hash_func: (allow-none): a function to hash the keys, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the keys for equality, or
+ * %NULL for g_direct_equal()
+ * @key_free_func: (allow-none): a function to free the keys, or %NULL if
+ * @key_func1 and @key_func2 do not allocate them
+ * @join_func: a function to combine an element of @list1 with an element of
+ * @list2 that has the same key
+ * @user_data: (allow-none): a user pointer passed to the key functions and to
+ * @join_func
+ *
+ * Get the inner join of @list1 and @list2: for each pair of elements (e1, e2)
+ * from @list1 and @list2 with equal keys, the result has an element
+ * @join_func (e1, e2, @user_data).
+ *
+ * This is a hash join: it builds an exactly-sized hash table on the shorter
+ * of the two lists, and probes it with the elements of the longer one,
+ * walking each list only once; so it takes O(n1 + n2 + m) time for a result
+ * of m elements. The result follows the order of the longer list (@list1 if
+ * the lengths are equal), and, for each of its elements, the order of the
+ * matching elements of the shorter list.
+ *
+ * The keys of both lists are freed with @key_free_func (if not %NULL) once
+ * they are no longer needed; the keys of the longer list right after their
+ * lookup.
+ *
+ * |[<!-- language="C" -->
+ * GList *list1, *list2, *joined;
+ *
+ * list1  = gx_strv_to_list ((gchar*[]){ "a", "b", "c", "b", NULL }, -1);
+ * list2  = gx_strv_to_list ((gchar*[]){ "b", "c", "d", NULL }, -1);
+ * joined = gx_list_join_by_key (list1, list2, NULL, NULL,
+ *                               g_str_hash, g_str_equal, NULL,
+ *                               (GXTernaryFunc)gx_str_chain, "=");
+ * // "b=b", "c=c", "b=b"
+ * g_assert_cmpuint (g_list_length (joined), ==, 3);
+ * g_assert_cmpstr (joined->next->data, ==, "c=c");
+ *
+ * g_list_free (list1);
+ * g_list_free (list2);
+ * g_list_free_full (joined, g_free);
+ * ]|
+ *
+ * Returns: (transfer full): a list with the joined elements; free with
+ * g_list_free() (or g_list_free_full(), if @join_func allocates).
+ */
+GList*
+gx_list_join_by_key (GList *list1, GList *list2,
+                     GXBinaryFunc key_func1, GXBinaryFunc key_func2,
+                     GHashFunc hash_func, GEqualFunc equal_func,
+                     GDestroyNotify key_free_func,
+                     GXTernaryFunc join_func, gpointer user_data)
+{
+  GXListBuilder  builder;
+  HashSet        set;
+  JoinEntry     *entries1, *entries2, *build, *probe;
+  GList         *rest;
+  GXBinaryFunc   probe_key_func;
+  gsize          n, size, u;
+  gboolean       build_is_first;
+
+  g_return_val_if_fail (join_func, NULL);
+
+  if (!list1 || !list2)
+    return NULL;
+
+  hash_func = hash_func ? hash_func : g_direct_hash;
+
+  /* walk both lists in lock-step until the shorter one ends; then we have
+   * all of that one, and the same number of elements of the other one */
+  size     = 64;
+  entries1 = g_new (JoinEntry, size);
+  entries2 = g_new (JoinEntry, size);
+
+  for (n = 0; list1 && list2; ++n, list1 = list1->next, list2 = list2->next)
+    {
+      if (n == size)
+        {
+          size    *= 2;
+          entries1 = g_renew (JoinEntry, entries1, size);
+          entries2 = g_renew (JoinEntry, entries2, size);
+        }
+
+      join_entry_init (&entries1[n], list1->data, key_func1, hash_func,
+                       user_data);
+      join_entry_init (&entries2[n], list2->data, key_func2, hash_func,
+                       user_data);
+    }
+
+  build_is_first = list2 != NULL;
+  if (build_is_first)
+    {
+      build          = entries1;
+      probe          = entries2;
+      rest           = list2;
+      probe_key_func = key_func2;
+    }
+  else
+    {
+      build          = entries2;
+      probe          = entries1;
+      rest           = list1;
+      probe_key_func = key_func1;
+    }
+
+  hash_set_init (&set, n, hash_func, equal_func);
+
+  for (u = 0; u != n; ++u)
+    {
+      HashSlot *slot;
+
+      slot = hash_set_probe (&set, build[u].key, build[u].hash);
+      if (slot->state == SLOT_EMPTY)
+        {
+          slot->state = SLOT_SEEN;
+          slot->value = GSIZE_TO_POINTER (u + 1);
+        }
+      else
+        build[build[GPOINTER_TO_SIZE (slot->value) - 1].last - 1].next = u + 1;
+
+      build[GPOINTER_TO_SIZE (slot->value) - 1].last = u + 1;
+    }
+
+  gx_list_builder_init (&builder);
+
+  for (u = 0; u != n; ++u)
+    {
+      join_probe (&set, build, &probe[u], build_is_first, join_func,
+                  user_data, &builder);
+      if (key_free_func)
+        (*key_free_func) (probe[u].key);
+    }
+
+  for (; rest; rest = rest->next)
+    {
+      JoinEntry entry;
+
+      join_entry_init (&entry, rest->data, probe_key_func, hash_func,
+                       user_data);
+      join_probe (&set, build, &entry, build_is_first, join_func,
+                  user_data, &builder);
+      if (key_free_func)
+        (*key_free_func) (entry.key);
+    }
+
+  hash_set_clear (&set);
+
+  if (key_free_func)
+    for (u = 0; u != n; ++u)
+      (*key_free_func) (build[u].key);
+
+  g_free (entries1);
+  g_free (entries2);
+
+  return builder.head;
+}
+
+
+/**
+ * gx_list_group_by:
+ * @list: a #GList
+ * @key_func: (allow-none): a function to get the key of an element, or %NULL
+ * to use the element itself
+ * @hash_func: (allow-none): a function to hash the keys, or %NULL for
+ * g_direct_hash()
+ * @equal_func: (allow-none): a function to compare the keys for equality, or
+ * %NULL for g_direct_equal()
+ * @key_free_func: (allow-none): a function to free the keys, or %NULL if
+ * @key_func does not allocate them
+ * @fold_func: (allow-none): a ternary function to fold the elements of each
+ * group, or %NULL to collect them in a list
+ * @init: the start value for each group
+ * @user_data: (allow-none): a user pointer passed to @key_func and
+ * @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Group the elements of @list by their key, and fold the elements of each
+ * group as gx_list_fold() would, in list order. That is, for a group with
+ * elements (a, b, c), the value is
+ *      fold_func (fold_func (fold_func (@init, a), b), c)
+ *
+ * Like in gx_list_fold(), the intermediate values are freed with @free_func,
+ * but @init is never freed. If @fold_func is %NULL, the value for each group
+ * is a #GList with its elements instead.
+ *
+ * This walks @list only once, with a single hash table lookup per element;
+ * each group is then inserted into the result table once. The first key of
+ * each group is kept for the table, and the keys of the other elements are
+ * freed with @key_free_func.
+ *
+ * |[<!-- language="C" -->
+ * GList *words;
+ * GHashTable *groups;
+ * GList *bs;
+ *
+ * words  = gx_strv_to_list ((gchar*[]){ "a", "b", "c", "b", NULL }, -1);
+ * groups = gx_list_group_by (words, NULL, g_str_hash, g_str_equal, NULL,
+ *                            NULL, NULL, NULL, NULL);
+ * g_assert_cmpuint (g_hash_table_size (groups), ==, 3);
+ *
+ * bs = g_hash_table_lookup (groups, "b");
+ * g_assert_cmpuint (g_list_length (bs), ==, 2);
+ *
+ * g_hash_table_destroy (groups);
+ * g_list_free (words);
+ * ]|
+ *
+ * Returns: (transfer full): a #GHashTable of keys to values; when destroyed,
+ * it frees the keys with @key_free_func, and the values with @free_func (or,
+ * without @fold_func, with g_list_free()).
+ */
+GHashTable*
+gx_list_group_by (GList *list, GXBinaryFunc key_func, GHashFunc hash_func,
+                  GEqualFunc equal_func, GDestroyNotify key_free_func,
+                  GXTernaryFunc fold_func, gpointer init, gpointer user_data,
+                  GDestroyNotify free_func)
+{
+  GHashTable *table;
+  HashSet     set;
+  gsize       u;
+
+  /* we cannot know the number of groups beforehand; start with room for a
+   * few, and grow as needed */
+  hash_set_init (&set, 32, hash_func, equal_func);
+
+  for (; list; list = list->next)
+    {
+      HashSlot *slot;
+      gpointer  key, val;
+      gboolean  is_new;
+
+      key  = key_func ? (*key_func) (list->data, user_data) : list->data;
+      slot = hash_set_insert (&set, key, &is_new);
+
+      if (!is_new && key_free_func)
+        (*key_free_func) (key);
+
+      if (!fold_func)
+        slot->value = g_list_prepend (slot->value, list->data);
+      else if (is_new)
+        slot->value = (*fold_func) (init, list->data, user_data);
+      else
+        {
+          val         = slot->value;
+          slot->value = (*fold_func) (val, list->data, user_data);
+          if (free_func)
+            (*free_func) (val);
+        }
+    }
+
+  table = g_hash_table_new_full (set.hash_func, set.equal_func,
+                                 key_free_func,
+                                 fold_func ? free_func :
+                                 (GDestroyNotify)g_list_free);
+
+  for (u = 0; u != (gsize)1 << set.bits; ++u)
+    {
+      HashSlot *slot;
+
+      slot = &set.slots[u];
+      if (slot->state != SLOT_SEEN)
+        continue;
+
+      g_hash_table_insert (table, slot->key,
+                           fold_func ? slot->value :
+                           g_list_reverse (slot->value));
+    }
+
+  hash_set_clear (&set);
+
+  return table;
+}
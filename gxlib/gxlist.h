@@ -25,6 +25,19 @@
 
 G_BEGIN_DECLS
 
+/**
+ * GXScanMode:
+ * @GX_SCAN_INCLUSIVE: each value includes the element at its position
+ * @GX_SCAN_EXCLUSIVE: each value covers only the elements before its
+ * position, so the first value is the start value
+ *
+ * The kind of prefix scan for gx_list_scan().
+ */
+typedef enum {
+  GX_SCAN_INCLUSIVE,
+  GX_SCAN_EXCLUSIVE
+} GXScanMode;
+
 GList *gx_list_filter (GList *list, GXPred pred_func, gpointer user_data)
   G_GNUC_WARN_UNUSED_RESULT;
 
@@ -35,6 +48,15 @@ GList *gx_list_filter_in_place (GList *list, GXPred pred_func,
                                 gpointer user_data, GDestroyNotify free_func)
   G_GNUC_WARN_UNUSED_RESULT;
 
+GList *gx_list_partition (GList *list, GXPred pred_func, gpointer user_data,
+                          GList **rejected)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GList *gx_list_partition_in_place (GList *list, GXPred pred_func,
+                                   gpointer user_data, GList **rejected,
+                                   GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
 GList *gx_list_take (GList *list, gsize n)
   G_GNUC_WARN_UNUSED_RESULT;
 
@@ -56,12 +78,90 @@ gpointer gx_list_fold (GList *list, GXTernaryFunc fold_func, gpointer init,
                        gpointer user_data, GDestroyNotify free_func)
   G_GNUC_WARN_UNUSED_RESULT;
 
+GList *gx_list_scan (GList *list, GXTernaryFunc fold_func, gpointer init,
+                     gpointer user_data, GXScanMode mode)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_windowed_fold (GList *list, gsize window,
+                              GXTernaryFunc fold_func, gpointer init,
+                              gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sliding_min (GList *list, gsize window, GCompareFunc cmp_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sliding_max (GList *list, gsize window, GCompareFunc cmp_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
 GList *gx_list_iota (gsize count, gint start, gsize step)
    G_GNUC_WARN_UNUSED_RESULT;
 
 gint gx_list_sum (GList *list);
 gint gx_list_product (GList *list);
 
+GList *gx_list_uniq (GList *list, GHashFunc hash_func, GEqualFunc equal_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_uniq_in_place (GList *list, GHashFunc hash_func,
+                              GEqualFunc equal_func, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_intersect (GList *list1, GList *list2, GHashFunc hash_func,
+                          GEqualFunc equal_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_intersect_in_place (GList *list1, GList *list2,
+                                   GHashFunc hash_func, GEqualFunc equal_func,
+                                   GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_union (GList *list1, GList *list2, GHashFunc hash_func,
+                      GEqualFunc equal_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_union_in_place (GList *list1, GList *list2,
+                               GHashFunc hash_func, GEqualFunc equal_func,
+                               GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_difference (GList *list1, GList *list2, GHashFunc hash_func,
+                           GEqualFunc equal_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_difference_in_place (GList *list1, GList *list2,
+                                    GHashFunc hash_func, GEqualFunc equal_func,
+                                    GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GList *gx_list_sorted_uniq (GList *list, GCompareFunc cmp_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sorted_uniq_in_place (GList *list, GCompareFunc cmp_func,
+                                     GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sorted_intersect (GList *list1, GList *list2,
+                                 GCompareFunc cmp_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sorted_intersect_in_place (GList *list1, GList *list2,
+                                          GCompareFunc cmp_func,
+                                          GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sorted_union (GList *list1, GList *list2,
+                             GCompareFunc cmp_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sorted_union_in_place (GList *list1, GList *list2,
+                                      GCompareFunc cmp_func,
+                                      GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sorted_difference (GList *list1, GList *list2,
+                                  GCompareFunc cmp_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_list_sorted_difference_in_place (GList *list1, GList *list2,
+                                           GCompareFunc cmp_func,
+                                           GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GList *gx_list_join_by_key (GList *list1, GList *list2,
+                            GXBinaryFunc key_func1, GXBinaryFunc key_func2,
+                            GHashFunc hash_func, GEqualFunc equal_func,
+                            GDestroyNotify key_free_func,
+                            GXTernaryFunc join_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GHashTable *gx_list_group_by (GList *list, GXBinaryFunc key_func,
+                              GHashFunc hash_func, GEqualFunc equal_func,
+                              GDestroyNotify key_free_func,
+                              GXTernaryFunc fold_func, gpointer init,
+                              gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
 
 G_END_DECLS
 
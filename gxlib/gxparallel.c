@@ -0,0 +1,530 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxparallel.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxparallel
+ * @title: Parallel list operations
+ * @short_description: map, filter and fold a #GList using multiple threads
+ *
+ * When the functions passed to gx_list_map(), gx_list_filter() or
+ * gx_list_fold() are expensive, it can pay off to spread the work over
+ * multiple processors. The gx_list_par_ functions split the list into chunks,
+ * and process those on a #GThreadPool. The results are the same, and in the
+ * same order, as for their serial counterparts.
+ *
+ * The @n_threads parameter sets the maximum number of worker threads; if it is
+ * <= 0, the number of available processors is used.
+ *
+ * The functions passed as @map_func, @pred_func or @fold_func are called from
+ * the worker threads, so they must be thread-safe. The @free_func for elements
+ * that are replaced or removed on the other hand is only ever called from the
+ * calling thread.
+ *
+ * |[<!-- language="C" -->
+ * GList *nums, *primes;
+ *
+ * nums   = gx_list_iota (1000 * 1000, 1, 1);
+ * primes = gx_list_par_filter (nums, (GXPred)gx_is_prime, NULL, -1);
+ *
+ * g_assert_cmpuint (g_list_length (primes), ==, 78498);
+ *
+ * g_list_free (nums);
+ * g_list_free (primes);
+ * ]|
+ */
+
+/* the number of chunks per thread; more than one, so a thread that happens to
+ * get easy elements does not sit idle while the others finish */
+#define CHUNKS_PER_THREAD 4
+
+G_GNUC_INTERNAL guint
+gx_get_n_threads (gint n_threads)
+{
+  return n_threads > 0 ? (guint)n_threads : MAX (1, g_get_num_processors ());
+}
+
+
+typedef struct {
+  GXJobFunc job_func;
+  gpointer  user_data;
+} JobRunner;
+
+static void
+run_job (gpointer job, JobRunner *runner)
+{
+  /* the pool does not accept NULL as data, so the jobs are off-by-one */
+  (*runner->job_func) (GPOINTER_TO_SIZE (job) - 1, runner->user_data);
+}
+
+G_GNUC_INTERNAL void
+gx_run_jobs (gsize n_jobs, gint n_threads, GXJobFunc job_func,
+             gpointer user_data)
+{
+  GThreadPool *pool;
+  JobRunner    runner;
+  GError      *err;
+  guint        threads;
+  gsize        job;
+
+  threads = gx_get_n_threads (n_threads);
+
+  if (n_jobs <= 1 || threads == 1)
+    {
+      for (job = 0; job != n_jobs; ++job)
+        (*job_func) (job, user_data);
+      return;
+    }
+
+  runner.job_func  = job_func;
+  runner.user_data = user_data;
+
+  err  = NULL;
+  pool = g_thread_pool_new ((GFunc)run_job, &runner,
+                            (gint)MIN (threads, n_jobs), FALSE, &err);
+  if (!pool)
+    {
+      /* can't get threads; do the work ourselves */
+      g_warning ("failed to create thread pool: %s",
+                 err ? err->message : "something went wrong");
+      g_clear_error (&err);
+      for (job = 0; job != n_jobs; ++job)
+        (*job_func) (job, user_data);
+      return;
+    }
+
+  for (job = 0; job != n_jobs; ++job)
+    g_thread_pool_push (pool, GSIZE_TO_POINTER (job + 1), NULL);
+
+  /* wait until all jobs are done */
+  g_thread_pool_free (pool, FALSE, TRUE);
+}
+
+
+
+typedef struct {
+  GList         **nodes;
+  gsize           n;
+  gsize           chunk_size;
+  gpointer        func;
+  gpointer        user_data;
+  gpointer       *results;
+  gboolean       *keep;
+  gpointer        init;
+  GDestroyNotify  free_func;
+} ParContext;
+
+
+static GList**
+list_to_nodes (GList *list, gsize *n)
+{
+  GList **nodes;
+  gsize   u;
+
+  *n    = g_list_length (list);
+  nodes = g_new (GList*, *n);
+
+  for (u = 0; list; list = list->next, ++u)
+    nodes[u] = list;
+
+  return nodes;
+}
+
+
+static gsize
+par_context_init (ParContext *ctx, GList *list, gpointer func,
+                  gpointer user_data, gint n_threads)
+{
+  gsize n_chunks;
+
+  ctx->nodes     = list_to_nodes (list, &ctx->n);
+  ctx->func      = func;
+  ctx->user_data = user_data;
+  ctx->results   = NULL;
+  ctx->keep      = NULL;
+  ctx->init      = NULL;
+  ctx->free_func = NULL;
+
+  if (ctx->n == 0)
+    {
+      ctx->chunk_size = 0;
+      return 0;
+    }
+
+  n_chunks        = gx_get_n_threads (n_threads) * CHUNKS_PER_THREAD;
+  ctx->chunk_size = (ctx->n + n_chunks - 1) / n_chunks;
+
+  /* the last chunks may be empty; don't count those */
+  return (ctx->n + ctx->chunk_size - 1) / ctx->chunk_size;
+}
+
+static void
+chunk_range (ParContext *ctx, gsize chunk, gsize *start, gsize *end)
+{
+  *start = chunk * ctx->chunk_size;
+  *end   = MIN (*start + ctx->chunk_size, ctx->n);
+}
+
+
+static GList*
+list_from_array (gpointer *items, gsize n)
+{
+  GXListBuilder lst;
+  gsize         u;
+
+  gx_list_builder_init (&lst);
+  for (u = 0; u != n; ++u)
+    gx_list_builder_append (&lst, items[u]);
+
+  return lst.head;
+}
+
+
+
+static void
+map_chunk (gsize chunk, ParContext *ctx)
+{
+  GXBinaryFunc map_func;
+  gsize        u, end;
+
+  map_func = (GXBinaryFunc)ctx->func;
+  for (chunk_range (ctx, chunk, &u, &end); u != end; ++u)
+    ctx->results[u] = (*map_func) (ctx->nodes[u]->data, ctx->user_data);
+}
+
+static void
+par_map (ParContext *ctx, GList *list, GXBinaryFunc map_func,
+         gpointer user_data, gint n_threads)
+{
+  gsize n_chunks;
+
+  n_chunks     = par_context_init (ctx, list, map_func, user_data, n_threads);
+  ctx->results = g_new (gpointer, ctx->n);
+
+  gx_run_jobs (n_chunks, n_threads, (GXJobFunc)map_chunk, ctx);
+}
+
+
+/**
+ * gx_list_par_map:
+ * @list: a #GList
+ * @map_func: a thread-safe mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ * @n_threads: the maximum number of threads to use, or <= 0 to use the number
+ * of processors
+ *
+ * Like gx_list_map(), but call @map_func from multiple threads in parallel.
+ *
+ * Returns: (transfer full): the list with mapped values. Whether to free with
+ * g_list_free() or with g_list_free_full() depends on @map_func.
+ */
+GList*
+gx_list_par_map (GList *list, GXBinaryFunc map_func, gpointer user_data,
+                 gint n_threads)
+{
+  ParContext ctx;
+  GList     *mapped;
+
+  g_return_val_if_fail (map_func, NULL);
+
+  par_map (&ctx, list, map_func, user_data, n_threads);
+  mapped = list_from_array (ctx.results, ctx.n);
+
+  g_free (ctx.results);
+  g_free (ctx.nodes);
+
+  return mapped;
+}
+
+
+/**
+ * gx_list_par_map_in_place:
+ * @list: a #GList
+ * @map_func: a thread-safe mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ * @free_func: (allow-none): a function to free the replaced elements
+ * @n_threads: the maximum number of threads to use, or <= 0 to use the number
+ * of processors
+ *
+ * Like gx_list_map_in_place(), but call @map_func from multiple threads in
+ * parallel. The old elements are freed with @free_func from the calling
+ * thread, after all of them have been mapped.
+ *
+ * Returns: (transfer full): the list with mapped values.
+ */
+GList*
+gx_list_par_map_in_place (GList *list, GXBinaryFunc map_func,
+                          gpointer user_data, GDestroyNotify free_func,
+                          gint n_threads)
+{
+  ParContext ctx;
+  gsize      u;
+
+  g_return_val_if_fail (map_func, NULL);
+
+  par_map (&ctx, list, map_func, user_data, n_threads);
+
+  for (u = 0; u != ctx.n; ++u)
+    {
+      gpointer old;
+
+      old                = ctx.nodes[u]->data;
+      ctx.nodes[u]->data = ctx.results[u];
+
+      if (free_func)
+        (*free_func) (old);
+    }
+
+  g_free (ctx.results);
+  g_free (ctx.nodes);
+
+  return list;
+}
+
+
+
+static void
+filter_chunk (gsize chunk, ParContext *ctx)
+{
+  GXPred pred_func;
+  gsize  u, end;
+
+  pred_func = (GXPred)ctx->func;
+  for (chunk_range (ctx, chunk, &u, &end); u != end; ++u)
+    ctx->keep[u] = (*pred_func) (ctx->nodes[u]->data, ctx->user_data);
+}
+
+static void
+par_filter (ParContext *ctx, GList *list, GXPred pred_func,
+            gpointer user_data, gint n_threads)
+{
+  gsize n_chunks;
+
+  n_chunks  = par_context_init (ctx, list, pred_func, user_data, n_threads);
+  ctx->keep = g_new (gboolean, ctx->n);
+
+  gx_run_jobs (n_chunks, n_threads, (GXJobFunc)filter_chunk, ctx);
+}
+
+
+/**
+ * gx_list_par_filter:
+ * @list: a #GList
+ * @pred_func: a thread-safe predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @n_threads: the maximum number of threads to use, or <= 0 to use the number
+ * of processors
+ *
+ * Like gx_list_filter(), but call @pred_func from multiple threads in
+ * parallel.
+ *
+ * Returns: (transfer full): the filtered list; free with g_list_free().
+ */
+GList*
+gx_list_par_filter (GList *list, GXPred pred_func, gpointer user_data,
+                    gint n_threads)
+{
+  ParContext    ctx;
+  GXListBuilder filtered;
+  gsize         u;
+
+  g_return_val_if_fail (pred_func, NULL);
+
+  par_filter (&ctx, list, pred_func, user_data, n_threads);
+
+  gx_list_builder_init (&filtered);
+  for (u = 0; u != ctx.n; ++u)
+    if (ctx.keep[u])
+      gx_list_builder_append (&filtered, ctx.nodes[u]->data);
+
+  g_free (ctx.keep);
+  g_free (ctx.nodes);
+
+  return filtered.head;
+}
+
+
+/**
+ * gx_list_par_filter_in_place:
+ * @list: a #GList
+ * @pred_func: a thread-safe predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @free_func: (allow-none): function to free elements that are filtered-out
+ * @n_threads: the maximum number of threads to use, or <= 0 to use the number
+ * of processors
+ *
+ * Like gx_list_filter_in_place(), but call @pred_func from multiple threads
+ * in parallel. The removed elements are freed with @free_func from the calling
+ * thread, after all of them have been tested.
+ *
+ * Returns: the filtered list, consisting of the remaining elements of
+ * @list. Note that the start of the list may have changed.
+ */
+GList*
+gx_list_par_filter_in_place (GList *list, GXPred pred_func, gpointer user_data,
+                             GDestroyNotify free_func, gint n_threads)
+{
+  ParContext      ctx;
+  GList          *last;
+  GXListMagazine *mag;
+  gsize           u;
+
+  g_return_val_if_fail (pred_func, NULL);
+
+  par_filter (&ctx, list, pred_func, user_data, n_threads);
+  mag = gx_list_magazine_get ();
+
+  /* relink the nodes we keep; free the others */
+  for (list = last = NULL, u = 0; u != ctx.n; ++u)
+    {
+      GList *node;
+
+      node = ctx.nodes[u];
+      if (!ctx.keep[u])
+        {
+          if (free_func)
+            (*free_func) (node->data);
+          gx_list_node_free (mag, node);
+          continue;
+        }
+
+      node->prev = last;
+      node->next = NULL;
+      if (last)
+        last->next = node;
+      else
+        list = node;
+      last = node;
+    }
+
+  g_free (ctx.keep);
+  g_free (ctx.nodes);
+
+  return list;
+}
+
+
+
+static void
+fold_chunk (gsize chunk, ParContext *ctx)
+{
+  GXTernaryFunc fold_func;
+  gpointer      result, first;
+  gsize         u, end;
+
+  fold_func = (GXTernaryFunc)ctx->func;
+
+  chunk_range (ctx, chunk, &u, &end);
+  for (result = NULL, first = ctx->init; u != end; ++u)
+    {
+      gpointer tmp;
+
+      tmp = (*fold_func) (first, ctx->nodes[u]->data, ctx->user_data);
+      if (ctx->free_func)
+        (*ctx->free_func) (result);
+
+      result = tmp;
+      first  = result;
+    }
+
+  ctx->results[chunk] = result;
+}
+
+
+/**
+ * gx_list_par_fold:
+ * @list: a #GList
+ * @fold_func: a thread-safe, associative ternary function
+ * @init: the start value; this must be an identity value for @fold_func
+ * @combine_func: (allow-none): a function to combine the results of two
+ * chunks, or %NULL to use @fold_func
+ * @user_data: (allow-none): a user pointer passed to @fold_func and
+ * @combine_func
+ * @free_func: (allow-none): a thread-safe function to free the intermediate
+ * values
+ * @n_threads: the maximum number of threads to use, or <= 0 to use the number
+ * of processors
+ *
+ * Like gx_list_fold(), but split @list into chunks that are folded in
+ * parallel, each starting from @init. The per-chunk results are then combined,
+ * in order, with @combine_func on the calling thread.
+ *
+ * For the result to be the same as that of gx_list_fold(), @fold_func must be
+ * associative, and @init must be its identity value (e.g. 0 for gx_plus(), 1
+ * for gx_times()).
+ *
+ * Each intermediate value is only ever seen by the thread that produced it,
+ * and it is freed with @free_func by that same thread as soon as it is no
+ * longer needed, so the memory use is the same as for gx_list_fold(). This
+ * does mean that, unlike for the other gx_list_par_ functions, @free_func must
+ * be thread-safe, like g_free() is.
+ *
+ * |[<!-- language="C" -->
+ * sum = GPOINTER_TO_INT (gx_list_par_fold (lst, (GXTernaryFunc)gx_plus,
+ *                                          GINT_TO_POINTER(0), NULL,
+ *                                          NULL, NULL, -1));
+ * ]|
+ *
+ * Returns: (transfer full): the computed value.
+ */
+gpointer
+gx_list_par_fold (GList *list, GXTernaryFunc fold_func, gpointer init,
+                  GXTernaryFunc combine_func, gpointer user_data,
+                  GDestroyNotify free_func, gint n_threads)
+{
+  ParContext ctx;
+  gpointer   result;
+  gsize      n_chunks, chunk;
+
+  g_return_val_if_fail (fold_func, NULL);
+
+  if (!list)
+    return NULL;
+
+  if (!combine_func)
+    combine_func = fold_func;
+
+  n_chunks      = par_context_init (&ctx, list, fold_func, user_data, n_threads);
+  ctx.init      = init;
+  ctx.free_func = free_func;
+  ctx.results   = g_new (gpointer, n_chunks);
+
+  gx_run_jobs (n_chunks, n_threads, (GXJobFunc)fold_chunk, &ctx);
+
+  /* combine the per-chunk results, in order */
+  for (result = ctx.results[0], chunk = 1; chunk < n_chunks; ++chunk)
+    {
+      gpointer tmp;
+
+      tmp = (*combine_func) (result, ctx.results[chunk], user_data);
+      if (free_func)
+        {
+          (*free_func) (result);
+          (*free_func) (ctx.results[chunk]);
+        }
+      result = tmp;
+    }
+
+  g_free (ctx.results);
+  g_free (ctx.nodes);
+
+  return result;
+}
@@ -0,0 +1,52 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_PARALLEL_H__
+#define __GX_PARALLEL_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+GList *gx_list_par_map (GList *list, GXBinaryFunc map_func,
+                        gpointer user_data, gint n_threads)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GList *gx_list_par_map_in_place (GList *list, GXBinaryFunc map_func,
+                                 gpointer user_data, GDestroyNotify free_func,
+                                 gint n_threads);
+
+GList *gx_list_par_filter (GList *list, GXPred pred_func, gpointer user_data,
+                           gint n_threads)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GList *gx_list_par_filter_in_place (GList *list, GXPred pred_func,
+                                    gpointer user_data,
+                                    GDestroyNotify free_func, gint n_threads)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gpointer gx_list_par_fold (GList *list, GXTernaryFunc fold_func, gpointer init,
+                           GXTernaryFunc combine_func, gpointer user_data,
+                           GDestroyNotify free_func, gint n_threads)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
+
+#endif /* __GX_PARALLEL_H__ */
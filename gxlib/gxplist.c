@@ -0,0 +1,410 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxplist.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxplist
+ * @title: Persistent lists
+ * @short_description: immutable lists that share their tails
+ *
+ * gx_list_skip() and gx_list_take() copy the part of the list they return,
+ * since a #GList can be changed through any of its nodes. A #GXPList is never
+ * changed after it is created, so lists can safely share nodes: each node
+ * holds a reference to the rest of the list, and stays alive for as long as
+ * any list uses it.
+ *
+ * This makes gx_plist_cons() and gx_plist_skip() cheap, as they never copy
+ * anything, and gx_plist_filter() and gx_plist_map() share the part of the
+ * list after the last element they change. For instance, paging through a
+ * list of results takes time proportional to the size of the page, rather
+ * than to the size of the list:
+ *
+ * |[<!-- language="C" -->
+ * GList   *results;
+ * GXPList *all, *page, *rest;
+ *
+ * results = gx_list_iota (1000, 0, 1);
+ * all     = gx_plist_from_list (results);
+ *
+ * rest = gx_plist_skip (all, 20);   // shares the nodes of all
+ * page = gx_plist_take (rest, 10);  // 20, 21, ..., 29
+ *
+ * g_assert_cmpuint (gx_plist_length (page), ==, 10);
+ * g_assert_cmpint (GPOINTER_TO_INT (gx_plist_head (page)), ==, 20);
+ *
+ * gx_plist_unref (page);
+ * gx_plist_unref (rest);
+ * gx_plist_unref (all);
+ * g_list_free (results);
+ * ]|
+ *
+ * Like a #GList, a #GXPList does not own its elements; it is up to the
+ * application to keep them alive for as long as any list refers to them. The
+ * reference counts are atomic, so lists can be shared between threads.
+ */
+
+struct _GXPList {
+  gint      ref_count;
+  gpointer  data;
+  GXPList  *next;    /* we hold a reference to it */
+};
+
+/* build a new list front-to-back, ending in a (shared) tail */
+typedef struct {
+  GXPList *head;
+  GXPList *last;
+} PListBuilder;
+
+static inline void
+plist_builder_init (PListBuilder *builder)
+{
+  builder->head = builder->last = NULL;
+}
+
+static inline void
+plist_builder_append (PListBuilder *builder, gpointer data)
+{
+  GXPList *node;
+
+  node            = g_slice_new (GXPList);
+  node->ref_count = 1;
+  node->data      = data;
+  node->next      = NULL;
+
+  if (builder->last)
+    builder->last->next = node;
+  else
+    builder->head = node;
+
+  builder->last = node;
+}
+
+/* end the list with tail, taking over the caller's reference */
+static inline GXPList*
+plist_builder_finish (PListBuilder *builder, GXPList *tail)
+{
+  if (!builder->last)
+    return tail;
+
+  builder->last->next = tail;
+
+  return builder->head;
+}
+
+
+/**
+ * gx_plist_cons:
+ * @data: an element
+ * @tail: (transfer full) (allow-none): a #GXPList
+ *
+ * Create a list with @data as its first element, followed by the elements of
+ * @tail, in constant time. This takes over the caller's reference to @tail,
+ * so a list can be built with:
+ *
+ * |[<!-- language="C" -->
+ * list = gx_plist_cons (data, list);
+ * ]|
+ *
+ * Use gx_plist_ref() on @tail to keep using it independently.
+ *
+ * Returns: (transfer full): a new #GXPList; free with gx_plist_unref().
+ */
+GXPList*
+gx_plist_cons (gpointer data, GXPList *tail)
+{
+  GXPList *list;
+
+  list            = g_slice_new (GXPList);
+  list->ref_count = 1;
+  list->data      = data;
+  list->next      = tail;
+
+  return list;
+}
+
+
+/**
+ * gx_plist_ref:
+ * @list: (allow-none): a #GXPList
+ *
+ * Increase the reference count of @list.
+ *
+ * Returns: (transfer full): @list
+ */
+GXPList*
+gx_plist_ref (GXPList *list)
+{
+  if (list)
+    g_atomic_int_inc (&list->ref_count);
+
+  return list;
+}
+
+
+/**
+ * gx_plist_unref:
+ * @list: (allow-none): a #GXPList
+ *
+ * Decrease the reference count of @list. When it drops to 0, the first node
+ * of @list is freed, and the same happens for the rest of the list; the
+ * nodes that are shared with other lists stay alive.
+ */
+void
+gx_plist_unref (GXPList *list)
+{
+  /* iteratively, so long lists do not overflow the stack */
+  while (list && g_atomic_int_dec_and_test (&list->ref_count))
+    {
+      GXPList *next;
+
+      next = list->next;
+      g_slice_free (GXPList, list);
+      list = next;
+    }
+}
+
+
+/**
+ * gx_plist_head:
+ * @list: (allow-none): a #GXPList
+ *
+ * Get the first element of @list.
+ *
+ * Returns: (transfer none): the first element, or %NULL if @list is empty.
+ */
+gpointer
+gx_plist_head (GXPList *list)
+{
+  return list ? list->data : NULL;
+}
+
+
+/**
+ * gx_plist_tail:
+ * @list: (allow-none): a #GXPList
+ *
+ * Get the list of all elements of @list but the first one, in constant time.
+ * Use gx_plist_ref() to keep the tail alive independently of @list.
+ *
+ * Returns: (transfer none): the tail of @list, or %NULL if @list has fewer
+ * than two elements.
+ */
+GXPList*
+gx_plist_tail (GXPList *list)
+{
+  return list ? list->next : NULL;
+}
+
+
+/**
+ * gx_plist_length:
+ * @list: (allow-none): a #GXPList
+ *
+ * Get the number of elements in @list.
+ *
+ * Returns: the length of @list.
+ */
+gsize
+gx_plist_length (GXPList *list)
+{
+  gsize n;
+
+  for (n = 0; list; list = list->next)
+    ++n;
+
+  return n;
+}
+
+
+/**
+ * gx_plist_from_list:
+ * @list: a #GList
+ *
+ * Create a #GXPList with the elements of @list, in the same order.
+ *
+ * Returns: (transfer full): a new #GXPList; free with gx_plist_unref().
+ */
+GXPList*
+gx_plist_from_list (GList *list)
+{
+  PListBuilder builder;
+
+  plist_builder_init (&builder);
+  for (; list; list = list->next)
+    plist_builder_append (&builder, list->data);
+
+  return plist_builder_finish (&builder, NULL);
+}
+
+
+/**
+ * gx_plist_to_list:
+ * @list: a #GXPList
+ *
+ * Create a #GList with the elements of @list, in the same order.
+ *
+ * Returns: (transfer full): a new #GList; free with g_list_free().
+ */
+GList*
+gx_plist_to_list (GXPList *list)
+{
+  GXListBuilder builder;
+
+  gx_list_builder_init (&builder);
+  for (; list; list = list->next)
+    gx_list_builder_append (&builder, list->data);
+
+  return builder.head;
+}
+
+
+/**
+ * gx_plist_take:
+ * @list: a #GXPList
+ * @n: the number of elements to take
+ *
+ * Get a list of the first @n elements of @list, or all elements if @n is
+ * greater than the length of @list. The first @n elements have to be copied,
+ * unless that is all of them, in which case this just returns a new
+ * reference to @list.
+ *
+ * Returns: (transfer full): a list of up to @n elements; free with
+ * gx_plist_unref().
+ */
+GXPList*
+gx_plist_take (GXPList *list, gsize n)
+{
+  PListBuilder  builder;
+  GXPList      *cur;
+  gsize         u;
+
+  for (cur = list, u = 0; cur && u != n; cur = cur->next, ++u);
+  if (!cur)
+    return gx_plist_ref (list);
+
+  plist_builder_init (&builder);
+  for (; n > 0; list = list->next, --n)
+    plist_builder_append (&builder, list->data);
+
+  return plist_builder_finish (&builder, NULL);
+}
+
+
+/**
+ * gx_plist_skip:
+ * @list: a #GXPList
+ * @n: the number of elements to skip
+ *
+ * Get the list of all but the first @n elements of @list, or the empty list
+ * if @n is greater than the length of @list. This takes O(@n) time and does
+ * not copy anything: the result is a tail of @list.
+ *
+ * Returns: (transfer full): the remaining list; free with gx_plist_unref().
+ */
+GXPList*
+gx_plist_skip (GXPList *list, gsize n)
+{
+  for (; list && n != 0; list = list->next, --n);
+
+  return gx_plist_ref (list);
+}
+
+
+/**
+ * gx_plist_filter:
+ * @list: a #GXPList
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Get a list of the elements of @list for which @pred_func returns %TRUE,
+ * like gx_list_filter(). @pred_func is called once for each element. Only
+ * the elements before the last rejected one are copied; the rest of @list is
+ * shared.
+ *
+ * Returns: (transfer full): the filtered list; free with gx_plist_unref().
+ */
+GXPList*
+gx_plist_filter (GXPList *list, GXPred pred_func, gpointer user_data)
+{
+  PListBuilder  builder;
+  GXPList      *cur, *shared;
+
+  g_return_val_if_fail (pred_func, NULL);
+
+  /* collect the kept elements; whenever an element is rejected, the ones
+   * collected so far have to be copied, and the shared part restarts after
+   * it */
+  plist_builder_init (&builder);
+  for (cur = shared = list; cur; cur = cur->next)
+    {
+      if ((*pred_func) (cur->data, user_data))
+        continue;
+
+      for (; shared != cur; shared = shared->next)
+        plist_builder_append (&builder, shared->data);
+      shared = cur->next;
+    }
+
+  return plist_builder_finish (&builder, gx_plist_ref (shared));
+}
+
+
+/**
+ * gx_plist_map:
+ * @list: a #GXPList
+ * @map_func: a function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Get a list of the results of applying @map_func to the elements of @list,
+ * like gx_list_map(). @map_func is called once for each element. The nodes
+ * after the last element for which @map_func returns something other than
+ * the element itself are shared with @list.
+ *
+ * Returns: (transfer full): the mapped list; free with gx_plist_unref().
+ */
+GXPList*
+gx_plist_map (GXPList *list, GXBinaryFunc map_func, gpointer user_data)
+{
+  PListBuilder  builder;
+  GXPList      *cur, *shared;
+
+  g_return_val_if_fail (map_func, NULL);
+
+  /* as for filter; the unchanged elements since the last changed one are
+   * copied when the next changed one comes along */
+  plist_builder_init (&builder);
+  for (cur = shared = list; cur; cur = cur->next)
+    {
+      gpointer mapped;
+
+      mapped = (*map_func) (cur->data, user_data);
+      if (mapped == cur->data)
+        continue;
+
+      for (; shared != cur; shared = shared->next)
+        plist_builder_append (&builder, shared->data);
+      plist_builder_append (&builder, mapped);
+      shared = cur->next;
+    }
+
+  return plist_builder_finish (&builder, gx_plist_ref (shared));
+}
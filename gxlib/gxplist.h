@@ -0,0 +1,60 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_PLIST_H__
+#define __GX_PLIST_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXPList:
+ *
+ * A #GXPList is an immutable, reference-counted singly-linked list, whose
+ * tails can be shared between many lists. %NULL is the empty list.
+ *
+ * The struct has only private fields and should not be directly accessed.
+ */
+struct _GXPList;
+typedef struct _GXPList GXPList;
+
+GXPList *gx_plist_cons (gpointer data, GXPList *tail)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXPList *gx_plist_ref (GXPList *list);
+void gx_plist_unref (GXPList *list);
+
+gpointer gx_plist_head (GXPList *list);
+GXPList *gx_plist_tail (GXPList *list);
+gsize gx_plist_length (GXPList *list);
+
+GXPList *gx_plist_from_list (GList *list) G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_plist_to_list (GXPList *list) G_GNUC_WARN_UNUSED_RESULT;
+
+GXPList *gx_plist_take (GXPList *list, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GXPList *gx_plist_skip (GXPList *list, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GXPList *gx_plist_filter (GXPList *list, GXPred pred_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXPList *gx_plist_map (GXPList *list, GXBinaryFunc map_func,
+                       gpointer user_data) G_GNUC_WARN_UNUSED_RESULT;
+
+G_END_DECLS
+
+#endif /* __GX_PLIST_H__ */
@@ -18,6 +18,7 @@
 */
 
 #include <gxlib.h>
+#include "gxlib-private.h"
 
 /**
  * gx_is_prime:
@@ -27,6 +28,9 @@
  * otherwise. A prime number is a positive number that is only divisible by
  * itself and 1.
  *
+ * If a default #GXPrimeTable has been set with gx_prime_table_set_default(),
+ * numbers up to its limit are looked up in that table, in constant time.
+ *
  * |[<!-- language="C" -->
  * g_assert_cmpuint (gx_is_prime (13),==, TRUE);
  * g_assert_cmpuint (gx_is_prime (52),==, FALSE);
@@ -37,19 +41,274 @@
 gboolean
 gx_is_prime (gint i)
 {
-  int j;
-  
+  gboolean is_prime;
+  int      j;
+
   if (i < 2)
     return FALSE;
-  
-  for (j = 2; j <= sqrt(i); ++j)
-    if (i % j == 0)
+
+  if (gx_prime_table_lookup_default ((guint)i, &is_prime))
+    return is_prime;
+
+  if (i % 2 == 0 || i % 3 == 0)
+    return i <= 3;
+
+  /* the other primes are 6k +/- 1 */
+  for (j = 5; j <= i / j; j += 6)
+    if (i % j == 0 || i % (j + 2) == 0)
       return FALSE;
 
   return TRUE;
 }
 
 
+/* the product of a and b, as a 128-bit (hi, lo) pair */
+static inline guint64
+mul_128 (guint64 a, guint64 b, guint64 *hi)
+{
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product;
+
+  product = (unsigned __int128)a * b;
+  *hi     = (guint64)(product >> 64);
+
+  return (guint64)product;
+#else
+  guint64 a_lo, a_hi, b_lo, b_hi, lo_lo, hi_lo, lo_hi, cross;
+
+  a_lo = a & 0xffffffff; a_hi = a >> 32;
+  b_lo = b & 0xffffffff; b_hi = b >> 32;
+
+  lo_lo = a_lo * b_lo;
+  hi_lo = a_hi * b_lo;
+  lo_hi = a_lo * b_hi;
+  cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+
+  *hi = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+
+  return (cross << 32) | (lo_lo & 0xffffffff);
+#endif /*__SIZEOF_INT128__*/
+}
+
+/* arithmetic modulo an odd n in Montgomery form, i.e. x is represented by
+ * x * 2^64 mod n; this avoids the (slow) 128-bit division in a mulmod */
+typedef struct {
+  guint64 n;
+  guint64 n_inv;  /* n^-1 mod 2^64 */
+  guint64 one;    /* 2^64 mod n, i.e. 1 in Montgomery form */
+  guint64 r2;     /* 2^128 mod n, to convert numbers to Montgomery form */
+} Montgomery;
+
+static inline guint64
+mont_mul (const Montgomery *mont, guint64 a, guint64 b)
+{
+  guint64 lo, hi, m_hi;
+
+  /* REDC (a * b) */
+  lo = mul_128 (a, b, &hi);
+  mul_128 (lo * mont->n_inv, mont->n, &m_hi);
+
+  return hi >= m_hi ? hi - m_hi : hi - m_hi + mont->n;
+}
+
+static inline guint64
+add_mod (guint64 a, guint64 b, guint64 n)
+{
+  return a >= n - b ? a - (n - b) : a + b;
+}
+
+static void
+mont_init (Montgomery *mont, guint64 n)
+{
+  guint64 inv;
+  guint   u;
+
+  /* Newton's iteration; each step doubles the number of correct bits, and
+   * n is its own inverse modulo 2^3 */
+  for (inv = n, u = 0; u != 5; ++u)
+    inv *= 2 - n * inv;
+
+  mont->n     = n;
+  mont->n_inv = inv;
+  mont->one   = (0 - n) % n;
+
+  for (mont->r2 = mont->one, u = 0; u != 64; ++u)
+    mont->r2 = add_mod (mont->r2, mont->r2, n);
+}
+
+/* is n a strong probable prime to base a? n must be odd, and a < n */
+static gboolean
+is_strong_probable_prime (const Montgomery *mont, guint64 a, guint64 d,
+                          guint s)
+{
+  guint64 x, minus_one;
+
+  minus_one = mont->n - mont->one;
+
+  /* x = a^d */
+  a = mont_mul (mont, a, mont->r2);
+  for (x = mont->one; d; d >>= 1)
+    {
+      if (d & 1)
+        x = mont_mul (mont, x, a);
+      a = mont_mul (mont, a, a);
+    }
+
+  if (x == mont->one || x == minus_one)
+    return TRUE;
+
+  while (--s)
+    {
+      x = mont_mul (mont, x, x);
+      if (x == minus_one)
+        return TRUE;
+      else if (x == mont->one)
+        return FALSE;
+    }
+
+  return FALSE;
+}
+
+/**
+ * gx_is_prime64:
+ * @n: an unsigned 64-bit integer
+ *
+ * Predicate function that returns %TRUE if @n is a prime number, %FALSE
+ * otherwise; like gx_is_prime(), but for 64-bit numbers.
+ *
+ * After checking for small prime factors, this uses the Miller-Rabin test
+ * with a set of witnesses that gives the correct answer for all 64-bit
+ * numbers, so it takes O(log n) time; numbers that are in the default
+ * #GXPrimeTable (if any) are simply looked up.
+ *
+ * |[<!-- language="C" -->
+ * g_assert_true (gx_is_prime64 (G_GUINT64_CONSTANT(18446744073709551557)));
+ * g_assert_false (gx_is_prime64 (G_MAXUINT64));
+ * ]|
+ *
+ * Returns: %TRUE if @n is prime; %FALSE otherwise.
+ */
+gboolean
+gx_is_prime64 (guint64 n)
+{
+  /* the odd primes up to 53, with their inverse modulo 2^64 and
+   * G_MAXUINT64 / p: n is divisible by p iff n * inverse <= G_MAXUINT64 / p,
+   * which avoids the (slow) division */
+  static const struct {
+    guint   p;
+    guint64 inverse;
+    guint64 max;
+  } small_primes[] = {
+    {  3, G_GUINT64_CONSTANT(0xaaaaaaaaaaaaaaab), G_GUINT64_CONSTANT(0x5555555555555555) },
+    {  5, G_GUINT64_CONSTANT(0xcccccccccccccccd), G_GUINT64_CONSTANT(0x3333333333333333) },
+    {  7, G_GUINT64_CONSTANT(0x6db6db6db6db6db7), G_GUINT64_CONSTANT(0x2492492492492492) },
+    { 11, G_GUINT64_CONSTANT(0x2e8ba2e8ba2e8ba3), G_GUINT64_CONSTANT(0x1745d1745d1745d1) },
+    { 13, G_GUINT64_CONSTANT(0x4ec4ec4ec4ec4ec5), G_GUINT64_CONSTANT(0x13b13b13b13b13b1) },
+    { 17, G_GUINT64_CONSTANT(0xf0f0f0f0f0f0f0f1), G_GUINT64_CONSTANT(0x0f0f0f0f0f0f0f0f) },
+    { 19, G_GUINT64_CONSTANT(0x86bca1af286bca1b), G_GUINT64_CONSTANT(0x0d79435e50d79435) },
+    { 23, G_GUINT64_CONSTANT(0xd37a6f4de9bd37a7), G_GUINT64_CONSTANT(0x0b21642c8590b216) },
+    { 29, G_GUINT64_CONSTANT(0x34f72c234f72c235), G_GUINT64_CONSTANT(0x08d3dcb08d3dcb08) },
+    { 31, G_GUINT64_CONSTANT(0xef7bdef7bdef7bdf), G_GUINT64_CONSTANT(0x0842108421084210) },
+    { 37, G_GUINT64_CONSTANT(0x14c1bacf914c1bad), G_GUINT64_CONSTANT(0x06eb3e45306eb3e4) },
+    { 41, G_GUINT64_CONSTANT(0x8f9c18f9c18f9c19), G_GUINT64_CONSTANT(0x063e7063e7063e70) },
+    { 43, G_GUINT64_CONSTANT(0x82fa0be82fa0be83), G_GUINT64_CONSTANT(0x05f417d05f417d05) },
+    { 47, G_GUINT64_CONSTANT(0x51b3bea3677d46cf), G_GUINT64_CONSTANT(0x0572620ae4c415c9) },
+    { 53, G_GUINT64_CONSTANT(0x21cfb2b78c13521d), G_GUINT64_CONSTANT(0x04d4873ecade304d) }
+  };
+  /* bases that give the correct answer for all n < 2^32 (Jaeschke), and for
+   * all n < 2^64 (Sinclair) */
+  static const guint64 witnesses32[] = { 2, 7, 61 };
+  static const guint64 witnesses64[] = {
+    2, 325, 9375, 28178, 450775, 9780504, 1795265022 };
+  const guint64 *witnesses;
+  Montgomery     mont;
+  gboolean       is_prime;
+  guint64        d;
+  guint          u, s, n_witnesses;
+
+  if (n <= G_MAXUINT && gx_prime_table_lookup_default ((guint)n, &is_prime))
+    return is_prime;
+
+  if (n % 2 == 0)
+    return n == 2;
+
+  for (u = 0; u != G_N_ELEMENTS (small_primes); ++u)
+    if (n * small_primes[u].inverse <= small_primes[u].max)
+      return n == small_primes[u].p;
+
+  /* no factors up to 53, so anything below 59^2 is prime */
+  if (n < 59 * 59)
+    return n > 1;
+
+  for (d = n - 1, s = 0; d % 2 == 0; d /= 2, ++s);
+
+  if (n <= G_MAXUINT32)
+    {
+      witnesses   = witnesses32;
+      n_witnesses = G_N_ELEMENTS (witnesses32);
+    }
+  else
+    {
+      witnesses   = witnesses64;
+      n_witnesses = G_N_ELEMENTS (witnesses64);
+    }
+
+  mont_init (&mont, n);
+  for (u = 0; u != n_witnesses; ++u)
+    {
+      guint64 a;
+
+      a = witnesses[u] % n;
+      if (a != 0 && !is_strong_probable_prime (&mont, a, d, s))
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+
+/**
+ * gx_is_prime64_batch:
+ * @candidates: (array length=n): an array of numbers
+ * @n: the number of elements in @candidates
+ * @results: (allow-none) (array length=n) (out caller-allocates): an array
+ * receiving the result of gx_is_prime64() for each of the candidates, or
+ * %NULL
+ *
+ * Test an array of numbers for being prime; see gx_is_prime64().
+ *
+ * |[<!-- language="C" -->
+ * guint64 nums[] = { 7, 8, 9, G_GUINT64_CONSTANT(2305843009213693951) };
+ * gboolean results[4];
+ *
+ * g_assert_cmpuint (gx_is_prime64_batch (nums, 4, results), ==, 2);
+ * g_assert_true (results[3]);
+ * ]|
+ *
+ * Returns: the number of primes in @candidates.
+ */
+gsize
+gx_is_prime64_batch (const guint64 *candidates, gsize n, gboolean *results)
+{
+  gsize u, count;
+
+  g_return_val_if_fail (candidates || n == 0, 0);
+
+  for (u = count = 0; u != n; ++u)
+    {
+      gboolean is_prime;
+
+      is_prime = gx_is_prime64 (candidates[u]);
+      if (results)
+        results[u] = is_prime;
+      if (is_prime)
+        ++count;
+    }
+
+  return count;
+}
+
+
 /**
  * gx_is_str_equal:
  * @s1: a string
@@ -102,6 +102,9 @@ gx_is_odd (gint i)
 }
 
 gboolean gx_is_prime (gint i);
+gboolean gx_is_prime64 (guint64 n);
+gsize gx_is_prime64_batch (const guint64 *candidates, gsize n,
+                           gboolean *results);
 
 gboolean gx_is_str_equal (const char *s1, const char *s2);
 
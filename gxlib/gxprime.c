@@ -0,0 +1,607 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <string.h>
+
+#include "gxprime.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxprime
+ * @title: Prime tables
+ * @short_description: fast primality checks, prime enumeration and
+ * factorization for bounded numbers
+ *
+ * A #GXPrimeTable is built with a segmented Sieve of Eratosthenes, running on
+ * multiple threads, and stores one bit for each odd number up to its limit
+ * (a table for 10^8 numbers takes about 6 MiB). After that, checking whether
+ * a number is prime takes constant time.
+ *
+ * Once a table has been made the default with gx_prime_table_set_default(),
+ * gx_is_prime() uses it as well, for all numbers up to its limit; this makes
+ * filtering large lists much faster:
+ *
+ * |[<!-- language="C" -->
+ * GXPrimeTable *table;
+ * GList *primes;
+ *
+ * table = gx_prime_table_new (10 * 1000 * 1000, GX_PRIME_TABLE_FLAGS_NONE, -1);
+ * gx_prime_table_set_default (table);
+ * gx_prime_table_unref (table);
+ *
+ * primes = gx_list_filter_in_place (gx_list_iota (10 * 1000 * 1000, 1, 1),
+ *                                   (GXPred)gx_is_prime, NULL, NULL);
+ * g_assert_cmpuint (g_list_length (primes), ==, 664579);
+ * g_list_free (primes);
+ * ]|
+ *
+ * A table built with %GX_PRIME_TABLE_FLAGS_FACTORS also remembers the
+ * smallest prime factor of each number, so numbers can be factorized in
+ * O(log n) steps:
+ *
+ * |[<!-- language="C" -->
+ * GXPrimeTable *table;
+ * GList *factors;
+ *
+ * table   = gx_prime_table_new (1000, GX_PRIME_TABLE_FLAGS_FACTORS, 1);
+ * factors = gx_prime_table_factorize (table, 360); // 2, 2, 2, 3, 3, 5
+ * g_assert_cmpuint (gx_list_product (factors), ==, 360);
+ *
+ * g_list_free (factors);
+ * gx_prime_table_unref (table);
+ * ]|
+ */
+
+/* each job sieves this many odd numbers, i.e. 32 KiB of the bitset, which
+ * keeps the segment in the L1/L2 cache; a multiple of 64 so that no two jobs
+ * touch the same word */
+#define SEGMENT_BITS (32 * 1024 * 8)
+
+/* bit i of the bitset (and element i of factors) is for the odd number 2i+1 */
+#define INDEX_OF(n)  ((n) / 2)
+#define NUMBER_OF(i) (2 * (guint64)(i) + 1)
+
+struct _GXPrimeTable {
+  volatile gint  ref_count;
+  guint          limit;
+  gsize          n_bits;   /* the number of odd numbers in 1 .. limit */
+  guint64       *bits;     /* bit set: the odd number is prime */
+  guint32       *factors;  /* smallest factor of the odd numbers, or 0 for
+                            * primes; NULL unless FLAGS_FACTORS */
+};
+
+static inline guint
+popcount64 (guint64 word)
+{
+#if defined(__GNUC__)
+  return (guint)__builtin_popcountll (word);
+#else
+  guint count;
+
+  for (count = 0; word; word &= word - 1)
+    ++count;
+
+  return count;
+#endif /*__GNUC__*/
+}
+
+static inline guint
+ctz64 (guint64 word)
+{
+#if defined(__GNUC__)
+  return (guint)__builtin_ctzll (word);
+#else
+  guint count;
+
+  for (count = 0; !(word & 1); word >>= 1)
+    ++count;
+
+  return count;
+#endif /*__GNUC__*/
+}
+
+
+typedef struct {
+  GXPrimeTable *table;
+  guint32      *base_primes;  /* the odd primes up to sqrt(limit) */
+  gsize         n_base_primes;
+} SieveContext;
+
+static void
+sieve_segment (gsize segment, SieveContext *ctx)
+{
+  GXPrimeTable *table;
+  gsize         lo, hi, u;
+
+  table = ctx->table;
+  lo    = segment * SEGMENT_BITS;
+  hi    = MIN (lo + SEGMENT_BITS, table->n_bits);
+
+  memset (&table->bits[lo / 64], 0xff, (hi - lo + 63) / 64 * sizeof (guint64));
+  if (lo == 0)
+    table->bits[0] &= ~(guint64)1;  /* 1 is not prime */
+
+  for (u = 0; u != ctx->n_base_primes; ++u)
+    {
+      guint64 p, i;
+
+      /* the odd multiples of p are at p * k + (p - 1) / 2, and the smaller
+       * ones have a smaller prime factor as well, so start at p * p */
+      p = ctx->base_primes[u];
+      i = INDEX_OF (p * p);
+      if (i >= hi)
+        break;
+      if (i < lo)
+        i = lo + (p - (lo - (p - 1) / 2) % p) % p;
+
+      if (table->factors)
+        for (; i < hi; i += p)
+          {
+            table->bits[i / 64] &= ~((guint64)1 << (i % 64));
+            if (table->factors[i] == 0)
+              table->factors[i] = (guint32)p;
+          }
+      else
+        for (; i < hi; i += p)
+          table->bits[i / 64] &= ~((guint64)1 << (i % 64));
+    }
+
+  /* clear the bits past the limit */
+  if (hi == table->n_bits && hi % 64 != 0)
+    table->bits[hi / 64] &= ((guint64)1 << (hi % 64)) - 1;
+}
+
+
+static guint32*
+get_base_primes (guint limit, gsize *n_base_primes)
+{
+  guint    root, n, m;
+  guint8  *composite;
+  guint32 *primes;
+  gsize    count;
+
+  for (root = 1; (guint64)(root + 1) * (root + 1) <= limit; ++root);
+
+  composite = g_new0 (guint8, root + 1);
+  primes    = g_new (guint32, root / 2 + 1);
+
+  for (count = 0, n = 3; n <= root; n += 2)
+    {
+      if (composite[n])
+        continue;
+
+      primes[count++] = n;
+      for (m = n * n; m <= root; m += 2 * n)
+        composite[m] = 1;
+    }
+
+  g_free (composite);
+
+  *n_base_primes = count;
+  return primes;
+}
+
+
+/**
+ * gx_prime_table_new:
+ * @limit: the largest number the table should know about
+ * @flags: flags for the table
+ * @n_threads: the maximum number of threads to use for building the table, or
+ * <= 0 to use the number of processors
+ *
+ * Create a new prime table for the numbers 0 .. @limit.
+ *
+ * Returns: (transfer full): a new #GXPrimeTable; free with
+ * gx_prime_table_unref().
+ */
+GXPrimeTable*
+gx_prime_table_new (guint limit, GXPrimeTableFlags flags, gint n_threads)
+{
+  GXPrimeTable *table;
+  SieveContext  ctx;
+  gsize         n_words;
+
+  table            = g_slice_new0 (GXPrimeTable);
+  table->ref_count = 1;
+  table->limit     = limit;
+  table->n_bits    = ((gsize)limit + 1) / 2;
+
+  n_words     = (table->n_bits + 63) / 64;
+  table->bits = g_new (guint64, MAX (n_words, 1));
+  table->bits[0] = 0;
+
+  if (flags & GX_PRIME_TABLE_FLAGS_FACTORS)
+    table->factors = g_new0 (guint32, MAX (table->n_bits, 1));
+
+  ctx.table       = table;
+  ctx.base_primes = get_base_primes (limit, &ctx.n_base_primes);
+
+  gx_run_jobs ((table->n_bits + SEGMENT_BITS - 1) / SEGMENT_BITS, n_threads,
+               (GXJobFunc)sieve_segment, &ctx);
+
+  g_free (ctx.base_primes);
+
+  return table;
+}
+
+
+/**
+ * gx_prime_table_ref:
+ * @table: a #GXPrimeTable
+ *
+ * Increase the reference count of @table.
+ *
+ * Returns: (transfer full): @table
+ */
+GXPrimeTable*
+gx_prime_table_ref (GXPrimeTable *table)
+{
+  g_return_val_if_fail (table, NULL);
+
+  g_atomic_int_inc (&table->ref_count);
+
+  return table;
+}
+
+
+/**
+ * gx_prime_table_unref:
+ * @table: a #GXPrimeTable
+ *
+ * Decrease the reference count of @table, and free it when it drops to 0.
+ */
+void
+gx_prime_table_unref (GXPrimeTable *table)
+{
+  if (!table)
+    return;
+
+  if (!g_atomic_int_dec_and_test (&table->ref_count))
+    return;
+
+  g_free (table->bits);
+  g_free (table->factors);
+
+  g_slice_free (GXPrimeTable, table);
+}
+
+
+/**
+ * gx_prime_table_get_limit:
+ * @table: a #GXPrimeTable
+ *
+ * Get the largest number @table knows about.
+ *
+ * Returns: the limit that @table was created with.
+ */
+guint
+gx_prime_table_get_limit (GXPrimeTable *table)
+{
+  g_return_val_if_fail (table, 0);
+
+  return table->limit;
+}
+
+
+static inline gboolean
+table_is_prime (GXPrimeTable *table, guint n)
+{
+  if (n % 2 == 0)
+    return n == 2;
+  else
+    return (table->bits[INDEX_OF (n) / 64] >> (INDEX_OF (n) % 64)) & 1;
+}
+
+/**
+ * gx_prime_table_is_prime:
+ * @table: a #GXPrimeTable
+ * @n: a number, at most the limit of @table
+ *
+ * Check whether @n is a prime number, in constant time.
+ *
+ * Returns: %TRUE if @n is prime, %FALSE otherwise.
+ */
+gboolean
+gx_prime_table_is_prime (GXPrimeTable *table, guint n)
+{
+  g_return_val_if_fail (table, FALSE);
+  g_return_val_if_fail (n <= table->limit, FALSE);
+
+  return table_is_prime (table, n);
+}
+
+
+/**
+ * gx_prime_table_count:
+ * @table: a #GXPrimeTable
+ * @n: a number, at most the limit of @table
+ *
+ * Count the prime numbers up to and including @n.
+ *
+ * |[<!-- language="C" -->
+ * table = gx_prime_table_new (100, GX_PRIME_TABLE_FLAGS_NONE, 1);
+ * g_assert_cmpuint (gx_prime_table_count (table, 100), ==, 25);
+ * ]|
+ *
+ * Returns: the number of primes <= @n.
+ */
+gsize
+gx_prime_table_count (GXPrimeTable *table, guint n)
+{
+  gsize n_bits, count, u;
+
+  g_return_val_if_fail (table, 0);
+  g_return_val_if_fail (n <= table->limit, 0);
+
+  if (n < 2)
+    return 0;
+
+  /* 2, and the odd primes in 3 .. n */
+  n_bits = ((gsize)n + 1) / 2;
+  for (count = 1, u = 0; u != n_bits / 64; ++u)
+    count += popcount64 (table->bits[u]);
+
+  if (n_bits % 64 != 0)
+    count += popcount64 (table->bits[u] &
+                         (((guint64)1 << (n_bits % 64)) - 1));
+
+  return count;
+}
+
+
+/* the smallest prime >= n, or 0 if there is none up to the limit */
+static guint
+find_prime (GXPrimeTable *table, guint64 n)
+{
+  guint64 word;
+  gsize   i;
+
+  if (n <= 2)
+    return table->limit >= 2 ? 2 : 0;
+  if (n > table->limit)
+    return 0;
+
+  /* for an even limit, n == limit is beyond the last odd number */
+  i = INDEX_OF (n);
+  if (i >= table->n_bits)
+    return 0;
+
+  word = table->bits[i / 64] & (~(guint64)0 << (i % 64));
+
+  for (i /= 64; !word; word = table->bits[i])
+    if (++i >= (table->n_bits + 63) / 64)
+      return 0;
+
+  return (guint)NUMBER_OF (i * 64 + ctz64 (word));
+}
+
+/**
+ * gx_prime_table_next:
+ * @table: a #GXPrimeTable
+ * @n: a number
+ *
+ * Find the smallest prime number greater than @n.
+ *
+ * |[<!-- language="C" -->
+ * g_assert_cmpuint (gx_prime_table_next (table, 13), ==, 17);
+ * ]|
+ *
+ * Returns: the next prime after @n, or 0 if there is none up to the limit
+ * of @table.
+ */
+guint
+gx_prime_table_next (GXPrimeTable *table, guint n)
+{
+  g_return_val_if_fail (table, 0);
+
+  return find_prime (table, (guint64)n + 1);
+}
+
+
+typedef struct {
+  GXPrimeTable *table;
+  guint64       next;
+} PrimeIterState;
+
+static gboolean
+prime_iter_next (PrimeIterState *state, gpointer *data)
+{
+  guint prime;
+
+  prime = find_prime (state->table, state->next);
+  if (prime == 0)
+    return FALSE;
+
+  state->next = (guint64)prime + 1;
+  *data       = GUINT_TO_POINTER (prime);
+
+  return TRUE;
+}
+
+static void
+prime_iter_state_free (PrimeIterState *state)
+{
+  gx_prime_table_unref (state->table);
+  g_slice_free (PrimeIterState, state);
+}
+
+/**
+ * gx_prime_table_iter:
+ * @table: a #GXPrimeTable
+ * @start: the number to start at
+ *
+ * Create a #GXIter producing the prime numbers >= @start, up to the limit of
+ * @table, in ascending order. The elements are numbers stored with
+ * GUINT_TO_POINTER().
+ *
+ * |[<!-- language="C" -->
+ * // 11, 13, 17, 19
+ * iter = gx_iter_take (gx_prime_table_iter (table, 10), 4);
+ * ]|
+ *
+ * Returns: (transfer full): a new #GXIter.
+ */
+GXIter*
+gx_prime_table_iter (GXPrimeTable *table, guint start)
+{
+  PrimeIterState *state;
+
+  g_return_val_if_fail (table, NULL);
+
+  state        = g_slice_new (PrimeIterState);
+  state->table = gx_prime_table_ref (table);
+  state->next  = start;
+
+  return gx_iter_new ((GXIterNextFunc)prime_iter_next, state,
+                      (GDestroyNotify)prime_iter_state_free);
+}
+
+
+/**
+ * gx_prime_table_smallest_factor:
+ * @table: a #GXPrimeTable
+ * @n: a number, at most the limit of @table
+ *
+ * Get the smallest prime factor of @n. This takes constant time if @table was
+ * built with %GX_PRIME_TABLE_FLAGS_FACTORS, and uses trial division by the
+ * primes in @table otherwise.
+ *
+ * Returns: the smallest prime factor of @n (which is @n itself if it is
+ * prime), or 0 for 0 and 1.
+ */
+guint
+gx_prime_table_smallest_factor (GXPrimeTable *table, guint n)
+{
+  guint p;
+
+  g_return_val_if_fail (table, 0);
+  g_return_val_if_fail (n <= table->limit, 0);
+
+  if (n < 2)
+    return 0;
+  else if (n % 2 == 0)
+    return 2;
+  else if (table->factors)
+    return table->factors[INDEX_OF (n)] ? table->factors[INDEX_OF (n)] : n;
+
+  for (p = 3; p != 0 && (guint64)p * p <= n; p = find_prime (table, p + 1))
+    if (n % p == 0)
+      return p;
+
+  return n;
+}
+
+
+/**
+ * gx_prime_table_factorize:
+ * @table: a #GXPrimeTable
+ * @n: a number, at most the limit of @table
+ *
+ * Get the prime factors of @n, in ascending order, and repeated according to
+ * their multiplicity. The elements are numbers stored with GUINT_TO_POINTER().
+ *
+ * Returns: (transfer full): a list with the prime factors of @n (empty for 0
+ * and 1); free with g_list_free().
+ */
+GList*
+gx_prime_table_factorize (GXPrimeTable *table, guint n)
+{
+  GXListBuilder factors;
+
+  g_return_val_if_fail (table, NULL);
+  g_return_val_if_fail (n <= table->limit, NULL);
+
+  gx_list_builder_init (&factors);
+
+  while (n > 1)
+    {
+      guint p;
+
+      p = gx_prime_table_smallest_factor (table, n);
+      gx_list_builder_append (&factors, GUINT_TO_POINTER (p));
+      n /= p;
+    }
+
+  return factors.head;
+}
+
+
+static GXPrimeTable *default_table;
+static GMutex        default_lock;
+static GSList       *retired_tables;
+
+/**
+ * gx_prime_table_set_default:
+ * @table: (allow-none): a #GXPrimeTable, or %NULL
+ *
+ * Make @table the default prime table, which gx_is_prime() uses for the
+ * numbers up to its limit. Pass %NULL to go back to trial division.
+ *
+ * Since other threads may still be using it, a table that has been the
+ * default is never freed; so it is best to set a default table only once, or
+ * a few times with increasing limits.
+ */
+void
+gx_prime_table_set_default (GXPrimeTable *table)
+{
+  GXPrimeTable *old;
+
+  g_mutex_lock (&default_lock);
+
+  old = g_atomic_pointer_get (&default_table);
+  if (old != table)
+    {
+      if (table)
+        gx_prime_table_ref (table);
+      g_atomic_pointer_set (&default_table, table);
+
+      if (old)
+        retired_tables = g_slist_prepend (retired_tables, old);
+    }
+
+  g_mutex_unlock (&default_lock);
+}
+
+
+/**
+ * gx_prime_table_get_default:
+ *
+ * Get the default prime table, if any; see gx_prime_table_set_default().
+ *
+ * Returns: (transfer none): the default #GXPrimeTable, or %NULL.
+ */
+GXPrimeTable*
+gx_prime_table_get_default (void)
+{
+  return g_atomic_pointer_get (&default_table);
+}
+
+
+gboolean
+gx_prime_table_lookup_default (guint n, gboolean *is_prime)
+{
+  GXPrimeTable *table;
+
+  table = g_atomic_pointer_get (&default_table);
+  if (!table || n > table->limit)
+    return FALSE;
+
+  *is_prime = table_is_prime (table, n);
+  return TRUE;
+}
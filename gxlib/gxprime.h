@@ -0,0 +1,74 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_PRIME_H__
+#define __GX_PRIME_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXPrimeTable:
+ *
+ * A #GXPrimeTable knows which of the numbers 0 .. limit are prime, and can
+ * optionally give the smallest prime factor of each of them.
+ *
+ * The struct has only private fields and should not be directly accessed.
+ */
+struct _GXPrimeTable;
+typedef struct _GXPrimeTable GXPrimeTable;
+
+/**
+ * GXPrimeTableFlags:
+ * @GX_PRIME_TABLE_FLAGS_NONE: no flags
+ * @GX_PRIME_TABLE_FLAGS_FACTORS: also build a table with the smallest prime
+ * factor of each number, for constant-time gx_prime_table_smallest_factor();
+ * this takes 2 bytes of memory per number (rather than 1/16)
+ *
+ * Flags for gx_prime_table_new().
+ */
+typedef enum {
+  GX_PRIME_TABLE_FLAGS_NONE    = 0,
+  GX_PRIME_TABLE_FLAGS_FACTORS = 1 << 0
+} GXPrimeTableFlags;
+
+GXPrimeTable *gx_prime_table_new (guint limit, GXPrimeTableFlags flags,
+                                  gint n_threads) G_GNUC_WARN_UNUSED_RESULT;
+GXPrimeTable *gx_prime_table_ref (GXPrimeTable *table);
+void gx_prime_table_unref (GXPrimeTable *table);
+
+guint gx_prime_table_get_limit (GXPrimeTable *table);
+
+gboolean gx_prime_table_is_prime (GXPrimeTable *table, guint n);
+gsize gx_prime_table_count (GXPrimeTable *table, guint n);
+guint gx_prime_table_next (GXPrimeTable *table, guint n);
+GXIter *gx_prime_table_iter (GXPrimeTable *table, guint start)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+guint gx_prime_table_smallest_factor (GXPrimeTable *table, guint n);
+GList *gx_prime_table_factorize (GXPrimeTable *table, guint n)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+void gx_prime_table_set_default (GXPrimeTable *table);
+GXPrimeTable *gx_prime_table_get_default (void);
+
+G_END_DECLS
+
+#endif /* __GX_PRIME_H__ */
@@ -0,0 +1,480 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <string.h>
+
+#include "gxptrarray.h"
+
+/**
+ * SECTION:gxptrarray
+ * @title: Functional pointer arrays
+ * @short_description: the functional operations of #GList for #GPtrArray
+ *
+ * A #GPtrArray keeps its elements in a single contiguous buffer, which is
+ * much kinder to the CPU-caches than a chain of list nodes. The functions
+ * here offer the same operations as their gx_list_ counterparts
+ * (gx_ptr_array_filter(), gx_ptr_array_map(), gx_ptr_array_fold() and so on),
+ * working on that buffer directly.
+ *
+ * The functions that create an array return a new #GPtrArray without an
+ * element free function, as the elements are shared with the original. The
+ * in-place functions free the elements they remove with the @free_func they
+ * are passed; if the array has an element free function of its own (see
+ * g_ptr_array_new_with_free_func()), that is called for the removed elements
+ * as well, just like for g_ptr_array_remove_range(), so one would normally
+ * pass %NULL for @free_func in that case.
+ *
+ * |[<!-- language="C" -->
+ * GPtrArray *nums;
+ *
+ * // numbers 1..100 (inclusive)
+ * nums = gx_ptr_array_iota (100, 1, 1);
+ * // filter out the non-primes
+ * nums = gx_ptr_array_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+ *
+ * g_assert_cmpuint (nums->len, ==, 25);
+ * g_assert_cmpint (gx_ptr_array_sum (nums), ==, 1060);
+ * g_ptr_array_free (nums, TRUE);
+ * ]|
+ */
+
+/* a #GXVec sharing the buffer of array, to re-use the #GXVec functions that
+ * do not change their argument */
+static inline GXVec
+ptr_array_view (GPtrArray *array)
+{
+  GXVec view;
+
+  view.pdata = array->pdata;
+  view.len   = array->len;
+
+  return view;
+}
+
+static GPtrArray*
+ptr_array_copy_range (GPtrArray *array, guint start, guint len)
+{
+  GPtrArray *copy;
+
+  copy = g_ptr_array_sized_new (len);
+  g_ptr_array_set_size (copy, (gint)len);
+  if (len > 0)
+    memcpy (copy->pdata, array->pdata + start, len * sizeof (gpointer));
+
+  return copy;
+}
+
+
+/**
+ * gx_ptr_array_filter:
+ * @array: a #GPtrArray
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Create an array consisting of a shallow copy of the elements of @array for
+ * which the predicate function @pred_func returns %TRUE. This is the
+ * #GPtrArray equivalent of gx_list_filter().
+ *
+ * Returns: (transfer full): the filtered array; free with g_ptr_array_free().
+ */
+GPtrArray*
+gx_ptr_array_filter (GPtrArray *array, GXPred pred_func, gpointer user_data)
+{
+  GPtrArray *filtered;
+  guint      u;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  filtered = g_ptr_array_sized_new (array->len);
+  for (u = 0; u != array->len; ++u)
+    if ((*pred_func) (array->pdata[u], user_data))
+      g_ptr_array_add (filtered, array->pdata[u]);
+
+  return filtered;
+}
+
+
+/**
+ * gx_ptr_array_filter_in_place:
+ * @array: a #GPtrArray
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @free_func: (allow-none): function to free elements that are filtered-out
+ *
+ * Remove elements from @array for which @pred_func does not return %TRUE. The
+ * removed elements are freed with @free_func, and with the element free
+ * function of @array, if any. The remaining elements keep their order. This
+ * is the #GPtrArray equivalent of gx_list_filter_in_place().
+ *
+ * Returns: @array
+ */
+GPtrArray*
+gx_ptr_array_filter_in_place (GPtrArray *array, GXPred pred_func,
+                              gpointer user_data, GDestroyNotify free_func)
+{
+  guint u, kept;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  /* swap the elements we keep to the front, so the removed ones end up
+   * behind them, where g_ptr_array_set_size() gives them to the element free
+   * function of the array */
+  for (u = kept = 0; u != array->len; ++u)
+    {
+      gpointer data;
+
+      data = array->pdata[u];
+      if ((*pred_func) (data, user_data))
+        {
+          array->pdata[u]      = array->pdata[kept];
+          array->pdata[kept++] = data;
+        }
+      else if (free_func)
+        (*free_func) (data);
+    }
+
+  g_ptr_array_set_size (array, (gint)kept);
+
+  return array;
+}
+
+
+/**
+ * gx_ptr_array_every:
+ * @array: a #GPtrArray
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for every element in @array. If @array is
+ * empty, this is considered %TRUE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for every element in @array;
+ * %FALSE otherwise.
+ */
+gboolean
+gx_ptr_array_every (GPtrArray *array, GXPred pred_func, gpointer user_data)
+{
+  GXVec view;
+
+  g_return_val_if_fail (array, FALSE);
+
+  view = ptr_array_view (array);
+
+  return gx_vec_every (&view, pred_func, user_data);
+}
+
+
+/**
+ * gx_ptr_array_any:
+ * @array: a #GPtrArray
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for any element in @array. If @array is
+ * empty, this is considered %FALSE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for at least one element in
+ * @array; %FALSE otherwise.
+ */
+gboolean
+gx_ptr_array_any (GPtrArray *array, GXPred pred_func, gpointer user_data)
+{
+  GXVec view;
+
+  g_return_val_if_fail (array, FALSE);
+
+  view = ptr_array_view (array);
+
+  return gx_vec_any (&view, pred_func, user_data);
+}
+
+
+/**
+ * gx_ptr_array_take:
+ * @array: a #GPtrArray
+ * @n: the number of elements to take
+ *
+ * Take up to @n elements from @array; if @n is greater than the length of
+ * @array, take all of them. The elements are shared between @array and the
+ * result.
+ *
+ * Returns: (transfer full): a new #GPtrArray with up to @n elements; free
+ * with g_ptr_array_free().
+ */
+GPtrArray*
+gx_ptr_array_take (GPtrArray *array, gsize n)
+{
+  g_return_val_if_fail (array, NULL);
+
+  return ptr_array_copy_range (array, 0, (guint)MIN (n, array->len));
+}
+
+
+/**
+ * gx_ptr_array_take_in_place:
+ * @array: a #GPtrArray
+ * @n: the number of elements to take
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Like gx_ptr_array_take(), but affects @array in-place; this reduces @array
+ * to its first @n elements. The removed elements are freed with @free_func,
+ * and with the element free function of @array, if any.
+ *
+ * Returns: @array
+ */
+GPtrArray*
+gx_ptr_array_take_in_place (GPtrArray *array, gsize n,
+                            GDestroyNotify free_func)
+{
+  guint u;
+
+  g_return_val_if_fail (array, NULL);
+
+  if (n >= array->len)
+    return array;
+
+  if (free_func)
+    for (u = (guint)n; u != array->len; ++u)
+      (*free_func) (array->pdata[u]);
+
+  g_ptr_array_set_size (array, (gint)n);
+
+  return array;
+}
+
+
+/**
+ * gx_ptr_array_skip:
+ * @array: a #GPtrArray
+ * @n: the number of elements to skip
+ *
+ * Return a #GPtrArray of all but the first @n elements of @array. If @n is
+ * greater than the length of @array, the result is empty. The elements are
+ * shared between @array and the result.
+ *
+ * Returns: (transfer full): a new #GPtrArray; free with g_ptr_array_free().
+ */
+GPtrArray*
+gx_ptr_array_skip (GPtrArray *array, gsize n)
+{
+  guint start;
+
+  g_return_val_if_fail (array, NULL);
+
+  start = (guint)MIN (n, array->len);
+
+  return ptr_array_copy_range (array, start, array->len - start);
+}
+
+
+/**
+ * gx_ptr_array_skip_in_place:
+ * @array: a #GPtrArray
+ * @n: the number of elements to skip
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Remove the first @n elements from @array. The removed elements are freed
+ * with @free_func, and with the element free function of @array, if any.
+ *
+ * Returns: @array
+ */
+GPtrArray*
+gx_ptr_array_skip_in_place (GPtrArray *array, gsize n,
+                            GDestroyNotify free_func)
+{
+  guint u;
+
+  g_return_val_if_fail (array, NULL);
+
+  n = MIN (n, array->len);
+  if (n == 0)
+    return array;
+
+  if (free_func)
+    for (u = 0; u != n; ++u)
+      (*free_func) (array->pdata[u]);
+
+  g_ptr_array_remove_range (array, 0, (guint)n);
+
+  return array;
+}
+
+
+/**
+ * gx_ptr_array_map:
+ * @array: a #GPtrArray
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Create a new #GPtrArray consisting of the elements obtained by applying
+ * @map_func to the corresponding elements in @array.
+ *
+ * Returns: (transfer full): the array with mapped values. Whether to free the
+ * elements when calling g_ptr_array_free() depends on @map_func.
+ */
+GPtrArray*
+gx_ptr_array_map (GPtrArray *array, GXBinaryFunc map_func, gpointer user_data)
+{
+  GPtrArray *mapped;
+  guint      u;
+
+  g_return_val_if_fail (array, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  mapped = g_ptr_array_sized_new (array->len);
+  g_ptr_array_set_size (mapped, (gint)array->len);
+  for (u = 0; u != array->len; ++u)
+    mapped->pdata[u] = (*map_func) (array->pdata[u], user_data);
+
+  return mapped;
+}
+
+
+/**
+ * gx_ptr_array_map_in_place:
+ * @array: a #GPtrArray
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ * @free_func: (allow-none): a function to free the replaced element
+ *
+ * Replace each element in @array with the value obtained from applying
+ * @map_func to it. Free the old element using @free_func; the element free
+ * function of @array is not called for it.
+ *
+ * Returns: @array
+ */
+GPtrArray*
+gx_ptr_array_map_in_place (GPtrArray *array, GXBinaryFunc map_func,
+                           gpointer user_data, GDestroyNotify free_func)
+{
+  GXVec view;
+
+  g_return_val_if_fail (array, NULL);
+
+  view = ptr_array_view (array);
+  (void)gx_vec_map_in_place (&view, map_func, user_data, free_func);
+
+  return array;
+}
+
+
+/**
+ * gx_ptr_array_fold:
+ * @array: a #GPtrArray
+ * @fold_func: a ternary function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Given an array (a, b, c), compute
+ *      fold_func (fold_func (fold_func (@init, a), b), c)
+ *
+ * This is the #GPtrArray equivalent of gx_list_fold(); as with that function,
+ * the result for an empty @array is %NULL, and a #GXFoldKernel registered for
+ * @fold_func is used when @free_func is %NULL.
+ *
+ * Returns: (transfer full): the computed value.
+ */
+gpointer
+gx_ptr_array_fold (GPtrArray *array, GXTernaryFunc fold_func, gpointer init,
+                   gpointer user_data, GDestroyNotify free_func)
+{
+  GXVec view;
+
+  g_return_val_if_fail (array, NULL);
+
+  view = ptr_array_view (array);
+
+  return gx_vec_fold (&view, fold_func, init, user_data, free_func);
+}
+
+
+/**
+ * gx_ptr_array_iota:
+ * @count: number of elements to generate
+ * @start: the start value
+ * @step: the step size, must be > 0
+ *
+ * Create a #GPtrArray with @count numbers starting at @start, and then
+ * increasing by @step; this is the #GPtrArray equivalent of gx_list_iota().
+ *
+ * Returns: (transfer full): an array with numbers. Free with
+ * g_ptr_array_free().
+ */
+GPtrArray*
+gx_ptr_array_iota (gsize count, gint start, gsize step)
+{
+  GPtrArray *array;
+  guint      u;
+
+  g_return_val_if_fail (step > 0, NULL);
+  g_return_val_if_fail (count <= G_MAXINT, NULL);
+
+  array = g_ptr_array_sized_new ((guint)count);
+  g_ptr_array_set_size (array, (gint)count);
+  for (u = 0; u != count; ++u, start += step)
+    array->pdata[u] = GINT_TO_POINTER (start);
+
+  return array;
+}
+
+
+/**
+ * gx_ptr_array_sum:
+ * @array: a #GPtrArray
+ *
+ * Calculate the sum of an array of integers; see gx_list_sum().
+ *
+ * Returns: the sum of the integers in @array.
+ */
+gint
+gx_ptr_array_sum (GPtrArray *array)
+{
+  GXVec view;
+
+  g_return_val_if_fail (array, 0);
+
+  view = ptr_array_view (array);
+
+  return gx_vec_sum (&view);
+}
+
+
+/**
+ * gx_ptr_array_product:
+ * @array: a #GPtrArray
+ *
+ * Calculate the product of an array of integers; see gx_list_product().
+ *
+ * Returns: the product of the integers in @array.
+ */
+gint
+gx_ptr_array_product (GPtrArray *array)
+{
+  GXVec view;
+
+  g_return_val_if_fail (array, 1);
+
+  view = ptr_array_view (array);
+
+  return gx_vec_product (&view);
+}
@@ -0,0 +1,68 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_PTR_ARRAY_H__
+#define __GX_PTR_ARRAY_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+GPtrArray *gx_ptr_array_filter (GPtrArray *array, GXPred pred_func,
+                                gpointer user_data) G_GNUC_WARN_UNUSED_RESULT;
+GPtrArray *gx_ptr_array_filter_in_place (GPtrArray *array, GXPred pred_func,
+                                         gpointer user_data,
+                                         GDestroyNotify free_func);
+
+gboolean gx_ptr_array_every (GPtrArray *array, GXPred pred_func,
+                             gpointer user_data);
+gboolean gx_ptr_array_any (GPtrArray *array, GXPred pred_func,
+                           gpointer user_data);
+
+GPtrArray *gx_ptr_array_take (GPtrArray *array, gsize n)
+  G_GNUC_WARN_UNUSED_RESULT;
+GPtrArray *gx_ptr_array_take_in_place (GPtrArray *array, gsize n,
+                                       GDestroyNotify free_func);
+
+GPtrArray *gx_ptr_array_skip (GPtrArray *array, gsize n)
+  G_GNUC_WARN_UNUSED_RESULT;
+GPtrArray *gx_ptr_array_skip_in_place (GPtrArray *array, gsize n,
+                                       GDestroyNotify free_func);
+
+GPtrArray *gx_ptr_array_map (GPtrArray *array, GXBinaryFunc map_func,
+                             gpointer user_data) G_GNUC_WARN_UNUSED_RESULT;
+GPtrArray *gx_ptr_array_map_in_place (GPtrArray *array, GXBinaryFunc map_func,
+                                      gpointer user_data,
+                                      GDestroyNotify free_func);
+
+gpointer gx_ptr_array_fold (GPtrArray *array, GXTernaryFunc fold_func,
+                            gpointer init, gpointer user_data,
+                            GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GPtrArray *gx_ptr_array_iota (gsize count, gint start, gsize step)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gint gx_ptr_array_sum (GPtrArray *array);
+gint gx_ptr_array_product (GPtrArray *array);
+
+G_END_DECLS
+
+#endif /* __GX_PTR_ARRAY_H__ */
@@ -0,0 +1,436 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxqueue.h"
+
+/**
+ * SECTION:gxqueue
+ * @title: Functional queues
+ * @short_description: the functional operations of #GList for #GQueue
+ *
+ * A #GQueue keeps track of both ends of its list and of its length, so it can
+ * grow and shrink at either end in constant time. The functions here offer
+ * the same operations as their gx_list_ counterparts (gx_queue_filter(),
+ * gx_queue_map(), gx_queue_fold() and so on), and keep the head, tail and
+ * length of the queue up-to-date as they go.
+ *
+ * The functions that create a queue return a new #GQueue, to be freed with
+ * g_queue_free(); the in-place ones modify and return the queue they are
+ * passed. The nodes of a #GQueue are never taken from a #GXListArena.
+ *
+ * |[<!-- language="C" -->
+ * GQueue *nums;
+ *
+ * // numbers 1..100 (inclusive)
+ * nums = gx_queue_iota (100, 1, 1);
+ * // filter out the non-primes
+ * nums = gx_queue_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+ *
+ * g_assert_cmpuint (nums->length, ==, 25);
+ * g_assert_cmpint (gx_queue_sum (nums), ==, 1060);
+ * g_queue_free (nums);
+ * ]|
+ */
+
+
+/**
+ * gx_queue_filter:
+ * @queue: a #GQueue
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Create a queue consisting of a shallow copy of the elements of @queue for
+ * which the predicate function @pred_func returns %TRUE. This is the #GQueue
+ * equivalent of gx_list_filter().
+ *
+ * Returns: (transfer full): the filtered queue; free with g_queue_free().
+ */
+GQueue*
+gx_queue_filter (GQueue *queue, GXPred pred_func, gpointer user_data)
+{
+  GQueue *filtered;
+  GList  *cur;
+
+  g_return_val_if_fail (queue, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  filtered = g_queue_new ();
+  for (cur = queue->head; cur; cur = cur->next)
+    if ((*pred_func) (cur->data, user_data))
+      g_queue_push_tail (filtered, cur->data);
+
+  return filtered;
+}
+
+
+/**
+ * gx_queue_filter_in_place:
+ * @queue: a #GQueue
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @free_func: (allow-none): function to free elements that are filtered-out
+ *
+ * Remove elements from @queue for which @pred_func does not return %TRUE, and
+ * free them with @free_func. The remaining elements keep their order. This is
+ * the #GQueue equivalent of gx_list_filter_in_place().
+ *
+ * Returns: @queue
+ */
+GQueue*
+gx_queue_filter_in_place (GQueue *queue, GXPred pred_func, gpointer user_data,
+                          GDestroyNotify free_func)
+{
+  GList *cur;
+
+  g_return_val_if_fail (queue, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  for (cur = queue->head; cur;)
+    {
+      GList *next;
+
+      next = cur->next;
+      if (!(*pred_func) (cur->data, user_data))
+        {
+          if (free_func)
+            (*free_func) (cur->data);
+          g_queue_delete_link (queue, cur);
+        }
+
+      cur = next;
+    }
+
+  return queue;
+}
+
+
+/**
+ * gx_queue_every:
+ * @queue: a #GQueue
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for every element in @queue. If @queue is
+ * empty, this is considered %TRUE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for every element in @queue;
+ * %FALSE otherwise.
+ */
+gboolean
+gx_queue_every (GQueue *queue, GXPred pred_func, gpointer user_data)
+{
+  GList *cur;
+
+  g_return_val_if_fail (queue, FALSE);
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (cur = queue->head; cur; cur = cur->next)
+    if (!(*pred_func) (cur->data, user_data))
+      return FALSE;
+
+  return TRUE;
+}
+
+
+/**
+ * gx_queue_any:
+ * @queue: a #GQueue
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for any element in @queue. If @queue is
+ * empty, this is considered %FALSE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for at least one element in
+ * @queue; %FALSE otherwise.
+ */
+gboolean
+gx_queue_any (GQueue *queue, GXPred pred_func, gpointer user_data)
+{
+  GList *cur;
+
+  g_return_val_if_fail (queue, FALSE);
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (cur = queue->head; cur; cur = cur->next)
+    if ((*pred_func) (cur->data, user_data))
+      return TRUE;
+
+  return FALSE;
+}
+
+
+/**
+ * gx_queue_take:
+ * @queue: a #GQueue
+ * @n: the number of elements to take
+ *
+ * Take up to @n elements from @queue; if @n is greater than the length of
+ * @queue, take all of them. The elements are shared between @queue and the
+ * result.
+ *
+ * Returns: (transfer full): a new queue with up to @n elements; free with
+ * g_queue_free().
+ */
+GQueue*
+gx_queue_take (GQueue *queue, gsize n)
+{
+  GQueue *taken;
+  GList  *cur;
+
+  g_return_val_if_fail (queue, NULL);
+
+  taken = g_queue_new ();
+  for (cur = queue->head; cur && n != 0; cur = cur->next, --n)
+    g_queue_push_tail (taken, cur->data);
+
+  return taken;
+}
+
+
+/**
+ * gx_queue_take_in_place:
+ * @queue: a #GQueue
+ * @n: the number of elements to take
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Like gx_queue_take(), but affects @queue in-place; this reduces @queue to
+ * its first @n elements. The elements are removed from the tail, so this
+ * takes time proportional to the number of removed elements only.
+ *
+ * Returns: @queue
+ */
+GQueue*
+gx_queue_take_in_place (GQueue *queue, gsize n, GDestroyNotify free_func)
+{
+  g_return_val_if_fail (queue, NULL);
+
+  while (queue->length > n)
+    {
+      gpointer data;
+
+      data = g_queue_pop_tail (queue);
+      if (free_func)
+        (*free_func) (data);
+    }
+
+  return queue;
+}
+
+
+/**
+ * gx_queue_skip:
+ * @queue: a #GQueue
+ * @n: the number of elements to skip
+ *
+ * Return a queue of all but the first @n elements of @queue. If @n is greater
+ * than the length of @queue, the result is empty. The elements are shared
+ * between @queue and the result.
+ *
+ * Returns: (transfer full): a new queue; free with g_queue_free().
+ */
+GQueue*
+gx_queue_skip (GQueue *queue, gsize n)
+{
+  GQueue *skipped;
+  GList  *cur;
+
+  g_return_val_if_fail (queue, NULL);
+
+  skipped = g_queue_new ();
+  if (n >= queue->length)
+    return skipped;
+
+  for (cur = queue->tail, n = queue->length - n; n != 0; cur = cur->prev, --n)
+    g_queue_push_head (skipped, cur->data);
+
+  return skipped;
+}
+
+
+/**
+ * gx_queue_skip_in_place:
+ * @queue: a #GQueue
+ * @n: the number of elements to skip
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Remove the first @n elements from @queue.
+ *
+ * Returns: @queue
+ */
+GQueue*
+gx_queue_skip_in_place (GQueue *queue, gsize n, GDestroyNotify free_func)
+{
+  g_return_val_if_fail (queue, NULL);
+
+  for (n = MIN (n, queue->length); n != 0; --n)
+    {
+      gpointer data;
+
+      data = g_queue_pop_head (queue);
+      if (free_func)
+        (*free_func) (data);
+    }
+
+  return queue;
+}
+
+
+/**
+ * gx_queue_map:
+ * @queue: a #GQueue
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Create a new queue consisting of the elements obtained by applying
+ * @map_func to the corresponding elements in @queue.
+ *
+ * Returns: (transfer full): the queue with mapped values. Whether to free the
+ * elements when calling g_queue_free() depends on @map_func.
+ */
+GQueue*
+gx_queue_map (GQueue *queue, GXBinaryFunc map_func, gpointer user_data)
+{
+  GQueue *mapped;
+  GList  *cur;
+
+  g_return_val_if_fail (queue, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  mapped = g_queue_new ();
+  for (cur = queue->head; cur; cur = cur->next)
+    g_queue_push_tail (mapped, (*map_func) (cur->data, user_data));
+
+  return mapped;
+}
+
+
+/**
+ * gx_queue_map_in_place:
+ * @queue: a #GQueue
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ * @free_func: (allow-none): a function to free the replaced element
+ *
+ * Replace each element in @queue with the value obtained from applying
+ * @map_func to it. Free the old element using @free_func.
+ *
+ * Returns: @queue
+ */
+GQueue*
+gx_queue_map_in_place (GQueue *queue, GXBinaryFunc map_func,
+                       gpointer user_data, GDestroyNotify free_func)
+{
+  g_return_val_if_fail (queue, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  /* the nodes stay the same, so head, tail and length do too */
+  (void)gx_list_map_in_place (queue->head, map_func, user_data, free_func);
+
+  return queue;
+}
+
+
+/**
+ * gx_queue_fold:
+ * @queue: a #GQueue
+ * @fold_func: a ternary function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Given a queue (a, b, c), compute
+ *      fold_func (fold_func (fold_func (@init, a), b), c)
+ *
+ * This is the #GQueue equivalent of gx_list_fold(); as with that function,
+ * the result for an empty @queue is %NULL, and a #GXFoldKernel registered for
+ * @fold_func is used when @free_func is %NULL.
+ *
+ * Returns: (transfer full): the computed value.
+ */
+gpointer
+gx_queue_fold (GQueue *queue, GXTernaryFunc fold_func, gpointer init,
+               gpointer user_data, GDestroyNotify free_func)
+{
+  g_return_val_if_fail (queue, NULL);
+  g_return_val_if_fail (fold_func, NULL);
+
+  return gx_list_fold (queue->head, fold_func, init, user_data, free_func);
+}
+
+
+/**
+ * gx_queue_iota:
+ * @count: number of elements to generate
+ * @start: the start value
+ * @step: the step size, must be > 0
+ *
+ * Create a #GQueue with @count numbers starting at @start, and then
+ * increasing by @step; this is the #GQueue equivalent of gx_list_iota().
+ *
+ * Returns: (transfer full): a queue with numbers. Free with g_queue_free().
+ */
+GQueue*
+gx_queue_iota (gsize count, gint start, gsize step)
+{
+  GQueue *queue;
+
+  g_return_val_if_fail (step > 0, NULL);
+
+  queue = g_queue_new ();
+  for (; count > 0; --count, start += step)
+    g_queue_push_tail (queue, GINT_TO_POINTER (start));
+
+  return queue;
+}
+
+
+/**
+ * gx_queue_sum:
+ * @queue: a #GQueue
+ *
+ * Calculate the sum of a queue of integers; see gx_list_sum().
+ *
+ * Returns: the sum of the integers in @queue.
+ */
+gint
+gx_queue_sum (GQueue *queue)
+{
+  g_return_val_if_fail (queue, 0);
+
+  return gx_list_sum (queue->head);
+}
+
+
+/**
+ * gx_queue_product:
+ * @queue: a #GQueue
+ *
+ * Calculate the product of a queue of integers; see gx_list_product().
+ *
+ * Returns: the product of the integers in @queue.
+ */
+gint
+gx_queue_product (GQueue *queue)
+{
+  g_return_val_if_fail (queue, 1);
+
+  return gx_list_product (queue->head);
+}
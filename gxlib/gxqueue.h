@@ -0,0 +1,61 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_QUEUE_H__
+#define __GX_QUEUE_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+GQueue *gx_queue_filter (GQueue *queue, GXPred pred_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GQueue *gx_queue_filter_in_place (GQueue *queue, GXPred pred_func,
+                                  gpointer user_data, GDestroyNotify free_func);
+
+gboolean gx_queue_every (GQueue *queue, GXPred pred_func, gpointer user_data);
+gboolean gx_queue_any (GQueue *queue, GXPred pred_func, gpointer user_data);
+
+GQueue *gx_queue_take (GQueue *queue, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GQueue *gx_queue_take_in_place (GQueue *queue, gsize n,
+                                GDestroyNotify free_func);
+
+GQueue *gx_queue_skip (GQueue *queue, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GQueue *gx_queue_skip_in_place (GQueue *queue, gsize n,
+                                GDestroyNotify free_func);
+
+GQueue *gx_queue_map (GQueue *queue, GXBinaryFunc map_func,
+                      gpointer user_data) G_GNUC_WARN_UNUSED_RESULT;
+GQueue *gx_queue_map_in_place (GQueue *queue, GXBinaryFunc map_func,
+                               gpointer user_data, GDestroyNotify free_func);
+
+gpointer gx_queue_fold (GQueue *queue, GXTernaryFunc fold_func, gpointer init,
+                        gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GQueue *gx_queue_iota (gsize count, gint start, gsize step)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gint gx_queue_sum (GQueue *queue);
+gint gx_queue_product (GQueue *queue);
+
+G_END_DECLS
+
+#endif /* __GX_QUEUE_H__ */
@@ -0,0 +1,544 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxsequence.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxsequence
+ * @title: Functional sequences
+ * @short_description: the functional operations of #GList for #GSequence
+ *
+ * A #GSequence is a balanced tree that behaves like a list, but with
+ * logarithmic-time access by position, insertion and removal. The functions
+ * here offer the same operations as their gx_list_ counterparts
+ * (gx_sequence_filter(), gx_sequence_map(), gx_sequence_fold() and so on),
+ * walking the sequence with its #GSequenceIter<!-- -->s. Taking or skipping
+ * elements finds the split point by position, rather than by walking up to
+ * it.
+ *
+ * The functions that create a sequence return a new #GSequence without a
+ * destroy function, as the elements are shared with the original. The
+ * in-place functions free the elements they remove or replace with the
+ * @free_func they are passed; if the sequence has a #GDestroyNotify of its
+ * own (see g_sequence_new()), that is called for them as well, so one would
+ * normally pass %NULL for @free_func in that case.
+ *
+ * |[<!-- language="C" -->
+ * GSequence *nums;
+ *
+ * // numbers 1..100 (inclusive)
+ * nums = gx_sequence_iota (100, 1, 1);
+ * // filter out the non-primes
+ * nums = gx_sequence_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+ *
+ * g_assert_cmpint (g_sequence_get_length (nums), ==, 25);
+ * g_assert_cmpint (gx_sequence_sum (nums), ==, 1060);
+ * g_sequence_free (nums);
+ * ]|
+ */
+
+/* the iterator for position n, or the end iterator if n is beyond the end */
+static GSequenceIter*
+sequence_iter_at (GSequence *seq, gsize n)
+{
+  if (n >= (gsize)g_sequence_get_length (seq))
+    return g_sequence_get_end_iter (seq);
+
+  return g_sequence_get_iter_at_pos (seq, (gint)n);
+}
+
+/* a new sequence with the elements in begin .. end */
+static GSequence*
+sequence_copy_range (GSequenceIter *begin, GSequenceIter *end)
+{
+  GSequence *copy;
+
+  copy = g_sequence_new (NULL);
+  for (; begin != end; begin = g_sequence_iter_next (begin))
+    g_sequence_append (copy, g_sequence_get (begin));
+
+  return copy;
+}
+
+/* free the elements in begin .. end with free_func, and remove them */
+static void
+sequence_remove_range (GSequenceIter *begin, GSequenceIter *end,
+                       GDestroyNotify free_func)
+{
+  GSequenceIter *iter;
+
+  if (free_func)
+    for (iter = begin; iter != end; iter = g_sequence_iter_next (iter))
+      (*free_func) (g_sequence_get (iter));
+
+  g_sequence_remove_range (begin, end);
+}
+
+
+/**
+ * gx_sequence_filter:
+ * @seq: a #GSequence
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Create a sequence consisting of a shallow copy of the elements of @seq for
+ * which the predicate function @pred_func returns %TRUE. This is the
+ * #GSequence equivalent of gx_list_filter().
+ *
+ * Returns: (transfer full): the filtered sequence; free with
+ * g_sequence_free().
+ */
+GSequence*
+gx_sequence_filter (GSequence *seq, GXPred pred_func, gpointer user_data)
+{
+  GSequence     *filtered;
+  GSequenceIter *iter;
+
+  g_return_val_if_fail (seq, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  filtered = g_sequence_new (NULL);
+  for (iter = g_sequence_get_begin_iter (seq); !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    {
+      gpointer data;
+
+      data = g_sequence_get (iter);
+      if ((*pred_func) (data, user_data))
+        g_sequence_append (filtered, data);
+    }
+
+  return filtered;
+}
+
+
+/**
+ * gx_sequence_filter_in_place:
+ * @seq: a #GSequence
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @free_func: (allow-none): function to free elements that are filtered-out
+ *
+ * Remove elements from @seq for which @pred_func does not return %TRUE. The
+ * removed elements are freed with @free_func, and with the destroy function
+ * of @seq, if any. The remaining elements keep their order. This is the
+ * #GSequence equivalent of gx_list_filter_in_place().
+ *
+ * Returns: @seq
+ */
+GSequence*
+gx_sequence_filter_in_place (GSequence *seq, GXPred pred_func,
+                             gpointer user_data, GDestroyNotify free_func)
+{
+  GSequenceIter *iter;
+
+  g_return_val_if_fail (seq, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  for (iter = g_sequence_get_begin_iter (seq); !g_sequence_iter_is_end (iter);)
+    {
+      GSequenceIter *next;
+      gpointer       data;
+
+      next = g_sequence_iter_next (iter);
+      data = g_sequence_get (iter);
+      if (!(*pred_func) (data, user_data))
+        {
+          if (free_func)
+            (*free_func) (data);
+          g_sequence_remove (iter);
+        }
+
+      iter = next;
+    }
+
+  return seq;
+}
+
+
+/**
+ * gx_sequence_every:
+ * @seq: a #GSequence
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for every element in @seq. If @seq is empty,
+ * this is considered %TRUE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for every element in @seq;
+ * %FALSE otherwise.
+ */
+gboolean
+gx_sequence_every (GSequence *seq, GXPred pred_func, gpointer user_data)
+{
+  GSequenceIter *iter;
+
+  g_return_val_if_fail (seq, FALSE);
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (iter = g_sequence_get_begin_iter (seq); !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    if (!(*pred_func) (g_sequence_get (iter), user_data))
+      return FALSE;
+
+  return TRUE;
+}
+
+
+/**
+ * gx_sequence_any:
+ * @seq: a #GSequence
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for any element in @seq. If @seq is empty,
+ * this is considered %FALSE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for at least one element in
+ * @seq; %FALSE otherwise.
+ */
+gboolean
+gx_sequence_any (GSequence *seq, GXPred pred_func, gpointer user_data)
+{
+  GSequenceIter *iter;
+
+  g_return_val_if_fail (seq, FALSE);
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (iter = g_sequence_get_begin_iter (seq); !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    if ((*pred_func) (g_sequence_get (iter), user_data))
+      return TRUE;
+
+  return FALSE;
+}
+
+
+/**
+ * gx_sequence_take:
+ * @seq: a #GSequence
+ * @n: the number of elements to take
+ *
+ * Take up to @n elements from @seq; if @n is greater than the length of
+ * @seq, take all of them. The elements are shared between @seq and the
+ * result.
+ *
+ * Returns: (transfer full): a new #GSequence with up to @n elements; free
+ * with g_sequence_free().
+ */
+GSequence*
+gx_sequence_take (GSequence *seq, gsize n)
+{
+  g_return_val_if_fail (seq, NULL);
+
+  return sequence_copy_range (g_sequence_get_begin_iter (seq),
+                              sequence_iter_at (seq, n));
+}
+
+
+/**
+ * gx_sequence_take_in_place:
+ * @seq: a #GSequence
+ * @n: the number of elements to take
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Like gx_sequence_take(), but affects @seq in-place; this reduces @seq to
+ * its first @n elements. The removed elements are freed with @free_func, and
+ * with the destroy function of @seq, if any.
+ *
+ * Returns: @seq
+ */
+GSequence*
+gx_sequence_take_in_place (GSequence *seq, gsize n, GDestroyNotify free_func)
+{
+  g_return_val_if_fail (seq, NULL);
+
+  sequence_remove_range (sequence_iter_at (seq, n),
+                         g_sequence_get_end_iter (seq), free_func);
+
+  return seq;
+}
+
+
+/**
+ * gx_sequence_skip:
+ * @seq: a #GSequence
+ * @n: the number of elements to skip
+ *
+ * Return a #GSequence of all but the first @n elements of @seq. If @n is
+ * greater than the length of @seq, the result is empty. The elements are
+ * shared between @seq and the result.
+ *
+ * Returns: (transfer full): a new #GSequence; free with g_sequence_free().
+ */
+GSequence*
+gx_sequence_skip (GSequence *seq, gsize n)
+{
+  g_return_val_if_fail (seq, NULL);
+
+  return sequence_copy_range (sequence_iter_at (seq, n),
+                              g_sequence_get_end_iter (seq));
+}
+
+
+/**
+ * gx_sequence_skip_in_place:
+ * @seq: a #GSequence
+ * @n: the number of elements to skip
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Remove the first @n elements from @seq. The removed elements are freed
+ * with @free_func, and with the destroy function of @seq, if any.
+ *
+ * Returns: @seq
+ */
+GSequence*
+gx_sequence_skip_in_place (GSequence *seq, gsize n, GDestroyNotify free_func)
+{
+  g_return_val_if_fail (seq, NULL);
+
+  sequence_remove_range (g_sequence_get_begin_iter (seq),
+                         sequence_iter_at (seq, n), free_func);
+
+  return seq;
+}
+
+
+/**
+ * gx_sequence_map:
+ * @seq: a #GSequence
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Create a new #GSequence consisting of the elements obtained by applying
+ * @map_func to the corresponding elements in @seq.
+ *
+ * Returns: (transfer full): the sequence with mapped values. Whether to free
+ * the elements after calling g_sequence_free() depends on @map_func.
+ */
+GSequence*
+gx_sequence_map (GSequence *seq, GXBinaryFunc map_func, gpointer user_data)
+{
+  GSequence     *mapped;
+  GSequenceIter *iter;
+
+  g_return_val_if_fail (seq, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  mapped = g_sequence_new (NULL);
+  for (iter = g_sequence_get_begin_iter (seq); !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    g_sequence_append (mapped, (*map_func) (g_sequence_get (iter), user_data));
+
+  return mapped;
+}
+
+
+/**
+ * gx_sequence_map_in_place:
+ * @seq: a #GSequence
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ * @free_func: (allow-none): a function to free the replaced element
+ *
+ * Replace each element in @seq with the value obtained from applying
+ * @map_func to it. Free the old element using @free_func, and with the
+ * destroy function of @seq, if any (as g_sequence_set() does). Elements for
+ * which @map_func returns the element itself are left alone, and not freed.
+ *
+ * Returns: @seq
+ */
+GSequence*
+gx_sequence_map_in_place (GSequence *seq, GXBinaryFunc map_func,
+                          gpointer user_data, GDestroyNotify free_func)
+{
+  GSequenceIter *iter;
+
+  g_return_val_if_fail (seq, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  for (iter = g_sequence_get_begin_iter (seq); !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    {
+      gpointer old, mapped;
+
+      old    = g_sequence_get (iter);
+      mapped = (*map_func) (old, user_data);
+      if (mapped == old)
+        continue;
+
+      g_sequence_set (iter, mapped);
+      if (free_func)
+        (*free_func) (old);
+    }
+
+  return seq;
+}
+
+
+static gpointer
+sequence_fold_kernel (GSequence *seq, GXFoldKernel kernel, gpointer init,
+                      gpointer user_data)
+{
+  gpointer       batch[FOLD_BATCH_SIZE];
+  gpointer       result;
+  GSequenceIter *iter;
+
+  iter = g_sequence_get_begin_iter (seq);
+  if (g_sequence_iter_is_end (iter))
+    return NULL;
+
+  for (result = init; !g_sequence_iter_is_end (iter);)
+    {
+      gsize n;
+
+      for (n = 0; !g_sequence_iter_is_end (iter) && n != FOLD_BATCH_SIZE;
+           iter = g_sequence_iter_next (iter))
+        batch[n++] = g_sequence_get (iter);
+
+      result = kernel (result, batch, n, user_data);
+    }
+
+  return result;
+}
+
+/**
+ * gx_sequence_fold:
+ * @seq: a #GSequence
+ * @fold_func: a ternary function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Given a sequence (a, b, c), compute
+ *      fold_func (fold_func (fold_func (@init, a), b), c)
+ *
+ * This is the #GSequence equivalent of gx_list_fold(); as with that function,
+ * the result for an empty @seq is %NULL, and a #GXFoldKernel registered for
+ * @fold_func is used when @free_func is %NULL.
+ *
+ * Returns: (transfer full): the computed value.
+ */
+gpointer
+gx_sequence_fold (GSequence *seq, GXTernaryFunc fold_func, gpointer init,
+                  gpointer user_data, GDestroyNotify free_func)
+{
+  gpointer       result, first;
+  GSequenceIter *iter;
+  GXFoldKernel   kernel;
+
+  g_return_val_if_fail (seq, NULL);
+  g_return_val_if_fail (fold_func, NULL);
+
+  kernel = free_func ? NULL : gx_fold_kernel_lookup (fold_func);
+  if (kernel)
+    return sequence_fold_kernel (seq, kernel, init, user_data);
+
+  for (result = NULL, first = init, iter = g_sequence_get_begin_iter (seq);
+       !g_sequence_iter_is_end (iter); iter = g_sequence_iter_next (iter))
+    {
+      gpointer tmp;
+
+      tmp = (*fold_func) (first, g_sequence_get (iter), user_data);
+      if (free_func)
+        (*free_func) (result);
+
+      result = tmp;
+      first  = result;
+    }
+
+  return result;
+}
+
+
+/**
+ * gx_sequence_iota:
+ * @count: number of elements to generate
+ * @start: the start value
+ * @step: the step size, must be > 0
+ *
+ * Create a #GSequence with @count numbers starting at @start, and then
+ * increasing by @step; this is the #GSequence equivalent of gx_list_iota().
+ *
+ * Returns: (transfer full): a sequence with numbers. Free with
+ * g_sequence_free().
+ */
+GSequence*
+gx_sequence_iota (gsize count, gint start, gsize step)
+{
+  GSequence *seq;
+
+  g_return_val_if_fail (step > 0, NULL);
+
+  seq = g_sequence_new (NULL);
+  for (; count > 0; --count, start += step)
+    g_sequence_append (seq, GINT_TO_POINTER (start));
+
+  return seq;
+}
+
+
+/**
+ * gx_sequence_sum:
+ * @seq: a #GSequence
+ *
+ * Calculate the sum of a sequence of integers; see gx_list_sum().
+ *
+ * Returns: the sum of the integers in @seq.
+ */
+gint
+gx_sequence_sum (GSequence *seq)
+{
+  GSequenceIter *iter;
+  gint           sum;
+
+  g_return_val_if_fail (seq, 0);
+
+  for (sum = 0, iter = g_sequence_get_begin_iter (seq);
+       !g_sequence_iter_is_end (iter); iter = g_sequence_iter_next (iter))
+    sum += GPOINTER_TO_INT (g_sequence_get (iter));
+
+  return sum;
+}
+
+
+/**
+ * gx_sequence_product:
+ * @seq: a #GSequence
+ *
+ * Calculate the product of a sequence of integers; see gx_list_product().
+ *
+ * Returns: the product of the integers in @seq.
+ */
+gint
+gx_sequence_product (GSequence *seq)
+{
+  GSequenceIter *iter;
+  gint           product;
+
+  g_return_val_if_fail (seq, 1);
+
+  for (product = 1, iter = g_sequence_get_begin_iter (seq);
+       !g_sequence_iter_is_end (iter); iter = g_sequence_iter_next (iter))
+    product *= GPOINTER_TO_INT (g_sequence_get (iter));
+
+  return product;
+}
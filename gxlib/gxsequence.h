@@ -0,0 +1,68 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_SEQUENCE_H__
+#define __GX_SEQUENCE_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+GSequence *gx_sequence_filter (GSequence *seq, GXPred pred_func,
+                               gpointer user_data) G_GNUC_WARN_UNUSED_RESULT;
+GSequence *gx_sequence_filter_in_place (GSequence *seq, GXPred pred_func,
+                                        gpointer user_data,
+                                        GDestroyNotify free_func);
+
+gboolean gx_sequence_every (GSequence *seq, GXPred pred_func,
+                            gpointer user_data);
+gboolean gx_sequence_any (GSequence *seq, GXPred pred_func,
+                          gpointer user_data);
+
+GSequence *gx_sequence_take (GSequence *seq, gsize n)
+  G_GNUC_WARN_UNUSED_RESULT;
+GSequence *gx_sequence_take_in_place (GSequence *seq, gsize n,
+                                      GDestroyNotify free_func);
+
+GSequence *gx_sequence_skip (GSequence *seq, gsize n)
+  G_GNUC_WARN_UNUSED_RESULT;
+GSequence *gx_sequence_skip_in_place (GSequence *seq, gsize n,
+                                      GDestroyNotify free_func);
+
+GSequence *gx_sequence_map (GSequence *seq, GXBinaryFunc map_func,
+                            gpointer user_data) G_GNUC_WARN_UNUSED_RESULT;
+GSequence *gx_sequence_map_in_place (GSequence *seq, GXBinaryFunc map_func,
+                                     gpointer user_data,
+                                     GDestroyNotify free_func);
+
+gpointer gx_sequence_fold (GSequence *seq, GXTernaryFunc fold_func,
+                           gpointer init, gpointer user_data,
+                           GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GSequence *gx_sequence_iota (gsize count, gint start, gsize step)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gint gx_sequence_sum (GSequence *seq);
+gint gx_sequence_product (GSequence *seq);
+
+G_END_DECLS
+
+#endif /* __GX_SEQUENCE_H__ */
@@ -0,0 +1,516 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include "gxslist.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxslist
+ * @title: Functional singly-linked lists
+ * @short_description: the functional operations of #GList for #GSList
+ *
+ * A #GSList node is a third smaller than a #GList node, which adds up for
+ * long lists. The functions here offer the same operations as their gx_list_
+ * counterparts (gx_slist_filter(), gx_slist_map(), gx_slist_fold() and so
+ * on), working on the #GSList nodes directly.
+ *
+ * Unlike #GList nodes, #GSList nodes are never taken from a #GXListArena; the
+ * lists created here are freed with g_slist_free() as usual.
+ *
+ * |[<!-- language="C" -->
+ * GSList *nums;
+ *
+ * // numbers 1..100 (inclusive)
+ * nums = gx_slist_iota (100, 1, 1);
+ * // filter out the non-primes
+ * nums = gx_slist_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+ *
+ * g_assert_cmpint (gx_slist_sum (nums), ==, 1060);
+ * g_slist_free (nums);
+ * ]|
+ */
+
+/* build a list front-to-back */
+typedef struct {
+  GSList *head;
+  GSList *tail;
+} SListBuilder;
+
+static inline void
+slist_builder_init (SListBuilder *builder)
+{
+  builder->head = builder->tail = NULL;
+}
+
+static inline void
+slist_builder_append (SListBuilder *builder, gpointer data)
+{
+  GSList *node;
+
+  node       = g_slist_alloc ();
+  node->data = data;
+
+  if (builder->tail)
+    builder->tail->next = node;
+  else
+    builder->head = node;
+
+  builder->tail = node;
+}
+
+static void
+slist_free_full (GSList *list, GDestroyNotify free_func)
+{
+  if (free_func)
+    g_slist_free_full (list, free_func);
+  else
+    g_slist_free (list);
+}
+
+
+/**
+ * gx_slist_filter:
+ * @list: a #GSList
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Create a list consisting of a shallow copy of the elements of @list for
+ * which the predicate function @pred_func returns %TRUE. This is the #GSList
+ * equivalent of gx_list_filter().
+ *
+ * Returns: (transfer full): the filtered list; free with g_slist_free().
+ */
+GSList*
+gx_slist_filter (GSList *list, GXPred pred_func, gpointer user_data)
+{
+  SListBuilder filtered;
+
+  g_return_val_if_fail (pred_func, NULL);
+
+  slist_builder_init (&filtered);
+  for (; list; list = list->next)
+    if ((*pred_func) (list->data, user_data))
+      slist_builder_append (&filtered, list->data);
+
+  return filtered.head;
+}
+
+
+/**
+ * gx_slist_filter_in_place:
+ * @list: a #GSList
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @free_func: (allow-none): function to free elements that are filtered-out
+ *
+ * Remove elements from @list for which @pred_func does not return %TRUE, and
+ * free them with @free_func. The nodes of the remaining elements are re-used.
+ * This is the #GSList equivalent of gx_list_filter_in_place().
+ *
+ * Returns: the filtered list
+ */
+GSList*
+gx_slist_filter_in_place (GSList *list, GXPred pred_func, gpointer user_data,
+                          GDestroyNotify free_func)
+{
+  GSList **link, *cur;
+
+  g_return_val_if_fail (pred_func, NULL);
+
+  /* link points at the pointer to cur, so removing the head is no special
+   * case */
+  for (link = &list; (cur = *link);)
+    {
+      if ((*pred_func) (cur->data, user_data))
+        {
+          link = &cur->next;
+          continue;
+        }
+
+      *link = cur->next;
+      if (free_func)
+        (*free_func) (cur->data);
+
+      g_slist_free_1 (cur);
+    }
+
+  return list;
+}
+
+
+/**
+ * gx_slist_every:
+ * @list: a #GSList
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for every element in @list. If @list is
+ * empty, this is considered %TRUE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for every element in @list;
+ * %FALSE otherwise.
+ */
+gboolean
+gx_slist_every (GSList *list, GXPred pred_func, gpointer user_data)
+{
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (; list; list = list->next)
+    if (!(*pred_func) (list->data, user_data))
+      return FALSE;
+
+  return TRUE;
+}
+
+
+/**
+ * gx_slist_any:
+ * @list: a #GSList
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for any element in @list. If @list is empty,
+ * this is considered %FALSE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for at least one element in
+ * @list; %FALSE otherwise.
+ */
+gboolean
+gx_slist_any (GSList *list, GXPred pred_func, gpointer user_data)
+{
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (; list; list = list->next)
+    if ((*pred_func) (list->data, user_data))
+      return TRUE;
+
+  return FALSE;
+}
+
+
+/**
+ * gx_slist_take:
+ * @list: a #GSList
+ * @n: the number of elements to take
+ *
+ * Take up to @n elements from @list; if @n is greater than the length of
+ * @list, take all of them. The elements are shared between @list and the
+ * result.
+ *
+ * Returns: (transfer full): a new list with up to @n elements; free with
+ * g_slist_free().
+ */
+GSList*
+gx_slist_take (GSList *list, gsize n)
+{
+  SListBuilder taken;
+
+  slist_builder_init (&taken);
+  for (; list && n != 0; list = list->next, --n)
+    slist_builder_append (&taken, list->data);
+
+  return taken.head;
+}
+
+
+/**
+ * gx_slist_take_in_place:
+ * @list: a #GSList
+ * @n: the number of elements to take
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Like gx_slist_take(), but affects @list in-place; this reduces @list to its
+ * first @n elements.
+ *
+ * Returns: the list with up to @n elements.
+ */
+GSList*
+gx_slist_take_in_place (GSList *list, gsize n, GDestroyNotify free_func)
+{
+  GSList *cur;
+
+  if (n == 0)
+    {
+      slist_free_full (list, free_func);
+      return NULL;
+    }
+
+  for (cur = list; cur && n > 1; cur = cur->next, --n);
+
+  if (cur && cur->next)
+    {
+      slist_free_full (cur->next, free_func);
+      cur->next = NULL;
+    }
+
+  return list;
+}
+
+
+/**
+ * gx_slist_skip:
+ * @list: a #GSList
+ * @n: the number of elements to skip
+ *
+ * Return a list of all but the first @n elements of @list. If @n is greater
+ * than the length of @list, the result is empty. The elements are shared
+ * between @list and the result.
+ *
+ * Returns: (transfer full): a new list; free with g_slist_free().
+ */
+GSList*
+gx_slist_skip (GSList *list, gsize n)
+{
+  SListBuilder skipped;
+
+  for (; list && n != 0; list = list->next, --n);
+
+  slist_builder_init (&skipped);
+  for (; list; list = list->next)
+    slist_builder_append (&skipped, list->data);
+
+  return skipped.head;
+}
+
+
+/**
+ * gx_slist_skip_in_place:
+ * @list: a #GSList
+ * @n: the number of elements to skip
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Remove the first @n elements from @list.
+ *
+ * Returns: the remaining list.
+ */
+GSList*
+gx_slist_skip_in_place (GSList *list, gsize n, GDestroyNotify free_func)
+{
+  for (; list && n != 0; --n)
+    {
+      GSList *next;
+
+      next = list->next;
+      if (free_func)
+        (*free_func) (list->data);
+
+      g_slist_free_1 (list);
+      list = next;
+    }
+
+  return list;
+}
+
+
+/**
+ * gx_slist_map:
+ * @list: a #GSList
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Create a new list consisting of the elements obtained by applying
+ * @map_func to the corresponding elements in @list.
+ *
+ * Returns: (transfer full): the list with mapped values. Whether to free the
+ * elements when calling g_slist_free() depends on @map_func.
+ */
+GSList*
+gx_slist_map (GSList *list, GXBinaryFunc map_func, gpointer user_data)
+{
+  SListBuilder mapped;
+
+  g_return_val_if_fail (map_func, NULL);
+
+  slist_builder_init (&mapped);
+  for (; list; list = list->next)
+    slist_builder_append (&mapped, (*map_func) (list->data, user_data));
+
+  return mapped.head;
+}
+
+
+/**
+ * gx_slist_map_in_place:
+ * @list: a #GSList
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ * @free_func: (allow-none): a function to free the replaced element
+ *
+ * Replace each element in @list with the value obtained from applying
+ * @map_func to it. Free the old element using @free_func.
+ *
+ * Returns: @list
+ */
+GSList*
+gx_slist_map_in_place (GSList *list, GXBinaryFunc map_func, gpointer user_data,
+                       GDestroyNotify free_func)
+{
+  GSList *cur;
+
+  g_return_val_if_fail (map_func, NULL);
+
+  for (cur = list; cur; cur = cur->next)
+    {
+      gpointer old;
+
+      old = cur->data;
+      cur->data = (*map_func) (old, user_data);
+
+      if (free_func)
+        (*free_func) (old);
+    }
+
+  return list;
+}
+
+
+static gpointer
+slist_fold_kernel (GSList *list, GXFoldKernel kernel, gpointer init,
+                   gpointer user_data)
+{
+  gpointer batch[FOLD_BATCH_SIZE];
+  gpointer result;
+
+  if (!list)
+    return NULL;
+
+  for (result = init; list;)
+    {
+      gsize n;
+
+      for (n = 0; list && n != FOLD_BATCH_SIZE; list = list->next)
+        batch[n++] = list->data;
+
+      result = kernel (result, batch, n, user_data);
+    }
+
+  return result;
+}
+
+/**
+ * gx_slist_fold:
+ * @list: a #GSList
+ * @fold_func: a ternary function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Given a list (a, b, c), compute
+ *      fold_func (fold_func (fold_func (@init, a), b), c)
+ *
+ * This is the #GSList equivalent of gx_list_fold(); as with that function, the
+ * result for an empty @list is %NULL, and a #GXFoldKernel registered for
+ * @fold_func is used when @free_func is %NULL.
+ *
+ * Returns: (transfer full): the computed value.
+ */
+gpointer
+gx_slist_fold (GSList *list, GXTernaryFunc fold_func, gpointer init,
+               gpointer user_data, GDestroyNotify free_func)
+{
+  gpointer     result, first;
+  GXFoldKernel kernel;
+
+  g_return_val_if_fail (fold_func, NULL);
+
+  kernel = free_func ? NULL : gx_fold_kernel_lookup (fold_func);
+  if (kernel)
+    return slist_fold_kernel (list, kernel, init, user_data);
+
+  for (result = NULL, first = init; list; list = list->next)
+    {
+      gpointer tmp;
+
+      tmp = (*fold_func) (first, list->data, user_data);
+      if (free_func)
+        (*free_func) (result);
+
+      result = tmp;
+      first  = result;
+    }
+
+  return result;
+}
+
+
+/**
+ * gx_slist_iota:
+ * @count: number of elements to generate
+ * @start: the start value
+ * @step: the step size, must be > 0
+ *
+ * Create a #GSList with @count numbers starting at @start, and then
+ * increasing by @step; this is the #GSList equivalent of gx_list_iota().
+ *
+ * Returns: (transfer full): a list with numbers. Free with g_slist_free().
+ */
+GSList*
+gx_slist_iota (gsize count, gint start, gsize step)
+{
+  SListBuilder lst;
+
+  g_return_val_if_fail (step > 0, NULL);
+
+  slist_builder_init (&lst);
+  for (; count > 0; --count, start += step)
+    slist_builder_append (&lst, GINT_TO_POINTER (start));
+
+  return lst.head;
+}
+
+
+/**
+ * gx_slist_sum:
+ * @list: a #GSList
+ *
+ * Calculate the sum of a list of integers; see gx_list_sum().
+ *
+ * Returns: the sum of the integers in @list.
+ */
+gint
+gx_slist_sum (GSList *list)
+{
+  gint sum;
+
+  for (sum = 0; list; list = list->next)
+    sum += GPOINTER_TO_INT (list->data);
+
+  return sum;
+}
+
+
+/**
+ * gx_slist_product:
+ * @list: a #GSList
+ *
+ * Calculate the product of a list of integers; see gx_list_product().
+ *
+ * Returns: the product of the integers in @list.
+ */
+gint
+gx_slist_product (GSList *list)
+{
+  gint product;
+
+  for (product = 1; list; list = list->next)
+    product *= GPOINTER_TO_INT (list->data);
+
+  return product;
+}
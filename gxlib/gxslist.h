@@ -0,0 +1,64 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_SLIST_H__
+#define __GX_SLIST_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+GSList *gx_slist_filter (GSList *list, GXPred pred_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GSList *gx_slist_filter_in_place (GSList *list, GXPred pred_func,
+                                  gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gboolean gx_slist_every (GSList *list, GXPred pred_func, gpointer user_data);
+gboolean gx_slist_any (GSList *list, GXPred pred_func, gpointer user_data);
+
+GSList *gx_slist_take (GSList *list, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GSList *gx_slist_take_in_place (GSList *list, gsize n,
+                                GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GSList *gx_slist_skip (GSList *list, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GSList *gx_slist_skip_in_place (GSList *list, gsize n,
+                                GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GSList *gx_slist_map (GSList *list, GXBinaryFunc map_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GSList *gx_slist_map_in_place (GSList *list, GXBinaryFunc map_func,
+                               gpointer user_data, GDestroyNotify free_func);
+
+gpointer gx_slist_fold (GSList *list, GXTernaryFunc fold_func, gpointer init,
+                        gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GSList *gx_slist_iota (gsize count, gint start, gsize step)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gint gx_slist_sum (GSList *list);
+gint gx_slist_product (GSList *list);
+
+G_END_DECLS
+
+#endif /* __GX_SLIST_H__ */
@@ -0,0 +1,551 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <string.h>
+
+#include "gxsort.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxsort
+ * @title: Sorting
+ * @short_description: sorting lists by a key
+ *
+ * g_list_sort() calls its comparison function O(n log n) times, and each call
+ * follows two pointers to nodes spread all over memory. When comparing means
+ * computing a key first (say, a flattened version of a string), that work is
+ * repeated for every comparison.
+ *
+ * gx_list_sort_by_key() instead computes the key of each element exactly
+ * once, sorts compact key/node pairs in a single array, and then relinks the
+ * nodes in their new order. If the keys are integers compared with
+ * gx_cmp_int(), or strings compared with strcmp() or g_strcmp0(), it uses a
+ * radix sort, which does not call a comparison function at all.
+ *
+ * |[<!-- language="C" -->
+ * GList *words;
+ *
+ * words = gx_strv_to_list ((gchar*[]){ "Zebra", "apple", "Mango", NULL }, -1);
+ * // sort case-insensitively, folding each word only once
+ * words = gx_list_sort_by_key (words, (GXBinaryFunc)g_utf8_casefold,
+ *                              GINT_TO_POINTER (-1), (GCompareFunc)strcmp,
+ *                              g_free);
+ * g_assert_cmpstr (words->data, ==, "apple");
+ * g_assert_cmpstr (words->next->data, ==, "Mango");
+ *
+ * g_list_free (words);
+ * ]|
+ */
+
+/* an element and its key */
+typedef struct {
+  gpointer  key;
+  GList    *node;
+} KeyPair;
+
+/* below this many elements, insertion sort beats the alternatives */
+#define INSERTION_SORT_MAX 16
+
+static void
+pairs_insertion_sort (KeyPair *pairs, gsize n, GCompareFunc cmp_func)
+{
+  gsize u, v;
+
+  for (u = 1; u < n; ++u)
+    {
+      KeyPair pair;
+
+      pair = pairs[u];
+      for (v = u; v > 0 && (*cmp_func) (pairs[v - 1].key, pair.key) > 0; --v)
+        pairs[v] = pairs[v - 1];
+      pairs[v] = pair;
+    }
+}
+
+/* a stable merge sort; tmp must have room for n / 2 pairs */
+static void
+pairs_merge_sort (KeyPair *pairs, KeyPair *tmp, gsize n, GCompareFunc cmp_func)
+{
+  gsize half, i, j, k;
+
+  if (n <= INSERTION_SORT_MAX)
+    {
+      pairs_insertion_sort (pairs, n, cmp_func);
+      return;
+    }
+
+  half = n / 2;
+  pairs_merge_sort (pairs, tmp, half, cmp_func);
+  pairs_merge_sort (pairs + half, tmp, n - half, cmp_func);
+
+  /* already in order? */
+  if ((*cmp_func) (pairs[half - 1].key, pairs[half].key) <= 0)
+    return;
+
+  memcpy (tmp, pairs, half * sizeof (KeyPair));
+  for (i = 0, j = half, k = 0; i < half && j < n; ++k)
+    if ((*cmp_func) (pairs[j].key, tmp[i].key) < 0)
+      pairs[k] = pairs[j++];
+    else
+      pairs[k] = tmp[i++];
+
+  memcpy (pairs + k, tmp + i, (half - i) * sizeof (KeyPair));
+}
+
+
+#define INT_KEY(pair) ((guint32)GPOINTER_TO_INT ((pair)->key) ^ 0x80000000U)
+
+/* an LSD radix sort, for keys compared with gx_cmp_int(); tmp must have room
+ * for n pairs */
+static void
+pairs_radix_sort_int (KeyPair *pairs, KeyPair *tmp, gsize n)
+{
+  gsize    counts[4][256];
+  KeyPair *src, *dst, *swap;
+  gsize    u;
+  guint    pass;
+
+  /* the counts for all the passes, in one go */
+  memset (counts, 0, sizeof (counts));
+  for (u = 0; u != n; ++u)
+    {
+      guint32 key;
+
+      key = INT_KEY (&pairs[u]);
+      ++counts[0][key & 0xff];
+      ++counts[1][(key >> 8) & 0xff];
+      ++counts[2][(key >> 16) & 0xff];
+      ++counts[3][key >> 24];
+    }
+
+  for (src = pairs, dst = tmp, pass = 0; pass != 4; ++pass)
+    {
+      gsize *count, offset;
+      guint  shift;
+
+      count = counts[pass];
+      shift = pass * 8;
+
+      /* skip the pass if all keys have the same digit */
+      if (count[(INT_KEY (&src[0]) >> shift) & 0xff] == n)
+        continue;
+
+      for (offset = 0, u = 0; u != 256; ++u)
+        {
+          gsize c;
+
+          c        = count[u];
+          count[u] = offset;
+          offset  += c;
+        }
+
+      for (u = 0; u != n; ++u)
+        dst[count[(INT_KEY (&src[u]) >> shift) & 0xff]++] = src[u];
+
+      swap = src;
+      src  = dst;
+      dst  = swap;
+    }
+
+  if (src != pairs)
+    memcpy (pairs, src, n * sizeof (KeyPair));
+}
+
+
+/* the bucket of a string key at depth: 0 for NULL, 1 for the end of the
+ * string, and 2..256 for the bytes */
+#define STR_BUCKET(key,depth) \
+  ((key) ? (guint)((const guchar*)(key))[depth] + 1 : 0)
+
+static void
+pairs_insertion_sort_str (KeyPair *pairs, gsize n, gsize depth)
+{
+  gsize u, v;
+
+  for (u = 1; u < n; ++u)
+    {
+      KeyPair pair;
+
+      pair = pairs[u];
+      for (v = u; v > 0; --v)
+        {
+          const gchar *key1, *key2;
+
+          key1 = pairs[v - 1].key;
+          key2 = pair.key;
+          if (!key1 || (key2 && strcmp (key1 + depth, key2 + depth) <= 0))
+            break;
+
+          pairs[v] = pairs[v - 1];
+        }
+      pairs[v] = pair;
+    }
+}
+
+/* a stable MSD radix sort, for keys compared with strcmp() or g_strcmp0(), all
+ * of which have the same first depth bytes; tmp must have room for n pairs */
+static void
+pairs_radix_sort_str (KeyPair *pairs, KeyPair *tmp, gsize n, gsize depth)
+{
+  while (n > INSERTION_SORT_MAX)
+    {
+      gsize count[257], start[257], u, offset, largest;
+
+      memset (count, 0, sizeof (count));
+      for (u = 0; u != n; ++u)
+        ++count[STR_BUCKET (pairs[u].key, depth)];
+
+      for (offset = 0, u = 0; u != 257; ++u)
+        {
+          start[u] = offset;
+          offset  += count[u];
+        }
+
+      memcpy (tmp, pairs, n * sizeof (KeyPair));
+      for (u = 0; u != n; ++u)
+        pairs[start[STR_BUCKET (tmp[u].key, depth)]++] = tmp[u];
+
+      /* the strings in buckets 0 and 1 are done; recurse into the others,
+       * except for the largest, which we do in this loop; this keeps the
+       * recursion depth logarithmic */
+      for (largest = 2, u = 3; u != 257; ++u)
+        if (count[u] > count[largest])
+          largest = u;
+
+      for (u = 2; u != 257; ++u)
+        if (u != largest && count[u] > 1)
+          pairs_radix_sort_str (pairs + start[u] - count[u], tmp, count[u],
+                                depth + 1);
+
+      pairs += start[largest] - count[largest];
+      n      = count[largest];
+      ++depth;
+    }
+
+  pairs_insertion_sort_str (pairs, n, depth);
+}
+
+
+/* link the nodes in the order of pairs */
+static GList*
+pairs_relink (KeyPair *pairs, gsize n)
+{
+  gsize u;
+
+  for (u = 0; u != n; ++u)
+    {
+      pairs[u].node->prev = u > 0 ? pairs[u - 1].node : NULL;
+      pairs[u].node->next = u + 1 < n ? pairs[u + 1].node : NULL;
+    }
+
+  return n > 0 ? pairs[0].node : NULL;
+}
+
+/**
+ * gx_list_sort_by_key:
+ * @list: a #GList
+ * @key_func: (allow-none): a function to get the key of an element, or %NULL
+ * to use the element itself
+ * @user_data: (allow-none): a user pointer passed to @key_func
+ * @cmp_func: a function to compare the keys
+ * @key_free_func: (allow-none): a function to free the keys, or %NULL
+ *
+ * Sort @list by the keys of its elements, which are computed with @key_func
+ * only once per element, and then freed with @key_free_func. The sort is
+ * stable: elements with equal keys keep their order.
+ *
+ * The sort works on an array of key/node pairs, after which the nodes of
+ * @list are relinked in the sorted order. When @cmp_func is gx_cmp_int() (for
+ * integer keys stored with GINT_TO_POINTER()), or strcmp() or g_strcmp0()
+ * (for string keys), this uses a radix sort rather than calling @cmp_func.
+ *
+ * |[<!-- language="C" -->
+ * GList *words;
+ *
+ * words = gx_strv_to_list ((gchar*[]){ "ccc", "a", "bb", "d", NULL }, -1);
+ * words = gx_list_sort_by_key (words, (GXBinaryFunc)strlen, NULL,
+ *                              (GCompareFunc)gx_cmp_int, NULL);
+ * // "a", "d", "bb", "ccc"
+ * g_assert_cmpstr (words->next->data, ==, "d");
+ *
+ * g_list_free (words);
+ * ]|
+ *
+ * Returns: the sorted list. Note that the start of the list may have
+ * changed.
+ */
+GList*
+gx_list_sort_by_key (GList *list, GXBinaryFunc key_func, gpointer user_data,
+                     GCompareFunc cmp_func, GDestroyNotify key_free_func)
+{
+  KeyPair *pairs, *tmp;
+  gsize    n, size, u;
+
+  g_return_val_if_fail (cmp_func, list);
+
+  if (!list || !list->next)
+    {
+      if (list && key_func && key_free_func)
+        (*key_free_func) ((*key_func) (list->data, user_data));
+      return list;
+    }
+
+  size  = 1024;
+  pairs = g_new (KeyPair, size);
+
+  for (n = 0; list; list = list->next, ++n)
+    {
+      if (n == size)
+        {
+          size *= 2;
+          pairs = g_renew (KeyPair, pairs, size);
+        }
+
+      pairs[n].key  = key_func ? (*key_func) (list->data, user_data) :
+        list->data;
+      pairs[n].node = list;
+    }
+
+  tmp = g_new (KeyPair, n);
+
+  if (n <= INSERTION_SORT_MAX)
+    pairs_insertion_sort (pairs, n, cmp_func);
+  else if (cmp_func == (GCompareFunc)gx_cmp_int)
+    pairs_radix_sort_int (pairs, tmp, n);
+  else if (cmp_func == (GCompareFunc)strcmp ||
+           cmp_func == (GCompareFunc)g_strcmp0)
+    pairs_radix_sort_str (pairs, tmp, n, 0);
+  else
+    pairs_merge_sort (pairs, tmp, n, cmp_func);
+
+  list = pairs_relink (pairs, n);
+
+  if (key_func && key_free_func)
+    for (u = 0; u != n; ++u)
+      (*key_free_func) (pairs[u].key);
+
+  g_free (tmp);
+  g_free (pairs);
+
+  return list;
+}
+
+
+/**
+ * gx_list_sort_int:
+ * @list: a #GList of integers, stored with GINT_TO_POINTER()
+ *
+ * Sort @list in ascending order. This uses a radix sort, which takes O(n)
+ * time; it is equivalent to
+ *      gx_list_sort_by_key (@list, NULL, NULL, (GCompareFunc)gx_cmp_int, NULL)
+ *
+ * |[<!-- language="C" -->
+ * GList *nums;
+ *
+ * nums = gx_list_iota (5, -2, 1);
+ * nums = g_list_reverse (nums); // 2, 1, 0, -1, -2
+ * nums = gx_list_sort_int (nums);
+ * g_assert_cmpint (GPOINTER_TO_INT (nums->data), ==, -2);
+ *
+ * g_list_free (nums);
+ * ]|
+ *
+ * Returns: the sorted list. Note that the start of the list may have
+ * changed.
+ */
+GList*
+gx_list_sort_int (GList *list)
+{
+  return gx_list_sort_by_key (list, NULL, NULL, (GCompareFunc)gx_cmp_int,
+                              NULL);
+}
+
+
+/* below this many elements, a parallel sort is not worth the threads */
+#define PAR_SORT_MIN 16384
+
+typedef struct {
+  KeyPair      *src;
+  KeyPair      *dst;
+  gsize         n;
+  gsize         run;    /* the length of the sorted runs in src */
+  gsize         parts;  /* the number of jobs per merge of two runs */
+  GCompareFunc  cmp_func;
+} SortContext;
+
+static void
+sort_run (gsize job, SortContext *ctx)
+{
+  gsize start;
+
+  start = job * ctx->run;
+  if (start >= ctx->n)
+    return;
+
+  pairs_merge_sort (ctx->src + start, ctx->dst + start,
+                    MIN (ctx->run, ctx->n - start), ctx->cmp_func);
+}
+
+/* the number of elements of a that are among the first k elements of the
+ * stable merge of a and b */
+static gsize
+merge_split (KeyPair *a, gsize len_a, KeyPair *b, gsize len_b, gsize k,
+             GCompareFunc cmp_func)
+{
+  gsize lo, hi;
+
+  lo = k > len_b ? k - len_b : 0;
+  hi = MIN (k, len_a);
+
+  while (lo < hi)
+    {
+      gsize mid;
+
+      mid = lo + (hi - lo) / 2;
+      if ((*cmp_func) (b[k - mid - 1].key, a[mid].key) < 0)
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+
+  return lo;
+}
+
+/* merge a part of two adjacent runs; the parts are split such that each
+ * produces the same number of elements */
+static void
+merge_runs (gsize job, SortContext *ctx)
+{
+  KeyPair *a, *b, *dst;
+  gsize    merge, part, start, len_a, len_b, k0, k1, i, i1, j, j1;
+
+  merge = job / ctx->parts;
+  part  = job % ctx->parts;
+  start = merge * 2 * ctx->run;
+  if (start >= ctx->n)
+    return;
+
+  a     = ctx->src + start;
+  len_a = MIN (ctx->run, ctx->n - start);
+  b     = a + len_a;
+  len_b = MIN (ctx->run, ctx->n - start - len_a);
+  dst   = ctx->dst + start;
+
+  k0 = (len_a + len_b) * part / ctx->parts;
+  k1 = (len_a + len_b) * (part + 1) / ctx->parts;
+
+  i  = merge_split (a, len_a, b, len_b, k0, ctx->cmp_func);
+  i1 = merge_split (a, len_a, b, len_b, k1, ctx->cmp_func);
+  j  = k0 - i;
+  j1 = k1 - i1;
+
+  for (dst += k0; i < i1 && j < j1; ++dst)
+    if ((*ctx->cmp_func) (b[j].key, a[i].key) < 0)
+      *dst = b[j++];
+    else
+      *dst = a[i++];
+
+  memcpy (dst, a + i, (i1 - i) * sizeof (KeyPair));
+  memcpy (dst + (i1 - i), b + j, (j1 - j) * sizeof (KeyPair));
+}
+
+/**
+ * gx_list_sort_parallel:
+ * @list: a #GList
+ * @cmp_func: a thread-safe function to compare the elements
+ * @n_threads: the maximum number of threads to use, or <= 0 to use the number
+ * of processors
+ *
+ * Sort @list like g_list_sort() does, but using multiple threads. The sort is
+ * stable.
+ *
+ * The nodes are copied into an array, which is split in a run per thread;
+ * these runs are sorted in parallel, and then merged in rounds, where each
+ * merge is again split over the threads. Finally, the nodes are relinked in
+ * the sorted order. Short lists are sorted in the calling thread.
+ *
+ * |[<!-- language="C" -->
+ * GList *nums;
+ *
+ * nums = g_list_reverse (gx_list_iota (100 * 1000, 0, 1));
+ * nums = gx_list_sort_parallel (nums, (GCompareFunc)gx_cmp_int, -1);
+ * g_assert_cmpint (GPOINTER_TO_INT (nums->data), ==, 0);
+ *
+ * g_list_free (nums);
+ * ]|
+ *
+ * Returns: the sorted list. Note that the start of the list may have
+ * changed.
+ */
+GList*
+gx_list_sort_parallel (GList *list, GCompareFunc cmp_func, gint n_threads)
+{
+  SortContext  ctx;
+  KeyPair     *pairs, *swap;
+  GList       *cur;
+  guint        threads, n_runs;
+
+  g_return_val_if_fail (cmp_func, list);
+
+  ctx.n = g_list_length (list);
+  if (ctx.n < 2)
+    return list;
+
+  pairs = g_new (KeyPair, ctx.n);
+  for (ctx.n = 0, cur = list; cur; cur = cur->next, ++ctx.n)
+    {
+      pairs[ctx.n].key  = cur->data;
+      pairs[ctx.n].node = cur;
+    }
+
+  ctx.src      = pairs;
+  ctx.dst      = g_new (KeyPair, ctx.n);
+  ctx.cmp_func = cmp_func;
+
+  threads = gx_get_n_threads (n_threads);
+  if (threads == 1 || ctx.n < PAR_SORT_MIN)
+    pairs_merge_sort (ctx.src, ctx.dst, ctx.n, cmp_func);
+  else
+    {
+      /* a power of two of runs, so they pair up in every round */
+      for (n_runs = 1; n_runs < threads; n_runs *= 2);
+
+      ctx.run = (ctx.n + n_runs - 1) / n_runs;
+      gx_run_jobs (n_runs, n_threads, (GXJobFunc)sort_run, &ctx);
+
+      for (; n_runs > 1; n_runs /= 2, ctx.run *= 2)
+        {
+          ctx.parts = MAX (1, threads / (n_runs / 2));
+          gx_run_jobs (n_runs / 2 * ctx.parts, n_threads,
+                       (GXJobFunc)merge_runs, &ctx);
+
+          swap    = ctx.src;
+          ctx.src = ctx.dst;
+          ctx.dst = swap;
+        }
+    }
+
+  list = pairs_relink (ctx.src, ctx.n);
+
+  g_free (ctx.src);
+  g_free (ctx.dst);
+
+  return list;
+}
@@ -0,0 +1,971 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "gxstats.h"
+#include "gxlib-private.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GX_X86_SIMD 1
+#include <immintrin.h>
+#endif /*__GNUC__ && x86*/
+
+/**
+ * SECTION:gxstats
+ * @title: Statistics
+ * @short_description: one-pass summary statistics over streams of numbers
+ *
+ * Computing the sum, minimum, maximum and variance of a list with separate
+ * folds walks the list once for each of them. A #GXStats accumulator
+ * computes all of them in one pass instead, and never needs more than a
+ * fixed amount of memory, however many values are added:
+ *
+ * |[<!-- language="C" -->
+ * GXStats *stats;
+ * GList   *nums;
+ *
+ * nums  = gx_list_iota (100, 1, 1);
+ * stats = gx_stats_new (GX_STATS_FLAGS_PERCENTILES);
+ * g_assert (gx_list_fold (nums, (GXTernaryFunc)gx_stats_fold_int, stats,
+ *                        NULL, NULL) == stats);
+ *
+ * g_assert_cmpuint (gx_stats_get_count (stats), ==, 100);
+ * g_assert_cmpfloat (gx_stats_get_sum (stats), ==, 5050);
+ * g_assert_cmpfloat (gx_stats_get_max (stats), ==, 100);
+ * g_assert_cmpfloat (gx_stats_get_mean (stats), ==, 50.5);
+ * g_assert_cmpfloat (gx_stats_get_percentile (stats, 50), ==, 50.5);
+ *
+ * gx_stats_free (stats);
+ * g_list_free (nums);
+ * ]|
+ *
+ * The mean and variance are updated with Welford's method, which does not
+ * suffer from the cancellation of the textbook sum-of-squares formula, and
+ * the sum is kept with Kahan-Babuska compensation. Contiguous inputs, as
+ * passed to gx_stats_add_array(), are processed in blocks with SIMD
+ * instructions where the processor has them, and the blocks are combined
+ * with the parallel variant of Welford's update; gx_stats_merge() uses the
+ * same to combine accumulators filled by different threads.
+ *
+ * gx_stats_fold_int() and gx_stats_fold_double() have the #GXTernaryFunc
+ * signature, so a #GXStats can be filled by gx_list_fold(), gx_vec_fold() or
+ * gx_iter_fold(); these folds pass whole batches of values to the block
+ * functions.
+ *
+ * Percentiles are estimated with a t-digest: the values are clustered into
+ * about a hundred centroids, which are smallest near the extremes of the
+ * distribution, so that the tails are estimated much more precisely than the
+ * middle. Until the sketch is first compressed, after 700 values, the
+ * percentiles are exact.
+ */
+
+/* the compression of the t-digest; it has at most about this many centroids
+ * after compressing, and it compresses when the new values no longer fit in
+ * the buffer after them */
+#define DIGEST_COMPRESSION   100
+#define DIGEST_MAX_CENTROIDS (2 * DIGEST_COMPRESSION)
+#define DIGEST_BUFFER_SIZE   (5 * DIGEST_COMPRESSION)
+
+/* the number of values whose moments are computed together, and then added
+ * to the accumulator at once */
+#define STATS_BLOCK_SIZE 1024
+
+typedef struct {
+  gdouble mean;
+  gdouble weight;
+} Centroid;
+
+typedef struct {
+  /* the sorted centroids, followed by the values added since */
+  Centroid items[DIGEST_MAX_CENTROIDS + DIGEST_BUFFER_SIZE];
+  gsize    n_centroids;
+  gsize    n_items;
+  gdouble  total_weight;
+  gboolean reverse;     /* whether the last compression was right-to-left */
+} Digest;
+
+struct _GXStats {
+  guint64  count;
+  gdouble  sum;
+  gdouble  sum_comp;  /* the compensation for the rounding errors of sum */
+  gdouble  min;
+  gdouble  max;
+  gdouble  mean;
+  gdouble  m2;        /* the sum of squared differences from the mean */
+  Digest  *digest;
+};
+
+typedef struct {
+  gdouble sum;
+  gdouble min;
+  gdouble max;
+  gdouble m2;
+} Moments;
+
+
+/* the scale function of the t-digest, which maps quantiles onto a scale where
+ * each centroid may span at most 1 */
+static gdouble
+digest_scale (gdouble q)
+{
+  return DIGEST_COMPRESSION / (2 * G_PI) * asin (2 * q - 1);
+}
+
+static gdouble
+digest_scale_inverse (gdouble k)
+{
+  if (k >= DIGEST_COMPRESSION / 4.0)
+    return 1.0;
+
+  return (sin (k * 2 * G_PI / DIGEST_COMPRESSION) + 1) / 2;
+}
+
+#define SWAP_CENTROIDS(a,b) \
+  G_STMT_START { Centroid tmp_ = (a); (a) = (b); (b) = tmp_; } G_STMT_END
+
+/* sort by mean; qsort() would spend most of its time calling a comparison
+ * function, so this is an inlined quicksort */
+static void
+centroids_sort (Centroid *items, gsize n)
+{
+  gsize u, v;
+
+  while (n > 16)
+    {
+      gdouble pivot;
+      gssize  i, j;
+
+      /* the median of three, with the smallest and largest of them at the
+       * ends as sentinels */
+      if (items[n / 2].mean < items[0].mean)
+        SWAP_CENTROIDS (items[n / 2], items[0]);
+      if (items[n - 1].mean < items[n / 2].mean)
+        {
+          SWAP_CENTROIDS (items[n - 1], items[n / 2]);
+          if (items[n / 2].mean < items[0].mean)
+            SWAP_CENTROIDS (items[n / 2], items[0]);
+        }
+
+      pivot = items[n / 2].mean;
+      for (i = -1, j = n;;)
+        {
+          while (items[++i].mean < pivot);
+          while (items[--j].mean > pivot);
+          if (i >= j)
+            break;
+          SWAP_CENTROIDS (items[i], items[j]);
+        }
+
+      /* recurse into the smaller part, so the stack stays shallow */
+      if ((gsize)j + 1 < n / 2)
+        {
+          centroids_sort (items, j + 1);
+          items += j + 1;
+          n     -= j + 1;
+        }
+      else
+        {
+          centroids_sort (items + j + 1, n - j - 1);
+          n = j + 1;
+        }
+    }
+
+  for (u = 1; u < n; ++u)
+    {
+      Centroid item;
+
+      item = items[u];
+      for (v = u; v > 0 && items[v - 1].mean > item.mean; --v)
+        items[v] = items[v - 1];
+      items[v] = item;
+    }
+}
+
+/* sort the buffered values in between the centroids; as long as the digest
+ * was never compressed, this keeps all values exactly */
+static void
+digest_sort (Digest *digest)
+{
+  if (digest->n_centroids == digest->n_items)
+    return;
+
+  centroids_sort (digest->items, digest->n_items);
+  digest->n_centroids = digest->n_items;
+}
+
+static void
+centroids_reverse (Centroid *items, gsize n)
+{
+  gsize u;
+
+  for (u = 0; u < n / 2; ++u)
+    {
+      Centroid tmp;
+
+      tmp              = items[u];
+      items[u]         = items[n - 1 - u];
+      items[n - 1 - u] = tmp;
+    }
+}
+
+/* merge neighbouring centroids as far as the scale function allows, which
+ * leaves at most about DIGEST_COMPRESSION of them */
+static void
+digest_compress (Digest *digest)
+{
+  Centroid *items;
+  gsize     u, out;
+  gdouble   weight, limit;
+
+  digest_sort (digest);
+  items = digest->items;
+
+  /* merging always from the left would leave the left-most centroids
+   * systematically too heavy; as the scale function is symmetric, we can
+   * merge from the right instead by reversing the centroids */
+  digest->reverse = !digest->reverse;
+  if (digest->reverse)
+    centroids_reverse (items, digest->n_items);
+
+  weight = 0;
+  limit  = digest_scale_inverse (digest_scale (0) + 1);
+  for (out = 0, u = 1; u != digest->n_items; ++u)
+    {
+      Centroid *cur;
+
+      cur = &items[out];
+      if ((weight + cur->weight + items[u].weight) / digest->total_weight <=
+          limit)
+        {
+          cur->weight += items[u].weight;
+          cur->mean   += (items[u].mean - cur->mean) * items[u].weight /
+            cur->weight;
+        }
+      else
+        {
+          weight += cur->weight;
+          limit   = digest_scale_inverse
+            (digest_scale (weight / digest->total_weight) + 1);
+          items[++out] = items[u];
+        }
+    }
+
+  digest->n_centroids = digest->n_items = out + 1;
+  if (digest->reverse)
+    centroids_reverse (items, digest->n_centroids);
+}
+
+static inline void
+digest_add (Digest *digest, gdouble mean, gdouble weight)
+{
+  if (G_UNLIKELY (digest->n_items == G_N_ELEMENTS (digest->items)))
+    digest_compress (digest);
+
+  digest->items[digest->n_items].mean   = mean;
+  digest->items[digest->n_items].weight = weight;
+  ++digest->n_items;
+
+  digest->total_weight += weight;
+}
+
+
+/* Kahan-Babuska summation: unlike plain Kahan summation, this also works when
+ * the new value is larger than the sum so far */
+static inline void
+stats_add_to_sum (GXStats *stats, gdouble value)
+{
+  gdouble sum;
+
+  sum = stats->sum + value;
+  if (fabs (stats->sum) >= fabs (value))
+    stats->sum_comp += (stats->sum - sum) + value;
+  else
+    stats->sum_comp += (value - sum) + stats->sum;
+
+  stats->sum = sum;
+}
+
+/* add the moments of a block of n values with the given mean */
+static void
+stats_add_moments (GXStats *stats, guint64 n, gdouble mean,
+                   const Moments *moments)
+{
+  guint64 count;
+  gdouble delta;
+
+  count = stats->count + n;
+  delta = mean - stats->mean;
+
+  stats->mean += delta * ((gdouble)n / count);
+  stats->m2   += moments->m2 + delta * delta * ((gdouble)stats->count * n /
+                                                count);
+  stats->min   = MIN (stats->min, moments->min);
+  stats->max   = MAX (stats->max, moments->max);
+  stats->count = count;
+
+  stats_add_to_sum (stats, moments->sum);
+}
+
+
+typedef void (*MomentsKernel) (const gdouble *data, gsize len,
+                               Moments *moments);
+
+/* all kernels make two passes over the block, which is small enough to still
+ * be in the cache for the second one: one for the sum, min and max, and one
+ * for the squared differences from the mean of the block */
+static void
+moments_portable (const gdouble *data, gsize len, Moments *moments)
+{
+  gdouble s0, s1, s2, s3, min, max, mean;
+  gsize   u;
+
+  s0  = s1 = s2 = s3 = 0;
+  min = max = data[0];
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      s0 += data[u];
+      s1 += data[u + 1];
+      s2 += data[u + 2];
+      s3 += data[u + 3];
+
+      min = MIN (MIN (min, data[u]), MIN (data[u + 1], data[u + 2]));
+      min = MIN (min, data[u + 3]);
+      max = MAX (MAX (max, data[u]), MAX (data[u + 1], data[u + 2]));
+      max = MAX (max, data[u + 3]);
+    }
+  for (; u != len; ++u)
+    {
+      s0 += data[u];
+      min = MIN (min, data[u]);
+      max = MAX (max, data[u]);
+    }
+
+  moments->sum = (s0 + s1) + (s2 + s3);
+  moments->min = min;
+  moments->max = max;
+
+  mean = moments->sum / len;
+  s0   = s1 = s2 = s3 = 0;
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      s0 += (data[u] - mean) * (data[u] - mean);
+      s1 += (data[u + 1] - mean) * (data[u + 1] - mean);
+      s2 += (data[u + 2] - mean) * (data[u + 2] - mean);
+      s3 += (data[u + 3] - mean) * (data[u + 3] - mean);
+    }
+  for (; u != len; ++u)
+    s0 += (data[u] - mean) * (data[u] - mean);
+
+  moments->m2 = (s0 + s1) + (s2 + s3);
+}
+
+#ifdef GX_X86_SIMD
+
+__attribute__((target("sse2")))
+static void
+moments_sse2 (const gdouble *data, gsize len, Moments *moments)
+{
+  __m128d acc0, acc1, min, max, mean;
+  gdouble lanes[2], sum, m2, lo, hi;
+  gsize   u;
+
+  acc0 = acc1 = _mm_setzero_pd ();
+  min  = max  = _mm_set1_pd (data[0]);
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      __m128d v0, v1;
+
+      v0   = _mm_loadu_pd (data + u);
+      v1   = _mm_loadu_pd (data + u + 2);
+      acc0 = _mm_add_pd (acc0, v0);
+      acc1 = _mm_add_pd (acc1, v1);
+      min  = _mm_min_pd (min, _mm_min_pd (v0, v1));
+      max  = _mm_max_pd (max, _mm_max_pd (v0, v1));
+    }
+
+  _mm_storeu_pd (lanes, _mm_add_pd (acc0, acc1));
+  sum = lanes[0] + lanes[1];
+  _mm_storeu_pd (lanes, min);
+  lo = MIN (lanes[0], lanes[1]);
+  _mm_storeu_pd (lanes, max);
+  hi = MAX (lanes[0], lanes[1]);
+  for (; u != len; ++u)
+    {
+      sum += data[u];
+      lo   = MIN (lo, data[u]);
+      hi   = MAX (hi, data[u]);
+    }
+
+  moments->sum = sum;
+  moments->min = lo;
+  moments->max = hi;
+
+  mean = _mm_set1_pd (sum / len);
+  acc0 = acc1 = _mm_setzero_pd ();
+  for (u = 0; u + 4 <= len; u += 4)
+    {
+      __m128d d0, d1;
+
+      d0   = _mm_sub_pd (_mm_loadu_pd (data + u), mean);
+      d1   = _mm_sub_pd (_mm_loadu_pd (data + u + 2), mean);
+      acc0 = _mm_add_pd (acc0, _mm_mul_pd (d0, d0));
+      acc1 = _mm_add_pd (acc1, _mm_mul_pd (d1, d1));
+    }
+
+  _mm_storeu_pd (lanes, _mm_add_pd (acc0, acc1));
+  m2 = lanes[0] + lanes[1];
+  for (; u != len; ++u)
+    m2 += (data[u] - sum / len) * (data[u] - sum / len);
+
+  moments->m2 = m2;
+}
+
+__attribute__((target("avx")))
+static void
+moments_avx (const gdouble *data, gsize len, Moments *moments)
+{
+  __m256d acc0, acc1, min, max, mean;
+  gdouble lanes[4], sum, m2, lo, hi;
+  gsize   u;
+
+  acc0 = acc1 = _mm256_setzero_pd ();
+  min  = max  = _mm256_set1_pd (data[0]);
+  for (u = 0; u + 8 <= len; u += 8)
+    {
+      __m256d v0, v1;
+
+      v0   = _mm256_loadu_pd (data + u);
+      v1   = _mm256_loadu_pd (data + u + 4);
+      acc0 = _mm256_add_pd (acc0, v0);
+      acc1 = _mm256_add_pd (acc1, v1);
+      min  = _mm256_min_pd (min, _mm256_min_pd (v0, v1));
+      max  = _mm256_max_pd (max, _mm256_max_pd (v0, v1));
+    }
+
+  _mm256_storeu_pd (lanes, _mm256_add_pd (acc0, acc1));
+  sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  _mm256_storeu_pd (lanes, min);
+  lo = MIN (MIN (lanes[0], lanes[1]), MIN (lanes[2], lanes[3]));
+  _mm256_storeu_pd (lanes, max);
+  hi = MAX (MAX (lanes[0], lanes[1]), MAX (lanes[2], lanes[3]));
+  for (; u != len; ++u)
+    {
+      sum += data[u];
+      lo   = MIN (lo, data[u]);
+      hi   = MAX (hi, data[u]);
+    }
+
+  moments->sum = sum;
+  moments->min = lo;
+  moments->max = hi;
+
+  mean = _mm256_set1_pd (sum / len);
+  acc0 = acc1 = _mm256_setzero_pd ();
+  for (u = 0; u + 8 <= len; u += 8)
+    {
+      __m256d d0, d1;
+
+      d0   = _mm256_sub_pd (_mm256_loadu_pd (data + u), mean);
+      d1   = _mm256_sub_pd (_mm256_loadu_pd (data + u + 4), mean);
+      acc0 = _mm256_add_pd (acc0, _mm256_mul_pd (d0, d0));
+      acc1 = _mm256_add_pd (acc1, _mm256_mul_pd (d1, d1));
+    }
+
+  _mm256_storeu_pd (lanes, _mm256_add_pd (acc0, acc1));
+  m2 = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  for (; u != len; ++u)
+    m2 += (data[u] - sum / len) * (data[u] - sum / len);
+
+  moments->m2 = m2;
+}
+
+#endif /*GX_X86_SIMD*/
+
+static MomentsKernel moments_kernel;
+
+static void
+init_kernels (void)
+{
+  static gsize inited = 0;
+
+  if (!g_once_init_enter (&inited))
+    return;
+
+  moments_kernel = moments_portable;
+
+#ifdef GX_X86_SIMD
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx"))
+    moments_kernel = moments_avx;
+  else if (__builtin_cpu_supports ("sse2"))
+    moments_kernel = moments_sse2;
+#endif /*GX_X86_SIMD*/
+
+  g_once_init_leave (&inited, 1);
+}
+
+
+/**
+ * gx_stats_new:
+ * @flags: #GXStatsFlags
+ *
+ * Create a new #GXStats accumulator, without any values.
+ *
+ * Returns: (transfer full): a new #GXStats; free with gx_stats_free().
+ */
+GXStats*
+gx_stats_new (GXStatsFlags flags)
+{
+  GXStats *stats;
+
+  stats = g_slice_new0 (GXStats);
+
+  stats->min = INFINITY;
+  stats->max = -INFINITY;
+
+  if (flags & GX_STATS_FLAGS_PERCENTILES)
+    stats->digest = g_new0 (Digest, 1);
+
+  return stats;
+}
+
+
+/**
+ * gx_stats_free:
+ * @stats: a #GXStats
+ *
+ * Free @stats.
+ */
+void
+gx_stats_free (GXStats *stats)
+{
+  if (!stats)
+    return;
+
+  g_free (stats->digest);
+  g_slice_free (GXStats, stats);
+}
+
+
+/**
+ * gx_stats_add:
+ * @stats: a #GXStats
+ * @value: a number; not NaN
+ *
+ * Add @value to @stats.
+ */
+void
+gx_stats_add (GXStats *stats, gdouble value)
+{
+  gdouble delta;
+
+  g_return_if_fail (stats);
+
+  ++stats->count;
+  delta        = value - stats->mean;
+  stats->mean += delta / stats->count;
+  stats->m2   += delta * (value - stats->mean);
+  stats->min   = MIN (stats->min, value);
+  stats->max   = MAX (stats->max, value);
+
+  stats_add_to_sum (stats, value);
+
+  if (stats->digest)
+    digest_add (stats->digest, value, 1);
+}
+
+
+/**
+ * gx_stats_add_array:
+ * @stats: a #GXStats
+ * @values: (array length=n): an array of numbers; none of them NaN
+ * @n: the number of elements in @values
+ *
+ * Add the @n numbers in @values to @stats. This gives the same result as
+ * calling gx_stats_add() for each of them (up to rounding), but is much
+ * faster.
+ */
+void
+gx_stats_add_array (GXStats *stats, const gdouble *values, gsize n)
+{
+  gsize u, v, len;
+
+  g_return_if_fail (stats);
+  g_return_if_fail (values || n == 0);
+
+  init_kernels ();
+
+  for (u = 0; u < n; u += len)
+    {
+      Moments moments;
+
+      len = MIN (n - u, STATS_BLOCK_SIZE);
+      moments_kernel (values + u, len, &moments);
+      stats_add_moments (stats, len, moments.sum / len, &moments);
+
+      if (stats->digest)
+        for (v = 0; v != len; ++v)
+          digest_add (stats->digest, values[u + v], 1);
+    }
+}
+
+
+/**
+ * gx_stats_add_int_array:
+ * @stats: a #GXStats
+ * @array: a #GXIntArray
+ *
+ * Add the integers in @array to @stats, as with gx_stats_add_array(). Note
+ * that integers with an absolute value larger than 2^53 cannot all be
+ * represented exactly as a #gdouble.
+ */
+void
+gx_stats_add_int_array (GXStats *stats, GXIntArray *array)
+{
+  gdouble values[STATS_BLOCK_SIZE];
+  gsize   u, v, len;
+
+  g_return_if_fail (stats);
+  g_return_if_fail (array);
+
+  for (u = 0; u < array->len; u += len)
+    {
+      len = MIN (array->len - u, STATS_BLOCK_SIZE);
+      for (v = 0; v != len; ++v)
+        values[v] = (gdouble)array->data[u + v];
+
+      gx_stats_add_array (stats, values, len);
+    }
+}
+
+
+/**
+ * gx_stats_merge:
+ * @stats: a #GXStats
+ * @other: another #GXStats
+ *
+ * Add all the values that were added to @other to @stats as well, without
+ * changing @other (apart from compressing its percentile sketch). With this,
+ * the values can be spread over a number of accumulators, e.g. one for each
+ * thread, which are then combined.
+ *
+ * If @stats keeps percentiles (see #GX_STATS_FLAGS_PERCENTILES), @other must
+ * do so as well.
+ */
+void
+gx_stats_merge (GXStats *stats, GXStats *other)
+{
+  Moments moments;
+  gsize   u;
+
+  g_return_if_fail (stats);
+  g_return_if_fail (other);
+  g_return_if_fail (stats != other);
+  g_return_if_fail (!stats->digest || other->digest);
+
+  if (other->count == 0)
+    return;
+
+  moments.sum = other->sum;
+  moments.min = other->min;
+  moments.max = other->max;
+  moments.m2  = other->m2;
+  stats_add_moments (stats, other->count, other->mean, &moments);
+  stats_add_to_sum (stats, other->sum_comp);
+
+  if (stats->digest)
+    {
+      digest_sort (other->digest);
+      for (u = 0; u != other->digest->n_centroids; ++u)
+        digest_add (stats->digest, other->digest->items[u].mean,
+                    other->digest->items[u].weight);
+    }
+}
+
+
+/**
+ * gx_stats_fold_int:
+ * @stats: a #GXStats
+ * @data: an integer, stored in a pointer
+ * @user_data: (allow-none): ignored
+ *
+ * Add GPOINTER_TO_INT(@data) to @stats; for use with folds over integers
+ * stored in pointers, such as gx_list_fold(). Note that the folds return
+ * %NULL for empty sequences, rather than @stats.
+ *
+ * Returns: (transfer none): @stats.
+ */
+gpointer
+gx_stats_fold_int (GXStats *stats, gpointer data, gpointer user_data)
+{
+  g_return_val_if_fail (stats, NULL);
+
+  gx_stats_add (stats, GPOINTER_TO_INT (data));
+
+  return stats;
+}
+
+
+/**
+ * gx_stats_fold_double:
+ * @stats: a #GXStats
+ * @data: a pointer to a #gdouble
+ * @user_data: (allow-none): ignored
+ *
+ * Add *@data to @stats; for use with folds over sequences of pointers to
+ * #gdouble, such as gx_list_fold().
+ *
+ * Returns: (transfer none): @stats.
+ */
+gpointer
+gx_stats_fold_double (GXStats *stats, const gdouble *data, gpointer user_data)
+{
+  g_return_val_if_fail (stats, NULL);
+  g_return_val_if_fail (data, stats);
+
+  gx_stats_add (stats, *data);
+
+  return stats;
+}
+
+
+gpointer
+gx_stats_fold_int_kernel (gpointer acc, gpointer *data, gsize n,
+                          gpointer user_data)
+{
+  gdouble values[STATS_BLOCK_SIZE];
+  gsize   u, v, len;
+
+  g_return_val_if_fail (acc, NULL);
+
+  for (u = 0; u < n; u += len)
+    {
+      len = MIN (n - u, STATS_BLOCK_SIZE);
+      for (v = 0; v != len; ++v)
+        values[v] = GPOINTER_TO_INT (data[u + v]);
+
+      gx_stats_add_array ((GXStats*)acc, values, len);
+    }
+
+  return acc;
+}
+
+
+gpointer
+gx_stats_fold_double_kernel (gpointer acc, gpointer *data, gsize n,
+                             gpointer user_data)
+{
+  gdouble values[STATS_BLOCK_SIZE];
+  gsize   u, v, len;
+
+  g_return_val_if_fail (acc, NULL);
+
+  for (u = 0; u < n; u += len)
+    {
+      len = MIN (n - u, STATS_BLOCK_SIZE);
+      for (v = 0; v != len; ++v)
+        values[v] = *(const gdouble*)data[u + v];
+
+      gx_stats_add_array ((GXStats*)acc, values, len);
+    }
+
+  return acc;
+}
+
+
+/**
+ * gx_stats_get_count:
+ * @stats: a #GXStats
+ *
+ * Get the number of values added to @stats.
+ *
+ * Returns: the number of values.
+ */
+guint64
+gx_stats_get_count (GXStats *stats)
+{
+  g_return_val_if_fail (stats, 0);
+
+  return stats->count;
+}
+
+
+/**
+ * gx_stats_get_sum:
+ * @stats: a #GXStats
+ *
+ * Get the sum of the values added to @stats.
+ *
+ * Returns: the sum, or 0 if there are no values.
+ */
+gdouble
+gx_stats_get_sum (GXStats *stats)
+{
+  g_return_val_if_fail (stats, NAN);
+
+  return stats->sum + stats->sum_comp;
+}
+
+
+/**
+ * gx_stats_get_min:
+ * @stats: a #GXStats
+ *
+ * Get the smallest of the values added to @stats.
+ *
+ * Returns: the minimum, or NaN if there are no values.
+ */
+gdouble
+gx_stats_get_min (GXStats *stats)
+{
+  g_return_val_if_fail (stats, NAN);
+
+  return stats->count > 0 ? stats->min : NAN;
+}
+
+
+/**
+ * gx_stats_get_max:
+ * @stats: a #GXStats
+ *
+ * Get the largest of the values added to @stats.
+ *
+ * Returns: the maximum, or NaN if there are no values.
+ */
+gdouble
+gx_stats_get_max (GXStats *stats)
+{
+  g_return_val_if_fail (stats, NAN);
+
+  return stats->count > 0 ? stats->max : NAN;
+}
+
+
+/**
+ * gx_stats_get_mean:
+ * @stats: a #GXStats
+ *
+ * Get the arithmetic mean of the values added to @stats.
+ *
+ * Returns: the mean, or NaN if there are no values.
+ */
+gdouble
+gx_stats_get_mean (GXStats *stats)
+{
+  g_return_val_if_fail (stats, NAN);
+
+  return stats->count > 0 ? stats->mean : NAN;
+}
+
+
+/**
+ * gx_stats_get_variance:
+ * @stats: a #GXStats
+ *
+ * Get the (unbiased) sample variance of the values added to @stats, that is,
+ * the sum of the squared differences from the mean, divided by the number of
+ * values minus one.
+ *
+ * Returns: the variance, or NaN if there are fewer than two values.
+ */
+gdouble
+gx_stats_get_variance (GXStats *stats)
+{
+  g_return_val_if_fail (stats, NAN);
+
+  return stats->count > 1 ? stats->m2 / (stats->count - 1) : NAN;
+}
+
+
+/**
+ * gx_stats_get_stddev:
+ * @stats: a #GXStats
+ *
+ * Get the sample standard deviation of the values added to @stats: the
+ * square root of gx_stats_get_variance().
+ *
+ * Returns: the standard deviation, or NaN if there are fewer than two values.
+ */
+gdouble
+gx_stats_get_stddev (GXStats *stats)
+{
+  return sqrt (gx_stats_get_variance (stats));
+}
+
+
+/**
+ * gx_stats_get_percentile:
+ * @stats: a #GXStats, created with #GX_STATS_FLAGS_PERCENTILES
+ * @percentile: a percentile, between 0 and 100
+ *
+ * Estimate the given percentile of the values added to @stats; e.g., the
+ * median for 50, or the value that 99% of the values are smaller than for
+ * 99. The 0th and 100th percentiles are the minimum and maximum.
+ *
+ * Between the centroids of the sketch, the percentiles are linearly
+ * interpolated; the relative error in the rank of the estimate is largest for
+ * the median, where it is typically well below 1%.
+ *
+ * Returns: the estimated percentile, or NaN if there are no values.
+ */
+gdouble
+gx_stats_get_percentile (GXStats *stats, gdouble percentile)
+{
+  Digest   *digest;
+  Centroid *items;
+  gdouble   target, cum;
+  gsize     u;
+
+  g_return_val_if_fail (stats, NAN);
+  g_return_val_if_fail (stats->digest, NAN);
+  g_return_val_if_fail (percentile >= 0 && percentile <= 100, NAN);
+
+  if (stats->count == 0)
+    return NAN;
+
+  digest = stats->digest;
+  digest_sort (digest);
+
+  items  = digest->items;
+  target = percentile / 100 * digest->total_weight;
+
+  /* each centroid covers the ranks around its mean; below the first and
+   * above the last, interpolate towards the minimum and maximum */
+  cum = items[0].weight / 2;
+  if (target < cum)
+    return stats->min + (items[0].mean - stats->min) * target / cum;
+
+  for (u = 0; u + 1 < digest->n_centroids; ++u)
+    {
+      gdouble dw;
+
+      dw = (items[u].weight + items[u + 1].weight) / 2;
+      if (cum + dw > target)
+        return items[u].mean +
+          (items[u + 1].mean - items[u].mean) * (target - cum) / dw;
+
+      cum += dw;
+    }
+
+  return items[u].mean + (stats->max - items[u].mean) *
+    MIN (1.0, (target - cum) / (items[u].weight / 2));
+}
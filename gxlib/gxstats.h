@@ -0,0 +1,77 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_STATS_H__
+#define __GX_STATS_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXStats:
+ *
+ * A #GXStats accumulates summary statistics (count, sum, minimum, maximum,
+ * mean and variance, and optionally percentiles) over a stream of numbers,
+ * in a single pass and in a fixed amount of memory.
+ *
+ * The struct has only private fields and should not be directly accessed.
+ */
+struct _GXStats;
+typedef struct _GXStats GXStats;
+
+/**
+ * GXStatsFlags:
+ * @GX_STATS_FLAGS_NONE: no flags
+ * @GX_STATS_FLAGS_PERCENTILES: also keep a sketch of the distribution of the
+ * values, for gx_stats_get_percentile(); this takes about 12 kB of memory, and
+ * makes adding values considerably slower
+ *
+ * Flags for gx_stats_new().
+ */
+typedef enum {
+  GX_STATS_FLAGS_NONE        = 0,
+  GX_STATS_FLAGS_PERCENTILES = 1 << 0
+} GXStatsFlags;
+
+GXStats *gx_stats_new (GXStatsFlags flags) G_GNUC_WARN_UNUSED_RESULT;
+void gx_stats_free (GXStats *stats);
+
+void gx_stats_add (GXStats *stats, gdouble value);
+void gx_stats_add_array (GXStats *stats, const gdouble *values, gsize n);
+void gx_stats_add_int_array (GXStats *stats, GXIntArray *array);
+void gx_stats_merge (GXStats *stats, GXStats *other);
+
+gpointer gx_stats_fold_int (GXStats *stats, gpointer data, gpointer user_data);
+gpointer gx_stats_fold_double (GXStats *stats, const gdouble *data,
+                               gpointer user_data);
+
+guint64 gx_stats_get_count (GXStats *stats);
+gdouble gx_stats_get_sum (GXStats *stats);
+gdouble gx_stats_get_min (GXStats *stats);
+gdouble gx_stats_get_max (GXStats *stats);
+gdouble gx_stats_get_mean (GXStats *stats);
+gdouble gx_stats_get_variance (GXStats *stats);
+gdouble gx_stats_get_stddev (GXStats *stats);
+gdouble gx_stats_get_percentile (GXStats *stats, gdouble percentile);
+
+G_END_DECLS
+
+#endif /* __GX_STATS_H__ */
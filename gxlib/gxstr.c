@@ -18,8 +18,16 @@
 */
 
 #include <gxlib.h>
+#include "gxlib-private.h"
 #include <string.h>
 
+#include "gxflatten-table.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GX_X86_SIMD 1
+#include <immintrin.h>
+#endif /*__GNUC__ && x86*/
+
 /**
  * SECTION:gxstr
  * @title: Working with strings
@@ -32,18 +40,20 @@
 static GList*
 strv_to_list (gchar **strv, gssize n, gboolean copy)
 {
-  gint  i;
-  GList *lst;
+  gint          i;
+  GXListBuilder lst;
+
+  gx_list_builder_init (&lst);
 
   if (n < 0)
-    for (lst = NULL; *strv; ++strv) {
-      lst = g_list_prepend (lst, copy ? g_strdup (*strv): *strv);
+    for (; *strv; ++strv) {
+      gx_list_builder_append (&lst, copy ? g_strdup (*strv): *strv);
     }
   else
-    for (lst = NULL, i = 0; i != n; ++i, ++strv)
-      lst = g_list_prepend (lst, copy ? g_strdup (*strv): *strv);
+    for (i = 0; i != n; ++i, ++strv)
+      gx_list_builder_append (&lst, copy ? g_strdup (*strv): *strv);
 
-  return g_list_reverse (lst);
+  return lst.head;
 }
 
 
@@ -81,41 +91,851 @@ gx_strv_to_list_copy (gchar **strv, gssize n)
 
 
 
+/* gx_utf8_flatten() lowercases ASCII in bulk, a vector at a time where
+ * possible, and only takes the Unicode path for the non-ASCII spans in
+ * between.
+ *
+ * Flattening character-by-character gives the same result as flattening the
+ * fully decomposed (NFKD) string: decomposition works per character, and
+ * canonical reordering only moves combining marks, which we drop anyway. So
+ * the Unicode path looks up the flattened form of each character in a table
+ * that gen-flatten-table.c generates at build time. */
+
+/* lowercase the ASCII prefix of src (of at most len bytes) into dst, and
+ * return its length */
+typedef gsize (*LowerAsciiKernel) (const gchar *src, gchar *dst, gsize len);
+
+#define SWAR_ONES  G_GUINT64_CONSTANT (0x0101010101010101)
+#define SWAR_HIGHS (0x80 * SWAR_ONES)
+
+static gsize
+lower_ascii_portable (const gchar *src, gchar *dst, gsize len)
+{
+  gsize u;
+
+  /* eight bytes at a time; with all high bits clear, adding to a byte cannot
+   * carry into the next one, and the sums tell us which bytes are >= 'A'
+   * and > 'Z' */
+  for (u = 0; u + 8 <= len; u += 8)
+    {
+      guint64 word, upper;
+
+      memcpy (&word, src + u, 8);
+      if (word & SWAR_HIGHS)
+        break;
+
+      upper = (word + (0x80 - 'A') * SWAR_ONES) &
+        ~(word + (0x80 - 'Z' - 1) * SWAR_ONES) & SWAR_HIGHS;
+      word |= upper >> 2;
+
+      memcpy (dst + u, &word, 8);
+    }
+
+  for (; u != len && !(src[u] & 0x80); ++u)
+    dst[u] = g_ascii_tolower (src[u]);
+
+  return u;
+}
+
+#ifdef GX_X86_SIMD
+
+/* bytes b with 'A' <= b <= 'Z' are the ones where b + (128 - 'A'), as a
+ * signed byte, is less than -128 + 26 */
+
+__attribute__((target("sse2")))
+static gsize
+lower_ascii_sse2 (const gchar *src, gchar *dst, gsize len)
+{
+  __m128i offset, limit, bit;
+  gsize   u;
+
+  offset = _mm_set1_epi8 (128 - 'A');
+  limit  = _mm_set1_epi8 (-128 + 26);
+  bit    = _mm_set1_epi8 (0x20);
+
+  for (u = 0; u + 16 <= len; u += 16)
+    {
+      __m128i chars, upper;
+
+      chars = _mm_loadu_si128 ((const __m128i*)(src + u));
+      if (_mm_movemask_epi8 (chars))
+        break;
+
+      upper = _mm_cmplt_epi8 (_mm_add_epi8 (chars, offset), limit);
+      _mm_storeu_si128 ((__m128i*)(dst + u),
+                        _mm_or_si128 (chars, _mm_and_si128 (upper, bit)));
+    }
+
+  return u + lower_ascii_portable (src + u, dst + u, len - u);
+}
+
+__attribute__((target("avx2")))
+static gsize
+lower_ascii_avx2 (const gchar *src, gchar *dst, gsize len)
+{
+  __m256i offset, limit, bit;
+  gsize   u;
+
+  offset = _mm256_set1_epi8 (128 - 'A');
+  limit  = _mm256_set1_epi8 (-128 + 26);
+  bit    = _mm256_set1_epi8 (0x20);
+
+  for (u = 0; u + 32 <= len; u += 32)
+    {
+      __m256i chars, upper;
+
+      chars = _mm256_loadu_si256 ((const __m256i*)(src + u));
+      if (_mm256_movemask_epi8 (chars))
+        break;
+
+      upper = _mm256_cmpgt_epi8 (limit, _mm256_add_epi8 (chars, offset));
+      _mm256_storeu_si256 ((__m256i*)(dst + u),
+                           _mm256_or_si256 (chars,
+                                            _mm256_and_si256 (upper, bit)));
+    }
+
+  return u + lower_ascii_portable (src + u, dst + u, len - u);
+}
+
+#endif /*GX_X86_SIMD*/
+
+static LowerAsciiKernel lower_ascii_kernel;
+
+static void
+init_kernels (void)
+{
+  static gsize inited = 0;
+
+  if (!g_once_init_enter (&inited))
+    return;
+
+  lower_ascii_kernel = lower_ascii_portable;
+
+#ifdef GX_X86_SIMD
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2"))
+    lower_ascii_kernel = lower_ascii_avx2;
+  else if (__builtin_cpu_supports ("sse2"))
+    lower_ascii_kernel = lower_ascii_sse2;
+#endif /*GX_X86_SIMD*/
+
+  g_once_init_leave (&inited, 1);
+}
+
+
+/* the Hangul syllables decompose algorithmically, so they are not in the
+ * table; see the Unicode standard, section 3.12 */
+#define HANGUL_S_BASE  0xac00
+#define HANGUL_L_BASE  0x1100
+#define HANGUL_V_BASE  0x1161
+#define HANGUL_T_BASE  0x11a7
+#define HANGUL_T_COUNT 28
+#define HANGUL_N_COUNT (21 * HANGUL_T_COUNT)
+#define HANGUL_S_COUNT (19 * HANGUL_N_COUNT)
+
+/* the most bytes a character flattens to */
+#define FLATTEN_MAX_LEN ((1 << FLATTEN_LEN_BITS) - 1)
+
+/* decode the non-ASCII character at p, rejecting what g_utf8_validate()
+ * rejects; returns its length, or 0 if it is not valid */
+static inline gsize
+utf8_decode (const guchar *p, const guchar *end, gunichar *uc)
+{
+  if (p[0] < 0xc2)
+    return 0;  /* a continuation byte, or an overlong form */
+
+  else if (p[0] < 0xe0)
+    {
+      if (end - p < 2 || (p[1] & 0xc0) != 0x80)
+        return 0;
+
+      *uc = ((gunichar)(p[0] & 0x1f) << 6) | (p[1] & 0x3f);
+      return 2;
+    }
+
+  else if (p[0] < 0xf0)
+    {
+      if (end - p < 3 || (p[1] & 0xc0) != 0x80 || (p[2] & 0xc0) != 0x80)
+        return 0;
+
+      *uc = ((gunichar)(p[0] & 0x0f) << 12) |
+        ((gunichar)(p[1] & 0x3f) << 6) | (p[2] & 0x3f);
+      if (*uc < 0x800 || (*uc >= 0xd800 && *uc <= 0xdfff))
+        return 0;
+
+      return 3;
+    }
+
+  else if (p[0] < 0xf5)
+    {
+      if (end - p < 4 || (p[1] & 0xc0) != 0x80 || (p[2] & 0xc0) != 0x80 ||
+          (p[3] & 0xc0) != 0x80)
+        return 0;
+
+      *uc = ((gunichar)(p[0] & 0x07) << 18) |
+        ((gunichar)(p[1] & 0x3f) << 12) |
+        ((gunichar)(p[2] & 0x3f) << 6) | (p[3] & 0x3f);
+      if (*uc < 0x10000 || *uc > 0x10ffff)
+        return 0;
+
+      return 4;
+    }
+
+  return 0;
+}
+
+/* write the flattened form of uc (which is n bytes at p) to out, which must
+ * have room for FLATTEN_MAX_LEN bytes; returns the number of bytes
+ * written */
+static inline gsize
+flatten_char (gunichar uc, const guchar *p, gsize n, gchar *out)
+{
+  guint32 entry;
+  gsize   len;
+
+  if (uc - HANGUL_S_BASE < HANGUL_S_COUNT)
+    {
+      gunichar s;
+
+      s   = uc - HANGUL_S_BASE;
+      len = (gsize)g_unichar_to_utf8 (HANGUL_L_BASE + s / HANGUL_N_COUNT, out);
+      len += (gsize)g_unichar_to_utf8
+        (HANGUL_V_BASE + s % HANGUL_N_COUNT / HANGUL_T_COUNT, out + len);
+      if (s % HANGUL_T_COUNT != 0)
+        len += (gsize)g_unichar_to_utf8
+          (HANGUL_T_BASE + s % HANGUL_T_COUNT, out + len);
+
+      return len;
+    }
+
+  entry = flatten_blocks[((gsize)flatten_index[uc >> FLATTEN_BLOCK_BITS]
+                          << FLATTEN_BLOCK_BITS) |
+                         (uc & ((1 << FLATTEN_BLOCK_BITS) - 1))];
+  if (entry == 0)
+    {
+      memcpy (out, p, n);  /* it flattens to itself */
+      return n;
+    }
+
+  len = entry & FLATTEN_MAX_LEN;
+  memcpy (out, flatten_pool + (entry >> FLATTEN_LEN_BITS), len);
+
+  return len;
+}
+
+/* where flattened text goes: either a GString, which grows as needed, or a
+ * fixed buffer; once a fixed buffer is full, we only count */
+typedef struct {
+  GString *gstr;
+  gchar   *buf;
+  gsize    size;  /* the room in buf; for a GString, its length */
+  gsize    len;   /* the flattened length so far */
+} FlattenOut;
+
+/* make room for n more bytes; returns where to write them, or NULL if they
+ * do not fit in a fixed buffer */
+static inline gchar*
+flatten_reserve (FlattenOut *out, gsize n)
+{
+  if (G_LIKELY (out->len + n <= out->size))
+    return out->buf + out->len;
+
+  if (!out->gstr)
+    return NULL;
+
+  g_string_set_size (out->gstr, out->len + n);
+  out->buf  = out->gstr->str;
+  out->size = out->gstr->len;
+
+  return out->buf + out->len;
+}
+
+/* lowercase the ASCII prefix of str (of at most len bytes) into out;
+ * returns its length */
+static gsize
+flatten_ascii (FlattenOut *out, const gchar *str, gsize len)
+{
+  gchar *dst;
+  gsize  room, n;
+
+  dst = flatten_reserve (out, len);
+  if (G_LIKELY (dst != NULL))
+    n = lower_ascii_kernel (str, dst, len);
+  else
+    {
+      /* a full fixed buffer: fill what is left, and count the rest */
+      room = out->size > out->len ? out->size - out->len : 0;
+      n    = room ? lower_ascii_kernel (str, out->buf + out->len,
+                                        MIN (room, len)) : 0;
+      if (n == room)
+        while (n != len && !(str[n] & 0x80))
+          ++n;
+    }
+
+  out->len += n;
+
+  return n;
+}
+
+/* flatten a span of non-ASCII characters, in one pass through the table */
+static gboolean
+flatten_unicode (FlattenOut *out, const gchar *str, gsize len)
+{
+  const guchar *cur, *end;
+
+  for (cur = (const guchar*)str, end = cur + len; cur != end;)
+    {
+      gunichar uc;
+      gsize    n;
+
+      n = utf8_decode (cur, end, &uc);
+      if (G_UNLIKELY (n == 0))
+        return FALSE;
+
+      /* room for the rest, in case it all stays the same length */
+      if (G_LIKELY (out->len + FLATTEN_MAX_LEN <= out->size) ||
+          flatten_reserve (out, (gsize)(end - cur) + FLATTEN_MAX_LEN))
+        out->len += flatten_char (uc, cur, n, out->buf + out->len);
+      else
+        {
+          gchar scratch[FLATTEN_MAX_LEN];
+          gsize m;
+
+          m = flatten_char (uc, cur, n, scratch);
+          if (out->len + m <= out->size)
+            memcpy (out->buf + out->len, scratch, m);
+          out->len += m;
+        }
+
+      cur += n;
+    }
+
+  return TRUE;
+}
+
+/* flatten str (len bytes, without any '\0') into out; returns FALSE if str
+ * is not valid UTF-8 */
+static gboolean
+utf8_flatten_out (FlattenOut *out, const gchar *str, gsize len)
+{
+  gsize pos;
+
+  init_kernels ();
+
+  for (pos = 0; pos != len;)
+    {
+      gsize end;
+
+      pos += flatten_ascii (out, str + pos, len - pos);
+      if (pos == len)
+        break;
+
+      for (end = pos + 1; end != len && (str[end] & 0x80); ++end);
+
+      if (!flatten_unicode (out, str + pos, end - pos))
+        return FALSE;
+
+      pos = end;
+    }
+
+  return TRUE;
+}
+
+/* append the flattened str (len bytes, without any '\0') to gstr; returns
+ * FALSE, leaving gstr as it was, if str is not valid UTF-8 */
+static gboolean
+utf8_flatten_append (GString *gstr, const gchar *str, gsize len)
+{
+  FlattenOut out;
+  gsize      old_len;
+
+  old_len  = gstr->len;
+  out.gstr = gstr;
+  out.buf  = gstr->str;
+  out.size = out.len = old_len;
+
+  if (!utf8_flatten_out (&out, str, len))
+    {
+      g_string_truncate (gstr, old_len);
+      return FALSE;
+    }
+
+  g_string_truncate (gstr, out.len);
+
+  return TRUE;
+}
+
+/* the length of str, up to the first '\0' or len */
+static gsize
+utf8_flatten_len (const gchar *str, gssize len)
+{
+  const gchar *nul;
+
+  if (len < 0)
+    return strlen (str);
+
+  nul = memchr (str, '\0', (gsize)len);
+
+  return nul ? (gsize)(nul - str) : (gsize)len;
+}
+
+
 /**
  * gx_utf8_flatten:
  * @str: a UTF-8 string
  * @len: the length of @str, or -1 if it is %NULL-terminated
  *
  * Flatten some UTF-8 string; that is, downcase it and remove any diacritics.
+ * More precisely, each character is decomposed (as with
+ * g_utf8_normalize() and %G_NORMALIZE_ALL), the combining marks are dropped,
+ * and the rest is converted to lower case with g_unichar_tolower().
  *
- * Returns: (transfer full): a flattened string, free with g_free().
+ * ASCII text is lowercased in bulk, a vector of bytes at a time where the
+ * CPU supports it, so flattening mostly-ASCII strings is cheap.
+ *
+ * Returns: (transfer full): a flattened string, free with g_free(); or %NULL
+ * if @str is not valid UTF-8.
  */
 gchar*
 gx_utf8_flatten (const gchar *str, gssize len)
 {
   GString *gstr;
-  char    *norm, *cur;
+  gsize    n;
 
   g_return_val_if_fail (str, NULL);
 
-  norm = g_utf8_normalize (str, len, G_NORMALIZE_ALL);
-  if (!norm)
-    return NULL;
+  n    = utf8_flatten_len (str, len);
+  gstr = g_string_sized_new (n);
 
-  gstr = g_string_sized_new (strlen (norm));
+  if (!utf8_flatten_append (gstr, str, n))
+    {
+      g_string_free (gstr, TRUE);
+      return NULL;
+    }
+
+  return g_string_free (gstr, FALSE);
+}
+
+
+/**
+ * gx_utf8_flatten_append:
+ * @gstr: a #GString
+ * @str: a UTF-8 string
+ * @len: the length of @str, or -1 if it is %NULL-terminated
+ *
+ * Append the flattened @str (see gx_utf8_flatten()) to @gstr. When @gstr is
+ * reused, say after g_string_truncate(), this does not allocate once @gstr
+ * has grown big enough.
+ *
+ * Returns: %TRUE if @str was appended; %FALSE if @str is not valid UTF-8, in
+ * which case @gstr is unchanged.
+ */
+gboolean
+gx_utf8_flatten_append (GString *gstr, const gchar *str, gssize len)
+{
+  g_return_val_if_fail (gstr, FALSE);
+  g_return_val_if_fail (str, FALSE);
+
+  return utf8_flatten_append (gstr, str, utf8_flatten_len (str, len));
+}
+
+
+/**
+ * gx_utf8_flatten_into:
+ * @str: a UTF-8 string
+ * @len: the length of @str, or -1 if it is %NULL-terminated
+ * @buf: (allow-none): a buffer for the flattened string
+ * @buf_size: the size of @buf in bytes
+ *
+ * Flatten @str (see gx_utf8_flatten()) into @buf, including the terminating
+ * '\0'; this does not allocate.
+ *
+ * If the return value is @buf_size or more, the flattened string did not
+ * fit, and the contents of @buf are undefined; flatten again into a buffer
+ * of at least the return value plus one bytes. So, passing a @buf_size of 0
+ * (and @buf %NULL) gets you the size to use.
+ *
+ * Returns: the length of the flattened string, excluding the '\0'; or -1 if
+ * @str is not valid UTF-8.
+ */
+gssize
+gx_utf8_flatten_into (const gchar *str, gssize len, gchar *buf, gsize buf_size)
+{
+  FlattenOut out;
+
+  g_return_val_if_fail (str, -1);
+  g_return_val_if_fail (buf || buf_size == 0, -1);
 
-  for (cur = norm; cur && *cur; cur = g_utf8_next_char (cur))
+  out.gstr = NULL;
+  out.buf  = buf;
+  out.size = buf_size;
+  out.len  = 0;
+
+  if (!utf8_flatten_out (&out, str, utf8_flatten_len (str, len)))
+    return -1;
+
+  if (out.len < buf_size)
+    buf[out.len] = '\0';
+
+  return (gssize)out.len;
+}
+
+
+/* reads the flattened form of a string a byte at a time, without
+ * flattening more of it than that */
+typedef struct {
+  const guchar *cur;         /* the rest of the string */
+  const gchar  *pending;     /* the rest of the current character */
+  gsize         n_pending;
+  gchar         buf[FLATTEN_MAX_LEN];
+} FlattenReader;
+
+static inline void
+flatten_reader_init (FlattenReader *reader, const gchar *str)
+{
+  reader->cur       = (const guchar*)str;
+  reader->n_pending = 0;
+}
+
+static inline guchar
+lower_ascii (guchar c)
+{
+  return (guchar)(c - 'A') < 26 ? c | 0x20 : c;
+}
+
+/* the next byte of the flattened string, or 0 at its end; bytes that are
+ * not valid UTF-8 are passed as they are */
+static guchar
+flatten_reader_next (FlattenReader *reader)
+{
+  for (;;)
     {
-      gunichar gc;
+      gunichar uc;
+      guchar   c;
+      gsize    n, m;
 
-      gc = g_utf8_get_char (cur);
-      if (g_unichar_combining_class (gc) != 0)
-        continue;
+      if (reader->n_pending != 0)
+        {
+          --reader->n_pending;
+          return (guchar)*reader->pending++;
+        }
 
-      g_string_append_unichar (gstr, g_unichar_tolower(gc));
+      c = *reader->cur;
+      if (c < 0x80)
+        {
+          if (c != 0)
+            ++reader->cur;
+          return lower_ascii (c);
+        }
+
+      /* the string ends in a '\0', which stops decoding before the end we
+       * pass here */
+      n = utf8_decode (reader->cur, reader->cur + 4, &uc);
+      if (G_UNLIKELY (n == 0))
+        {
+          ++reader->cur;
+          return c;
+        }
+
+      m            = flatten_char (uc, reader->cur, n, reader->buf);
+      reader->cur += n;
+      if (m != 0)  /* otherwise, a dropped combining mark */
+        {
+          reader->pending   = reader->buf + 1;
+          reader->n_pending = m - 1;
+          return (guchar)reader->buf[0];
+        }
     }
+}
+
+static gint
+utf8_flatten_cmp (const gchar *str1, const gchar *str2)
+{
+  FlattenReader r1, r2;
 
-  g_free (norm);
+  flatten_reader_init (&r1, str1);
+  flatten_reader_init (&r2, str2);
 
-  return g_string_free (gstr, FALSE);
+  for (;;)
+    {
+      guchar c1, c2;
+
+      c1 = *r1.cur;
+      c2 = *r2.cur;
+
+      /* the common case: ASCII on both sides */
+      if (G_LIKELY ((c1 | c2) < 0x80 && (r1.n_pending | r2.n_pending) == 0))
+        {
+          ++r1.cur;
+          ++r2.cur;
+          c1 = lower_ascii (c1);
+          c2 = lower_ascii (c2);
+        }
+      else
+        {
+          c1 = flatten_reader_next (&r1);
+          c2 = flatten_reader_next (&r2);
+        }
+
+      if (c1 != c2)
+        return c1 < c2 ? -1 : 1;
+      else if (c1 == 0)
+        return 0;
+    }
+}
+
+
+/**
+ * gx_utf8_flatten_cmp:
+ * @str1: a %NULL-terminated UTF-8 string
+ * @str2: another one
+ *
+ * Compare two strings by their flattened forms (see gx_utf8_flatten()),
+ * as strcmp() would compare the results of gx_utf8_flatten(). The strings
+ * are flattened a character at a time while comparing, up to the first
+ * difference, and without allocating. Bytes that are not valid UTF-8
+ * compare as themselves.
+ *
+ * This is a #GCompareFunc, so it can be used with g_list_sort(),
+ * gx_list_sorted_uniq() and so on.
+ *
+ * Returns: a negative number if @str1 sorts before @str2, 0 if they
+ * flatten to the same string, or a positive number otherwise.
+ */
+gint
+gx_utf8_flatten_cmp (gconstpointer str1, gconstpointer str2)
+{
+  g_return_val_if_fail (str1, 0);
+  g_return_val_if_fail (str2, 0);
+
+  return utf8_flatten_cmp (str1, str2);
+}
+
+
+/**
+ * gx_utf8_flatten_equal:
+ * @str1: a %NULL-terminated UTF-8 string
+ * @str2: another one
+ *
+ * Check whether two strings flatten to the same string, as with
+ * gx_utf8_flatten_cmp().
+ *
+ * This is a #GEqualFunc; together with gx_utf8_flatten_hash() it makes
+ * for a #GHashTable whose keys match regardless of case and diacritics:
+ * |[<!-- language="C" -->
+ * GHashTable *table;
+ *
+ * table = g_hash_table_new (gx_utf8_flatten_hash, gx_utf8_flatten_equal);
+ * g_hash_table_insert (table, "Crème Brûlée", GINT_TO_POINTER (1));
+ *
+ * g_assert (g_hash_table_contains (table, "CRÈME BRÛLÉE"));
+ * g_assert (g_hash_table_contains (table, "creme brulee"));
+ * g_hash_table_destroy (table);
+ * ]|
+ *
+ * Returns: %TRUE if the strings flatten to the same string, %FALSE
+ * otherwise.
+ */
+gboolean
+gx_utf8_flatten_equal (gconstpointer str1, gconstpointer str2)
+{
+  g_return_val_if_fail (str1, FALSE);
+  g_return_val_if_fail (str2, FALSE);
+
+  return str1 == str2 || utf8_flatten_cmp (str1, str2) == 0;
+}
+
+
+/**
+ * gx_utf8_flatten_hash:
+ * @str: a %NULL-terminated UTF-8 string
+ *
+ * Get a hash value for the flattened form of @str, without allocating; it
+ * is the same as g_str_hash() of gx_utf8_flatten() of @str. Strings that
+ * are equal according to gx_utf8_flatten_equal() have the same hash value.
+ *
+ * This is a #GHashFunc; see gx_utf8_flatten_equal().
+ *
+ * Returns: a hash value.
+ */
+guint
+gx_utf8_flatten_hash (gconstpointer str)
+{
+  FlattenReader reader;
+  guint32       h;
+  guchar        c;
+
+  g_return_val_if_fail (str, 0);
+
+  /* as g_str_hash() does it */
+  flatten_reader_init (&reader, str);
+  for (h = 5381;;)
+    {
+      c = *reader.cur;
+      if (G_LIKELY ((guchar)(c - 1) < 0x7f && reader.n_pending == 0))
+        {
+          ++reader.cur;
+          c = lower_ascii (c);
+        }
+      else if ((c = flatten_reader_next (&reader)) == 0)
+        break;
+
+      h = (h << 5) + h + (guint32)(gint8)c;
+    }
+
+  return h;
+}
+
+
+/* the number of strings flattened per job in gx_utf8_flatten_strv(); for
+ * names and such, their input and output then stay in a core's cache */
+#define FLATTEN_JOB_SIZE 2048
+/* the number of jobs per thread, at least, so the work is spread evenly */
+#define FLATTEN_JOBS_PER_THREAD 4
+
+typedef struct {
+  gchar   **strv;
+  gsize     n;
+  gsize     job_size;
+  gchar   **result;
+  GString **bufs;     /* the flattened strings of each job */
+  gsize    *offsets;  /* where each job's strings go in the arena */
+  gchar    *arena;
+} FlattenStrvContext;
+
+static void
+flatten_strv_job (gsize job, FlattenStrvContext *ctx)
+{
+  GString *gstr;
+  gsize    u, end;
+
+  u    = job * ctx->job_size;
+  end  = MIN (u + ctx->job_size, ctx->n);
+  gstr = g_string_sized_new (32 * (end - u));
+
+  for (; u != end; ++u)
+    {
+      /* for now, the offset in the job's buffer */
+      ctx->result[u] = GSIZE_TO_POINTER (gstr->len);
+
+      /* if it is not valid UTF-8, we add nothing: an empty string */
+      utf8_flatten_append (gstr, ctx->strv[u], strlen (ctx->strv[u]));
+      g_string_append_c (gstr, '\0');
+    }
+
+  ctx->bufs[job] = gstr;
+}
+
+static void
+flatten_strv_copy_job (gsize job, FlattenStrvContext *ctx)
+{
+  gchar *dst;
+  gsize  u, end;
+
+  dst = ctx->arena + ctx->offsets[job];
+  memcpy (dst, ctx->bufs[job]->str, ctx->bufs[job]->len);
+  g_string_free (ctx->bufs[job], TRUE);
+
+  u   = job * ctx->job_size;
+  end = MIN (u + ctx->job_size, ctx->n);
+  for (; u != end; ++u)
+    ctx->result[u] = dst + GPOINTER_TO_SIZE (ctx->result[u]);
+}
+
+static gchar**
+utf8_flatten_strv (gchar **strv, gsize n, gint n_threads)
+{
+  FlattenStrvContext ctx;
+  gsize              n_jobs, job, size;
+
+  /* enough jobs to keep every thread busy, but not so big that they spill
+   * out of the cache */
+  n_jobs       = gx_get_n_threads (n_threads) * FLATTEN_JOBS_PER_THREAD;
+  ctx.job_size = CLAMP ((n + n_jobs - 1) / n_jobs, 1, FLATTEN_JOB_SIZE);
+  n_jobs       = (n + ctx.job_size - 1) / ctx.job_size;
+
+  ctx.strv    = strv;
+  ctx.n       = n;
+  ctx.result  = g_new (gchar*, n + 1);
+  ctx.bufs    = g_new (GString*, n_jobs);
+  ctx.offsets = g_new (gsize, n_jobs);
+
+  gx_run_jobs (n_jobs, n_threads, (GXJobFunc)flatten_strv_job, &ctx);
+
+  /* now that we know the sizes, put all the strings in an arena behind the
+   * pointers, so it can all be freed with a single g_free() */
+  for (size = 0, job = 0; job != n_jobs; ++job)
+    {
+      ctx.offsets[job] = size;
+      size            += ctx.bufs[job]->len;
+    }
+
+  ctx.result    = g_realloc (ctx.result, (n + 1) * sizeof (gchar*) + size);
+  ctx.arena     = (gchar*)(ctx.result + n + 1);
+  ctx.result[n] = NULL;
+
+  gx_run_jobs (n_jobs, n_threads, (GXJobFunc)flatten_strv_copy_job, &ctx);
+
+  g_free (ctx.bufs);
+  g_free (ctx.offsets);
+
+  return ctx.result;
+}
+
+
+/**
+ * gx_utf8_flatten_strv:
+ * @strv: an array of UTF-8 strings
+ * @n: the number of strings in @strv, or -1 if it is %NULL-terminated
+ * @n_threads: the maximum number of threads to use, or <= 0 to use the number
+ * of processors
+ *
+ * Flatten each of the strings in @strv (see gx_utf8_flatten()). For big
+ * arrays, the work is split into cache-sized chunks and spread over a
+ * #GThreadPool.
+ *
+ * The array and the flattened strings it points to share a single block of
+ * memory, which is freed with a single g_free() (not with g_strfreev()).
+ *
+ * Strings that are not valid UTF-8 become empty strings.
+ *
+ * Returns: (transfer full): a %NULL-terminated array of the flattened
+ * strings, in the order of @strv; free with g_free().
+ */
+gchar**
+gx_utf8_flatten_strv (gchar **strv, gssize n, gint n_threads)
+{
+  g_return_val_if_fail (strv || n == 0, NULL);
+
+  return utf8_flatten_strv (strv, n < 0 ? g_strv_length (strv) : (gsize)n,
+                            n_threads);
+}
+
+
+/**
+ * gx_utf8_flatten_list:
+ * @list: a #GList of UTF-8 strings
+ * @n_threads: the maximum number of threads to use, or <= 0 to use the number
+ * of processors
+ *
+ * Like gx_utf8_flatten_strv(), but for the strings in @list.
+ *
+ * Returns: (transfer full): a %NULL-terminated array of the flattened
+ * strings, in the order of @list; free with g_free().
+ */
+gchar**
+gx_utf8_flatten_list (GList *list, gint n_threads)
+{
+  gchar **strv, **flat;
+  gsize   u, n;
+
+  n    = g_list_length (list);
+  strv = g_new (gchar*, n);
+  for (u = 0; list; list = list->next, ++u)
+    strv[u] = list->data;
+
+  flat = utf8_flatten_strv (strv, n, n_threads);
+  g_free (strv);
+
+  return flat;
 }
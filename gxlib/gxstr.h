@@ -30,6 +30,20 @@ GList* gx_strv_to_list_copy (gchar **strv, gssize n) G_GNUC_WARN_UNUSED_RESULT;
 
 gchar* gx_utf8_flatten (const gchar *str, gssize len) G_GNUC_WARN_UNUSED_RESULT;
 
+gboolean gx_utf8_flatten_append (GString *gstr, const gchar *str, gssize len);
+
+gssize gx_utf8_flatten_into (const gchar *str, gssize len, gchar *buf,
+                             gsize buf_size);
+
+gint gx_utf8_flatten_cmp (gconstpointer str1, gconstpointer str2);
+gboolean gx_utf8_flatten_equal (gconstpointer str1, gconstpointer str2);
+guint gx_utf8_flatten_hash (gconstpointer str);
+
+gchar** gx_utf8_flatten_strv (gchar **strv, gssize n, gint n_threads)
+  G_GNUC_WARN_UNUSED_RESULT;
+gchar** gx_utf8_flatten_list (GList *list, gint n_threads)
+  G_GNUC_WARN_UNUSED_RESULT;
+
 G_END_DECLS
 
 #endif /* __GX_STR_H__ */
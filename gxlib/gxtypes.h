@@ -0,0 +1,38 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_TYPES_H__
+#define __GX_TYPES_H__
+
+/* forward declarations of the types that are used in more than one header,
+ * so that the headers can be included in any order; the types themselves
+ * are documented (and, where public, defined) in their own headers */
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GXIter     GXIter;
+typedef struct _GXIntArray GXIntArray;
+typedef struct _GXVec      GXVec;
+
+G_END_DECLS
+
+#endif /* __GX_TYPES_H__ */
@@ -0,0 +1,711 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <string.h>
+
+#include "gxvec.h"
+#include "gxlib-private.h"
+
+/**
+ * SECTION:gxvec
+ * @title: Functional vectors
+ * @short_description: a contiguous sequence of pointers with the
+ * functional operations of #GList
+ *
+ * A #GXVec stores its elements in a single contiguous buffer, rather than in a
+ * chain of separately allocated nodes like #GList. For large sequences, this
+ * is much kinder to the CPU-caches and the memory allocator, while offering
+ * the same functional operations as the gx_list_ functions: gx_vec_filter(),
+ * gx_vec_map(), gx_vec_fold() and so on.
+ *
+ * Converting between #GXVec and #GList or #GPtrArray is straightforward with
+ * gx_vec_from_list(), gx_vec_to_list(), gx_vec_from_ptr_array() and
+ * gx_vec_to_ptr_array().
+ *
+ * |[<!-- language="C" -->
+ * gint sum;
+ * GXVec *nums;
+ *
+ * // numbers 1..100 (inclusive)
+ * nums = gx_vec_iota (100, 1, 1);
+ * // filter out the non-primes
+ * nums = gx_vec_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+ * // take the sum
+ * sum = gx_vec_sum (nums);
+ *
+ * g_assert_cmpint (sum, ==, 1060);
+ * gx_vec_free (nums, NULL);
+ * ]|
+ */
+
+typedef struct {
+  gpointer *pdata;
+  gsize     len;
+  gsize     alloc;
+} GXRealVec;
+
+#define MIN_VEC_SIZE 16
+
+static void
+vec_maybe_expand (GXRealVec *rvec, gsize extra)
+{
+  gsize want;
+
+  want = rvec->len + extra;
+  if (want <= rvec->alloc)
+    return;
+
+  rvec->alloc = MAX (rvec->alloc, MIN_VEC_SIZE);
+  while (rvec->alloc < want)
+    rvec->alloc *= 2;
+
+  rvec->pdata = g_renew (gpointer, rvec->pdata, rvec->alloc);
+}
+
+
+/**
+ * gx_vec_new:
+ *
+ * Create a new, empty #GXVec.
+ *
+ * Returns: (transfer full): a new #GXVec; free with gx_vec_free().
+ */
+GXVec*
+gx_vec_new (void)
+{
+  return gx_vec_sized_new (0);
+}
+
+
+/**
+ * gx_vec_sized_new:
+ * @reserved_size: number of elements to pre-allocate space for
+ *
+ * Create a new, empty #GXVec with room for @reserved_size elements. This avoids
+ * re-allocations when the number of elements is known in advance.
+ *
+ * Returns: (transfer full): a new #GXVec; free with gx_vec_free().
+ */
+GXVec*
+gx_vec_sized_new (gsize reserved_size)
+{
+  GXRealVec *rvec;
+
+  rvec = g_slice_new0 (GXRealVec);
+  vec_maybe_expand (rvec, reserved_size);
+
+  return (GXVec*)rvec;
+}
+
+
+/**
+ * gx_vec_free:
+ * @vec: a #GXVec
+ * @free_func: (allow-none): function to free the elements in @vec
+ *
+ * Free @vec, after freeing each of its elements with @free_func, if it is not
+ * %NULL.
+ */
+void
+gx_vec_free (GXVec *vec, GDestroyNotify free_func)
+{
+  gsize u;
+
+  if (!vec)
+    return;
+
+  if (free_func)
+    for (u = 0; u != vec->len; ++u)
+      (*free_func) (vec->pdata[u]);
+
+  g_free (vec->pdata);
+  g_slice_free (GXRealVec, (GXRealVec*)vec);
+}
+
+
+/**
+ * gx_vec_append:
+ * @vec: a #GXVec
+ * @data: a pointer
+ *
+ * Add @data to the end of @vec, expanding its buffer if needed.
+ */
+void
+gx_vec_append (GXVec *vec, gpointer data)
+{
+  GXRealVec *rvec;
+
+  g_return_if_fail (vec);
+
+  rvec = (GXRealVec*)vec;
+  if (G_UNLIKELY (rvec->len == rvec->alloc))
+    vec_maybe_expand (rvec, 1);
+
+  rvec->pdata[rvec->len++] = data;
+}
+
+
+/**
+ * gx_vec_from_list:
+ * @list: a #GList
+ *
+ * Create a #GXVec with the elements of @list, in the same order. The elements
+ * themselves are not copied.
+ *
+ * Returns: (transfer full): a new #GXVec; free with gx_vec_free().
+ */
+GXVec*
+gx_vec_from_list (GList *list)
+{
+  GXVec *vec;
+
+  vec = gx_vec_sized_new (g_list_length (list));
+  for (; list; list = g_list_next (list))
+    vec->pdata[vec->len++] = list->data;
+
+  return vec;
+}
+
+
+/**
+ * gx_vec_to_list:
+ * @vec: a #GXVec
+ *
+ * Create a #GList with the elements of @vec, in the same order. The elements
+ * themselves are not copied.
+ *
+ * Returns: (transfer full): a new #GList; free with g_list_free().
+ */
+GList*
+gx_vec_to_list (GXVec *vec)
+{
+  GXListBuilder lst;
+  gsize         u;
+
+  g_return_val_if_fail (vec, NULL);
+
+  gx_list_builder_init (&lst);
+  for (u = 0; u != vec->len; ++u)
+    gx_list_builder_append (&lst, vec->pdata[u]);
+
+  return lst.head;
+}
+
+
+/**
+ * gx_vec_from_ptr_array:
+ * @array: a #GPtrArray
+ *
+ * Create a #GXVec with the elements of @array, in the same order. The
+ * elements themselves are not copied.
+ *
+ * Returns: (transfer full): a new #GXVec; free with gx_vec_free().
+ */
+GXVec*
+gx_vec_from_ptr_array (GPtrArray *array)
+{
+  GXVec *vec;
+
+  g_return_val_if_fail (array, NULL);
+
+  vec = gx_vec_sized_new (array->len);
+  if (array->len > 0)
+    memcpy (vec->pdata, array->pdata, array->len * sizeof (gpointer));
+  vec->len = array->len;
+
+  return vec;
+}
+
+
+/**
+ * gx_vec_to_ptr_array:
+ * @vec: a #GXVec
+ *
+ * Create a #GPtrArray with the elements of @vec, in the same order. The
+ * elements themselves are not copied.
+ *
+ * Returns: (transfer full): a new #GPtrArray; free with g_ptr_array_free().
+ */
+GPtrArray*
+gx_vec_to_ptr_array (GXVec *vec)
+{
+  GPtrArray *array;
+
+  g_return_val_if_fail (vec, NULL);
+  g_return_val_if_fail (vec->len <= G_MAXINT, NULL);
+
+  array = g_ptr_array_sized_new ((guint)vec->len);
+  g_ptr_array_set_size (array, (gint)vec->len);
+  if (vec->len > 0)
+    memcpy (array->pdata, vec->pdata, vec->len * sizeof (gpointer));
+
+  return array;
+}
+
+
+/**
+ * gx_vec_filter:
+ * @vec: a #GXVec
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ *
+ * Create a #GXVec consisting of a shallow copy of the elements of @vec for
+ * which the predicate function @pred_func returns %TRUE. This is the #GXVec
+ * equivalent of gx_list_filter().
+ *
+ * Returns: (transfer full): the filtered vector; free with gx_vec_free().
+ */
+GXVec*
+gx_vec_filter (GXVec *vec, GXPred pred_func, gpointer user_data)
+{
+  GXVec *filtered;
+  gsize  u;
+
+  g_return_val_if_fail (vec, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  filtered = gx_vec_sized_new (vec->len);
+  for (u = 0; u != vec->len; ++u)
+    if ((*pred_func) (vec->pdata[u], user_data))
+      filtered->pdata[filtered->len++] = vec->pdata[u];
+
+  return filtered;
+}
+
+
+/**
+ * gx_vec_filter_in_place:
+ * @vec: a #GXVec
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func
+ * @free_func: (allow-none): function to free elements that are filtered-out
+ *
+ * Remove elements from @vec for which @pred_func does not return %TRUE. The
+ * removed elements are freed with @free_func. The remaining elements keep
+ * their order. This is the #GXVec equivalent of gx_list_filter_in_place().
+ *
+ * Returns: @vec
+ */
+GXVec*
+gx_vec_filter_in_place (GXVec *vec, GXPred pred_func, gpointer user_data,
+                        GDestroyNotify free_func)
+{
+  gsize u, kept;
+
+  g_return_val_if_fail (vec, NULL);
+  g_return_val_if_fail (pred_func, NULL);
+
+  for (u = kept = 0; u != vec->len; ++u)
+    {
+      gpointer data;
+
+      data = vec->pdata[u];
+      if ((*pred_func) (data, user_data))
+        vec->pdata[kept++] = data;
+      else if (free_func)
+        (*free_func) (data);
+    }
+
+  vec->len = kept;
+
+  return vec;
+}
+
+
+/**
+ * gx_vec_every:
+ * @vec: a #GXVec
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for every element in @vec. If @vec is empty,
+ * this is considered %TRUE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for every element in @vec; %FALSE
+ * otherwise.
+ */
+gboolean
+gx_vec_every (GXVec *vec, GXPred pred_func, gpointer user_data)
+{
+  gsize u;
+
+  g_return_val_if_fail (vec, FALSE);
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (u = 0; u != vec->len; ++u)
+    if (!(*pred_func) (vec->pdata[u], user_data))
+      return FALSE;
+
+  return TRUE;
+}
+
+
+/**
+ * gx_vec_any:
+ * @vec: a #GXVec
+ * @pred_func: a predicate function
+ * @user_data: (allow-none): a user pointer passed to @pred_func.
+ *
+ * Check if the predicate is true for any element in @vec. If @vec is empty,
+ * this is considered %FALSE.
+ *
+ * Returns: %TRUE if #pred_func returns %TRUE for at least one element in @vec;
+ * %FALSE otherwise.
+ */
+gboolean
+gx_vec_any (GXVec *vec, GXPred pred_func, gpointer user_data)
+{
+  gsize u;
+
+  g_return_val_if_fail (vec, FALSE);
+  g_return_val_if_fail (pred_func, FALSE);
+
+  for (u = 0; u != vec->len; ++u)
+    if ((*pred_func) (vec->pdata[u], user_data))
+      return TRUE;
+
+  return FALSE;
+}
+
+
+static GXVec*
+vec_copy_range (GXVec *vec, gsize start, gsize len)
+{
+  GXVec *copy;
+
+  copy = gx_vec_sized_new (len);
+  if (len > 0)
+    memcpy (copy->pdata, vec->pdata + start, len * sizeof (gpointer));
+  copy->len = len;
+
+  return copy;
+}
+
+
+/**
+ * gx_vec_take:
+ * @vec: a #GXVec
+ * @n: the number of elements to take
+ *
+ * Take up to @n elements from @vec; if @n is greater than the length of @vec,
+ * take all of them. The elements are shared between @vec and the result.
+ *
+ * Returns: (transfer full): a new #GXVec with up to @n elements; free with
+ * gx_vec_free().
+ */
+GXVec*
+gx_vec_take (GXVec *vec, gsize n)
+{
+  g_return_val_if_fail (vec, NULL);
+
+  return vec_copy_range (vec, 0, MIN (n, vec->len));
+}
+
+
+/**
+ * gx_vec_take_in_place:
+ * @vec: a #GXVec
+ * @n: the number of elements to take
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Like gx_vec_take(), but affects @vec in-place; this reduces @vec to its first
+ * @n elements.
+ *
+ * Returns: @vec
+ */
+GXVec*
+gx_vec_take_in_place (GXVec *vec, gsize n, GDestroyNotify free_func)
+{
+  gsize u;
+
+  g_return_val_if_fail (vec, NULL);
+
+  if (n >= vec->len)
+    return vec;
+
+  if (free_func)
+    for (u = n; u != vec->len; ++u)
+      (*free_func) (vec->pdata[u]);
+
+  vec->len = n;
+
+  return vec;
+}
+
+
+/**
+ * gx_vec_skip:
+ * @vec: a #GXVec
+ * @n: the number of elements to skip
+ *
+ * Return a #GXVec of all but the first @n elements of @vec. If @n is greater
+ * than the length of @vec, the result is empty. The elements are shared
+ * between @vec and the result.
+ *
+ * Returns: (transfer full): a new #GXVec; free with gx_vec_free().
+ */
+GXVec*
+gx_vec_skip (GXVec *vec, gsize n)
+{
+  g_return_val_if_fail (vec, NULL);
+
+  n = MIN (n, vec->len);
+
+  return vec_copy_range (vec, n, vec->len - n);
+}
+
+
+/**
+ * gx_vec_skip_in_place:
+ * @vec: a #GXVec
+ * @n: the number of elements to skip
+ * @free_func: (allow-none): function to free the removed elements
+ *
+ * Remove the first @n elements from @vec.
+ *
+ * Returns: @vec
+ */
+GXVec*
+gx_vec_skip_in_place (GXVec *vec, gsize n, GDestroyNotify free_func)
+{
+  gsize u;
+
+  g_return_val_if_fail (vec, NULL);
+
+  n = MIN (n, vec->len);
+  if (n == 0)
+    return vec;
+
+  if (free_func)
+    for (u = 0; u != n; ++u)
+      (*free_func) (vec->pdata[u]);
+
+  memmove (vec->pdata, vec->pdata + n, (vec->len - n) * sizeof (gpointer));
+  vec->len -= n;
+
+  return vec;
+}
+
+
+/**
+ * gx_vec_map:
+ * @vec: a #GXVec
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ *
+ * Create a new #GXVec consisting of the elements obtained by applying
+ * @map_func to the corresponding elements in @vec.
+ *
+ * Returns: (transfer full): the vector with mapped values. Whether to free the
+ * elements when calling gx_vec_free() depends on @map_func.
+ */
+GXVec*
+gx_vec_map (GXVec *vec, GXBinaryFunc map_func, gpointer user_data)
+{
+  GXVec *mapped;
+  gsize  u;
+
+  g_return_val_if_fail (vec, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  mapped = gx_vec_sized_new (vec->len);
+  for (u = 0; u != vec->len; ++u)
+    mapped->pdata[u] = (*map_func) (vec->pdata[u], user_data);
+  mapped->len = vec->len;
+
+  return mapped;
+}
+
+
+/**
+ * gx_vec_map_in_place:
+ * @vec: a #GXVec
+ * @map_func: a mapping function
+ * @user_data: (allow-none): a user pointer passed to @map_func
+ * @free_func: (allow-none): a function to free the replaced element
+ *
+ * Replace each element in @vec with the value obtained from applying @map_func
+ * to it. Free the old element using @free_func.
+ *
+ * Returns: @vec
+ */
+GXVec*
+gx_vec_map_in_place (GXVec *vec, GXBinaryFunc map_func, gpointer user_data,
+                     GDestroyNotify free_func)
+{
+  gsize u;
+
+  g_return_val_if_fail (vec, NULL);
+  g_return_val_if_fail (map_func, NULL);
+
+  for (u = 0; u != vec->len; ++u)
+    {
+      gpointer old;
+
+      old = vec->pdata[u];
+      vec->pdata[u] = (*map_func) (old, user_data);
+
+      if (free_func)
+        (*free_func) (old);
+    }
+
+  return vec;
+}
+
+
+/**
+ * gx_vec_fold:
+ * @vec: a #GXVec
+ * @fold_func: a ternary function
+ * @init: the start value
+ * @user_data: (allow-none): a user pointer passed to @fold_func
+ * @free_func: (allow-none): a function to free the intermediate values
+ *
+ * Given a vector (a, b, c), compute
+ *      fold_func (fold_func (fold_func (@init, a), b), c)
+ *
+ * This is the #GXVec equivalent of gx_list_fold(); as with that function, the
+ * result for an empty @vec is %NULL, and a #GXFoldKernel registered for
+ * @fold_func is used when @free_func is %NULL.
+ *
+ * Returns: (transfer full): the computed value.
+ */
+gpointer
+gx_vec_fold (GXVec *vec, GXTernaryFunc fold_func, gpointer init,
+             gpointer user_data, GDestroyNotify free_func)
+{
+  gpointer     result, first;
+  gsize        u;
+  GXFoldKernel kernel;
+
+  g_return_val_if_fail (vec, NULL);
+  g_return_val_if_fail (fold_func, NULL);
+
+  kernel = free_func ? NULL : gx_fold_kernel_lookup (fold_func);
+  if (kernel && vec->len == 0)
+    return NULL;
+  else if (kernel)
+    return kernel (init, vec->pdata, vec->len, user_data);
+
+  for (result = NULL, first = init, u = 0; u != vec->len; ++u)
+    {
+      gpointer tmp;
+
+      tmp = (*fold_func) (first, vec->pdata[u], user_data);
+      if (free_func)
+        (*free_func) (result);
+
+      result = tmp;
+      first  = result;
+    }
+
+  return result;
+}
+
+
+/**
+ * gx_vec_iota:
+ * @count: number of elements to generate
+ * @start: the start value
+ * @step: the step size, must be > 0
+ *
+ * Create a #GXVec with @count numbers starting at @start, and then increasing
+ * by @step; this is the #GXVec equivalent of gx_list_iota().
+ *
+ * Returns: (transfer full): a vector with numbers. Free with gx_vec_free().
+ */
+GXVec*
+gx_vec_iota (gsize count, gint start, gsize step)
+{
+  GXVec *vec;
+  gsize  u;
+
+  g_return_val_if_fail (step > 0, NULL);
+
+  vec = gx_vec_sized_new (count);
+  for (u = 0; u != count; ++u, start += step)
+    vec->pdata[u] = GINT_TO_POINTER (start);
+  vec->len = count;
+
+  return vec;
+}
+
+
+/**
+ * gx_vec_sum:
+ * @vec: a #GXVec
+ *
+ * Calculate the sum of a vector of integers; see gx_list_sum().
+ *
+ * Returns: the sum of the integers in @vec.
+ */
+gint
+gx_vec_sum (GXVec *vec)
+{
+  guint  s0, s1, s2, s3;
+  gsize  u;
+
+  g_return_val_if_fail (vec, 0);
+
+  /* independent accumulators so the additions can overlap; unsigned, so
+   * overflow wraps around in the same way for every order of addition */
+  s0 = s1 = s2 = s3 = 0;
+  for (u = 0; u + 4 <= vec->len; u += 4)
+    {
+      s0 += (guint)GPOINTER_TO_INT (vec->pdata[u]);
+      s1 += (guint)GPOINTER_TO_INT (vec->pdata[u + 1]);
+      s2 += (guint)GPOINTER_TO_INT (vec->pdata[u + 2]);
+      s3 += (guint)GPOINTER_TO_INT (vec->pdata[u + 3]);
+    }
+  for (; u != vec->len; ++u)
+    s0 += (guint)GPOINTER_TO_INT (vec->pdata[u]);
+
+  return (gint)(s0 + s1 + s2 + s3);
+}
+
+
+/**
+ * gx_vec_product:
+ * @vec: a #GXVec
+ *
+ * Calculate the product of a vector of integers; see gx_list_product().
+ *
+ * Returns: the product of the integers in @vec.
+ */
+gint
+gx_vec_product (GXVec *vec)
+{
+  guint  p0, p1, p2, p3;
+  gsize  u;
+
+  g_return_val_if_fail (vec, 1);
+
+  p0 = p1 = p2 = p3 = 1;
+  for (u = 0; u + 4 <= vec->len; u += 4)
+    {
+      p0 *= (guint)GPOINTER_TO_INT (vec->pdata[u]);
+      p1 *= (guint)GPOINTER_TO_INT (vec->pdata[u + 1]);
+      p2 *= (guint)GPOINTER_TO_INT (vec->pdata[u + 2]);
+      p3 *= (guint)GPOINTER_TO_INT (vec->pdata[u + 3]);
+    }
+  for (; u != vec->len; ++u)
+    p0 *= (guint)GPOINTER_TO_INT (vec->pdata[u]);
+
+  return (gint)(p0 * p1 * p2 * p3);
+}
@@ -0,0 +1,96 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#ifndef __GX_VEC_H__
+#define __GX_VEC_H__
+
+#include <gxlib/gxlib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GXVec:
+ * @pdata: points to the contiguous array of pointers
+ * @len: the number of pointers in the array
+ *
+ * A #GXVec is a sequence of pointers stored in a single contiguous buffer,
+ * much like a #GPtrArray. Elements can be accessed directly through @pdata,
+ * or with gx_vec_index().
+ */
+struct _GXVec {
+  gpointer *pdata;
+  gsize     len;
+};
+
+/**
+ * gx_vec_index:
+ * @vec: a #GXVec
+ * @index_: the index of the element
+ *
+ * Get the element at @index_ of @vec. @index_ must be smaller than the length
+ * of @vec.
+ *
+ * Returns: the pointer at @index_.
+ */
+#define gx_vec_index(vec,index_) ((vec)->pdata)[index_]
+
+GXVec *gx_vec_new (void) G_GNUC_WARN_UNUSED_RESULT;
+GXVec *gx_vec_sized_new (gsize reserved_size) G_GNUC_WARN_UNUSED_RESULT;
+void gx_vec_free (GXVec *vec, GDestroyNotify free_func);
+
+void gx_vec_append (GXVec *vec, gpointer data);
+
+GXVec *gx_vec_from_list (GList *list) G_GNUC_WARN_UNUSED_RESULT;
+GList *gx_vec_to_list (GXVec *vec) G_GNUC_WARN_UNUSED_RESULT;
+GXVec *gx_vec_from_ptr_array (GPtrArray *array) G_GNUC_WARN_UNUSED_RESULT;
+GPtrArray *gx_vec_to_ptr_array (GXVec *vec) G_GNUC_WARN_UNUSED_RESULT;
+
+GXVec *gx_vec_filter (GXVec *vec, GXPred pred_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXVec *gx_vec_filter_in_place (GXVec *vec, GXPred pred_func,
+                               gpointer user_data, GDestroyNotify free_func);
+
+gboolean gx_vec_every (GXVec *vec, GXPred pred_func, gpointer user_data);
+gboolean gx_vec_any (GXVec *vec, GXPred pred_func, gpointer user_data);
+
+GXVec *gx_vec_take (GXVec *vec, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GXVec *gx_vec_take_in_place (GXVec *vec, gsize n, GDestroyNotify free_func);
+
+GXVec *gx_vec_skip (GXVec *vec, gsize n) G_GNUC_WARN_UNUSED_RESULT;
+GXVec *gx_vec_skip_in_place (GXVec *vec, gsize n, GDestroyNotify free_func);
+
+GXVec *gx_vec_map (GXVec *vec, GXBinaryFunc map_func, gpointer user_data)
+  G_GNUC_WARN_UNUSED_RESULT;
+GXVec *gx_vec_map_in_place (GXVec *vec, GXBinaryFunc map_func,
+                            gpointer user_data, GDestroyNotify free_func);
+
+gpointer gx_vec_fold (GXVec *vec, GXTernaryFunc fold_func, gpointer init,
+                      gpointer user_data, GDestroyNotify free_func)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+GXVec *gx_vec_iota (gsize count, gint start, gsize step)
+  G_GNUC_WARN_UNUSED_RESULT;
+
+gint gx_vec_sum (GXVec *vec);
+gint gx_vec_product (GXVec *vec);
+
+G_END_DECLS
+
+#endif /* __GX_VEC_H__ */
@@ -424,6 +424,708 @@ example_map_fold (void)
 }
 
 
+static void
+example_vec_primes_100 (void)
+{
+  gint sum;
+  GXVec *nums;
+
+  // numbers 1..100 (inclusive)
+  nums = gx_vec_iota (100, 1, 1);
+  // filter out the non-primes
+  nums = gx_vec_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+  // take the sum
+  sum = gx_vec_sum (nums);
+
+  g_assert_cmpint (sum, ==, 1060);
+  gx_vec_free (nums, NULL);
+}
+
+
+static void
+example_iter_primes_prod_20 (void)
+{
+  gint prod;
+
+  prod = gx_iter_product (
+          gx_iter_filter (gx_iter_iota (20, 1, 1), (GXPred)gx_is_prime, NULL));
+
+  g_assert_cmpint (prod, ==, 9699690);
+}
+
+
+static void
+example_iter_range (void)
+{
+  GXIter *iter;
+  GList  *lst;
+
+  // 10, 7, 4, 1
+  iter = gx_iter_range (10, 0, -3);
+
+  lst = gx_iter_collect (iter);
+  g_assert_cmpint (g_list_length (lst), ==, 4);
+  g_assert_cmpint (GPOINTER_TO_INT (g_list_last (lst)->data), ==, 1);
+  g_list_free (lst);
+}
+
+
+static gboolean below_1000 (gint n) { return n < 1000; }
+
+static void
+example_iter_take_while (void)
+{
+  gint sum;
+
+  // the sum of the even numbers below 1000
+  sum = gx_iter_sum (
+          gx_iter_take_while (gx_iter_iota (G_MAXSIZE, 0, 2),
+                              (GXPred)below_1000, NULL));
+
+  g_assert_cmpint (sum, ==, 249500);
+}
+
+
+static void
+example_par_filter (void)
+{
+  GList *nums, *primes;
+
+  nums   = gx_list_iota (1000 * 1000, 1, 1);
+  primes = gx_list_par_filter (nums, (GXPred)gx_is_prime, NULL, -1);
+
+  g_assert_cmpuint (g_list_length (primes), ==, 78498);
+
+  g_list_free (nums);
+  g_list_free (primes);
+}
+
+
+static void
+example_par_fold (void)
+{
+  GList *lst;
+  gint   sum;
+
+  lst = gx_list_iota (100, 1, 1);
+  sum = GPOINTER_TO_INT (gx_list_par_fold (lst, (GXTernaryFunc)gx_plus,
+                                           GINT_TO_POINTER(0), NULL,
+                                           NULL, NULL, -1));
+  g_assert_cmpint (sum, ==, 5050);
+  g_list_free (lst);
+}
+
+
+static void
+example_arena (void)
+{
+  GXListArena *arena;
+  GList *nums;
+
+  arena = gx_list_arena_new ();
+  gx_list_arena_push_thread_default (arena);
+
+  nums = gx_list_iota (1000 * 1000, 1, 1);
+  nums = gx_list_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+  g_assert_cmpuint (g_list_length (nums), ==, 78498);
+
+  gx_list_arena_pop_thread_default (arena);
+  gx_list_arena_free (arena); // frees all nodes of nums
+}
+
+
+static gint64 square (gint64 n, gpointer user_data) { return n * n; }
+
+static void
+example_int_array_squares (void)
+{
+  GXIntArray *nums;
+  gint64      sum;
+
+  // numbers 1..1000000 (inclusive)
+  nums = gx_int_array_iota (1000000, 1, 1);
+  // the sum of their squares does not fit in a gint, but does fit in a gint64
+  nums = gx_int_array_map_in_place (nums, square, NULL);
+  g_assert (gx_int_array_sum_checked (nums, &sum));
+  g_assert_cmpint (sum, ==, G_GINT64_CONSTANT(333333833333500000));
+
+  gx_int_array_free (nums);
+}
+
+
+static void
+example_int_array_fold (void)
+{
+  GXIntArray *nums;
+
+  nums = gx_int_array_iota (20, 1, 1);
+  g_assert_cmpint (gx_int_array_fold (nums, (GXIntFoldFunc)gx_times, 1, NULL),
+                   ==, G_GINT64_CONSTANT(2432902008176640000));
+  gx_int_array_free (nums);
+}
+
+
+static void
+example_reducer (void)
+{
+  g_assert (gx_reducer_for_func ((GCallback)gx_max) == GX_REDUCER_MAX);
+  g_assert (gx_reducer_for_func ((GCallback)gx_str_chain) == GX_REDUCER_NONE);
+}
+
+
+static gpointer
+xor_func (gpointer p1, gpointer p2, gpointer user_data)
+{
+  return GUINT_TO_POINTER (GPOINTER_TO_UINT (p1) ^ GPOINTER_TO_UINT (p2));
+}
+
+static gpointer
+xor_kernel (gpointer acc, gpointer *data, gsize n, gpointer user_data)
+{
+  guint x;
+  gsize u;
+
+  for (x = GPOINTER_TO_UINT (acc), u = 0; u != n; ++u)
+    x ^= GPOINTER_TO_UINT (data[u]);
+
+  return GUINT_TO_POINTER (x);
+}
+
+static void
+example_fold_kernel (void)
+{
+  GList *lst;
+
+  gx_fold_kernel_register ((GXTernaryFunc)xor_func, xor_kernel);
+
+  lst = gx_list_iota (4, 1, 1);
+  g_assert_cmpuint (GPOINTER_TO_UINT (gx_list_fold (lst, (GXTernaryFunc)xor_func,
+                                                    NULL, NULL, NULL)),
+                    ==, 1 ^ 2 ^ 3 ^ 4);
+  g_list_free (lst);
+
+  gx_fold_kernel_unregister ((GXTernaryFunc)xor_func);
+}
+
+
+static void
+example_prime_table (void)
+{
+  GXPrimeTable *table;
+  GList *primes;
+
+  table = gx_prime_table_new (10 * 1000 * 1000, GX_PRIME_TABLE_FLAGS_NONE, -1);
+  gx_prime_table_set_default (table);
+  gx_prime_table_unref (table);
+
+  primes = gx_list_filter_in_place (gx_list_iota (10 * 1000 * 1000, 1, 1),
+                                    (GXPred)gx_is_prime, NULL, NULL);
+  g_assert_cmpuint (g_list_length (primes), ==, 664579);
+  g_list_free (primes);
+
+  /* don't affect the other examples */
+  gx_prime_table_set_default (NULL);
+}
+
+
+static void
+example_prime_factorize (void)
+{
+  GXPrimeTable *table;
+  GList *factors;
+
+  table   = gx_prime_table_new (1000, GX_PRIME_TABLE_FLAGS_FACTORS, 1);
+  factors = gx_prime_table_factorize (table, 360); // 2, 2, 2, 3, 3, 5
+  g_assert_cmpuint (gx_list_product (factors), ==, 360);
+
+  g_list_free (factors);
+  gx_prime_table_unref (table);
+}
+
+
+static void
+example_prime_count_next_iter (void)
+{
+  GXPrimeTable *table;
+  GXIter *iter;
+
+  table = gx_prime_table_new (100, GX_PRIME_TABLE_FLAGS_NONE, 1);
+  g_assert_cmpuint (gx_prime_table_count (table, 100), ==, 25);
+  g_assert_cmpuint (gx_prime_table_next (table, 13), ==, 17);
+
+  // 11, 13, 17, 19
+  iter = gx_iter_take (gx_prime_table_iter (table, 10), 4);
+  g_assert_cmpint (gx_iter_sum (iter), ==, 11 + 13 + 17 + 19);
+
+  gx_prime_table_unref (table);
+}
+
+
+static void
+example_prime64 (void)
+{
+  g_assert_true (gx_is_prime64 (G_GUINT64_CONSTANT(18446744073709551557)));
+  g_assert_false (gx_is_prime64 (G_MAXUINT64));
+}
+
+
+static void
+example_prime64_batch (void)
+{
+  guint64 nums[] = { 7, 8, 9, G_GUINT64_CONSTANT(2305843009213693951) };
+  gboolean results[4];
+
+  g_assert_cmpuint (gx_is_prime64_batch (nums, 4, results), ==, 2);
+  g_assert_true (results[3]);
+}
+
+
+static void
+example_partition (void)
+{
+  GList *nums, *even, *odd;
+
+  nums = gx_list_iota (10, 1, 1);
+  even = gx_list_partition (nums, (GXPred)gx_is_even, NULL, &odd);
+
+  g_assert_cmpint (gx_list_sum (even), ==, 2 + 4 + 6 + 8 + 10);
+  g_assert_cmpint (gx_list_sum (odd), ==, 1 + 3 + 5 + 7 + 9);
+
+  g_list_free (nums);
+  g_list_free (even);
+  g_list_free (odd);
+}
+
+
+static void
+example_cmp_int (void)
+{
+  g_assert_cmpint (gx_cmp_int (-5, 3),<, 0);
+}
+
+
+static void
+example_uniq (void)
+{
+  GList *words, *uniq;
+
+  words = gx_strv_to_list ((gchar*[]){ "a", "b", "a", "c", "b", NULL }, -1);
+  uniq  = gx_list_uniq (words, g_str_hash, g_str_equal); // a, b, c
+  g_assert_cmpuint (g_list_length (uniq), ==, 3);
+
+  g_list_free (words);
+  g_list_free (uniq);
+}
+
+
+static void
+example_difference (void)
+{
+  GList *nums, *primes, *composites;
+
+  nums       = gx_list_iota (20, 1, 1);
+  primes     = gx_list_filter (nums, (GXPred)gx_is_prime, NULL);
+  composites = gx_list_difference (nums, primes, NULL, NULL);
+  g_assert_cmpuint (g_list_length (composites), ==, 12);
+
+  g_list_free (nums);
+  g_list_free (primes);
+  g_list_free (composites);
+}
+
+
+static void
+example_sorted_union (void)
+{
+  GList *odd, *threes, *merged;
+
+  odd    = gx_list_iota (5, 1, 2); // 1, 3, 5, 7, 9
+  threes = gx_list_iota (3, 3, 3); // 3, 6, 9
+  merged = gx_list_sorted_union (odd, threes, (GCompareFunc)gx_cmp_int);
+  g_assert_cmpint (gx_list_sum (merged), ==, 1 + 3 + 5 + 6 + 7 + 9);
+
+  g_list_free (odd);
+  g_list_free (threes);
+  g_list_free (merged);
+}
+
+
+static void
+example_join_by_key (void)
+{
+  GList *list1, *list2, *joined;
+
+  list1  = gx_strv_to_list ((gchar*[]){ "a", "b", "c", "b", NULL }, -1);
+  list2  = gx_strv_to_list ((gchar*[]){ "b", "c", "d", NULL }, -1);
+  joined = gx_list_join_by_key (list1, list2, NULL, NULL,
+                                g_str_hash, g_str_equal, NULL,
+                                (GXTernaryFunc)gx_str_chain, "=");
+  // "b=b", "c=c", "b=b"
+  g_assert_cmpuint (g_list_length (joined), ==, 3);
+  g_assert_cmpstr (joined->next->data, ==, "c=c");
+
+  g_list_free (list1);
+  g_list_free (list2);
+  g_list_free_full (joined, g_free);
+}
+
+
+static void
+example_group_by (void)
+{
+  GList *words;
+  GHashTable *groups;
+  GList *bs;
+
+  words  = gx_strv_to_list ((gchar*[]){ "a", "b", "c", "b", NULL }, -1);
+  groups = gx_list_group_by (words, NULL, g_str_hash, g_str_equal, NULL,
+                             NULL, NULL, NULL, NULL);
+  g_assert_cmpuint (g_hash_table_size (groups), ==, 3);
+
+  bs = g_hash_table_lookup (groups, "b");
+  g_assert_cmpuint (g_list_length (bs), ==, 2);
+
+  g_hash_table_destroy (groups);
+  g_list_free (words);
+}
+
+
+static void
+example_heap (void)
+{
+  GXHeap *heap;
+
+  heap = gx_heap_new ((GCompareFunc)gx_cmp_int);
+  gx_heap_push (heap, GINT_TO_POINTER (3));
+  gx_heap_push (heap, GINT_TO_POINTER (1));
+  gx_heap_push (heap, GINT_TO_POINTER (2));
+
+  g_assert_cmpint (GPOINTER_TO_INT (gx_heap_pop (heap)), ==, 1);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_heap_pop (heap)), ==, 2);
+  g_assert_cmpuint (gx_heap_get_size (heap), ==, 1);
+
+  gx_heap_free (heap, NULL);
+}
+
+
+static void
+example_top_k (void)
+{
+  GList *nums, *top;
+
+  nums = gx_list_iota (100, 1, 1);
+  top  = gx_list_top_k (nums, 3, (GCompareFunc)gx_cmp_int); // 100, 99, 98
+  g_assert_cmpint (gx_list_sum (top), ==, 100 + 99 + 98);
+  g_assert_cmpint (GPOINTER_TO_INT (top->data), ==, 100);
+
+  g_list_free (nums);
+  g_list_free (top);
+}
+
+
+static void
+example_merge_sorted (void)
+{
+  GList *lists[3], *merged;
+
+  lists[0] = gx_list_iota (3, 1, 3); // 1, 4, 7
+  lists[1] = gx_list_iota (3, 2, 3); // 2, 5, 8
+  lists[2] = gx_list_iota (3, 3, 3); // 3, 6, 9
+
+  merged = gx_list_merge_sorted (lists, 3, (GCompareFunc)gx_cmp_int);
+  g_assert_cmpint (GPOINTER_TO_INT (g_list_nth_data (merged, 4)), ==, 5);
+
+  g_list_free (lists[0]);
+  g_list_free (lists[1]);
+  g_list_free (lists[2]);
+  g_list_free (merged);
+}
+
+
+static void
+example_sort_by_key_casefold (void)
+{
+  GList *words;
+
+  words = gx_strv_to_list ((gchar*[]){ "Zebra", "apple", "Mango", NULL }, -1);
+  // sort case-insensitively, folding each word only once
+  words = gx_list_sort_by_key (words, (GXBinaryFunc)g_utf8_casefold,
+                               GINT_TO_POINTER (-1), (GCompareFunc)strcmp,
+                               g_free);
+  g_assert_cmpstr (words->data, ==, "apple");
+  g_assert_cmpstr (words->next->data, ==, "Mango");
+
+  g_list_free (words);
+}
+
+
+static void
+example_sort_by_key (void)
+{
+  GList *words;
+
+  words = gx_strv_to_list ((gchar*[]){ "ccc", "a", "bb", "d", NULL }, -1);
+  words = gx_list_sort_by_key (words, (GXBinaryFunc)strlen, NULL,
+                               (GCompareFunc)gx_cmp_int, NULL);
+  // "a", "d", "bb", "ccc"
+  g_assert_cmpstr (words->next->data, ==, "d");
+
+  g_list_free (words);
+}
+
+
+static void
+example_sort_int (void)
+{
+  GList *nums;
+
+  nums = gx_list_iota (5, -2, 1);
+  nums = g_list_reverse (nums); // 2, 1, 0, -1, -2
+  nums = gx_list_sort_int (nums);
+  g_assert_cmpint (GPOINTER_TO_INT (nums->data), ==, -2);
+
+  g_list_free (nums);
+}
+
+
+static void
+example_sort_parallel (void)
+{
+  GList *nums;
+
+  nums = g_list_reverse (gx_list_iota (100 * 1000, 0, 1));
+  nums = gx_list_sort_parallel (nums, (GCompareFunc)gx_cmp_int, -1);
+  g_assert_cmpint (GPOINTER_TO_INT (nums->data), ==, 0);
+
+  g_list_free (nums);
+}
+
+
+static void
+example_int_array_sort (void)
+{
+  GXIntArray *nums;
+
+  nums = gx_int_array_iota (5, 10, -3); // 10, 7, 4, 1, -2
+  gx_int_array_sort (nums);
+  g_assert_cmpint (gx_int_array_index (nums, 0), ==, -2);
+  g_assert_cmpint (gx_int_array_index (nums, 4), ==, 10);
+
+  gx_int_array_free (nums);
+}
+
+
+static void
+example_scan (void)
+{
+  GList *nums, *totals;
+
+  nums   = gx_list_iota (5, 1, 1); // 1, 2, 3, 4, 5
+  totals = gx_list_scan (nums, (GXTernaryFunc)gx_plus, GINT_TO_POINTER (0),
+                         NULL, GX_SCAN_INCLUSIVE); // 1, 3, 6, 10, 15
+  g_assert_cmpint (GPOINTER_TO_INT (g_list_last (totals)->data), ==, 15);
+
+  g_list_free (nums);
+  g_list_free (totals);
+}
+
+
+static void
+example_sliding_min (void)
+{
+  GList *nums, *mins;
+
+  nums = gx_list_iota (6, 1, 1); // 1, 2, 3, 4, 5, 6
+  nums = g_list_reverse (nums);
+  mins = gx_list_sliding_min (nums, 3, (GCompareFunc)gx_cmp_int);
+  // 4, 3, 2, 1
+  g_assert_cmpint (gx_list_sum (mins), ==, 4 + 3 + 2 + 1);
+
+  g_list_free (nums);
+  g_list_free (mins);
+}
+
+
+static void
+example_windowed_fold (void)
+{
+  GList *nums, *sums;
+
+  nums = gx_list_iota (5, 1, 1); // 1, 2, 3, 4, 5
+  sums = gx_list_windowed_fold (nums, 2, (GXTernaryFunc)gx_plus,
+                                GINT_TO_POINTER (0), NULL, NULL);
+  // 3, 5, 7, 9
+  g_assert_cmpint (gx_list_sum (sums), ==, 3 + 5 + 7 + 9);
+
+  g_list_free (nums);
+  g_list_free (sums);
+}
+
+
+static void
+example_int_array_scan (void)
+{
+  GXIntArray *nums;
+
+  nums = gx_int_array_iota (5, 1, 1); // 1, 2, 3, 4, 5
+  gx_int_array_scan_in_place (nums, (GXIntFoldFunc)gx_plus, 0, NULL);
+  // 1, 3, 6, 10, 15
+  g_assert_cmpint (gx_int_array_index (nums, 4), ==, 15);
+
+  gx_int_array_free (nums);
+}
+
+
+static void
+example_stats (void)
+{
+  GXStats *stats;
+  GList   *nums;
+
+  nums  = gx_list_iota (100, 1, 1);
+  stats = gx_stats_new (GX_STATS_FLAGS_PERCENTILES);
+  g_assert (gx_list_fold (nums, (GXTernaryFunc)gx_stats_fold_int, stats,
+                          NULL, NULL) == stats);
+
+  g_assert_cmpuint (gx_stats_get_count (stats), ==, 100);
+  g_assert_cmpfloat (gx_stats_get_sum (stats), ==, 5050);
+  g_assert_cmpfloat (gx_stats_get_max (stats), ==, 100);
+  g_assert_cmpfloat (gx_stats_get_mean (stats), ==, 50.5);
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 50), ==, 50.5);
+
+  gx_stats_free (stats);
+  g_list_free (nums);
+}
+
+
+typedef struct {
+  GXLink link;
+  gint   n;
+} Item;
+
+static gboolean
+item_is_even (GXLink *link, gpointer user_data)
+{
+  return GX_CONTAINER_OF (link, Item, link)->n % 2 == 0;
+}
+
+static void
+example_link (void)
+{
+  Item    items[10];
+  GXLink *list;
+  gint    i;
+
+  for (list = NULL, i = 9; i >= 0; --i)
+    {
+      items[i].n = i;
+      list = gx_link_prepend (list, &items[i].link);
+    }
+
+  list = gx_link_filter_in_place (list, (GXPred)item_is_even, NULL, NULL);
+  g_assert_cmpuint (gx_link_length (list), ==, 5);
+  g_assert_cmpint (GX_CONTAINER_OF (list->next, Item, link)->n, ==, 2);
+}
+
+
+static void
+example_plist_pages (void)
+{
+  GList   *results;
+  GXPList *all, *page, *rest;
+
+  results = gx_list_iota (1000, 0, 1);
+  all     = gx_plist_from_list (results);
+
+  rest = gx_plist_skip (all, 20);   // shares the nodes of all
+  page = gx_plist_take (rest, 10);  // 20, 21, ..., 29
+
+  g_assert_cmpuint (gx_plist_length (page), ==, 10);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_plist_head (page)), ==, 20);
+
+  gx_plist_unref (page);
+  gx_plist_unref (rest);
+  gx_plist_unref (all);
+  g_list_free (results);
+}
+
+
+static void
+example_slist (void)
+{
+  GSList *nums;
+
+  // numbers 1..100 (inclusive)
+  nums = gx_slist_iota (100, 1, 1);
+  // filter out the non-primes
+  nums = gx_slist_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+
+  g_assert_cmpint (gx_slist_sum (nums), ==, 1060);
+  g_slist_free (nums);
+}
+
+
+static void
+example_queue (void)
+{
+  GQueue *nums;
+
+  // numbers 1..100 (inclusive)
+  nums = gx_queue_iota (100, 1, 1);
+  // filter out the non-primes
+  nums = gx_queue_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+
+  g_assert_cmpuint (nums->length, ==, 25);
+  g_assert_cmpint (gx_queue_sum (nums), ==, 1060);
+  g_queue_free (nums);
+}
+
+
+static void
+example_ptr_array (void)
+{
+  GPtrArray *nums;
+
+  // numbers 1..100 (inclusive)
+  nums = gx_ptr_array_iota (100, 1, 1);
+  // filter out the non-primes
+  nums = gx_ptr_array_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+
+  g_assert_cmpuint (nums->len, ==, 25);
+  g_assert_cmpint (gx_ptr_array_sum (nums), ==, 1060);
+  g_ptr_array_free (nums, TRUE);
+}
+
+
+static void
+example_sequence (void)
+{
+  GSequence *nums;
+
+  // numbers 1..100 (inclusive)
+  nums = gx_sequence_iota (100, 1, 1);
+  // filter out the non-primes
+  nums = gx_sequence_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+
+  g_assert_cmpint (g_sequence_get_length (nums), ==, 25);
+  g_assert_cmpint (gx_sequence_sum (nums), ==, 1060);
+  g_sequence_free (nums);
+}
+
+
+static void
+example_utf8_flatten_keys (void)
+{
+  GHashTable *table;
+
+  table = g_hash_table_new (gx_utf8_flatten_hash, gx_utf8_flatten_equal);
+  g_hash_table_insert (table, "Crème Brûlée", GINT_TO_POINTER (1));
+
+  g_assert (g_hash_table_contains (table, "CRÈME BRÛLÉE"));
+  g_assert (g_hash_table_contains (table, "creme brulee"));
+  g_hash_table_destroy (table);
+}
+
 
 int
 main (int argc, char *argv[])
@@ -448,6 +1150,51 @@ main (int argc, char *argv[])
   g_test_add_func ("/example/chain", example_chain);
   g_test_add_func ("/example/sub-command", example_sub_command);
   g_test_add_func ("/example/map-fold", example_map_fold);
+  g_test_add_func ("/example/vec-primes-100", example_vec_primes_100);
+  g_test_add_func ("/example/iter-primes-prod-20", example_iter_primes_prod_20);
+  g_test_add_func ("/example/iter-range", example_iter_range);
+  g_test_add_func ("/example/iter-take-while", example_iter_take_while);
+  g_test_add_func ("/example/par-filter", example_par_filter);
+  g_test_add_func ("/example/par-fold", example_par_fold);
+  g_test_add_func ("/example/arena", example_arena);
+  g_test_add_func ("/example/int-array-squares", example_int_array_squares);
+  g_test_add_func ("/example/int-array-fold", example_int_array_fold);
+  g_test_add_func ("/example/reducer", example_reducer);
+  g_test_add_func ("/example/fold-kernel", example_fold_kernel);
+  g_test_add_func ("/example/prime-table", example_prime_table);
+  g_test_add_func ("/example/prime-factorize", example_prime_factorize);
+  g_test_add_func ("/example/prime-count-next-iter",
+                   example_prime_count_next_iter);
+  g_test_add_func ("/example/prime64", example_prime64);
+  g_test_add_func ("/example/prime64-batch", example_prime64_batch);
+  g_test_add_func ("/example/partition", example_partition);
+  g_test_add_func ("/example/cmp-int", example_cmp_int);
+  g_test_add_func ("/example/uniq", example_uniq);
+  g_test_add_func ("/example/difference", example_difference);
+  g_test_add_func ("/example/sorted-union", example_sorted_union);
+  g_test_add_func ("/example/join-by-key", example_join_by_key);
+  g_test_add_func ("/example/group-by", example_group_by);
+  g_test_add_func ("/example/heap", example_heap);
+  g_test_add_func ("/example/top-k", example_top_k);
+  g_test_add_func ("/example/merge-sorted", example_merge_sorted);
+  g_test_add_func ("/example/sort-by-key-casefold",
+                   example_sort_by_key_casefold);
+  g_test_add_func ("/example/sort-by-key", example_sort_by_key);
+  g_test_add_func ("/example/sort-int", example_sort_int);
+  g_test_add_func ("/example/sort-parallel", example_sort_parallel);
+  g_test_add_func ("/example/int-array-sort", example_int_array_sort);
+  g_test_add_func ("/example/scan", example_scan);
+  g_test_add_func ("/example/sliding-min", example_sliding_min);
+  g_test_add_func ("/example/windowed-fold", example_windowed_fold);
+  g_test_add_func ("/example/int-array-scan", example_int_array_scan);
+  g_test_add_func ("/example/stats", example_stats);
+  g_test_add_func ("/example/link", example_link);
+  g_test_add_func ("/example/plist-pages", example_plist_pages);
+  g_test_add_func ("/example/slist", example_slist);
+  g_test_add_func ("/example/queue", example_queue);
+  g_test_add_func ("/example/ptr-array", example_ptr_array);
+  g_test_add_func ("/example/sequence", example_sequence);
+  g_test_add_func ("/example/utf8-flatten-keys", example_utf8_flatten_keys);
  
   return g_test_run ();
 }
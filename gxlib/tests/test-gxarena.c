@@ -0,0 +1,307 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+
+static void
+assert_owned (GXListArena *arena, GList *lst)
+{
+  for (; lst; lst = g_list_next (lst))
+    {
+      g_assert (gx_list_arena_owns (arena, lst));
+      if (lst->next)
+        g_assert (lst->next->prev == lst);
+    }
+}
+
+
+static void
+test_thread_default (void)
+{
+  GXListArena *arena1, *arena2;
+
+  g_assert (!gx_list_arena_get_thread_default ());
+
+  arena1 = gx_list_arena_new ();
+  arena2 = gx_list_arena_new ();
+
+  gx_list_arena_push_thread_default (arena1);
+  g_assert (gx_list_arena_get_thread_default () == arena1);
+
+  gx_list_arena_push_thread_default (arena2);
+  g_assert (gx_list_arena_get_thread_default () == arena2);
+
+  gx_list_arena_pop_thread_default (arena2);
+  g_assert (gx_list_arena_get_thread_default () == arena1);
+
+  gx_list_arena_pop_thread_default (arena1);
+  g_assert (!gx_list_arena_get_thread_default ());
+
+  gx_list_arena_free (arena1);
+  gx_list_arena_free (arena2);
+}
+
+
+static int
+twice (gint num)
+{
+  return num * 2;
+}
+
+static void
+test_constructors (void)
+{
+  GXListArena *arena;
+  GList       *nums, *lst;
+  const char  *words[] = { "foo", "bar", "cuux", NULL };
+
+  arena = gx_list_arena_new ();
+  gx_list_arena_push_thread_default (arena);
+
+  /* spans several blocks */
+  nums = gx_list_iota (100000, 1, 1);
+  assert_owned (arena, nums);
+  g_assert_cmpuint (g_list_length (nums), ==, 100000);
+
+  lst = gx_list_filter (nums, (GXPred)gx_is_prime, NULL);
+  assert_owned (arena, lst);
+  g_assert_cmpuint (g_list_length (lst), ==, 9592);
+
+  lst = gx_list_map (lst, (GXBinaryFunc)twice, NULL);
+  assert_owned (arena, lst);
+  g_assert_cmpint (GPOINTER_TO_INT(lst->data), ==, 4);
+
+  lst = gx_list_take (nums, 10);
+  assert_owned (arena, lst);
+  g_assert_cmpint (gx_list_sum (lst), ==, 55);
+
+  lst = gx_list_skip (nums, 99990);
+  assert_owned (arena, lst);
+  g_assert_cmpuint (g_list_length (lst), ==, 10);
+  g_assert_cmpint (GPOINTER_TO_INT(lst->data), ==, 99991);
+
+  lst = gx_strv_to_list ((gchar**)words, -1);
+  assert_owned (arena, lst);
+  g_assert_cmpstr ((const char*)g_list_last (lst)->data, ==, "cuux");
+
+  gx_list_arena_pop_thread_default (arena);
+
+  /* without a thread-default, we get normal nodes */
+  lst = gx_list_iota (10, 1, 1);
+  g_assert (!gx_list_arena_owns (arena, lst));
+  g_list_free (lst);
+
+  gx_list_arena_free (arena);
+}
+
+
+static void
+test_in_place (void)
+{
+  GXListArena *arena;
+  GList       *nums, *normal;
+
+  arena  = gx_list_arena_new ();
+  normal = gx_list_iota (1000, 1, 1);
+
+  gx_list_arena_push_thread_default (arena);
+
+  nums = gx_list_iota (100000, 1, 1);
+  nums = gx_list_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+  g_assert_cmpuint (g_list_length (nums), ==, 9592);
+  nums = gx_list_skip_in_place (nums, 2, NULL);
+  nums = gx_list_take_in_place (nums, 3, NULL);
+  g_assert_cmpint (gx_list_sum (nums), ==, 5 + 7 + 11);
+
+  /* nodes that are not from the arena are freed as usual */
+  normal = gx_list_filter_in_place (normal, (GXPred)gx_is_prime, NULL, NULL);
+  g_assert_cmpuint (g_list_length (normal), ==, 168);
+  normal = gx_list_take_in_place (normal, 0, NULL);
+  g_assert (!normal);
+
+  gx_list_arena_pop_thread_default (arena);
+  gx_list_arena_free (arena);
+}
+
+
+static gpointer
+filter_nums (GList *nums)
+{
+  return gx_list_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+}
+
+static void
+test_in_place_popped (void)
+{
+  GXListArena *arena, *other;
+  GList       *nums;
+  GThread     *thread;
+
+  arena = gx_list_arena_new ();
+  other = gx_list_arena_new ();
+
+  gx_list_arena_push_thread_default (arena);
+  nums = gx_list_iota (100000, 1, 1);
+  gx_list_arena_pop_thread_default (arena);
+
+  /* without a thread-default arena */
+  nums = gx_list_filter_in_place (nums, (GXPred)gx_is_odd, NULL, NULL);
+  g_assert_cmpuint (g_list_length (nums), ==, 50000);
+  assert_owned (arena, nums);
+
+  /* with another thread-default arena */
+  gx_list_arena_push_thread_default (other);
+  nums = gx_list_skip_in_place (nums, 1, NULL);
+  nums = gx_list_take_in_place (nums, 10000, NULL);
+  gx_list_arena_pop_thread_default (other);
+  g_assert_cmpuint (g_list_length (nums), ==, 10000);
+  assert_owned (arena, nums);
+
+  /* in another thread */
+  thread = g_thread_new ("filter", (GThreadFunc)filter_nums, nums);
+  nums   = g_thread_join (thread);
+  g_assert_cmpuint (g_list_length (nums), ==, 2261);
+  assert_owned (arena, nums);
+
+  gx_list_arena_free (other);
+  gx_list_arena_free (arena);
+}
+
+
+static void
+test_clear (void)
+{
+  GXListArena *arena;
+  GList       *first, *lst;
+  guint        u;
+
+  arena = gx_list_arena_new ();
+  first = NULL;
+
+  for (u = 0; u != 3; ++u)
+    {
+      gx_list_arena_push_thread_default (arena);
+      lst = gx_list_iota (50000, 0, 1);
+      gx_list_arena_pop_thread_default (arena);
+
+      /* after clearing, the same memory is used again */
+      if (u == 0)
+        first = lst;
+      else
+        g_assert (lst == first);
+
+      g_assert_cmpuint (g_list_length (lst), ==, 50000);
+      gx_list_arena_clear (arena);
+    }
+
+  gx_list_arena_free (arena);
+}
+
+
+static gpointer
+build_lists (GXListArena *arena)
+{
+  guint u;
+
+  gx_list_arena_push_thread_default (arena);
+
+  for (u = 0; u != 20; ++u)
+    {
+      GList *lst;
+
+      lst = gx_list_iota (10000, 1, 1);
+      assert_owned (arena, lst);
+      lst = gx_list_filter_in_place (lst, (GXPred)gx_is_prime, NULL, NULL);
+      g_assert_cmpuint (g_list_length (lst), ==, 1229);
+    }
+
+  gx_list_arena_pop_thread_default (arena);
+
+  return NULL;
+}
+
+static void
+test_threads (void)
+{
+  GXListArena *arena;
+  GThread     *threads[4];
+  guint        u;
+
+  arena = gx_list_arena_new ();
+
+  for (u = 0; u != G_N_ELEMENTS(threads); ++u)
+    threads[u] = g_thread_new ("arena", (GThreadFunc)build_lists, arena);
+  for (u = 0; u != G_N_ELEMENTS(threads); ++u)
+    g_thread_join (threads[u]);
+
+  g_assert (!gx_list_arena_get_thread_default ());
+  gx_list_arena_free (arena);
+}
+
+
+static void
+test_perf (void)
+{
+  GXListArena *arena;
+  GList       *lst;
+  GTimer      *timer;
+  gdouble      slice_secs, arena_secs;
+
+  if (!g_test_perf ())
+    return;
+
+  timer = g_timer_new ();
+
+  g_timer_start (timer);
+  lst = gx_list_iota (10000000, 0, 1);
+  g_assert_cmpuint (g_list_length (lst), ==, 10000000);
+  g_list_free (lst);
+  slice_secs = g_timer_elapsed (timer, NULL);
+
+  g_timer_start (timer);
+  arena = gx_list_arena_new ();
+  gx_list_arena_push_thread_default (arena);
+  lst = gx_list_iota (10000000, 0, 1);
+  g_assert_cmpuint (g_list_length (lst), ==, 10000000);
+  gx_list_arena_pop_thread_default (arena);
+  gx_list_arena_free (arena);
+  arena_secs = g_timer_elapsed (timer, NULL);
+
+  g_test_minimized_result (slice_secs, "GList iota+free: %.3fs", slice_secs);
+  g_test_minimized_result (arena_secs, "GXListArena iota+free: %.3fs",
+                           arena_secs);
+  g_timer_destroy (timer);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-arena/thread-default", test_thread_default);
+  g_test_add_func ("/gx-arena/constructors", test_constructors);
+  g_test_add_func ("/gx-arena/in-place", test_in_place);
+  g_test_add_func ("/gx-arena/in-place-popped", test_in_place_popped);
+  g_test_add_func ("/gx-arena/clear", test_clear);
+  g_test_add_func ("/gx-arena/threads", test_threads);
+  g_test_add_func ("/gx-arena/perf", test_perf);
+
+  return g_test_run ();
+}
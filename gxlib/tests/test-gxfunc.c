@@ -88,6 +88,124 @@ test_min (void)
 }
 
 
+static void
+test_cmp_int (void)
+{
+  GList *lst;
+
+  g_assert_cmpint (gx_cmp_int (1, -1), >, 0);
+  g_assert_cmpint (gx_cmp_int (-1, 1), <, 0);
+  g_assert_cmpint (gx_cmp_int (7, 7), ==, 0);
+  g_assert_cmpint (gx_cmp_int (G_MININT, G_MAXINT), <, 0);
+  g_assert_cmpint (gx_cmp_int (G_MAXINT, G_MININT), >, 0);
+
+  lst = g_list_sort (g_list_reverse (gx_list_iota (10, 1, 1)),
+                    (GCompareFunc)gx_cmp_int);
+  g_assert_cmpint (GPOINTER_TO_INT (lst->data), ==, 1);
+  g_list_free (lst);
+}
+
+
+static void
+test_reducer (void)
+{
+  g_assert (gx_reducer_for_func ((GCallback)gx_plus) == GX_REDUCER_PLUS);
+  g_assert (gx_reducer_for_func ((GCallback)gx_times) == GX_REDUCER_TIMES);
+  g_assert (gx_reducer_for_func ((GCallback)gx_max) == GX_REDUCER_MAX);
+  g_assert (gx_reducer_for_func ((GCallback)gx_min) == GX_REDUCER_MIN);
+  g_assert (gx_reducer_for_func ((GCallback)gx_str_chain) == GX_REDUCER_NONE);
+  g_assert (gx_reducer_for_func (NULL) == GX_REDUCER_NONE);
+}
+
+
+static gpointer
+xor_func (gpointer p1, gpointer p2, gpointer user_data)
+{
+  return GUINT_TO_POINTER (GPOINTER_TO_UINT (p1) ^ GPOINTER_TO_UINT (p2));
+}
+
+static guint kernel_calls;
+
+static gpointer
+xor_kernel (gpointer acc, gpointer *data, gsize n, gpointer user_data)
+{
+  guint x;
+  gsize u;
+
+  ++kernel_calls;
+  for (x = GPOINTER_TO_UINT (acc), u = 0; u != n; ++u)
+    x ^= GPOINTER_TO_UINT (data[u]);
+
+  return GUINT_TO_POINTER (x);
+}
+
+static void
+test_fold_kernel (void)
+{
+  GList  *lst;
+  GXVec  *vec;
+  guint   u, expected;
+
+  g_assert (!gx_fold_kernel_lookup ((GXTernaryFunc)xor_func));
+  g_assert (gx_fold_kernel_lookup ((GXTernaryFunc)gx_plus));
+
+  lst = gx_list_iota (1000, 1, 1);
+  vec = gx_vec_iota (1000, 1, 1);
+  for (expected = 0, u = 1; u <= 1000; ++u)
+    expected ^= u;
+
+  /* the built-in kernels */
+  g_assert_cmpint (GPOINTER_TO_INT (gx_list_fold (lst, (GXTernaryFunc)gx_max,
+                                                  GINT_TO_POINTER(0),
+                                                  NULL, NULL)), ==, 1000);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_list_fold (lst, (GXTernaryFunc)gx_min,
+                                                  GINT_TO_POINTER(10),
+                                                  NULL, NULL)), ==, 1);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_vec_fold (vec, (GXTernaryFunc)gx_plus,
+                                                 GINT_TO_POINTER(0),
+                                                 NULL, NULL)), ==, 500500);
+  g_assert (!gx_list_fold (NULL, (GXTernaryFunc)gx_plus, GINT_TO_POINTER(1),
+                           NULL, NULL));
+
+  gx_fold_kernel_register ((GXTernaryFunc)xor_func, xor_kernel);
+  g_assert (gx_fold_kernel_lookup ((GXTernaryFunc)xor_func) == xor_kernel);
+
+  kernel_calls = 0;
+  g_assert_cmpuint (GPOINTER_TO_UINT (gx_list_fold (lst,
+                                                    (GXTernaryFunc)xor_func,
+                                                    NULL, NULL, NULL)),
+                    ==, expected);
+  g_assert_cmpuint (kernel_calls, >, 0);
+
+  kernel_calls = 0;
+  g_assert_cmpuint (GPOINTER_TO_UINT (gx_vec_fold (vec,
+                                                   (GXTernaryFunc)xor_func,
+                                                   NULL, NULL, NULL)),
+                    ==, expected);
+  g_assert_cmpuint (kernel_calls, ==, 1);
+
+  kernel_calls = 0;
+  g_assert_cmpuint (GPOINTER_TO_UINT (gx_iter_fold (gx_iter_list (lst),
+                                                    (GXTernaryFunc)xor_func,
+                                                    NULL, NULL, NULL)),
+                    ==, expected);
+  g_assert_cmpuint (kernel_calls, >, 0);
+
+  gx_fold_kernel_unregister ((GXTernaryFunc)xor_func);
+  g_assert (!gx_fold_kernel_lookup ((GXTernaryFunc)xor_func));
+
+  kernel_calls = 0;
+  g_assert_cmpuint (GPOINTER_TO_UINT (gx_list_fold (lst,
+                                                    (GXTernaryFunc)xor_func,
+                                                    NULL, NULL, NULL)),
+                    ==, expected);
+  g_assert_cmpuint (kernel_calls, ==, 0);
+
+  gx_vec_free (vec, NULL);
+  g_list_free (lst);
+}
+
+
 static void
 test_concat (void)
 {
@@ -117,6 +235,9 @@ main (int argc, char *argv[])
   g_test_add_func ("/gx-func/times", test_times);
   g_test_add_func ("/gx-func/max", test_max);
   g_test_add_func ("/gx-func/min", test_min);
+  g_test_add_func ("/gx-func/cmp-int", test_cmp_int);
+  g_test_add_func ("/gx-func/reducer", test_reducer);
+  g_test_add_func ("/gx-func/fold-kernel", test_fold_kernel);
   g_test_add_func ("/gx-func/concat", test_concat);
   
   return g_test_run ();
@@ -0,0 +1,242 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+
+static void
+test_heap (void)
+{
+  GXHeap *heap;
+  GList  *nums, *cur;
+  guint   u;
+
+  heap = gx_heap_new ((GCompareFunc)gx_cmp_int);
+  g_assert (gx_heap_peek (heap) == NULL);
+  g_assert (gx_heap_pop (heap) == NULL);
+
+  /* enough to grow the heap a few times */
+  for (nums = NULL, u = 0; u != 1000; ++u)
+    {
+      gint n;
+
+      n    = g_random_int_range (-500, 500);
+      nums = g_list_prepend (nums, GINT_TO_POINTER (n));
+      gx_heap_push (heap, GINT_TO_POINTER (n));
+    }
+  g_assert_cmpuint (gx_heap_get_size (heap), ==, 1000);
+
+  nums = g_list_sort (nums, (GCompareFunc)gx_cmp_int);
+  for (cur = nums; cur; cur = cur->next)
+    {
+      g_assert_cmpint (GPOINTER_TO_INT (gx_heap_peek (heap)), ==,
+                       GPOINTER_TO_INT (cur->data));
+      g_assert_cmpint (GPOINTER_TO_INT (gx_heap_pop (heap)), ==,
+                       GPOINTER_TO_INT (cur->data));
+    }
+  g_assert_cmpuint (gx_heap_get_size (heap), ==, 0);
+
+  g_list_free (nums);
+  gx_heap_free (heap, NULL);
+}
+
+
+static gint
+cmp_int_desc (gconstpointer p1, gconstpointer p2, gpointer user_data)
+{
+  g_assert_cmpstr (user_data, ==, "data");
+  return gx_cmp_int (GPOINTER_TO_INT (p2), GPOINTER_TO_INT (p1));
+}
+
+static void
+test_replace (void)
+{
+  GXHeap *heap;
+  gint    i;
+
+  heap = gx_heap_new_with_data (cmp_int_desc, "data");
+  for (i = 0; i != 10; ++i)
+    gx_heap_push (heap, GINT_TO_POINTER (i));
+
+  /* a max-heap; replace the top with something smaller and larger */
+  g_assert_cmpint (GPOINTER_TO_INT (gx_heap_replace
+                                    (heap, GINT_TO_POINTER (-1))), ==, 9);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_heap_peek (heap)), ==, 8);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_heap_replace
+                                    (heap, GINT_TO_POINTER (20))), ==, 8);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_heap_pop (heap)), ==, 20);
+  g_assert_cmpuint (gx_heap_get_size (heap), ==, 9);
+
+  for (i = 7; i != -2; --i)
+    g_assert_cmpint (GPOINTER_TO_INT (gx_heap_pop (heap)), ==, i);
+
+  gx_heap_free (heap, NULL);
+
+  /* freeing the remaining elements */
+  heap = gx_heap_sized_new ((GCompareDataFunc)g_strcmp0, NULL, 2);
+  for (i = 0; i != 10; ++i)
+    gx_heap_push (heap, g_strdup_printf ("%d", i));
+  g_free (gx_heap_pop (heap));
+  gx_heap_free (heap, g_free);
+}
+
+
+static void
+test_top_k (void)
+{
+  guint round;
+
+  for (round = 0; round != 100; ++round)
+    {
+      GList *nums, *sorted, *top, *expected, *cur1, *cur2;
+      gsize  n, k;
+
+      n = g_random_int_range (0, 500);
+      k = round == 0 ? 0 : (gsize)g_random_int_range (1, 600);
+
+      for (nums = NULL; n != 0; --n)
+        nums = g_list_prepend (nums,
+                               GINT_TO_POINTER (g_random_int_range (0, 100)));
+
+      sorted   = g_list_reverse (g_list_sort (g_list_copy (nums),
+                                              (GCompareFunc)gx_cmp_int));
+      expected = gx_list_take (sorted, k);
+
+      top = gx_list_top_k (nums, k, (GCompareFunc)gx_cmp_int);
+      g_assert_cmpuint (g_list_length (top), ==, g_list_length (expected));
+      for (cur1 = top, cur2 = expected; cur1;
+           cur1 = cur1->next, cur2 = cur2->next)
+        g_assert_cmpint (GPOINTER_TO_INT (cur1->data), ==,
+                         GPOINTER_TO_INT (cur2->data));
+      g_list_free (top);
+
+      top = gx_list_top_k_in_place (nums, k, (GCompareFunc)gx_cmp_int, NULL);
+      g_assert_cmpuint (g_list_length (top), ==, g_list_length (expected));
+      for (cur1 = top, cur2 = expected; cur1;
+           cur1 = cur1->next, cur2 = cur2->next)
+        {
+          g_assert_cmpint (GPOINTER_TO_INT (cur1->data), ==,
+                           GPOINTER_TO_INT (cur2->data));
+          g_assert (!cur1->next || cur1->next->prev == cur1);
+        }
+      g_assert (!top || !top->prev);
+
+      g_list_free (top);
+      g_list_free (expected);
+      g_list_free (sorted);
+    }
+}
+
+
+static void
+test_top_k_in_place_free (void)
+{
+  GList *words;
+
+  words = NULL;
+  words = g_list_prepend (words, g_strdup ("banana"));
+  words = g_list_prepend (words, g_strdup ("cherry"));
+  words = g_list_prepend (words, g_strdup ("apple"));
+  words = g_list_prepend (words, g_strdup ("date"));
+
+  words = gx_list_top_k_in_place (words, 2, (GCompareFunc)g_strcmp0, g_free);
+  g_assert_cmpuint (g_list_length (words), ==, 2);
+  g_assert_cmpstr (words->data, ==, "date");
+  g_assert_cmpstr (words->next->data, ==, "cherry");
+
+  words = gx_list_top_k_in_place (words, 0, (GCompareFunc)g_strcmp0, g_free);
+  g_assert (!words);
+}
+
+
+/* compare by the tens, so we can check that the merge is stable */
+static gint
+cmp_tens (gconstpointer p1, gconstpointer p2)
+{
+  return gx_cmp_int (GPOINTER_TO_INT (p1) / 10, GPOINTER_TO_INT (p2) / 10);
+}
+
+static void
+test_merge_sorted (void)
+{
+  guint round;
+
+  g_assert (!gx_list_merge_sorted (NULL, 0, cmp_tens));
+
+  for (round = 0; round != 50; ++round)
+    {
+      GList  *lists[10], *all, *merged, *cur1, *cur2;
+      gsize   n_lists, u, v;
+
+      n_lists = g_random_int_range (1, G_N_ELEMENTS (lists) + 1);
+      for (all = NULL, u = 0; u != n_lists; ++u)
+        {
+          gsize len;
+
+          len = g_random_int_range (0, 50);
+          for (lists[u] = NULL, v = 0; v != len; ++v)
+            lists[u] = g_list_prepend
+              (lists[u], GINT_TO_POINTER (g_random_int_range (0, 20) * 10 +
+                                          (gint)u));
+          lists[u] = g_list_sort (lists[u], cmp_tens);
+          all      = g_list_concat (all, g_list_copy (lists[u]));
+        }
+
+      /* g_list_sort() is stable, too */
+      all = g_list_sort (all, cmp_tens);
+
+      merged = gx_list_merge_sorted (lists, n_lists, cmp_tens);
+      g_assert_cmpuint (g_list_length (merged), ==, g_list_length (all));
+      for (cur1 = merged, cur2 = all; cur1;
+           cur1 = cur1->next, cur2 = cur2->next)
+        g_assert_cmpint (GPOINTER_TO_INT (cur1->data), ==,
+                         GPOINTER_TO_INT (cur2->data));
+      g_list_free (merged);
+
+      merged = gx_list_merge_sorted_in_place (lists, n_lists, cmp_tens);
+      for (u = 0; u != n_lists; ++u)
+        g_assert (!lists[u]);
+      g_assert_cmpuint (g_list_length (merged), ==, g_list_length (all));
+      for (cur1 = merged, cur2 = all; cur1;
+           cur1 = cur1->next, cur2 = cur2->next)
+        {
+          g_assert_cmpint (GPOINTER_TO_INT (cur1->data), ==,
+                           GPOINTER_TO_INT (cur2->data));
+          g_assert (!cur1->next || cur1->next->prev == cur1);
+        }
+
+      g_list_free (merged);
+      g_list_free (all);
+    }
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-heap/heap", test_heap);
+  g_test_add_func ("/gx-heap/replace", test_replace);
+  g_test_add_func ("/gx-heap/top-k", test_top_k);
+  g_test_add_func ("/gx-heap/top-k-in-place-free", test_top_k_in_place_free);
+  g_test_add_func ("/gx-heap/merge-sorted", test_merge_sorted);
+
+  return g_test_run ();
+}
@@ -0,0 +1,450 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void
+test_iota (void)
+{
+  GXIntArray *array;
+  gsize       u;
+
+  array = gx_int_array_iota (0, 1, 1);
+  g_assert_cmpuint (array->len, ==, 0);
+  gx_int_array_free (array);
+
+  array = gx_int_array_iota (5, 10, -3);
+  g_assert_cmpuint (array->len, ==, 5);
+  for (u = 0; u != array->len; ++u)
+    g_assert_cmpint (gx_int_array_index (array, u), ==, 10 - 3 * (gint64)u);
+  gx_int_array_free (array);
+
+  array = gx_int_array_new ();
+  for (u = 0; u != 1000; ++u)
+    gx_int_array_append (array, G_MAXINT64 - u);
+  g_assert_cmpuint (array->len, ==, 1000);
+  g_assert_cmpint (array->data[999], ==, G_MAXINT64 - 999);
+  gx_int_array_free (array);
+}
+
+
+static void
+test_from_list (void)
+{
+  GList      *lst;
+  GXIntArray *array;
+
+  lst   = gx_list_iota (100, -50, 1);
+  array = gx_int_array_from_list (lst);
+
+  g_assert_cmpuint (array->len, ==, 100);
+  g_assert_cmpint (array->data[0], ==, -50);
+  g_assert_cmpint (gx_int_array_sum (array), ==, gx_list_sum (lst));
+
+  gx_int_array_free (array);
+  g_list_free (lst);
+}
+
+
+static gboolean
+is_prime (gint64 n, gpointer user_data)
+{
+  return gx_is_prime ((gint)n);
+}
+
+static gint64
+square (gint64 n, gpointer user_data)
+{
+  return n * n;
+}
+
+static void
+test_filter_map (void)
+{
+  GXIntArray *nums, *primes, *squares;
+  gint64      sum;
+
+  nums   = gx_int_array_iota (100, 1, 1);
+  primes = gx_int_array_filter (nums, is_prime, NULL);
+  g_assert_cmpuint (primes->len, ==, 25);
+  g_assert_cmpint (gx_int_array_sum (primes), ==, 1060);
+
+  nums = gx_int_array_filter_in_place (nums, is_prime, NULL);
+  g_assert_cmpuint (nums->len, ==, 25);
+  g_assert_cmpint (nums->data[24], ==, 97);
+  gx_int_array_free (nums);
+
+  squares = gx_int_array_map (primes, square, NULL);
+  g_assert_cmpint (squares->data[24], ==, 97 * 97);
+  primes = gx_int_array_map_in_place (primes, square, NULL);
+  g_assert_cmpint (gx_int_array_sum (primes), ==, gx_int_array_sum (squares));
+  gx_int_array_free (squares);
+  gx_int_array_free (primes);
+
+  /* the example from the documentation */
+  nums = gx_int_array_iota (1000000, 1, 1);
+  nums = gx_int_array_map_in_place (nums, square, NULL);
+  g_assert (gx_int_array_sum_checked (nums, &sum));
+  g_assert_cmpint (sum, ==, G_GINT64_CONSTANT(333333833333500000));
+  gx_int_array_free (nums);
+}
+
+
+/* reference implementations, to check the (vectorized) kernels against */
+static gint64
+naive_sum (GXIntArray *array, gsize start, gsize len)
+{
+  guint64 sum;
+  gsize   u;
+
+  for (sum = 0, u = start; u != start + len; ++u)
+    sum += (guint64)array->data[u];
+
+  return (gint64)sum;
+}
+
+static gint64
+naive_product (GXIntArray *array, gsize start, gsize len)
+{
+  guint64 product;
+  gsize   u;
+
+  for (product = 1, u = start; u != start + len; ++u)
+    product *= (guint64)array->data[u];
+
+  return (gint64)product;
+}
+
+static void
+test_reductions (void)
+{
+  GXIntArray *array;
+  GRand      *rand;
+  gsize       u, start, len;
+
+  rand  = g_rand_new_with_seed (42);
+  array = gx_int_array_new ();
+  for (u = 0; u != 128; ++u)
+    gx_int_array_append (array,
+                         (gint64)g_rand_int (rand) << 31 ^ g_rand_int (rand));
+
+  /* all lengths and (mis)alignments, to cover the vector loops and tails */
+  for (start = 0; start != 4; ++start)
+    for (len = 1; start + len <= array->len; ++len)
+      {
+        GXIntArray view;
+        gint64     min, max;
+
+        view.data = array->data + start;
+        view.len  = len;
+
+        for (min = G_MAXINT64, max = G_MININT64, u = 0; u != len; ++u)
+          {
+            min = MIN (min, view.data[u]);
+            max = MAX (max, view.data[u]);
+          }
+
+        g_assert_cmpint (gx_int_array_sum (&view), ==,
+                         naive_sum (array, start, len));
+        g_assert_cmpint (gx_int_array_product (&view), ==,
+                         naive_product (array, start, len));
+        g_assert_cmpint (gx_int_array_min (&view), ==, min);
+        g_assert_cmpint (gx_int_array_max (&view), ==, max);
+      }
+
+  gx_int_array_free (array);
+  g_rand_free (rand);
+
+  array = gx_int_array_new ();
+  g_assert_cmpint (gx_int_array_sum (array), ==, 0);
+  g_assert_cmpint (gx_int_array_product (array), ==, 1);
+  gx_int_array_free (array);
+}
+
+
+static gint64
+fold_minus (gint64 acc, gint64 val, gpointer user_data)
+{
+  return acc - val;
+}
+
+static void
+test_fold (void)
+{
+  GXIntArray *nums;
+
+  nums = gx_int_array_iota (20, 1, 1);
+
+  /* the known reducers, computed with 64 bits */
+  g_assert_cmpint (gx_int_array_fold (nums, (GXIntFoldFunc)gx_plus, 1000, NULL),
+                   ==, 1210);
+  g_assert_cmpint (gx_int_array_fold (nums, (GXIntFoldFunc)gx_times, 1, NULL),
+                   ==, G_GINT64_CONSTANT(2432902008176640000));
+  g_assert_cmpint (gx_int_array_fold (nums, (GXIntFoldFunc)gx_max, 0, NULL),
+                   ==, 20);
+  g_assert_cmpint (gx_int_array_fold (nums, (GXIntFoldFunc)gx_max, 100, NULL),
+                   ==, 100);
+  g_assert_cmpint (gx_int_array_fold (nums, (GXIntFoldFunc)gx_min, 100, NULL),
+                   ==, 1);
+
+  /* some other function */
+  g_assert_cmpint (gx_int_array_fold (nums, fold_minus, 0, NULL), ==, -210);
+  gx_int_array_free (nums);
+
+  nums = gx_int_array_new ();
+  g_assert_cmpint (gx_int_array_fold (nums, fold_minus, 7, NULL), ==, 7);
+  g_assert_cmpint (gx_int_array_fold (nums, (GXIntFoldFunc)gx_min, 7, NULL),
+                   ==, 7);
+  gx_int_array_free (nums);
+}
+
+
+static void
+test_checked (void)
+{
+  GXIntArray *array;
+  gint64      result;
+
+  array = gx_int_array_new ();
+  gx_int_array_append (array, G_MAXINT64);
+  gx_int_array_append (array, 1);
+
+  result = 123;
+  g_assert (!gx_int_array_sum_checked (array, &result));
+  g_assert_cmpint (result, ==, 123);
+  g_assert_cmpint (gx_int_array_sum_saturated (array), ==, G_MAXINT64);
+  g_assert_cmpint (gx_int_array_sum (array), ==, G_MININT64);
+
+  /* intermediate overflow is fine, if the final sum fits */
+  gx_int_array_append (array, -2);
+  g_assert (gx_int_array_sum_checked (array, &result));
+  g_assert_cmpint (result, ==, G_MAXINT64 - 1);
+  g_assert_cmpint (gx_int_array_sum_saturated (array), ==, G_MAXINT64 - 1);
+
+  gx_int_array_append (array, G_MININT64);
+  gx_int_array_append (array, G_MININT64);
+  g_assert (!gx_int_array_sum_checked (array, &result));
+  g_assert_cmpint (gx_int_array_sum_saturated (array), ==, G_MININT64);
+  gx_int_array_free (array);
+
+  /* products */
+  array = gx_int_array_iota (20, 1, 1);
+  g_assert (gx_int_array_product_checked (array, &result));
+  g_assert_cmpint (result, ==, G_GINT64_CONSTANT(2432902008176640000));
+  gx_int_array_append (array, 21);
+  g_assert (!gx_int_array_product_checked (array, &result));
+  g_assert_cmpint (gx_int_array_product_saturated (array), ==, G_MAXINT64);
+  gx_int_array_append (array, -1);
+  g_assert_cmpint (gx_int_array_product_saturated (array), ==, G_MININT64);
+  gx_int_array_append (array, 0);
+  g_assert (gx_int_array_product_checked (array, &result));
+  g_assert_cmpint (result, ==, 0);
+  g_assert_cmpint (gx_int_array_product_saturated (array), ==, 0);
+  gx_int_array_free (array);
+
+  /* -2^63 fits, 2^63 does not */
+  array = gx_int_array_new ();
+  gx_int_array_append (array, G_GINT64_CONSTANT(1) << 62);
+  gx_int_array_append (array, -2);
+  g_assert (gx_int_array_product_checked (array, &result));
+  g_assert_cmpint (result, ==, G_MININT64);
+  gx_int_array_append (array, -1);
+  g_assert (!gx_int_array_product_checked (array, &result));
+  g_assert_cmpint (gx_int_array_product_saturated (array), ==, G_MAXINT64);
+  gx_int_array_free (array);
+}
+
+
+static void
+test_perf_sum (void)
+{
+  GXIntArray *array;
+  GList      *lst;
+  GTimer     *timer;
+  gdouble     list_secs, array_secs;
+  gint64      sum;
+  guint       u;
+
+  if (!g_test_perf ())
+    return;
+
+  lst   = gx_list_iota (10000000, 0, 1);
+  array = gx_int_array_iota (10000000, 0, 1);
+  timer = g_timer_new ();
+
+  g_timer_start (timer);
+  for (u = 0; u != 10; ++u)
+    sum = gx_list_sum (lst);
+  list_secs = g_timer_elapsed (timer, NULL);
+
+  g_timer_start (timer);
+  for (u = 0; u != 10; ++u)
+    sum = gx_int_array_sum (array);
+  array_secs = g_timer_elapsed (timer, NULL);
+  g_assert_cmpint (sum, ==, G_GINT64_CONSTANT(49999995000000));
+
+  g_test_minimized_result (list_secs, "GList sum: %.3fs", list_secs);
+  g_test_minimized_result (array_secs, "GXIntArray sum: %.3fs", array_secs);
+
+  g_timer_destroy (timer);
+  gx_int_array_free (array);
+  g_list_free (lst);
+}
+
+
+static gint
+cmp_gint64 (gconstpointer p1, gconstpointer p2)
+{
+  gint64 i, j;
+
+  i = *(const gint64*)p1;
+  j = *(const gint64*)p2;
+
+  return i < j ? -1 : i > j;
+}
+
+static void
+test_sort (void)
+{
+  guint round;
+
+  for (round = 0; round != 40; ++round)
+    {
+      GXIntArray *array;
+      gint64     *expected;
+      gsize       n, u;
+
+      n     = round < 10 ? round : (gsize)g_random_int_range (0, 10000);
+      array = gx_int_array_new ();
+
+      /* full 64-bit values, and small ranges (which skip passes) */
+      for (u = 0; u != n; ++u)
+        if (round % 2)
+          gx_int_array_append (array, (gint64)g_random_int_range (-100, 100));
+        else
+          gx_int_array_append (array, (gint64)((guint64)g_random_int () << 32 |
+                                               g_random_int ()));
+
+      expected = g_new (gint64, n);
+      if (n > 0)
+        {
+          memcpy (expected, array->data, n * sizeof (gint64));
+          qsort (expected, n, sizeof (gint64), cmp_gint64);
+        }
+
+      g_assert (gx_int_array_sort (array) == array);
+      g_assert_cmpuint (array->len, ==, n);
+      for (u = 0; u != n; ++u)
+        g_assert_cmpint (array->data[u], ==, expected[u]);
+
+      /* still usable */
+      gx_int_array_append (array, 1);
+
+      g_free (expected);
+      gx_int_array_free (array);
+    }
+}
+
+
+static gint64
+plus_slowly (gint64 acc, gint64 value, gpointer user_data)
+{
+  return (gint64)((guint64)acc + (guint64)value);
+}
+
+static void
+test_scan (void)
+{
+  GXIntFoldFunc funcs[] = { (GXIntFoldFunc)gx_plus, (GXIntFoldFunc)gx_times,
+                            (GXIntFoldFunc)gx_max, (GXIntFoldFunc)gx_min,
+                            plus_slowly };
+  guint         round, f;
+
+  for (round = 0; round != 40; ++round)
+    for (f = 0; f != G_N_ELEMENTS (funcs); ++f)
+      {
+        GXIntArray *array, *scanned;
+        gint64      init, acc;
+        gsize       n, u;
+
+        /* all the lengths around the vector sizes */
+        n     = round < 20 ? round : (gsize)g_random_int_range (0, 5000);
+        init  = g_random_int_range (-10, 10);
+        array = gx_int_array_new ();
+        for (u = 0; u != n; ++u)
+          gx_int_array_append (array, g_random_int_range (-1000, 1000) *
+                               (gint64)G_MAXINT);
+
+        scanned = gx_int_array_scan (array, funcs[f], init, NULL);
+        g_assert_cmpuint (scanned->len, ==, n);
+
+        for (acc = init, u = 0; u != n; ++u)
+          {
+            gint64 val;
+
+            val = array->data[u];
+            switch (f)
+              {
+              case 0:
+              case 4:
+                acc = (gint64)((guint64)acc + (guint64)val);
+                break;
+              case 1:
+                acc = (gint64)((guint64)acc * (guint64)val);
+                break;
+              case 2:
+                acc = MAX (acc, val);
+                break;
+              case 3:
+                acc = MIN (acc, val);
+                break;
+              }
+            g_assert_cmpint (scanned->data[u], ==, acc);
+          }
+
+        g_assert (gx_int_array_scan_in_place (array, funcs[f], init, NULL) ==
+                  array);
+        for (u = 0; u != n; ++u)
+          g_assert_cmpint (array->data[u], ==, scanned->data[u]);
+
+        gx_int_array_free (scanned);
+        gx_int_array_free (array);
+      }
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-int-array/iota", test_iota);
+  g_test_add_func ("/gx-int-array/from-list", test_from_list);
+  g_test_add_func ("/gx-int-array/filter-map", test_filter_map);
+  g_test_add_func ("/gx-int-array/reductions", test_reductions);
+  g_test_add_func ("/gx-int-array/fold", test_fold);
+  g_test_add_func ("/gx-int-array/checked", test_checked);
+  g_test_add_func ("/gx-int-array/perf-sum", test_perf_sum);
+  g_test_add_func ("/gx-int-array/sort", test_sort);
+  g_test_add_func ("/gx-int-array/scan", test_scan);
+
+  return g_test_run ();
+}
@@ -0,0 +1,229 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+#include <string.h>
+
+static void
+assert_ints (GList *lst, const gint *expected, guint n)
+{
+  guint  u;
+  GList *cur;
+
+  g_assert_cmpuint (g_list_length (lst), ==, n);
+  for (u = 0, cur = lst; cur; cur = g_list_next (cur), ++u)
+    {
+      g_assert_cmpint (GPOINTER_TO_INT(cur->data), ==, expected[u]);
+      if (cur->next)
+        g_assert (cur->next->prev == cur);
+    }
+}
+
+
+static void
+test_sources (void)
+{
+  GList      *lst, *lst2;
+  GPtrArray  *array;
+  const gint  iota[]  = { 1, 4, 7, 10 };
+  const gint  range[] = { 10, 7, 4, 1 };
+  const char *words[] = { "foo", "bar", "cuux", NULL };
+
+  lst = gx_iter_collect (gx_iter_iota (4, 1, 3));
+  assert_ints (lst, iota, G_N_ELEMENTS(iota));
+
+  lst2 = gx_iter_collect (gx_iter_list (lst));
+  assert_ints (lst2, iota, G_N_ELEMENTS(iota));
+  g_list_free (lst2);
+  g_list_free (lst);
+
+  lst = gx_iter_collect (gx_iter_range (10, 0, -3));
+  assert_ints (lst, range, G_N_ELEMENTS(range));
+  g_list_free (lst);
+
+  /* up to the edges of gint */
+  lst = gx_iter_collect (gx_iter_range (G_MAXINT - 2, G_MAXINT, 3));
+  g_assert_cmpuint (g_list_length (lst), ==, 1);
+  g_assert_cmpint (GPOINTER_TO_INT (lst->data), ==, G_MAXINT - 2);
+  g_list_free (lst);
+
+  lst = gx_iter_collect (gx_iter_range (G_MININT + 1, G_MININT, -2));
+  g_assert_cmpint (GPOINTER_TO_INT (lst->data), ==, G_MININT + 1);
+  g_list_free (lst);
+
+  g_assert (!gx_iter_collect (gx_iter_range (0, 10, -1)));
+  g_assert (!gx_iter_collect (gx_iter_iota (0, 1, 1)));
+  g_assert (!gx_iter_collect (gx_iter_list (NULL)));
+  g_assert (!gx_iter_collect (gx_iter_strv (NULL, 0)));
+
+  lst = gx_iter_collect (gx_iter_strv ((gchar**)words, -1));
+  g_assert_cmpuint (g_list_length (lst), ==, 3);
+  g_assert_cmpstr (g_list_nth_data (lst, 2), ==, "cuux");
+  g_list_free (lst);
+
+  lst = gx_iter_collect (gx_iter_strv ((gchar**)words, 2));
+  g_assert_cmpuint (g_list_length (lst), ==, 2);
+  g_list_free (lst);
+
+  array = g_ptr_array_new ();
+  g_ptr_array_add (array, (gpointer)words[0]);
+  g_ptr_array_add (array, (gpointer)words[1]);
+  lst = gx_iter_collect (gx_iter_ptr_array (array));
+  g_assert_cmpuint (g_list_length (lst), ==, 2);
+  g_assert_cmpstr (g_list_nth_data (lst, 1), ==, "bar");
+  g_list_free (lst);
+  g_ptr_array_free (array, TRUE);
+}
+
+
+static int
+square (gint num)
+{
+  return num * num;
+}
+
+static gboolean
+below_100 (gint num)
+{
+  return num < 100;
+}
+
+static void
+test_adapters (void)
+{
+  GList      *lst;
+  const gint  odd_squares[] = { 1, 9, 25, 49, 81 };
+  const gint  skipped[]     = { 49, 81 };
+  const gint  small[]       = { 0, 1, 4, 9, 16, 25, 36, 49, 64, 81 };
+
+  lst = gx_iter_collect (
+    gx_iter_map (gx_iter_filter (gx_iter_iota (10, 0, 1),
+                                 (GXPred)gx_is_odd, NULL),
+                 (GXBinaryFunc)square, NULL));
+  assert_ints (lst, odd_squares, G_N_ELEMENTS(odd_squares));
+  g_list_free (lst);
+
+  lst = gx_iter_collect (
+    gx_iter_skip (gx_iter_take (gx_iter_map (gx_iter_filter (
+                                               gx_iter_iota (G_MAXSIZE, 0, 1),
+                                               (GXPred)gx_is_odd, NULL),
+                                             (GXBinaryFunc)square, NULL),
+                                5), 3));
+  assert_ints (lst, skipped, G_N_ELEMENTS(skipped));
+  g_list_free (lst);
+
+  lst = gx_iter_collect (
+    gx_iter_take_while (gx_iter_map (gx_iter_iota (G_MAXSIZE, 0, 1),
+                                     (GXBinaryFunc)square, NULL),
+                        (GXPred)below_100, NULL));
+  assert_ints (lst, small, G_N_ELEMENTS(small));
+  g_list_free (lst);
+
+  g_assert (!gx_iter_collect (gx_iter_skip (gx_iter_iota (3, 0, 1), 10)));
+  g_assert (!gx_iter_collect (gx_iter_take (gx_iter_iota (3, 0, 1), 0)));
+}
+
+
+static void
+test_sinks (void)
+{
+  GXIter *iter;
+  gpointer data;
+  char   *str;
+  const char *cities[] = { "Amsterdam", "San Francisco", "Helsinki", NULL };
+
+  g_assert_cmpint (
+    gx_iter_product (gx_iter_filter (gx_iter_iota (20, 1, 1),
+                                     (GXPred)gx_is_prime, NULL)),
+    ==, 9699690);
+
+  g_assert_cmpint (
+    gx_iter_sum (gx_iter_filter (gx_iter_iota (100, 1, 1),
+                                 (GXPred)gx_is_prime, NULL)),
+    ==, 1060);
+
+  g_assert_cmpint (GPOINTER_TO_INT(
+                     gx_iter_fold (gx_iter_iota (100, 1, 1),
+                                   (GXTernaryFunc)gx_plus, GINT_TO_POINTER(0),
+                                   NULL, NULL)), ==, 5050);
+
+  str = gx_iter_fold (gx_iter_strv ((gchar**)cities, -1),
+                      (GXTernaryFunc)gx_str_chain, NULL, "; ", g_free);
+  g_assert_cmpstr (str, ==, "Amsterdam; San Francisco; Helsinki");
+  g_free (str);
+
+  iter = gx_iter_iota (1, 42, 1);
+  g_assert_true (gx_iter_next (iter, &data));
+  g_assert_cmpint (GPOINTER_TO_INT(data), ==, 42);
+  g_assert_false (gx_iter_next (iter, &data));
+  g_assert_false (gx_iter_next (iter, &data));
+  gx_iter_free (iter);
+}
+
+
+typedef struct {
+  gint a, b;
+} Fib;
+
+static gboolean
+fib_next (Fib *fib, gpointer *data)
+{
+  gint next;
+
+  *data  = GINT_TO_POINTER(fib->a);
+  next   = fib->a + fib->b;
+  fib->a = fib->b;
+  fib->b = next;
+
+  return TRUE;
+}
+
+static void
+test_custom (void)
+{
+  Fib  *fib;
+  gint  sum;
+
+  /* the sum of the even Fibonacci numbers below 100 */
+  fib    = g_new (Fib, 1);
+  fib->a = 1;
+  fib->b = 2;
+
+  sum = gx_iter_sum (
+    gx_iter_filter (
+      gx_iter_take_while (gx_iter_new ((GXIterNextFunc)fib_next, fib, g_free),
+                          (GXPred)below_100, NULL),
+      (GXPred)gx_is_even, NULL));
+
+  g_assert_cmpint (sum, ==, 2 + 8 + 34);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-iter/sources", test_sources);
+  g_test_add_func ("/gx-iter/adapters", test_adapters);
+  g_test_add_func ("/gx-iter/sinks", test_sinks);
+  g_test_add_func ("/gx-iter/custom", test_custom);
+
+  return g_test_run ();
+}
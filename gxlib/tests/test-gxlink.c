@@ -0,0 +1,276 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+
+typedef struct {
+  GXLink link;
+  gint   n;
+} Item;
+
+#define ITEM(l) GX_CONTAINER_OF ((l), Item, link)
+
+static GXLink*
+make_items (gint start, gint count, Item **items)
+{
+  GXLink *list;
+  gint    i;
+
+  *items = g_new0 (Item, count);
+  for (list = NULL, i = count - 1; i >= 0; --i)
+    {
+      (*items)[i].n = start + i;
+      list = gx_link_prepend (list, &(*items)[i].link);
+    }
+
+  return list;
+}
+
+static void
+assert_items (GXLink *list, const gint *expected, gsize n)
+{
+  GXLink *prev;
+  gsize   u;
+
+  for (prev = NULL, u = 0; u != n; ++u, prev = list, list = list->next)
+    {
+      g_assert (list);
+      g_assert (list->prev == prev);
+      g_assert_cmpint (ITEM (list)->n, ==, expected[u]);
+    }
+  g_assert (!list);
+}
+
+static gboolean
+is_even (GXLink *link, gpointer user_data)
+{
+  return ITEM (link)->n % 2 == 0;
+}
+
+static gboolean
+is_negative (GXLink *link, gpointer user_data)
+{
+  return ITEM (link)->n < 0;
+}
+
+static void
+count_free (GXLink *link)
+{
+  ++ITEM (link)->n;
+  ITEM (link)->n += 1000;
+}
+
+
+static void
+test_basic (void)
+{
+  GXLink *list;
+  Item   *items, extra;
+  gint    expected[] = { 1, 3, 4 };
+
+  list = make_items (1, 4, &items);
+  g_assert_cmpuint (gx_link_length (list), ==, 4);
+  g_assert_cmpuint (gx_link_length (NULL), ==, 0);
+
+  list = gx_link_remove (list, &items[1].link);
+  assert_items (list, expected, 3);
+
+  list = gx_link_reverse (list);
+  g_assert_cmpint (ITEM (list)->n, ==, 4);
+  list = gx_link_reverse (list);
+  assert_items (list, expected, 3);
+
+  extra.n = 5;
+  list    = gx_link_append (list, &extra.link);
+  g_assert_cmpuint (gx_link_length (list), ==, 4);
+  g_assert (extra.link.prev == &items[3].link);
+
+  list = gx_link_remove (list, &items[0].link);
+  list = gx_link_remove (list, &items[2].link);
+  list = gx_link_remove (list, &items[3].link);
+  list = gx_link_remove (list, &extra.link);
+  g_assert (!list);
+
+  list = gx_link_append (NULL, &extra.link);
+  g_assert (list == &extra.link && !list->prev && !list->next);
+  g_assert (gx_link_reverse (NULL) == NULL);
+
+  g_free (items);
+}
+
+
+static void
+test_every_any (void)
+{
+  GXLink *list;
+  Item   *items;
+
+  g_assert (gx_link_every (NULL, (GXPred)is_even, NULL));
+  g_assert (!gx_link_any (NULL, (GXPred)is_even, NULL));
+
+  list = make_items (1, 10, &items);
+  g_assert (!gx_link_every (list, (GXPred)is_even, NULL));
+  g_assert (gx_link_any (list, (GXPred)is_even, NULL));
+  g_assert (!gx_link_any (list, (GXPred)is_negative, NULL));
+
+  g_free (items);
+}
+
+
+static void
+test_filter (void)
+{
+  GXLink *list;
+  Item   *items;
+  gint    evens[] = { 2, 4, 6, 8, 10 };
+
+  list = make_items (1, 10, &items);
+  list = gx_link_filter_in_place (list, (GXPred)is_even, NULL,
+                                  (GDestroyNotify)count_free);
+  assert_items (list, evens, G_N_ELEMENTS (evens));
+  /* the odd ones were freed */
+  g_assert_cmpint (items[0].n, ==, 1 + 1001);
+  g_assert_cmpint (items[8].n, ==, 9 + 1001);
+
+  list = gx_link_filter_in_place (list, (GXPred)is_negative, NULL, NULL);
+  g_assert (!list);
+  g_free (items);
+}
+
+
+static void
+test_take_skip (void)
+{
+  GXLink *list;
+  Item   *items;
+  gint    first[] = { 1, 2, 3 }, rest[] = { 6, 7, 8, 9, 10 };
+
+  list = make_items (1, 10, &items);
+  list = gx_link_take_in_place (list, 3, (GDestroyNotify)count_free);
+  assert_items (list, first, 3);
+  g_assert_cmpint (items[3].n, ==, 4 + 1001);
+  g_assert_cmpint (items[9].n, ==, 10 + 1001);
+  list = gx_link_take_in_place (list, 100, NULL);
+  assert_items (list, first, 3);
+  list = gx_link_take_in_place (list, 0, (GDestroyNotify)count_free);
+  g_assert (!list);
+  g_assert_cmpint (items[0].n, ==, 1 + 1001);
+  g_free (items);
+
+  list = make_items (1, 10, &items);
+  list = gx_link_skip_in_place (list, 0, NULL);
+  g_assert_cmpuint (gx_link_length (list), ==, 10);
+  list = gx_link_skip_in_place (list, 5, (GDestroyNotify)count_free);
+  assert_items (list, rest, 5);
+  g_assert_cmpint (items[4].n, ==, 5 + 1001);
+  list = gx_link_skip_in_place (list, 100, (GDestroyNotify)count_free);
+  g_assert (!list);
+  g_assert_cmpint (items[9].n, ==, 10 + 1001);
+  g_free (items);
+}
+
+
+static GXLink*
+double_or_replace (GXLink *link, Item *replacement)
+{
+  if (ITEM (link)->n == 2)
+    return &replacement->link;
+
+  ITEM (link)->n *= 2;
+  return link;
+}
+
+static void
+test_map (void)
+{
+  GXLink *list;
+  Item   *items, replacement;
+  gint    expected[] = { 2, -1, 6 };
+
+  replacement.n = -1;
+  list = make_items (1, 3, &items);
+  list = gx_link_map_in_place (list, (GXBinaryFunc)double_or_replace,
+                               &replacement, (GDestroyNotify)count_free);
+  assert_items (list, expected, 3);
+  g_assert_cmpint (items[1].n, ==, 2 + 1001);
+  g_free (items);
+
+  /* replacing the first */
+  list = make_items (2, 2, &items);
+  list = gx_link_map_in_place (list, (GXBinaryFunc)double_or_replace,
+                               &replacement, NULL);
+  g_assert (list == &replacement.link);
+  g_assert_cmpint (ITEM (list->next)->n, ==, 6);
+  g_assert (list->next->prev == list);
+  g_free (items);
+}
+
+
+static gpointer
+sum_items (gpointer acc, GXLink *link, gpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (acc) + ITEM (link)->n);
+}
+
+static gpointer
+concat_items (gchar *acc, GXLink *link, gpointer user_data)
+{
+  return g_strdup_printf ("%s%d", acc ? acc : "", ITEM (link)->n);
+}
+
+static void
+test_fold (void)
+{
+  GXLink *list;
+  Item   *items;
+  gchar  *str;
+
+  g_assert (gx_link_fold (NULL, (GXTernaryFunc)sum_items, GINT_TO_POINTER (1),
+                          NULL, NULL) == NULL);
+
+  list = make_items (1, 100, &items);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_link_fold (list,
+                                                  (GXTernaryFunc)sum_items,
+                                                  GINT_TO_POINTER (0),
+                                                  NULL, NULL)), ==, 5050);
+  g_free (items);
+
+  list = make_items (1, 5, &items);
+  str  = gx_link_fold (list, (GXTernaryFunc)concat_items, NULL, NULL, g_free);
+  g_assert_cmpstr (str, ==, "12345");
+  g_free (str);
+  g_free (items);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-link/basic", test_basic);
+  g_test_add_func ("/gx-link/every-any", test_every_any);
+  g_test_add_func ("/gx-link/filter", test_filter);
+  g_test_add_func ("/gx-link/take-skip", test_take_skip);
+  g_test_add_func ("/gx-link/map", test_map);
+  g_test_add_func ("/gx-link/fold", test_fold);
+
+  return g_test_run ();
+}
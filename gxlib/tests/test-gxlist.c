@@ -93,6 +93,112 @@ test_filter_in_place_free (void)
   g_list_free_full (lst, g_free);
 }
 
+static void
+test_partition (void)
+{
+  gint   x;
+  GList *lst, *cur, *even, *odd;
+
+  even = gx_list_partition (NULL, (GXPred)gx_is_even, NULL, &odd);
+  g_assert (!even && !odd);
+
+  lst  = gx_list_iota (1000, 0, 1);
+  even = gx_list_partition (lst, (GXPred)gx_is_even, NULL, &odd);
+  g_assert_cmpint (g_list_length (lst), ==, 1000);
+  g_assert_cmpint (g_list_length (even), ==, 500);
+  g_assert_cmpint (g_list_length (odd), ==, 500);
+
+  for (x = 0, cur = even; cur; cur = g_list_next (cur), x += 2)
+    g_assert_cmpint (GPOINTER_TO_INT(cur->data), ==, x);
+  for (x = 1, cur = odd; cur; cur = g_list_next (cur), x += 2)
+    g_assert_cmpint (GPOINTER_TO_INT(cur->data), ==, x);
+
+  g_list_free (lst);
+  g_list_free (even);
+  g_list_free (odd);
+}
+
+static gboolean
+count_calls (gconstpointer data, guint *calls)
+{
+  ++*calls;
+  return GPOINTER_TO_INT (data) < 10;
+}
+
+static void
+test_partition_in_place (void)
+{
+  gint   x;
+  guint  calls;
+  GList *lst, *cur, *small, *big;
+
+  small = gx_list_partition_in_place (NULL, (GXPred)gx_is_even, NULL, &big,
+                                      NULL);
+  g_assert (!small && !big);
+
+  calls = 0;
+  lst   = gx_list_iota (100, 0, 1);
+  small = gx_list_partition_in_place (lst, (GXPred)count_calls, &calls, &big,
+                                      NULL);
+  g_assert_cmpuint (calls, ==, 100);
+  g_assert (small == lst);
+  g_assert_cmpint (g_list_length (small), ==, 10);
+  g_assert_cmpint (g_list_length (big), ==, 90);
+  g_assert (!small->prev && !big->prev);
+
+  for (x = 0, cur = small; cur; cur = g_list_next (cur), ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(cur->data), ==, x);
+  for (cur = big; cur; cur = g_list_next (cur), ++x)
+    {
+      g_assert_cmpint (GPOINTER_TO_INT(cur->data), ==, x);
+      if (cur->next)
+        g_assert (cur->next->prev == cur);
+    }
+
+  g_list_free (small);
+  g_list_free (big);
+
+  /* everything on one side */
+  lst   = gx_list_iota (5, 100, 1);
+  small = gx_list_partition_in_place (lst, (GXPred)count_calls, &calls, &big,
+                                      NULL);
+  g_assert (!small);
+  g_assert (big == lst);
+  g_assert_cmpint (g_list_length (big), ==, 5);
+  g_list_free (big);
+}
+
+static void
+test_partition_in_place_free (void)
+{
+  gint         x;
+  GList       *lst;
+  GXListArena *arena;
+  const char  *str;
+
+  /* without a rejected list, this is gx_list_filter_in_place */
+  str = "Hello, world!";
+  for (x = 0, lst = NULL; x != 10; ++x)
+    lst = g_list_append (lst, g_strndup (str, x));
+
+  lst = gx_list_partition_in_place (lst, (GXPred)even_length, NULL, NULL,
+                                    g_free);
+  g_assert_cmpint (g_list_length (lst), ==, 5);
+  g_list_free_full (lst, g_free);
+
+  /* nodes from an arena are left to the arena */
+  arena = gx_list_arena_new ();
+  gx_list_arena_push_thread_default (arena);
+
+  lst = gx_list_partition_in_place (gx_list_iota (1000, 0, 1),
+                                    (GXPred)gx_is_odd, NULL, NULL, NULL);
+  g_assert_cmpint (g_list_length (lst), ==, 500);
+  g_assert (gx_list_arena_owns (arena, lst));
+
+  gx_list_arena_pop_thread_default (arena);
+  gx_list_arena_free (arena);
+}
+
 static void
 test_every (void)
 {
@@ -410,6 +516,607 @@ test_iota (void)
   g_list_free (lst);
 }
 
+/* quadratic reference implementations of the set operations */
+typedef enum { OP_UNIQ, OP_INTERSECT, OP_UNION, OP_DIFFERENCE } SetOp;
+
+static GList*
+naive_set_op (SetOp op, GList *list1, GList *list2)
+{
+  GList *result, *cur;
+
+  for (result = NULL, cur = list1; cur; cur = cur->next)
+    {
+      gboolean in2;
+
+      if (g_list_find (result, cur->data))
+        continue;
+
+      in2 = g_list_find (list2, cur->data) != NULL;
+      if (op == OP_UNIQ || op == OP_UNION ||
+          (op == OP_INTERSECT && in2) || (op == OP_DIFFERENCE && !in2))
+        result = g_list_append (result, cur->data);
+    }
+
+  if (op == OP_UNION)
+    for (cur = list2; cur; cur = cur->next)
+      if (!g_list_find (result, cur->data))
+        result = g_list_append (result, cur->data);
+
+  return result;
+}
+
+static void
+assert_lists_equal (GList *list1, GList *list2)
+{
+  g_assert_cmpuint (g_list_length (list1), ==, g_list_length (list2));
+
+  for (; list1; list1 = list1->next, list2 = list2->next)
+    {
+      g_assert_cmpint (GPOINTER_TO_INT (list1->data), ==,
+                       GPOINTER_TO_INT (list2->data));
+      g_assert (!list1->next || list1->next->prev == list1);
+    }
+}
+
+static GList*
+random_list (GRand *rand, guint max_len, gint max_val)
+{
+  GList *list;
+  guint  u, len;
+
+  len = g_rand_int_range (rand, 0, max_len + 1);
+  for (list = NULL, u = 0; u != len; ++u)
+    list = g_list_prepend (list,
+                           GINT_TO_POINTER (g_rand_int_range (rand, 0,
+                                                              max_val)));
+  return list;
+}
+
+static GList*
+hash_set_op (SetOp op, gboolean in_place, GList *list1, GList *list2)
+{
+  switch (op)
+    {
+    case OP_UNIQ:
+      return in_place ? gx_list_uniq_in_place (list1, NULL, NULL, NULL) :
+        gx_list_uniq (list1, NULL, NULL);
+    case OP_INTERSECT:
+      return in_place ?
+        gx_list_intersect_in_place (list1, list2, NULL, NULL, NULL) :
+        gx_list_intersect (list1, list2, NULL, NULL);
+    case OP_UNION:
+      return in_place ?
+        gx_list_union_in_place (list1, list2, NULL, NULL, NULL) :
+        gx_list_union (list1, list2, NULL, NULL);
+    default:
+      return in_place ?
+        gx_list_difference_in_place (list1, list2, NULL, NULL, NULL) :
+        gx_list_difference (list1, list2, NULL, NULL);
+    }
+}
+
+static GList*
+sorted_set_op (SetOp op, gboolean in_place, GList *list1, GList *list2)
+{
+  GCompareFunc cmp;
+
+  cmp = (GCompareFunc)gx_cmp_int;
+
+  switch (op)
+    {
+    case OP_UNIQ:
+      return in_place ? gx_list_sorted_uniq_in_place (list1, cmp, NULL) :
+        gx_list_sorted_uniq (list1, cmp);
+    case OP_INTERSECT:
+      return in_place ?
+        gx_list_sorted_intersect_in_place (list1, list2, cmp, NULL) :
+        gx_list_sorted_intersect (list1, list2, cmp);
+    case OP_UNION:
+      return in_place ?
+        gx_list_sorted_union_in_place (list1, list2, cmp, NULL) :
+        gx_list_sorted_union (list1, list2, cmp);
+    default:
+      return in_place ?
+        gx_list_sorted_difference_in_place (list1, list2, cmp, NULL) :
+        gx_list_sorted_difference (list1, list2, cmp);
+    }
+}
+
+static void
+test_set_ops (void)
+{
+  GRand *rand;
+  guint  round;
+  SetOp  op;
+
+  rand = g_rand_new_with_seed (12345);
+
+  for (round = 0; round != 200; ++round)
+    for (op = OP_UNIQ; op <= OP_DIFFERENCE; ++op)
+      {
+        GList    *list1, *list2, *expected, *result;
+        gboolean  sorted, in_place;
+        gint      max_val;
+
+        max_val = round % 2 ? 20 : 1000;
+        list1   = random_list (rand, 100, max_val);
+        list2   = random_list (rand, 100, max_val);
+
+        for (sorted = FALSE; sorted <= TRUE; ++sorted)
+          {
+            if (sorted)
+              {
+                list1 = g_list_sort (list1, (GCompareFunc)gx_cmp_int);
+                list2 = g_list_sort (list2, (GCompareFunc)gx_cmp_int);
+              }
+
+            /* for sorted lists, the order of first occurrence is sorted
+             * as well, except for unions */
+            expected = naive_set_op (op, list1, list2);
+            if (sorted && op == OP_UNION)
+              expected = g_list_sort (expected, (GCompareFunc)gx_cmp_int);
+
+            for (in_place = FALSE; in_place <= TRUE; ++in_place)
+              {
+                GList *copy1, *copy2;
+
+                copy1 = in_place ? g_list_copy (list1) : list1;
+                copy2 = in_place && op == OP_UNION ? g_list_copy (list2) : list2;
+
+                result = sorted ?
+                  sorted_set_op (op, in_place, copy1, copy2) :
+                  hash_set_op (op, in_place, copy1, copy2);
+
+                assert_lists_equal (result, expected);
+                g_list_free (result);
+              }
+
+            g_list_free (expected);
+          }
+
+        g_list_free (list1);
+        g_list_free (list2);
+      }
+
+  g_rand_free (rand);
+}
+
+static void
+test_set_ops_free (void)
+{
+  GList *list1, *list2, *result;
+  guint  u;
+
+  /* the dropped elements are freed; different pointers, equal strings */
+  for (list1 = list2 = NULL, u = 0; u != 100; ++u)
+    {
+      list1 = g_list_prepend (list1, g_strdup_printf ("%u", u % 30));
+      list2 = g_list_prepend (list2, g_strdup_printf ("%u", u % 40 + 20));
+    }
+
+  result = gx_list_uniq_in_place (list1, g_str_hash, g_str_equal, g_free);
+  g_assert_cmpuint (g_list_length (result), ==, 30);
+
+  result = gx_list_difference_in_place (result, list2, g_str_hash,
+                                        g_str_equal, g_free);
+  g_assert_cmpuint (g_list_length (result), ==, 20);
+
+  result = gx_list_union_in_place (result, list2, g_str_hash, g_str_equal,
+                                   g_free);
+  g_assert_cmpuint (g_list_length (result), ==, 60);
+
+  for (list2 = NULL, u = 0; u != 10; ++u)
+    list2 = g_list_prepend (list2, g_strdup_printf ("%u", u));
+  result = gx_list_intersect_in_place (result, list2, g_str_hash, g_str_equal,
+                                       g_free);
+  g_assert_cmpuint (g_list_length (result), ==, 10);
+
+  g_list_free_full (result, g_free);
+  g_list_free_full (list2, g_free);
+
+  /* and the sorted variants */
+  for (list1 = NULL, u = 0; u != 100; ++u)
+    list1 = g_list_prepend (list1, g_strdup_printf ("%02u", u / 3));
+  list1 = g_list_reverse (list1);
+
+  result = gx_list_sorted_uniq_in_place (list1, (GCompareFunc)g_strcmp0,
+                                         g_free);
+  g_assert_cmpuint (g_list_length (result), ==, 34);
+  g_assert_cmpstr (result->data, ==, "00");
+
+  list2  = g_list_append (NULL, g_strdup ("05"));
+  list2  = g_list_append (list2, g_strdup ("50"));
+  result = gx_list_sorted_union_in_place (result, list2,
+                                          (GCompareFunc)g_strcmp0, g_free);
+  g_assert_cmpuint (g_list_length (result), ==, 35);
+
+  list2  = g_list_append (NULL, "10");
+  result = gx_list_sorted_difference_in_place (result, list2,
+                                               (GCompareFunc)g_strcmp0, g_free);
+  g_assert_cmpuint (g_list_length (result), ==, 34);
+  result = gx_list_sorted_intersect_in_place (result, list2,
+                                              (GCompareFunc)g_strcmp0, g_free);
+  g_assert (!result);
+  g_list_free (list2);
+}
+
+static void
+test_set_ops_perf (void)
+{
+  GList  *list1, *list2, *result;
+  GTimer *timer;
+
+  list1 = gx_list_iota (1000 * 1000, 0, 1);
+  list2 = gx_list_iota (1000 * 1000, 500 * 1000, 1);
+  timer = g_timer_new ();
+
+  /* this would take hours with g_list_find() */
+  result = gx_list_intersect (list1, list2, NULL, NULL);
+  g_assert_cmpuint (g_list_length (result), ==, 500 * 1000);
+  g_list_free (result);
+
+  result = gx_list_union (list1, list2, NULL, NULL);
+  g_assert_cmpuint (g_list_length (result), ==, 1500 * 1000);
+  g_list_free (result);
+
+  if (g_test_perf ())
+    g_test_minimized_result (g_timer_elapsed (timer, NULL),
+                             "intersection + union: %.3fs",
+                             g_timer_elapsed (timer, NULL));
+
+  g_timer_destroy (timer);
+  g_list_free (list1);
+  g_list_free (list2);
+}
+
+
+static gpointer
+mod_key (gconstpointer ptr, gconstpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (ptr) % GPOINTER_TO_INT (user_data));
+}
+
+static gpointer
+join_pair (gconstpointer p1, gconstpointer p2, gconstpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (p1) * 1000 + GPOINTER_TO_INT (p2));
+}
+
+static void
+test_join (void)
+{
+  guint round;
+
+  g_assert (!gx_list_join_by_key (NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                                  join_pair, NULL));
+
+  for (round = 0; round != 50; ++round)
+    {
+      GList *list1, *list2, *result, *expected, *outer, *inner, *cur;
+      guint  n1, n2, u;
+      gint   mod;
+
+      /* both orders of sizes, equal sizes, duplicate keys */
+      n1  = g_random_int_range (0, 300);
+      n2  = round % 5 == 0 ? n1 : (guint)g_random_int_range (0, 300);
+      mod = g_random_int_range (1, 50);
+
+      for (list1 = NULL, u = 0; u != n1; ++u)
+        list1 = g_list_prepend (list1,
+                                GINT_TO_POINTER (g_random_int_range (0, 1000)));
+      for (list2 = NULL, u = 0; u != n2; ++u)
+        list2 = g_list_prepend (list2,
+                                GINT_TO_POINTER (g_random_int_range (0, 1000)));
+
+      result = gx_list_join_by_key (list1, list2, mod_key, mod_key, NULL, NULL,
+                                    NULL, join_pair, GINT_TO_POINTER (mod));
+
+      /* nested loops, with the longer list outside */
+      for (expected = NULL, outer = n1 >= n2 ? list1 : list2; outer;
+           outer = outer->next)
+        for (inner = n1 >= n2 ? list2 : list1; inner; inner = inner->next)
+          {
+            gint a, b;
+
+            a = GPOINTER_TO_INT (n1 >= n2 ? outer->data : inner->data);
+            b = GPOINTER_TO_INT (n1 >= n2 ? inner->data : outer->data);
+            if (a % mod == b % mod)
+              expected = g_list_prepend (expected,
+                                         GINT_TO_POINTER (a * 1000 + b));
+          }
+      expected = g_list_reverse (expected);
+
+      g_assert_cmpuint (g_list_length (result), ==, g_list_length (expected));
+      for (cur = result, outer = expected; cur;
+           cur = cur->next, outer = outer->next)
+        g_assert_cmpint (GPOINTER_TO_INT (cur->data), ==,
+                         GPOINTER_TO_INT (outer->data));
+
+      g_list_free (result);
+      g_list_free (expected);
+      g_list_free (list1);
+      g_list_free (list2);
+    }
+}
+
+
+static gpointer
+lower_key (const char *str, gconstpointer user_data)
+{
+  return g_ascii_strdown (str, -1);
+}
+
+static guint n_freed_keys;
+
+static void
+free_key (gchar *key)
+{
+  g_free (key);
+  ++n_freed_keys;
+}
+
+static void
+test_join_free_keys (void)
+{
+  const char *words1[] = { "Foo", "BAR", "cuux", "bar", "Zap", NULL };
+  const char *words2[] = { "foo", "Bar", "Cuux", NULL };
+  GList      *list1, *list2, *joined;
+
+  list1 = gx_strv_to_list ((gchar**)words1, -1);
+  list2 = gx_strv_to_list ((gchar**)words2, -1);
+
+  n_freed_keys = 0;
+  joined = gx_list_join_by_key (list1, list2,
+                                (GXBinaryFunc)lower_key,
+                                (GXBinaryFunc)lower_key,
+                                g_str_hash, g_str_equal,
+                                (GDestroyNotify)free_key,
+                                (GXTernaryFunc)gx_str_chain, "=");
+  /* "Foo=foo", "BAR=Bar", "cuux=Cuux", "bar=Bar" */
+  g_assert_cmpuint (g_list_length (joined), ==, 4);
+  g_assert_cmpstr (joined->next->data, ==, "BAR=Bar");
+  g_assert_cmpuint (n_freed_keys, ==, 8);
+
+  g_list_free_full (joined, g_free);
+
+  /* and the other way around */
+  n_freed_keys = 0;
+  joined = gx_list_join_by_key (list2, list1,
+                                (GXBinaryFunc)lower_key,
+                                (GXBinaryFunc)lower_key,
+                                g_str_hash, g_str_equal,
+                                (GDestroyNotify)free_key,
+                                (GXTernaryFunc)gx_str_chain, "=");
+  g_assert_cmpuint (g_list_length (joined), ==, 4);
+  g_assert_cmpuint (n_freed_keys, ==, 8);
+
+  g_list_free_full (joined, g_free);
+  g_list_free (list1);
+  g_list_free (list2);
+}
+
+static gpointer
+group_sum (gconstpointer p1, gconstpointer p2, gconstpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (p1) + GPOINTER_TO_INT (p2));
+}
+
+static gpointer
+group_chain (gconstpointer p1, gconstpointer p2, gconstpointer user_data)
+{
+  return g_strdup_printf ("%s%s", (const char*)p1, (const char*)p2);
+}
+
+static gpointer
+first_char (gconstpointer ptr, gconstpointer user_data)
+{
+  return g_strndup (ptr, 1);
+}
+
+static void
+test_group_by (void)
+{
+  GList      *nums, *words, *group, *cur;
+  GHashTable *table;
+  gint        sums[7];
+  gint        i;
+
+  /* many groups, so the table has to grow */
+  nums = gx_list_iota (10000, 0, 1);
+
+  table = gx_list_group_by (nums, mod_key, NULL, NULL, NULL, group_sum,
+                            GINT_TO_POINTER (0), GINT_TO_POINTER (7), NULL);
+  memset (sums, 0, sizeof (sums));
+  for (i = 0; i != 10000; ++i)
+    sums[i % 7] += i;
+
+  g_assert_cmpuint (g_hash_table_size (table), ==, 7);
+  for (i = 0; i != 7; ++i)
+    g_assert_cmpint (GPOINTER_TO_INT (g_hash_table_lookup
+                                      (table, GINT_TO_POINTER (i))), ==,
+                     sums[i]);
+  g_hash_table_destroy (table);
+
+  table = gx_list_group_by (nums, mod_key, NULL, NULL, NULL, NULL, NULL,
+                            GINT_TO_POINTER (1000), NULL);
+  g_assert_cmpuint (g_hash_table_size (table), ==, 1000);
+  for (i = 0; i != 1000; ++i)
+    {
+      group = g_hash_table_lookup (table, GINT_TO_POINTER (i));
+      g_assert_cmpuint (g_list_length (group), ==, 10);
+      for (cur = group; cur; cur = cur->next, i += 1000)
+        g_assert_cmpint (GPOINTER_TO_INT (cur->data), ==, i);
+      i -= 10 * 1000;
+    }
+  g_hash_table_destroy (table);
+  g_list_free (nums);
+
+  /* allocated keys and values */
+  words = gx_strv_to_list ((gchar*[]){ "apple", "avocado", "banana",
+                                       "blueberry", "cherry", "apricot",
+                                       NULL }, -1);
+  table = gx_list_group_by (words, first_char, g_str_hash, g_str_equal,
+                            g_free, group_chain, "", NULL, g_free);
+  g_assert_cmpuint (g_hash_table_size (table), ==, 3);
+  g_assert_cmpstr (g_hash_table_lookup (table, "a"), ==,
+                   "appleavocadoapricot");
+  g_assert_cmpstr (g_hash_table_lookup (table, "b"), ==, "bananablueberry");
+  g_assert_cmpstr (g_hash_table_lookup (table, "c"), ==, "cherry");
+  g_hash_table_destroy (table);
+
+  g_list_free (words);
+}
+
+
+static gpointer
+chain_strs (gconstpointer p1, gconstpointer p2, gconstpointer user_data)
+{
+  return g_strconcat (p1 ? p1 : "", p2, NULL);
+}
+
+static void
+test_scan (void)
+{
+  GList *words, *scanned;
+
+  words = gx_strv_to_list ((gchar*[]){ "a", "b", "c", NULL }, -1);
+
+  scanned = gx_list_scan (words, chain_strs, NULL, NULL, GX_SCAN_INCLUSIVE);
+  g_assert_cmpuint (g_list_length (scanned), ==, 3);
+  g_assert_cmpstr (scanned->data, ==, "a");
+  g_assert_cmpstr (scanned->next->data, ==, "ab");
+  g_assert_cmpstr (scanned->next->next->data, ==, "abc");
+  g_list_free_full (scanned, g_free);
+
+  scanned = gx_list_scan (words, chain_strs, "", NULL, GX_SCAN_EXCLUSIVE);
+  g_assert_cmpuint (g_list_length (scanned), ==, 3);
+  g_assert_cmpstr (scanned->data, ==, "");
+  g_assert_cmpstr (scanned->next->data, ==, "a");
+  g_assert_cmpstr (scanned->next->next->data, ==, "ab");
+  g_free (scanned->next->next->data);
+  g_free (scanned->next->data);
+  g_list_free (scanned);
+
+  g_assert (!gx_list_scan (NULL, chain_strs, "", NULL, GX_SCAN_EXCLUSIVE));
+  g_list_free (words);
+}
+
+
+/* gx_plus(), but not recognized as such */
+static gpointer
+plus_slowly (gconstpointer p1, gconstpointer p2, gconstpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (p1) + GPOINTER_TO_INT (p2));
+}
+
+static gpointer
+max_slowly (gconstpointer p1, gconstpointer p2, gconstpointer user_data)
+{
+  return GINT_TO_POINTER (MAX (GPOINTER_TO_INT (p1), GPOINTER_TO_INT (p2)));
+}
+
+static gpointer
+min_slowly (gconstpointer p1, gconstpointer p2, gconstpointer user_data)
+{
+  return GINT_TO_POINTER (MIN (GPOINTER_TO_INT (p1), GPOINTER_TO_INT (p2)));
+}
+
+static void
+assert_same_ints (GList *list1, GList *list2)
+{
+  g_assert_cmpuint (g_list_length (list1), ==, g_list_length (list2));
+  for (; list1; list1 = list1->next, list2 = list2->next)
+    g_assert_cmpint (GPOINTER_TO_INT (list1->data), ==,
+                     GPOINTER_TO_INT (list2->data));
+}
+
+static void
+test_windowed (void)
+{
+  guint round;
+
+  for (round = 0; round != 100; ++round)
+    {
+      GList *nums, *fast, *slow;
+      gsize  n, window, u;
+      gint   init;
+
+      n      = g_random_int_range (0, 200);
+      window = g_random_int_range (1, 20);
+      init   = g_random_int_range (-50, 50);
+
+      /* a small range, so there are duplicates */
+      for (nums = NULL, u = 0; u != n; ++u)
+        nums = g_list_prepend (nums,
+                               GINT_TO_POINTER (g_random_int_range (-50, 50)));
+
+      fast = gx_list_windowed_fold (nums, window, (GXTernaryFunc)gx_plus,
+                                    GINT_TO_POINTER (init), NULL, NULL);
+      slow = gx_list_windowed_fold (nums, window, plus_slowly,
+                                    GINT_TO_POINTER (init), NULL, NULL);
+      g_assert_cmpuint (g_list_length (slow), ==,
+                        n >= window ? n - window + 1 : 0);
+      assert_same_ints (fast, slow);
+      g_list_free (fast);
+      g_list_free (slow);
+
+      fast = gx_list_windowed_fold (nums, window, (GXTernaryFunc)gx_max,
+                                    GINT_TO_POINTER (init), NULL, NULL);
+      slow = gx_list_windowed_fold (nums, window, max_slowly,
+                                    GINT_TO_POINTER (init), NULL, NULL);
+      assert_same_ints (fast, slow);
+      g_list_free (fast);
+      g_list_free (slow);
+
+      fast = gx_list_windowed_fold (nums, window, (GXTernaryFunc)gx_min,
+                                    GINT_TO_POINTER (init), NULL, NULL);
+      slow = gx_list_windowed_fold (nums, window, min_slowly,
+                                    GINT_TO_POINTER (init), NULL, NULL);
+      assert_same_ints (fast, slow);
+      g_list_free (fast);
+      g_list_free (slow);
+
+      /* without the start value */
+      fast = gx_list_sliding_max (nums, window, (GCompareFunc)gx_cmp_int);
+      slow = gx_list_windowed_fold (nums, window, max_slowly,
+                                    GINT_TO_POINTER (G_MININT), NULL, NULL);
+      assert_same_ints (fast, slow);
+      g_list_free (fast);
+      g_list_free (slow);
+
+      fast = gx_list_sliding_min (nums, window, (GCompareFunc)gx_cmp_int);
+      slow = gx_list_windowed_fold (nums, window, min_slowly,
+                                    GINT_TO_POINTER (G_MAXINT), NULL, NULL);
+      assert_same_ints (fast, slow);
+      g_list_free (fast);
+      g_list_free (slow);
+
+      g_list_free (nums);
+    }
+}
+
+
+static void
+test_windowed_free (void)
+{
+  GList *words, *folded;
+
+  words = gx_strv_to_list ((gchar*[]){ "a", "b", "c", "d", NULL }, -1);
+
+  /* the intermediate strings are freed */
+  folded = gx_list_windowed_fold (words, 3, chain_strs, NULL, NULL, g_free);
+  g_assert_cmpuint (g_list_length (folded), ==, 2);
+  g_assert_cmpstr (folded->data, ==, "abc");
+  g_assert_cmpstr (folded->next->data, ==, "bcd");
+  g_list_free_full (folded, g_free);
+
+  folded = gx_list_windowed_fold (words, 5, chain_strs, NULL, NULL, g_free);
+  g_assert (!folded);
+
+  g_list_free (words);
+}
+
+
 int
 main (int argc, char *argv[])
 {
@@ -418,6 +1125,10 @@ main (int argc, char *argv[])
   g_test_add_func ("/gx-list/filter", test_filter);
   g_test_add_func ("/gx-list/filter-in-place", test_filter_in_place);
   g_test_add_func ("/gx-list/filter-in-place-free", test_filter_in_place_free);
+  g_test_add_func ("/gx-list/partition", test_partition);
+  g_test_add_func ("/gx-list/partition-in-place", test_partition_in_place);
+  g_test_add_func ("/gx-list/partition-in-place-free",
+                   test_partition_in_place_free);
   g_test_add_func ("/gx-list/every", test_every);
   g_test_add_func ("/gx-list/any", test_any);
   g_test_add_func ("/gx-list/take", test_take);
@@ -431,6 +1142,15 @@ main (int argc, char *argv[])
   g_test_add_func ("/gx-list/iota", test_iota);
   g_test_add_func ("/gx-list/sum", test_sum);
   g_test_add_func ("/gx-list/product", test_product);
+  g_test_add_func ("/gx-list/set-ops", test_set_ops);
+  g_test_add_func ("/gx-list/set-ops-free", test_set_ops_free);
+  g_test_add_func ("/gx-list/set-ops-perf", test_set_ops_perf);
+  g_test_add_func ("/gx-list/join", test_join);
+  g_test_add_func ("/gx-list/join-free-keys", test_join_free_keys);
+  g_test_add_func ("/gx-list/group-by", test_group_by);
+  g_test_add_func ("/gx-list/scan", test_scan);
+  g_test_add_func ("/gx-list/windowed", test_windowed);
+  g_test_add_func ("/gx-list/windowed-free", test_windowed_free);
 
   return g_test_run ();
 }
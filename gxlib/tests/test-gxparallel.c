@@ -0,0 +1,226 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+#include <string.h>
+
+static const gint thread_counts[] = { 1, 2, 3, 8, -1 };
+
+static void
+assert_same (GList *l1, GList *l2)
+{
+  g_assert_cmpuint (g_list_length (l1), ==, g_list_length (l2));
+  for (; l1; l1 = g_list_next (l1), l2 = g_list_next (l2))
+    {
+      g_assert (l1->data == l2->data);
+      if (l2->next)
+        g_assert (l2->next->prev == l2);
+    }
+}
+
+
+static int
+square (gint num)
+{
+  return num * num;
+}
+
+static void
+test_map (void)
+{
+  GList *lst, *serial;
+  guint  u;
+
+  g_assert (!gx_list_par_map (NULL, (GXBinaryFunc)square, NULL, -1));
+
+  lst    = gx_list_iota (10007, 0, 1);
+  serial = gx_list_map (lst, (GXBinaryFunc)square, NULL);
+
+  for (u = 0; u != G_N_ELEMENTS(thread_counts); ++u)
+    {
+      GList *par;
+
+      par = gx_list_par_map (lst, (GXBinaryFunc)square, NULL,
+                             thread_counts[u]);
+      assert_same (serial, par);
+      g_list_free (par);
+    }
+
+  g_list_free (serial);
+  g_list_free (lst);
+}
+
+
+static char*
+upcase (char *s)
+{
+  return g_ascii_strup (s, -1);
+}
+
+static void
+test_map_in_place (void)
+{
+  GList *lst, *cur;
+  guint  u;
+  gint   x;
+  const char *letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+  for (u = 0; u != G_N_ELEMENTS(thread_counts); ++u)
+    {
+      for (lst = NULL, x = 25; x >= 0; --x)
+        {
+          char buf[2];
+          buf [0] = 'a' + x;
+          buf [1] = '\0';
+          lst = g_list_prepend (lst, g_strdup (buf));
+        }
+
+      g_assert (gx_list_par_map_in_place (lst, (GXBinaryFunc)upcase, NULL,
+                                          g_free, thread_counts[u]) == lst);
+      for (x = 0, cur = lst; cur; cur = g_list_next(cur), ++x)
+        g_assert_cmpint (((char*)cur->data)[0], ==, letters[x]);
+
+      g_list_free_full (lst, g_free);
+    }
+}
+
+
+static void
+test_filter (void)
+{
+  GList *lst, *serial;
+  guint  u;
+
+  g_assert (!gx_list_par_filter (NULL, (GXPred)gx_is_prime, NULL, -1));
+
+  lst    = gx_list_iota (10007, 0, 1);
+  serial = gx_list_filter (lst, (GXPred)gx_is_prime, NULL);
+
+  for (u = 0; u != G_N_ELEMENTS(thread_counts); ++u)
+    {
+      GList *par, *copy;
+
+      par = gx_list_par_filter (lst, (GXPred)gx_is_prime, NULL,
+                                thread_counts[u]);
+      assert_same (serial, par);
+      g_list_free (par);
+
+      copy = g_list_copy (lst);
+      copy = gx_list_par_filter_in_place (copy, (GXPred)gx_is_prime, NULL,
+                                          NULL, thread_counts[u]);
+      assert_same (serial, copy);
+      g_assert (!copy->prev);
+      g_list_free (copy);
+    }
+
+  g_list_free (serial);
+  g_list_free (lst);
+}
+
+
+static GThread *main_thread;
+static guint    freed;
+
+static void
+count_free (gpointer data)
+{
+  g_assert (g_thread_self () == main_thread);
+  ++freed;
+  g_free (data);
+}
+
+static gboolean
+even_length (const char *s)
+{
+  return strlen (s) % 2 == 0 ? TRUE : FALSE;
+}
+
+static void
+test_filter_in_place_free (void)
+{
+  GList *lst;
+  gint   x;
+  const char* str;
+
+  main_thread = g_thread_self ();
+  freed       = 0;
+
+  str = "Hello, world!";
+  for (x = 0, lst = NULL; x != 10; ++x)
+    lst = g_list_append (lst, g_strndup (str, x));
+
+  lst = gx_list_par_filter_in_place (lst, (GXPred)even_length, NULL,
+                                     count_free, 4);
+  g_assert_cmpint (g_list_length (lst), ==, 5);
+  g_assert_cmpuint (freed, ==, 5);
+
+  lst = gx_list_par_filter_in_place (lst, (GXPred)gx_is_str_equal, "no match",
+                                     count_free, 4);
+  g_assert (!lst);
+  g_assert_cmpuint (freed, ==, 10);
+}
+
+
+static void
+test_fold (void)
+{
+  GList *lst;
+  guint  u;
+  char  *str;
+  const char* cities[] = { "Amsterdam", "San Francisco", "Helsinki", "Paris",
+                           "Nairobi", "Lima", "Tokyo", NULL };
+
+  g_assert (!gx_list_par_fold (NULL, (GXTernaryFunc)gx_plus, NULL, NULL,
+                               NULL, NULL, -1));
+
+  lst = gx_list_iota (10000, 1, 1);
+  for (u = 0; u != G_N_ELEMENTS(thread_counts); ++u)
+    g_assert_cmpint (GPOINTER_TO_INT(
+                       gx_list_par_fold (lst, (GXTernaryFunc)gx_plus,
+                                         GINT_TO_POINTER(0), NULL, NULL, NULL,
+                                         thread_counts[u])), ==, 50005000);
+  g_list_free (lst);
+
+  lst = gx_strv_to_list ((gchar**)cities, -1);
+  for (u = 0; u != G_N_ELEMENTS(thread_counts); ++u)
+    {
+      str = gx_list_par_fold (lst, (GXTernaryFunc)gx_str_chain, NULL, NULL,
+                              "; ", g_free, thread_counts[u]);
+      g_assert_cmpstr (str, ==, "Amsterdam; San Francisco; Helsinki; Paris; "
+                       "Nairobi; Lima; Tokyo");
+      g_free (str);
+    }
+  g_list_free (lst);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-parallel/map", test_map);
+  g_test_add_func ("/gx-parallel/map-in-place", test_map_in_place);
+  g_test_add_func ("/gx-parallel/filter", test_filter);
+  g_test_add_func ("/gx-parallel/filter-in-place-free",
+                   test_filter_in_place_free);
+  g_test_add_func ("/gx-parallel/fold", test_fold);
+
+  return g_test_run ();
+}
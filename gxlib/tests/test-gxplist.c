@@ -0,0 +1,255 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+
+static void
+assert_plist (GXPList *list, gint start, gsize n)
+{
+  gsize u;
+
+  for (u = 0; u != n; ++u, list = gx_plist_tail (list))
+    {
+      g_assert (list);
+      g_assert_cmpint (GPOINTER_TO_INT (gx_plist_head (list)), ==,
+                       start + (gint)u);
+    }
+  g_assert (!list);
+}
+
+static GXPList*
+plist_iota (gsize count, gint start)
+{
+  GList   *nums;
+  GXPList *list;
+
+  nums = gx_list_iota (count, start, 1);
+  list = gx_plist_from_list (nums);
+  g_list_free (nums);
+
+  return list;
+}
+
+
+static void
+test_cons (void)
+{
+  GXPList *list, *other;
+
+  g_assert (gx_plist_head (NULL) == NULL);
+  g_assert (gx_plist_tail (NULL) == NULL);
+  g_assert_cmpuint (gx_plist_length (NULL), ==, 0);
+  g_assert (gx_plist_ref (NULL) == NULL);
+  gx_plist_unref (NULL);
+
+  list = gx_plist_cons (GINT_TO_POINTER (3), NULL);
+  list = gx_plist_cons (GINT_TO_POINTER (2), list);
+  list = gx_plist_cons (GINT_TO_POINTER (1), list);
+  assert_plist (list, 1, 3);
+
+  /* two lists with a shared tail */
+  other = gx_plist_cons (GINT_TO_POINTER (0), gx_plist_ref (list));
+  g_assert (gx_plist_tail (other) == list);
+  assert_plist (other, 0, 4);
+
+  gx_plist_unref (list);
+  assert_plist (other, 0, 4);
+  gx_plist_unref (other);
+
+  /* a long one, freed iteratively */
+  list = plist_iota (1000000, 0);
+  g_assert_cmpuint (gx_plist_length (list), ==, 1000000);
+  gx_plist_unref (list);
+}
+
+
+static void
+test_convert (void)
+{
+  GXPList *list;
+  GList   *nums, *back;
+
+  g_assert (gx_plist_from_list (NULL) == NULL);
+  g_assert (gx_plist_to_list (NULL) == NULL);
+
+  nums = gx_list_iota (100, 5, 1);
+  list = gx_plist_from_list (nums);
+  assert_plist (list, 5, 100);
+
+  back = gx_plist_to_list (list);
+  g_assert_cmpint (gx_list_sum (back), ==, gx_list_sum (nums));
+  g_assert_cmpuint (g_list_length (back), ==, 100);
+
+  g_list_free (back);
+  g_list_free (nums);
+  gx_plist_unref (list);
+}
+
+
+static void
+test_take_skip (void)
+{
+  GXPList *list, *part, *rest;
+
+  list = plist_iota (10, 0);
+
+  g_assert (gx_plist_take (list, 0) == NULL);
+  g_assert (gx_plist_take (NULL, 5) == NULL);
+
+  part = gx_plist_take (list, 3);
+  assert_plist (part, 0, 3);
+  gx_plist_unref (part);
+
+  /* everything: no copy */
+  part = gx_plist_take (list, 10);
+  g_assert (part == list);
+  gx_plist_unref (part);
+  part = gx_plist_take (list, 100);
+  g_assert (part == list);
+  gx_plist_unref (part);
+
+  part = gx_plist_skip (list, 0);
+  g_assert (part == list);
+  gx_plist_unref (part);
+
+  rest = gx_plist_skip (list, 4);
+  assert_plist (rest, 4, 6);
+  g_assert (rest == gx_plist_tail (gx_plist_tail (gx_plist_tail (
+    gx_plist_tail (list)))));
+  g_assert (gx_plist_skip (list, 10) == NULL);
+  g_assert (gx_plist_skip (list, 100) == NULL);
+
+  /* pages stay valid after the full list is gone */
+  gx_plist_unref (list);
+  part = gx_plist_take (rest, 2);
+  assert_plist (part, 4, 2);
+  gx_plist_unref (part);
+  assert_plist (rest, 4, 6);
+  gx_plist_unref (rest);
+}
+
+
+static gboolean
+is_not (gconstpointer data, gconstpointer user_data)
+{
+  return data != user_data;
+}
+
+static gboolean
+is_even (gint n)
+{
+  return n % 2 == 0;
+}
+
+static void
+test_filter (void)
+{
+  GXPList *list, *filtered, *rest1, *rest2;
+  GList   *nums;
+
+  list = plist_iota (10, 0);
+
+  /* nothing rejected: shared entirely */
+  filtered = gx_plist_filter (list, (GXPred)is_not, GINT_TO_POINTER (-1));
+  g_assert (filtered == list);
+  gx_plist_unref (filtered);
+
+  /* only 3 rejected: shares the nodes after it */
+  filtered = gx_plist_filter (list, (GXPred)is_not, GINT_TO_POINTER (3));
+  nums = gx_plist_to_list (filtered);
+  g_assert_cmpuint (g_list_length (nums), ==, 9);
+  g_assert_cmpint (gx_list_sum (nums), ==, 45 - 3);
+  g_list_free (nums);
+  rest1 = gx_plist_skip (filtered, 3);
+  rest2 = gx_plist_skip (list, 4);
+  g_assert (rest1 == rest2);
+  gx_plist_unref (rest1);
+  gx_plist_unref (rest2);
+  gx_plist_unref (filtered);
+
+  /* the last one rejected */
+  filtered = gx_plist_filter (list, (GXPred)is_not, GINT_TO_POINTER (9));
+  assert_plist (filtered, 0, 9);
+  gx_plist_unref (filtered);
+
+  filtered = gx_plist_filter (list, (GXPred)is_even, NULL);
+  nums     = gx_plist_to_list (filtered);
+  g_assert_cmpuint (g_list_length (nums), ==, 5);
+  g_assert_cmpint (gx_list_sum (nums), ==, 0 + 2 + 4 + 6 + 8);
+  g_list_free (nums);
+  gx_plist_unref (filtered);
+
+  filtered = gx_plist_filter (list, (GXPred)is_not, GINT_TO_POINTER (0));
+  gx_plist_unref (list);
+  /* survives the original */
+  assert_plist (filtered, 1, 9);
+  gx_plist_unref (filtered);
+}
+
+
+static gpointer
+double_small (gpointer data, gpointer user_data)
+{
+  gint n;
+
+  n = GPOINTER_TO_INT (data);
+
+  return GINT_TO_POINTER (n < GPOINTER_TO_INT (user_data) ? n * 2 : n);
+}
+
+static void
+test_map (void)
+{
+  GXPList *list, *mapped;
+  GList   *nums;
+
+  list = plist_iota (10, 1);
+
+  mapped = gx_plist_map (list, (GXBinaryFunc)double_small,
+                         GINT_TO_POINTER (0));
+  g_assert (mapped == list);
+  gx_plist_unref (mapped);
+
+  mapped = gx_plist_map (list, (GXBinaryFunc)double_small,
+                         GINT_TO_POINTER (4));
+  nums   = gx_plist_to_list (mapped);
+  g_assert_cmpint (gx_list_sum (nums), ==, 55 + 1 + 2 + 3);
+  g_list_free (nums);
+  /* 1, 2, 3 were changed, 4 .. 10 are shared */
+  g_assert (gx_plist_tail (gx_plist_tail (gx_plist_tail (mapped))) ==
+            gx_plist_tail (gx_plist_tail (gx_plist_tail (list))));
+  gx_plist_unref (list);
+  gx_plist_unref (mapped);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-plist/cons", test_cons);
+  g_test_add_func ("/gx-plist/convert", test_convert);
+  g_test_add_func ("/gx-plist/take-skip", test_take_skip);
+  g_test_add_func ("/gx-plist/filter", test_filter);
+  g_test_add_func ("/gx-plist/map", test_map);
+
+  return g_test_run ();
+}
@@ -54,6 +54,69 @@ test_prime (void)
 }
 
 
+static gboolean
+naive_is_prime64 (guint64 n)
+{
+  guint64 j;
+
+  if (n < 2)
+    return FALSE;
+
+  for (j = 2; j <= n / j; ++j)
+    if (n % j == 0)
+      return FALSE;
+
+  return TRUE;
+}
+
+static void
+test_prime64 (void)
+{
+  /* strong pseudoprimes (to several bases), Carmichael numbers, and
+   * products of large primes */
+  static const guint64 composites[] = {
+    561, 2047, 1373653, 25326001, G_GUINT64_CONSTANT(3215031751),
+    G_GUINT64_CONSTANT(2152302898747), G_GUINT64_CONSTANT(3474749660383),
+    G_GUINT64_CONSTANT(341550071728321),
+    G_GUINT64_CONSTANT(3825123056546413051),
+    G_GUINT64_CONSTANT(18446743979220271189), /* 4294967291 * 4294967279 */
+    G_GUINT64_CONSTANT(4611686014132420609),  /* (2^31 - 1)^2 */
+    G_MAXUINT64 };
+  static const guint64 primes[] = {
+    G_GUINT64_CONSTANT(4294967291), G_GUINT64_CONSTANT(4294967311),
+    G_GUINT64_CONSTANT(2305843009213693951), /* 2^61 - 1 */
+    G_GUINT64_CONSTANT(18446744073709551557) /* the largest */ };
+  gboolean results[G_N_ELEMENTS (composites)];
+  guint    u;
+  gint     i;
+
+  for (i = -1; i != 100000; ++i)
+    g_assert_cmpint (gx_is_prime64 ((guint64)MAX (i, 0)), ==, gx_is_prime (i));
+
+  for (u = 0; u != G_N_ELEMENTS (composites); ++u)
+    g_assert_false (gx_is_prime64 (composites[u]));
+  for (u = 0; u != G_N_ELEMENTS (primes); ++u)
+    g_assert_true (gx_is_prime64 (primes[u]));
+
+  /* around 2^32 */
+  for (u = 0; u != 1000; ++u)
+    {
+      guint64 n;
+
+      n = G_GUINT64_CONSTANT(4294967296) - 500 + u;
+      g_assert_cmpint (gx_is_prime64 (n), ==, naive_is_prime64 (n));
+    }
+
+  g_assert_cmpuint (gx_is_prime64_batch (composites, G_N_ELEMENTS (composites),
+                                         results), ==, 0);
+  for (u = 0; u != G_N_ELEMENTS (results); ++u)
+    g_assert_false (results[u]);
+  g_assert_cmpuint (gx_is_prime64_batch (primes, G_N_ELEMENTS (primes),
+                                         results), ==, G_N_ELEMENTS (primes));
+  g_assert_cmpuint (gx_is_prime64_batch (NULL, 0, NULL), ==, 0);
+}
+
+
 static void
 test_str_equal (void)
 {
@@ -74,6 +137,7 @@ main (int argc, char *argv[])
   g_test_add_func ("/gx-pred/is-even", test_even);
   g_test_add_func ("/gx-pred/is-odd", test_odd);
   g_test_add_func ("/gx-pred/is-prime", test_prime);
+  g_test_add_func ("/gx-pred/is-prime64", test_prime64);
   g_test_add_func ("/gx-pred/is-str-equal", test_str_equal);
   
   return g_test_run ();
@@ -0,0 +1,241 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+
+static gboolean
+naive_is_prime (guint n)
+{
+  guint j;
+
+  if (n < 2)
+    return FALSE;
+
+  for (j = 2; j <= n / j; ++j)
+    if (n % j == 0)
+      return FALSE;
+
+  return TRUE;
+}
+
+
+/* the smallest prime >= n, or 0 if there is none up to limit */
+static guint
+naive_next_prime (guint n, guint limit)
+{
+  for (; n <= limit; ++n)
+    if (naive_is_prime (n))
+      return n;
+
+  return 0;
+}
+
+static void
+test_small (void)
+{
+  GXPrimeTable *table;
+  GXIter       *iter;
+  gpointer      data;
+  guint         limit, n, p;
+
+  /* all the small limits, to cover the edges */
+  for (limit = 0; limit != 200; ++limit)
+    {
+      gsize count;
+
+      table = gx_prime_table_new (limit, GX_PRIME_TABLE_FLAGS_NONE, 1);
+      g_assert_cmpuint (gx_prime_table_get_limit (table), ==, limit);
+
+      for (count = 0, n = 0; n <= limit; ++n)
+        {
+          if (naive_is_prime (n))
+            ++count;
+
+          g_assert_cmpint (gx_prime_table_is_prime (table, n), ==,
+                           naive_is_prime (n));
+          g_assert_cmpuint (gx_prime_table_count (table, n), ==, count);
+          g_assert_cmpuint (gx_prime_table_next (table, n), ==,
+                            naive_next_prime (n + 1, limit));
+
+          /* the iterator produces exactly the primes from n to the limit */
+          iter = gx_prime_table_iter (table, n);
+          for (p = naive_next_prime (n, limit); p != 0;
+               p = naive_next_prime (p + 1, limit))
+            {
+              g_assert (gx_iter_next (iter, &data));
+              g_assert_cmpuint (GPOINTER_TO_UINT (data), ==, p);
+            }
+          g_assert (!gx_iter_next (iter, &data));
+          gx_iter_free (iter);
+        }
+
+      gx_prime_table_unref (table);
+    }
+}
+
+
+static void
+test_segments (void)
+{
+  GXPrimeTable *table, *table1;
+  guint         n;
+
+  /* spans a few segments; compare a single- and a multi-threaded build */
+  table  = gx_prime_table_new (3000000, GX_PRIME_TABLE_FLAGS_NONE, 4);
+  table1 = gx_prime_table_new (3000000, GX_PRIME_TABLE_FLAGS_NONE, 1);
+
+  g_assert_cmpuint (gx_prime_table_count (table, 1000000), ==, 78498);
+  g_assert_cmpuint (gx_prime_table_count (table, 3000000), ==, 216816);
+
+  for (n = 0; n <= 3000000; ++n)
+    g_assert_cmpint (gx_prime_table_is_prime (table, n), ==,
+                     gx_prime_table_is_prime (table1, n));
+
+  /* around the segment boundaries */
+  for (n = 524288 - 1000; n != 524288 + 1000; ++n)
+    g_assert_cmpint (gx_prime_table_is_prime (table, n), ==,
+                     naive_is_prime (n));
+
+  gx_prime_table_unref (table1);
+  gx_prime_table_unref (table);
+}
+
+
+static void
+test_next_iter (void)
+{
+  GXPrimeTable *table;
+  GXIter       *iter;
+  gpointer      data;
+  guint         n, p;
+
+  table = gx_prime_table_new (1000, GX_PRIME_TABLE_FLAGS_NONE, 1);
+
+  g_assert_cmpuint (gx_prime_table_next (table, 0), ==, 2);
+  g_assert_cmpuint (gx_prime_table_next (table, 2), ==, 3);
+  g_assert_cmpuint (gx_prime_table_next (table, 13), ==, 17);
+  g_assert_cmpuint (gx_prime_table_next (table, 996), ==, 997);
+  g_assert_cmpuint (gx_prime_table_next (table, 997), ==, 0);
+  g_assert_cmpuint (gx_prime_table_next (table, G_MAXUINT), ==, 0);
+
+  iter = gx_prime_table_iter (table, 0);
+  for (n = 0; gx_iter_next (iter, &data); ++n)
+    {
+      p = GPOINTER_TO_UINT (data);
+      g_assert (naive_is_prime (p));
+      g_assert_cmpuint (gx_prime_table_count (table, p), ==, n + 1);
+    }
+  g_assert_cmpuint (n, ==, 168);
+  gx_iter_free (iter);
+
+  iter = gx_prime_table_iter (table, 500);
+  g_assert (gx_iter_next (iter, &data));
+  g_assert_cmpuint (GPOINTER_TO_UINT (data), ==, 503);
+  gx_iter_free (iter);
+
+  /* the iterator keeps the table alive */
+  iter = gx_iter_take (gx_prime_table_iter (table, 10), 4);
+  gx_prime_table_unref (table);
+  g_assert_cmpint (gx_iter_sum (iter), ==, 11 + 13 + 17 + 19);
+}
+
+
+static void
+test_factors (void)
+{
+  GXPrimeTable *tables[2];
+  guint         u, n;
+
+  tables[0] = gx_prime_table_new (100000, GX_PRIME_TABLE_FLAGS_FACTORS, -1);
+  tables[1] = gx_prime_table_new (100000, GX_PRIME_TABLE_FLAGS_NONE, -1);
+
+  for (u = 0; u != G_N_ELEMENTS (tables); ++u)
+    {
+      g_assert_cmpuint (gx_prime_table_smallest_factor (tables[u], 0), ==, 0);
+      g_assert_cmpuint (gx_prime_table_smallest_factor (tables[u], 1), ==, 0);
+      g_assert (gx_prime_table_factorize (tables[u], 1) == NULL);
+
+      for (n = 2; n <= 100000; ++n)
+        {
+          GList *factors, *cur;
+          guint  product, prev;
+
+          factors = gx_prime_table_factorize (tables[u], n);
+          for (product = 1, prev = 0, cur = factors; cur; cur = cur->next)
+            {
+              guint p;
+
+              p = GPOINTER_TO_UINT (cur->data);
+              g_assert (naive_is_prime (p));
+              g_assert_cmpuint (p, >=, prev);
+              product *= p;
+              prev     = p;
+            }
+          g_assert_cmpuint (product, ==, n);
+          g_assert_cmpuint (gx_prime_table_smallest_factor (tables[u], n), ==,
+                            GPOINTER_TO_UINT (factors->data));
+          g_list_free (factors);
+        }
+
+      gx_prime_table_unref (tables[u]);
+    }
+}
+
+
+static void
+test_default (void)
+{
+  GXPrimeTable *table;
+  gint          i;
+
+  g_assert (gx_prime_table_get_default () == NULL);
+  for (i = -10; i != 10000; ++i)
+    g_assert_cmpint (gx_is_prime (i), ==, naive_is_prime ((guint)MAX (i, 0)));
+  g_assert (gx_is_prime (2147483647));
+
+  table = gx_prime_table_new (1000, GX_PRIME_TABLE_FLAGS_NONE, 1);
+  gx_prime_table_set_default (table);
+  gx_prime_table_unref (table);
+  g_assert (gx_prime_table_get_default () == table);
+
+  /* in the table and beyond it */
+  for (i = -10; i != 10000; ++i)
+    g_assert_cmpint (gx_is_prime (i), ==, naive_is_prime ((guint)MAX (i, 0)));
+
+  gx_prime_table_set_default (NULL);
+  g_assert (gx_prime_table_get_default () == NULL);
+
+  /* the old default is still alive */
+  g_assert (gx_prime_table_is_prime (table, 997));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-prime/small", test_small);
+  g_test_add_func ("/gx-prime/segments", test_segments);
+  g_test_add_func ("/gx-prime/next-iter", test_next_iter);
+  g_test_add_func ("/gx-prime/factors", test_factors);
+  g_test_add_func ("/gx-prime/default", test_default);
+
+  return g_test_run ();
+}
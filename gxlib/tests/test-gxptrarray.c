@@ -0,0 +1,243 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+
+static void
+assert_array_range (GPtrArray *array, gint start, gint step, guint len)
+{
+  guint u;
+
+  g_assert_cmpuint (array->len, ==, len);
+  for (u = 0; u != len; ++u, start += step)
+    g_assert_cmpint (GPOINTER_TO_INT (g_ptr_array_index (array, u)), ==, start);
+}
+
+
+static void
+test_filter (void)
+{
+  GPtrArray *array, *even;
+
+  array = gx_ptr_array_iota (1000, 0, 1);
+  even  = gx_ptr_array_filter (array, (GXPred)gx_is_even, NULL);
+  assert_array_range (even, 0, 2, 500);
+  g_ptr_array_free (even, TRUE);
+
+  g_assert (gx_ptr_array_filter_in_place (array, (GXPred)gx_is_odd,
+                                          NULL, NULL) == array);
+  assert_array_range (array, 1, 2, 500);
+
+  gx_ptr_array_filter_in_place (array, (GXPred)gx_is_even, NULL, NULL);
+  assert_array_range (array, 0, 1, 0);
+
+  g_ptr_array_free (array, TRUE);
+}
+
+
+static gboolean
+is_short (const char *s)
+{
+  return s[1] == '\0';
+}
+
+static void
+test_filter_in_place_free (void)
+{
+  GPtrArray *array;
+  guint      u;
+
+  /* with a free_func */
+  array = g_ptr_array_new ();
+  for (u = 0; u != 20; ++u)
+    g_ptr_array_add (array, g_strdup_printf ("%u", 19 - u));
+
+  gx_ptr_array_filter_in_place (array, (GXPred)is_short, NULL, g_free);
+  g_assert_cmpuint (array->len, ==, 10);
+  for (u = 0; u != 10; ++u)
+    g_assert_cmpint (((char*)g_ptr_array_index (array, u))[0], ==, '9' - u);
+
+  g_ptr_array_set_free_func (array, g_free);
+  g_ptr_array_free (array, TRUE);
+
+  /* with an element free function; the removed elements (and only those)
+   * must be passed to it */
+  array = g_ptr_array_new_with_free_func (g_free);
+  for (u = 0; u != 20; ++u)
+    g_ptr_array_add (array, g_strdup_printf ("%u", u));
+
+  gx_ptr_array_filter_in_place (array, (GXPred)is_short, NULL, NULL);
+  g_assert_cmpuint (array->len, ==, 10);
+  for (u = 0; u != 10; ++u)
+    g_assert_cmpint (((char*)g_ptr_array_index (array, u))[0], ==, '0' + u);
+
+  gx_ptr_array_take_in_place (array, 5, NULL);
+  gx_ptr_array_skip_in_place (array, 2, NULL);
+  g_assert_cmpuint (array->len, ==, 3);
+  g_assert_cmpstr (g_ptr_array_index (array, 0), ==, "2");
+  g_assert_cmpstr (g_ptr_array_index (array, 2), ==, "4");
+
+  g_ptr_array_free (array, TRUE);
+}
+
+
+static void
+test_every_any (void)
+{
+  GPtrArray *nums;
+
+  nums = g_ptr_array_new ();
+  g_assert_true (gx_ptr_array_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_ptr_array_any (nums, (GXPred)gx_is_odd, NULL));
+  g_ptr_array_free (nums, TRUE);
+
+  nums = gx_ptr_array_iota (20, 1, 2);
+  g_assert_true (gx_ptr_array_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_ptr_array_any (nums, (GXPred)gx_is_even, NULL));
+  g_ptr_array_free (nums, TRUE);
+}
+
+
+static void
+test_take_skip (void)
+{
+  GPtrArray *array, *array2;
+
+  array = gx_ptr_array_iota (100, 0, 1);
+
+  array2 = gx_ptr_array_take (array, 0);
+  assert_array_range (array2, 0, 1, 0);
+  g_ptr_array_free (array2, TRUE);
+
+  array2 = gx_ptr_array_take (array, 15);
+  assert_array_range (array2, 0, 1, 15);
+  g_ptr_array_free (array2, TRUE);
+
+  array2 = gx_ptr_array_take (array, 1000);
+  assert_array_range (array2, 0, 1, 100);
+  g_ptr_array_free (array2, TRUE);
+
+  array2 = gx_ptr_array_skip (array, 15);
+  assert_array_range (array2, 15, 1, 85);
+  g_ptr_array_free (array2, TRUE);
+
+  array2 = gx_ptr_array_skip (array, 1000);
+  assert_array_range (array2, 0, 1, 0);
+  g_ptr_array_free (array2, TRUE);
+
+  g_assert (gx_ptr_array_skip_in_place (array, 10, NULL) == array);
+  assert_array_range (array, 10, 1, 90);
+
+  g_assert (gx_ptr_array_take_in_place (array, 5, NULL) == array);
+  assert_array_range (array, 10, 1, 5);
+
+  gx_ptr_array_skip_in_place (array, 1000, NULL);
+  assert_array_range (array, 0, 1, 0);
+
+  g_ptr_array_free (array, TRUE);
+
+  array = g_ptr_array_new ();
+  g_ptr_array_add (array, g_strdup ("butter"));
+  g_ptr_array_add (array, g_strdup ("bread"));
+  g_ptr_array_add (array, g_strdup ("green"));
+  g_ptr_array_add (array, g_strdup ("cheese"));
+
+  gx_ptr_array_skip_in_place (array, 1, g_free);
+  gx_ptr_array_take_in_place (array, 2, g_free);
+  g_assert_cmpuint (array->len, ==, 2);
+  g_assert_cmpstr (g_ptr_array_index (array, 0), ==, "bread");
+  g_assert_cmpstr (g_ptr_array_index (array, 1), ==, "green");
+
+  g_ptr_array_set_free_func (array, g_free);
+  g_ptr_array_free (array, TRUE);
+}
+
+
+static int
+square (gint num)
+{
+  return num * num;
+}
+
+static void
+test_map (void)
+{
+  GPtrArray *array, *squares;
+  guint      u;
+
+  array   = gx_ptr_array_iota (1000, 0, 1);
+  squares = gx_ptr_array_map (array, (GXBinaryFunc)square, NULL);
+  g_assert_cmpuint (squares->len, ==, 1000);
+  for (u = 0; u != 1000; ++u)
+    g_assert_cmpint (GPOINTER_TO_INT (g_ptr_array_index (squares, u)), ==,
+                     u * u);
+  g_ptr_array_free (squares, TRUE);
+
+  g_assert (gx_ptr_array_map_in_place (array, (GXBinaryFunc)square,
+                                       NULL, NULL) == array);
+  for (u = 0; u != 1000; ++u)
+    g_assert_cmpint (GPOINTER_TO_INT (g_ptr_array_index (array, u)), ==,
+                     u * u);
+  g_ptr_array_free (array, TRUE);
+}
+
+
+static void
+test_fold_sum_product (void)
+{
+  GPtrArray *array;
+
+  array = gx_ptr_array_iota (1000, 1, 1);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_ptr_array_fold (array,
+                                                       (GXTernaryFunc)gx_plus,
+                                                       GINT_TO_POINTER (0),
+                                                       NULL, NULL)),
+                   ==, 500500);
+  g_assert_cmpint (gx_ptr_array_sum (array), ==, 500500);
+  g_ptr_array_free (array, TRUE);
+
+  array = gx_ptr_array_iota (7, 1, 1);
+  g_assert_cmpint (gx_ptr_array_product (array), ==, 5040);
+  g_ptr_array_free (array, TRUE);
+
+  array = g_ptr_array_new ();
+  g_assert (!gx_ptr_array_fold (array, (GXTernaryFunc)gx_plus,
+                                GINT_TO_POINTER (1), NULL, NULL));
+  g_assert_cmpint (gx_ptr_array_sum (array), ==, 0);
+  g_assert_cmpint (gx_ptr_array_product (array), ==, 1);
+  g_ptr_array_free (array, TRUE);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-ptr-array/filter", test_filter);
+  g_test_add_func ("/gx-ptr-array/filter-in-place-free",
+                   test_filter_in_place_free);
+  g_test_add_func ("/gx-ptr-array/every-any", test_every_any);
+  g_test_add_func ("/gx-ptr-array/take-skip", test_take_skip);
+  g_test_add_func ("/gx-ptr-array/map", test_map);
+  g_test_add_func ("/gx-ptr-array/fold-sum-product", test_fold_sum_product);
+
+  return g_test_run ();
+}
@@ -0,0 +1,220 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+
+/* check the elements, and that head, tail and length agree with them */
+static void
+assert_queue_range (GQueue *queue, gint start, gint step, guint len)
+{
+  GList *cur, *prev;
+  guint  n;
+
+  g_assert_cmpuint (queue->length, ==, len);
+
+  for (n = 0, prev = NULL, cur = queue->head; cur;
+       prev = cur, cur = cur->next, start += step, ++n)
+    {
+      g_assert (cur->prev == prev);
+      g_assert_cmpint (GPOINTER_TO_INT (cur->data), ==, start);
+    }
+
+  g_assert_cmpuint (n, ==, len);
+  g_assert (queue->tail == prev);
+}
+
+
+static gboolean
+is_short (const char *s)
+{
+  return s[1] == '\0';
+}
+
+static void
+test_filter (void)
+{
+  GQueue *queue, *even;
+  guint   u;
+
+  queue = gx_queue_iota (1000, 0, 1);
+  even  = gx_queue_filter (queue, (GXPred)gx_is_even, NULL);
+  assert_queue_range (even, 0, 2, 500);
+  g_queue_free (even);
+
+  /* drops both the head and the tail */
+  queue = gx_queue_filter_in_place (queue, (GXPred)gx_is_odd, NULL, NULL);
+  assert_queue_range (queue, 1, 2, 500);
+
+  queue = gx_queue_filter_in_place (queue, (GXPred)gx_is_even, NULL, NULL);
+  assert_queue_range (queue, 0, 1, 0);
+  g_queue_free (queue);
+
+  queue = g_queue_new ();
+  for (u = 0; u != 20; ++u)
+    g_queue_push_tail (queue, g_strdup_printf ("%u", u));
+  queue = gx_queue_filter_in_place (queue, (GXPred)is_short, NULL, g_free);
+  g_assert_cmpuint (queue->length, ==, 10);
+  g_assert_cmpstr (queue->tail->data, ==, "9");
+  g_queue_free_full (queue, g_free);
+}
+
+
+static void
+test_every_any (void)
+{
+  GQueue *nums;
+
+  nums = g_queue_new ();
+  g_assert_true (gx_queue_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_queue_any (nums, (GXPred)gx_is_odd, NULL));
+  g_queue_free (nums);
+
+  nums = gx_queue_iota (20, 1, 2);
+  g_assert_true (gx_queue_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_queue_any (nums, (GXPred)gx_is_even, NULL));
+  g_queue_free (nums);
+}
+
+
+static void
+test_take_skip (void)
+{
+  GQueue *queue, *queue2;
+
+  queue = gx_queue_iota (100, 0, 1);
+
+  queue2 = gx_queue_take (queue, 0);
+  assert_queue_range (queue2, 0, 1, 0);
+  g_queue_free (queue2);
+
+  queue2 = gx_queue_take (queue, 15);
+  assert_queue_range (queue2, 0, 1, 15);
+  g_queue_free (queue2);
+
+  queue2 = gx_queue_take (queue, 1000);
+  assert_queue_range (queue2, 0, 1, 100);
+  g_queue_free (queue2);
+
+  queue2 = gx_queue_skip (queue, 15);
+  assert_queue_range (queue2, 15, 1, 85);
+  g_queue_free (queue2);
+
+  queue2 = gx_queue_skip (queue, 100);
+  assert_queue_range (queue2, 0, 1, 0);
+  g_queue_free (queue2);
+
+  g_assert (gx_queue_skip_in_place (queue, 10, NULL) == queue);
+  assert_queue_range (queue, 10, 1, 90);
+
+  g_assert (gx_queue_take_in_place (queue, 5, NULL) == queue);
+  assert_queue_range (queue, 10, 1, 5);
+
+  gx_queue_take_in_place (queue, 1000, NULL);
+  assert_queue_range (queue, 10, 1, 5);
+
+  gx_queue_skip_in_place (queue, 1000, NULL);
+  assert_queue_range (queue, 0, 1, 0);
+
+  g_queue_free (queue);
+
+  queue = g_queue_new ();
+  g_queue_push_tail (queue, g_strdup ("butter"));
+  g_queue_push_tail (queue, g_strdup ("bread"));
+  g_queue_push_tail (queue, g_strdup ("green"));
+  g_queue_push_tail (queue, g_strdup ("cheese"));
+
+  gx_queue_skip_in_place (queue, 1, g_free);
+  gx_queue_take_in_place (queue, 2, g_free);
+  g_assert_cmpuint (queue->length, ==, 2);
+  g_assert_cmpstr (queue->head->data, ==, "bread");
+  g_assert_cmpstr (queue->tail->data, ==, "green");
+
+  g_queue_free_full (queue, g_free);
+}
+
+
+static int
+square (gint num)
+{
+  return num * num;
+}
+
+static void
+test_map (void)
+{
+  GQueue *queue, *squares;
+  GList  *cur;
+  gint    x;
+
+  queue   = gx_queue_iota (1000, 0, 1);
+  squares = gx_queue_map (queue, (GXBinaryFunc)square, NULL);
+  g_assert_cmpuint (squares->length, ==, 1000);
+  g_assert_cmpint (GPOINTER_TO_INT (squares->tail->data), ==, 999 * 999);
+  for (x = 0, cur = squares->head; cur; cur = cur->next, ++x)
+    g_assert_cmpint (GPOINTER_TO_INT (cur->data), ==, x * x);
+  g_queue_free (squares);
+
+  g_assert (gx_queue_map_in_place (queue, (GXBinaryFunc)square,
+                                   NULL, NULL) == queue);
+  for (x = 0, cur = queue->head; cur; cur = cur->next, ++x)
+    g_assert_cmpint (GPOINTER_TO_INT (cur->data), ==, x * x);
+  g_queue_free (queue);
+}
+
+
+static void
+test_fold_sum_product (void)
+{
+  GQueue *queue;
+
+  queue = gx_queue_iota (1000, 1, 1);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_queue_fold (queue, (GXTernaryFunc)gx_plus,
+                                                   GINT_TO_POINTER (0), NULL,
+                                                   NULL)),
+                   ==, 500500);
+  g_assert_cmpint (gx_queue_sum (queue), ==, 500500);
+  g_queue_free (queue);
+
+  queue = gx_queue_iota (7, 1, 1);
+  g_assert_cmpint (gx_queue_product (queue), ==, 5040);
+  g_queue_free (queue);
+
+  queue = g_queue_new ();
+  g_assert (!gx_queue_fold (queue, (GXTernaryFunc)gx_plus, GINT_TO_POINTER (1),
+                            NULL, NULL));
+  g_assert_cmpint (gx_queue_sum (queue), ==, 0);
+  g_assert_cmpint (gx_queue_product (queue), ==, 1);
+  g_queue_free (queue);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-queue/filter", test_filter);
+  g_test_add_func ("/gx-queue/every-any", test_every_any);
+  g_test_add_func ("/gx-queue/take-skip", test_take_skip);
+  g_test_add_func ("/gx-queue/map", test_map);
+  g_test_add_func ("/gx-queue/fold-sum-product", test_fold_sum_product);
+
+  return g_test_run ();
+}
@@ -0,0 +1,275 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+
+static void
+assert_seq_range (GSequence *seq, gint start, gint step, guint len)
+{
+  GSequenceIter *iter;
+
+  g_assert_cmpint (g_sequence_get_length (seq), ==, len);
+  for (iter = g_sequence_get_begin_iter (seq); !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter), start += step)
+    g_assert_cmpint (GPOINTER_TO_INT (g_sequence_get (iter)), ==, start);
+}
+
+
+static void
+test_filter (void)
+{
+  GSequence *seq, *even;
+
+  seq  = gx_sequence_iota (1000, 0, 1);
+  even = gx_sequence_filter (seq, (GXPred)gx_is_even, NULL);
+  assert_seq_range (even, 0, 2, 500);
+  g_sequence_free (even);
+
+  g_assert (gx_sequence_filter_in_place (seq, (GXPred)gx_is_odd,
+                                         NULL, NULL) == seq);
+  assert_seq_range (seq, 1, 2, 500);
+
+  gx_sequence_filter_in_place (seq, (GXPred)gx_is_even, NULL, NULL);
+  assert_seq_range (seq, 0, 1, 0);
+
+  g_sequence_free (seq);
+}
+
+
+static gboolean
+is_short (const char *s)
+{
+  return s[1] == '\0';
+}
+
+static char*
+upcase (char *s)
+{
+  return g_ascii_strup (s, -1);
+}
+
+/* edits the string and returns it, rather than a new one */
+static char*
+upcase_in_place (char *s)
+{
+  char *c;
+
+  for (c = s; *c; ++c)
+    *c = g_ascii_toupper (*c);
+
+  return s;
+}
+
+static void
+test_destroy_notify (void)
+{
+  GSequence *seq;
+  guint      u;
+
+  /* the destroy function of the sequence frees what is removed or
+   * replaced */
+  seq = g_sequence_new (g_free);
+  for (u = 0; u != 20; ++u)
+    g_sequence_append (seq, g_strdup_printf ("%c", 'a' + u));
+  for (u = 0; u != 20; ++u)
+    g_sequence_append (seq, g_strdup_printf ("%u", u));
+
+  gx_sequence_filter_in_place (seq, (GXPred)is_short, NULL, NULL);
+  g_assert_cmpint (g_sequence_get_length (seq), ==, 30);
+
+  gx_sequence_take_in_place (seq, 25, NULL);
+  gx_sequence_skip_in_place (seq, 18, NULL);
+  g_assert_cmpint (g_sequence_get_length (seq), ==, 7);
+
+  gx_sequence_map_in_place (seq, (GXBinaryFunc)upcase, NULL, NULL);
+  g_assert_cmpstr (g_sequence_get (g_sequence_get_begin_iter (seq)), ==, "S");
+
+  g_sequence_free (seq);
+
+  /* or our free_func does */
+  seq = g_sequence_new (NULL);
+  for (u = 0; u != 20; ++u)
+    g_sequence_append (seq, g_strdup_printf ("%u", u));
+
+  gx_sequence_filter_in_place (seq, (GXPred)is_short, NULL, g_free);
+  gx_sequence_take_in_place (seq, 8, g_free);
+  gx_sequence_skip_in_place (seq, 2, g_free);
+  gx_sequence_map_in_place (seq, (GXBinaryFunc)upcase, NULL, g_free);
+  g_assert_cmpint (g_sequence_get_length (seq), ==, 6);
+  g_assert_cmpstr (g_sequence_get (g_sequence_get_begin_iter (seq)), ==, "2");
+
+  g_sequence_foreach (seq, (GFunc)g_free, NULL);
+  g_sequence_free (seq);
+
+  /* elements that are mapped to themselves are not freed */
+  seq = g_sequence_new (g_free);
+  for (u = 0; u != 20; ++u)
+    g_sequence_append (seq, g_strdup_printf ("%c", 'a' + u));
+
+  gx_sequence_map_in_place (seq, (GXBinaryFunc)upcase_in_place, NULL, g_free);
+  g_assert_cmpint (g_sequence_get_length (seq), ==, 20);
+  g_assert_cmpstr (g_sequence_get (g_sequence_get_begin_iter (seq)), ==, "A");
+  g_assert_cmpstr (g_sequence_get (g_sequence_iter_prev
+                                   (g_sequence_get_end_iter (seq))), ==, "T");
+
+  g_sequence_free (seq);
+}
+
+
+static void
+test_every_any (void)
+{
+  GSequence *nums;
+
+  nums = g_sequence_new (NULL);
+  g_assert_true (gx_sequence_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_sequence_any (nums, (GXPred)gx_is_odd, NULL));
+  g_sequence_free (nums);
+
+  nums = gx_sequence_iota (20, 1, 2);
+  g_assert_true (gx_sequence_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_sequence_any (nums, (GXPred)gx_is_even, NULL));
+  g_sequence_free (nums);
+}
+
+
+static void
+test_take_skip (void)
+{
+  GSequence *seq, *seq2;
+
+  seq = gx_sequence_iota (100, 0, 1);
+
+  seq2 = gx_sequence_take (seq, 0);
+  assert_seq_range (seq2, 0, 1, 0);
+  g_sequence_free (seq2);
+
+  seq2 = gx_sequence_take (seq, 15);
+  assert_seq_range (seq2, 0, 1, 15);
+  g_sequence_free (seq2);
+
+  seq2 = gx_sequence_take (seq, 1000);
+  assert_seq_range (seq2, 0, 1, 100);
+  g_sequence_free (seq2);
+
+  seq2 = gx_sequence_skip (seq, 15);
+  assert_seq_range (seq2, 15, 1, 85);
+  g_sequence_free (seq2);
+
+  seq2 = gx_sequence_skip (seq, (gsize)G_MAXUINT + 1);
+  assert_seq_range (seq2, 0, 1, 0);
+  g_sequence_free (seq2);
+
+  g_assert (gx_sequence_skip_in_place (seq, 10, NULL) == seq);
+  assert_seq_range (seq, 10, 1, 90);
+
+  g_assert (gx_sequence_take_in_place (seq, 5, NULL) == seq);
+  assert_seq_range (seq, 10, 1, 5);
+
+  gx_sequence_take_in_place (seq, 1000, NULL);
+  assert_seq_range (seq, 10, 1, 5);
+
+  gx_sequence_skip_in_place (seq, 1000, NULL);
+  assert_seq_range (seq, 0, 1, 0);
+
+  g_sequence_free (seq);
+}
+
+
+static int
+square (gint num)
+{
+  return num * num;
+}
+
+static void
+test_map (void)
+{
+  GSequence     *seq, *squares;
+  GSequenceIter *iter;
+  gint           x;
+
+  seq     = gx_sequence_iota (1000, 0, 1);
+  squares = gx_sequence_map (seq, (GXBinaryFunc)square, NULL);
+  g_assert_cmpint (g_sequence_get_length (squares), ==, 1000);
+  for (x = 0, iter = g_sequence_get_begin_iter (squares);
+       !g_sequence_iter_is_end (iter); iter = g_sequence_iter_next (iter), ++x)
+    g_assert_cmpint (GPOINTER_TO_INT (g_sequence_get (iter)), ==, x * x);
+  g_sequence_free (squares);
+
+  g_assert (gx_sequence_map_in_place (seq, (GXBinaryFunc)square,
+                                      NULL, NULL) == seq);
+  for (x = 0, iter = g_sequence_get_begin_iter (seq);
+       !g_sequence_iter_is_end (iter); iter = g_sequence_iter_next (iter), ++x)
+    g_assert_cmpint (GPOINTER_TO_INT (g_sequence_get (iter)), ==, x * x);
+  g_sequence_free (seq);
+}
+
+
+static void
+test_fold_sum_product (void)
+{
+  GSequence *seq;
+  char      *str;
+
+  seq = gx_sequence_iota (1000, 1, 1);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_sequence_fold (seq,
+                                                      (GXTernaryFunc)gx_plus,
+                                                      GINT_TO_POINTER (0),
+                                                      NULL, NULL)),
+                   ==, 500500);
+  g_assert_cmpint (gx_sequence_sum (seq), ==, 500500);
+  g_sequence_free (seq);
+
+  seq = gx_sequence_iota (7, 1, 1);
+  g_assert_cmpint (gx_sequence_product (seq), ==, 5040);
+  g_sequence_free (seq);
+
+  seq = g_sequence_new (NULL);
+  g_assert (!gx_sequence_fold (seq, (GXTernaryFunc)gx_plus,
+                               GINT_TO_POINTER (1), NULL, NULL));
+  g_assert_cmpint (gx_sequence_sum (seq), ==, 0);
+  g_assert_cmpint (gx_sequence_product (seq), ==, 1);
+
+  g_sequence_append (seq, "Amsterdam");
+  g_sequence_append (seq, "Helsinki");
+  str = gx_sequence_fold (seq, (GXTernaryFunc)gx_str_chain, NULL, "; ",
+                          g_free);
+  g_assert_cmpstr (str, ==, "Amsterdam; Helsinki");
+  g_free (str);
+
+  g_sequence_free (seq);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-sequence/filter", test_filter);
+  g_test_add_func ("/gx-sequence/destroy-notify", test_destroy_notify);
+  g_test_add_func ("/gx-sequence/every-any", test_every_any);
+  g_test_add_func ("/gx-sequence/take-skip", test_take_skip);
+  g_test_add_func ("/gx-sequence/map", test_map);
+  g_test_add_func ("/gx-sequence/fold-sum-product", test_fold_sum_product);
+
+  return g_test_run ();
+}
@@ -0,0 +1,267 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+#include <string.h>
+
+static void
+assert_slist_range (GSList *list, gint start, gint step, guint len)
+{
+  g_assert_cmpuint (g_slist_length (list), ==, len);
+  for (; list; list = list->next, start += step)
+    g_assert_cmpint (GPOINTER_TO_INT (list->data), ==, start);
+}
+
+
+static void
+test_filter (void)
+{
+  GSList *list, *even;
+
+  list = gx_slist_iota (1000, 0, 1);
+  even = gx_slist_filter (list, (GXPred)gx_is_even, NULL);
+  assert_slist_range (even, 0, 2, 500);
+  g_slist_free (even);
+
+  list = gx_slist_filter_in_place (list, (GXPred)gx_is_odd, NULL, NULL);
+  assert_slist_range (list, 1, 2, 500);
+
+  /* removing everything, and nothing */
+  list = gx_slist_filter_in_place (list, (GXPred)gx_is_odd, NULL, NULL);
+  assert_slist_range (list, 1, 2, 500);
+  list = gx_slist_filter_in_place (list, (GXPred)gx_is_even, NULL, NULL);
+  g_assert (!list);
+
+  g_assert (!gx_slist_filter (NULL, (GXPred)gx_is_even, NULL));
+}
+
+
+static gboolean
+even_length (const char *s)
+{
+  return strlen (s) % 2 == 0 ? TRUE : FALSE;
+}
+
+static void
+test_filter_in_place_free (void)
+{
+  GSList     *list;
+  gint        x;
+  const char *str;
+
+  str = "Hello, world!";
+  for (x = 0, list = NULL; x != 10; ++x)
+    list = g_slist_prepend (list, g_strndup (str, x));
+
+  list = gx_slist_filter_in_place (list, (GXPred)even_length, NULL, g_free);
+  g_assert_cmpuint (g_slist_length (list), ==, 5);
+  g_assert_cmpstr (list->data, ==, "Hello, w");
+
+  g_slist_free_full (list, g_free);
+}
+
+
+static void
+test_every_any (void)
+{
+  GSList *nums;
+
+  g_assert_true (gx_slist_every (NULL, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_slist_any (NULL, (GXPred)gx_is_odd, NULL));
+
+  nums = gx_slist_iota (20, 1, 2);
+  g_assert_true (gx_slist_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_slist_any (nums, (GXPred)gx_is_even, NULL));
+  g_slist_free (nums);
+
+  nums = gx_slist_iota (20, 1, 1);
+  nums = gx_slist_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+  g_assert_true (gx_slist_any (nums, (GXPred)gx_is_even, NULL));
+  g_assert_false (gx_slist_every (nums, (GXPred)gx_is_odd, NULL));
+  g_slist_free (nums);
+}
+
+
+static void
+test_take_skip (void)
+{
+  GSList *list, *list2;
+
+  list = gx_slist_iota (100, 0, 1);
+
+  g_assert (!gx_slist_take (list, 0));
+
+  list2 = gx_slist_take (list, 15);
+  assert_slist_range (list2, 0, 1, 15);
+  g_slist_free (list2);
+
+  list2 = gx_slist_take (list, 1000);
+  assert_slist_range (list2, 0, 1, 100);
+  g_slist_free (list2);
+
+  list2 = gx_slist_skip (list, 15);
+  assert_slist_range (list2, 15, 1, 85);
+  g_slist_free (list2);
+
+  g_assert (!gx_slist_skip (list, 100));
+
+  list = gx_slist_skip_in_place (list, 10, NULL);
+  assert_slist_range (list, 10, 1, 90);
+
+  list = gx_slist_take_in_place (list, 5, NULL);
+  assert_slist_range (list, 10, 1, 5);
+
+  list = gx_slist_take_in_place (list, 1000, NULL);
+  assert_slist_range (list, 10, 1, 5);
+
+  list = gx_slist_skip_in_place (list, 1000, NULL);
+  g_assert (!list);
+
+  list = gx_slist_iota (10, 0, 1);
+  list = gx_slist_take_in_place (list, 0, NULL);
+  g_assert (!list);
+}
+
+
+static void
+test_take_skip_in_place_free (void)
+{
+  GSList     *list;
+  guint       u;
+  const char *words[] = { "butter", "bread", "green", "cheese" };
+
+  for (u = G_N_ELEMENTS(words), list = NULL; u != 0; --u)
+    list = g_slist_prepend (list, g_strdup (words[u - 1]));
+
+  list = gx_slist_skip_in_place (list, 1, g_free);
+  list = gx_slist_take_in_place (list, 2, g_free);
+  g_assert_cmpuint (g_slist_length (list), ==, 2);
+  g_assert_cmpstr (list->data, ==, "bread");
+  g_assert_cmpstr (list->next->data, ==, "green");
+
+  g_slist_free_full (list, g_free);
+}
+
+
+static int
+square (gint num)
+{
+  return num * num;
+}
+
+static char*
+upcase (char *s)
+{
+  return g_ascii_strup (s, -1);
+}
+
+static void
+test_map (void)
+{
+  GSList *list, *squares, *cur;
+  gint    x;
+
+  list    = gx_slist_iota (1000, 0, 1);
+  squares = gx_slist_map (list, (GXBinaryFunc)square, NULL);
+  for (x = 0, cur = squares; cur; cur = cur->next, ++x)
+    g_assert_cmpint (GPOINTER_TO_INT (cur->data), ==, x * x);
+  g_assert_cmpint (x, ==, 1000);
+  g_slist_free (squares);
+
+  g_assert (gx_slist_map_in_place (list, (GXBinaryFunc)square,
+                                   NULL, NULL) == list);
+  for (x = 0, cur = list; cur; cur = cur->next, ++x)
+    g_assert_cmpint (GPOINTER_TO_INT (cur->data), ==, x * x);
+  g_slist_free (list);
+
+  list = g_slist_prepend (NULL, g_strdup ("b"));
+  list = g_slist_prepend (list, g_strdup ("a"));
+  list = gx_slist_map_in_place (list, (GXBinaryFunc)upcase, NULL, g_free);
+  g_assert_cmpstr (list->data, ==, "A");
+  g_assert_cmpstr (list->next->data, ==, "B");
+  g_slist_free_full (list, g_free);
+}
+
+
+static void
+test_fold (void)
+{
+  GSList *list;
+  char   *str;
+  const char* cities[] = { "Amsterdam", "San Francisco", "Helsinki" };
+
+  /* more than one batch for the kernel */
+  list = gx_slist_iota (1000, 1, 1);
+  g_assert_cmpint (GPOINTER_TO_INT (gx_slist_fold (list, (GXTernaryFunc)gx_plus,
+                                                   GINT_TO_POINTER (0), NULL,
+                                                   NULL)),
+                   ==, 500500);
+  g_slist_free (list);
+
+  g_assert (!gx_slist_fold (NULL, (GXTernaryFunc)gx_plus, GINT_TO_POINTER (1),
+                            NULL, NULL));
+
+  list = g_slist_append (NULL, (gpointer)cities[0]);
+  list = g_slist_append (list, (gpointer)cities[1]);
+  list = g_slist_append (list, (gpointer)cities[2]);
+
+  str = gx_slist_fold (list, (GXTernaryFunc)gx_str_chain, NULL, "; ", g_free);
+  g_assert_cmpstr (str, ==, "Amsterdam; San Francisco; Helsinki");
+  g_free (str);
+
+  g_slist_free (list);
+}
+
+
+static void
+test_sum_product (void)
+{
+  GSList *list;
+
+  list = gx_slist_iota (100, 1, 1);
+  g_assert_cmpint (gx_slist_sum (list), ==, 5050);
+  g_slist_free (list);
+
+  list = gx_slist_iota (7, 1, 1);
+  g_assert_cmpint (gx_slist_product (list), ==, 5040);
+  g_slist_free (list);
+
+  g_assert_cmpint (gx_slist_sum (NULL), ==, 0);
+  g_assert_cmpint (gx_slist_product (NULL), ==, 1);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-slist/filter", test_filter);
+  g_test_add_func ("/gx-slist/filter-in-place-free", test_filter_in_place_free);
+  g_test_add_func ("/gx-slist/every-any", test_every_any);
+  g_test_add_func ("/gx-slist/take-skip", test_take_skip);
+  g_test_add_func ("/gx-slist/take-skip-in-place-free",
+                   test_take_skip_in_place_free);
+  g_test_add_func ("/gx-slist/map", test_map);
+  g_test_add_func ("/gx-slist/fold", test_fold);
+  g_test_add_func ("/gx-slist/sum-product", test_sum_product);
+
+  return g_test_run ();
+}
@@ -0,0 +1,258 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+#include <string.h>
+
+static void
+assert_same_list (GList *list1, GList *list2)
+{
+  g_assert_cmpuint (g_list_length (list1), ==, g_list_length (list2));
+
+  for (; list1; list1 = list1->next, list2 = list2->next)
+    {
+      g_assert (list1->data == list2->data);
+      g_assert (!list1->next || list1->next->prev == list1);
+    }
+}
+
+/* keys that have many duplicates, so we can check for stability */
+static gpointer
+coarse_key (gconstpointer ptr, gconstpointer user_data)
+{
+  return GINT_TO_POINTER (GPOINTER_TO_INT (ptr) >> 4);
+}
+
+static gint
+cmp_coarse (gconstpointer p1, gconstpointer p2)
+{
+  return gx_cmp_int (GPOINTER_TO_INT (p1) >> 4, GPOINTER_TO_INT (p2) >> 4);
+}
+
+static void
+test_sort_int (void)
+{
+  guint round;
+
+  for (round = 0; round != 50; ++round)
+    {
+      GList *list, *expected;
+      gsize  n, u;
+      gint   range;
+
+      n     = round < 20 ? round : (gsize)g_random_int_range (0, 5000);
+      range = round % 2 ? 1000 : G_MAXINT;
+
+      for (list = NULL, u = 0; u != n; ++u)
+        list = g_list_prepend
+          (list, GINT_TO_POINTER (g_random_int_range (-range, range)));
+
+      expected = g_list_sort (g_list_copy (list), cmp_coarse);
+      list     = gx_list_sort_by_key (list, coarse_key, NULL,
+                                      (GCompareFunc)gx_cmp_int, NULL);
+      assert_same_list (list, expected);
+      g_assert (!list || !list->prev);
+
+      g_list_free (list);
+      g_list_free (expected);
+    }
+}
+
+
+/* the part of a string before the '|' */
+static gpointer
+str_key (gconstpointer ptr, gconstpointer user_data)
+{
+  const char *bar;
+
+  if (!ptr)
+    return NULL;
+
+  bar = strchr (ptr, '|');
+  return g_strndup (ptr, bar - (const char*)ptr);
+}
+
+static gint
+cmp_str_keys (gconstpointer p1, gconstpointer p2)
+{
+  gchar *key1, *key2;
+  gint   cmp;
+
+  key1 = str_key (p1, NULL);
+  key2 = str_key (p2, NULL);
+  cmp  = g_strcmp0 (key1, key2);
+
+  g_free (key1);
+  g_free (key2);
+
+  return cmp;
+}
+
+static guint n_freed;
+
+static void
+count_free (gpointer ptr)
+{
+  ++n_freed;
+  g_free (ptr);
+}
+
+static void
+test_sort_str (void)
+{
+  guint round;
+
+  for (round = 0; round != 50; ++round)
+    {
+      GList *list, *expected;
+      gsize  n, u;
+
+      n = round < 20 ? round : (gsize)g_random_int_range (0, 3000);
+
+      /* with long common prefixes, empty strings and NULL */
+      for (list = NULL, u = 0; u != n; ++u)
+        {
+          GString *str;
+          guint    len;
+
+          if (g_random_int_range (0, 50) == 0)
+            {
+              list = g_list_prepend (list, NULL);
+              continue;
+            }
+
+          str = g_string_new (round % 3 == 0 ? "common/prefix/" : "");
+          for (len = g_random_int_range (0, 6); len != 0; --len)
+            g_string_append_c (str, "ab\xc3z"[g_random_int_range (0, 4)]);
+          g_string_append_printf (str, "|%u", (guint)u);
+
+          list = g_list_prepend (list, g_string_free (str, FALSE));
+        }
+
+      expected = g_list_sort (g_list_copy (list), cmp_str_keys);
+
+      n_freed = 0;
+      list    = gx_list_sort_by_key (list, str_key, NULL,
+                                     (GCompareFunc)g_strcmp0, count_free);
+      g_assert_cmpuint (n_freed, ==, n);
+      assert_same_list (list, expected);
+
+      g_list_free_full (list, g_free);
+      g_list_free (expected);
+    }
+}
+
+
+static gint
+cmp_desc (gconstpointer p1, gconstpointer p2)
+{
+  return cmp_coarse (p2, p1);
+}
+
+static void
+test_sort_custom (void)
+{
+  GList *list, *expected;
+  gsize  u;
+
+  /* anything else than the radix functions */
+  for (list = NULL, u = 0; u != 10000; ++u)
+    list = g_list_prepend
+      (list, GINT_TO_POINTER (g_random_int_range (-1000, 1000)));
+
+  expected = g_list_sort (g_list_copy (list), cmp_desc);
+  list     = gx_list_sort_by_key (list, NULL, NULL, cmp_desc, NULL);
+  assert_same_list (list, expected);
+
+  g_list_free (list);
+  g_list_free (expected);
+
+  /* a single element still has its key freed */
+  n_freed = 0;
+  list    = g_list_prepend (NULL, "a|b");
+  list    = gx_list_sort_by_key (list, str_key, NULL, (GCompareFunc)strcmp,
+                                 count_free);
+  g_assert_cmpuint (n_freed, ==, 1);
+  g_list_free (list);
+
+  g_assert (!gx_list_sort_by_key (NULL, NULL, NULL, cmp_desc, NULL));
+}
+
+
+static void
+test_sort_int_list (void)
+{
+  GList *list, *expected;
+  gsize  u;
+
+  for (list = NULL, u = 0; u != 5000; ++u)
+    list = g_list_prepend (list, GINT_TO_POINTER (g_random_int ()));
+
+  expected = g_list_sort (g_list_copy (list), (GCompareFunc)gx_cmp_int);
+  list     = gx_list_sort_int (list);
+  assert_same_list (list, expected);
+
+  g_list_free (list);
+  g_list_free (expected);
+}
+
+
+static void
+test_sort_parallel (void)
+{
+  gint   threads[] = { 1, 2, 3, 4, 7, -1 };
+  gsize  sizes[]   = { 0, 1, 2, 100, 16383, 16384, 16385, 100000 };
+  guint  t, s;
+
+  for (t = 0; t != G_N_ELEMENTS (threads); ++t)
+    for (s = 0; s != G_N_ELEMENTS (sizes); ++s)
+      {
+        GList *list, *expected;
+        gsize  u;
+
+        for (list = NULL, u = 0; u != sizes[s]; ++u)
+          list = g_list_prepend
+            (list, GINT_TO_POINTER (g_random_int_range (-5000, 5000)));
+
+        /* coarse keys, so we can check for stability */
+        expected = g_list_sort (g_list_copy (list), cmp_coarse);
+        list     = gx_list_sort_parallel (list, cmp_coarse, threads[t]);
+        assert_same_list (list, expected);
+        g_assert (!list || !list->prev);
+
+        g_list_free (list);
+        g_list_free (expected);
+      }
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-sort/sort-int", test_sort_int);
+  g_test_add_func ("/gx-sort/sort-str", test_sort_str);
+  g_test_add_func ("/gx-sort/sort-custom", test_sort_custom);
+  g_test_add_func ("/gx-sort/sort-int-list", test_sort_int_list);
+  g_test_add_func ("/gx-sort/sort-parallel", test_sort_parallel);
+
+  return g_test_run ();
+}
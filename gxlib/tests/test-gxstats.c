@@ -0,0 +1,351 @@
+/*
+** GXLIB - Library of extensions for GLIB
+** Copyright (C) 2017 Dirk-Jan C. Binnema
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <gxlib/gxlib.h>
+
+#define assert_close(a,b,eps)                                           \
+  g_assert_cmpfloat (fabs ((a) - (b)), <=, (eps) * MAX (1.0, fabs ((gdouble)(b))))
+
+static void
+naive_stats (const gdouble *values, gsize n, gdouble *mean, gdouble *variance)
+{
+  gdouble sum, m2;
+  gsize   u;
+
+  for (sum = 0, u = 0; u != n; ++u)
+    sum += values[u];
+  *mean = sum / n;
+
+  for (m2 = 0, u = 0; u != n; ++u)
+    m2 += (values[u] - *mean) * (values[u] - *mean);
+  *variance = m2 / (n - 1);
+}
+
+static int
+cmp_double (const void *p1, const void *p2)
+{
+  gdouble d1, d2;
+
+  d1 = *(const gdouble*)p1;
+  d2 = *(const gdouble*)p2;
+
+  return (d1 > d2) - (d1 < d2);
+}
+
+static gdouble*
+random_values (gsize n, gdouble offset)
+{
+  gdouble *values;
+  gsize    u;
+
+  values = g_new (gdouble, n);
+  for (u = 0; u != n; ++u)
+    values[u] = offset + g_random_double_range (-1000, 1000);
+
+  return values;
+}
+
+
+static void
+test_basic (void)
+{
+  GXStats *stats;
+
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+
+  g_assert_cmpuint (gx_stats_get_count (stats), ==, 0);
+  g_assert_cmpfloat (gx_stats_get_sum (stats), ==, 0);
+  g_assert (isnan (gx_stats_get_min (stats)));
+  g_assert (isnan (gx_stats_get_max (stats)));
+  g_assert (isnan (gx_stats_get_mean (stats)));
+  g_assert (isnan (gx_stats_get_variance (stats)));
+
+  gx_stats_add (stats, 4);
+  g_assert_cmpfloat (gx_stats_get_min (stats), ==, 4);
+  g_assert_cmpfloat (gx_stats_get_mean (stats), ==, 4);
+  g_assert (isnan (gx_stats_get_variance (stats)));
+
+  gx_stats_add (stats, 7);
+  gx_stats_add (stats, 13);
+  gx_stats_add (stats, 16);
+
+  g_assert_cmpuint (gx_stats_get_count (stats), ==, 4);
+  g_assert_cmpfloat (gx_stats_get_sum (stats), ==, 40);
+  g_assert_cmpfloat (gx_stats_get_min (stats), ==, 4);
+  g_assert_cmpfloat (gx_stats_get_max (stats), ==, 16);
+  g_assert_cmpfloat (gx_stats_get_mean (stats), ==, 10);
+  g_assert_cmpfloat (gx_stats_get_variance (stats), ==, 30);
+  g_assert_cmpfloat (gx_stats_get_stddev (stats), ==, sqrt (30));
+
+  gx_stats_free (stats);
+}
+
+
+static void
+test_precision (void)
+{
+  GXStats *stats;
+  gdouble  values[4] = { 4, 7, 13, 16 };
+  guint    u;
+
+  /* the textbook formula loses all precision here */
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+  for (u = 0; u != 4; ++u)
+    gx_stats_add (stats, 1e9 + values[u]);
+  assert_close (gx_stats_get_variance (stats), 30, 1e-9);
+  gx_stats_free (stats);
+
+  for (u = 0; u != 4; ++u)
+    values[u] += 1e9;
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+  gx_stats_add_array (stats, values, 4);
+  assert_close (gx_stats_get_variance (stats), 30, 1e-9);
+  gx_stats_free (stats);
+
+  /* compensated summation */
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+  gx_stats_add (stats, 1e16);
+  for (u = 0; u != 1000; ++u)
+    gx_stats_add (stats, 1.0);
+  gx_stats_add (stats, -1e16);
+  g_assert_cmpfloat (gx_stats_get_sum (stats), ==, 1000);
+  gx_stats_free (stats);
+}
+
+
+static void
+test_array (void)
+{
+  gsize sizes[] = { 1, 3, 8, 1023, 1024, 1025, 100003 };
+  guint u;
+
+  for (u = 0; u != G_N_ELEMENTS (sizes); ++u)
+    {
+      GXStats *stats, *stats1;
+      gdouble *values, mean, variance, min, max;
+      gsize    v;
+
+      values = random_values (sizes[u], 1e6);
+      naive_stats (values, sizes[u], &mean, &variance);
+      for (min = max = values[0], v = 0; v != sizes[u]; ++v)
+        {
+          min = MIN (min, values[v]);
+          max = MAX (max, values[v]);
+        }
+
+      stats  = gx_stats_new (GX_STATS_FLAGS_NONE);
+      stats1 = gx_stats_new (GX_STATS_FLAGS_NONE);
+      gx_stats_add_array (stats, values, sizes[u]);
+      for (v = 0; v != sizes[u]; ++v)
+        gx_stats_add (stats1, values[v]);
+
+      g_assert_cmpuint (gx_stats_get_count (stats), ==, sizes[u]);
+      g_assert_cmpfloat (gx_stats_get_min (stats), ==, min);
+      g_assert_cmpfloat (gx_stats_get_max (stats), ==, max);
+      assert_close (gx_stats_get_sum (stats), mean * sizes[u], 1e-12);
+      assert_close (gx_stats_get_mean (stats), mean, 1e-12);
+      assert_close (gx_stats_get_mean (stats1), mean, 1e-12);
+      if (sizes[u] > 1)
+        {
+          assert_close (gx_stats_get_variance (stats), variance, 1e-9);
+          assert_close (gx_stats_get_variance (stats1), variance, 1e-9);
+        }
+
+      gx_stats_free (stats1);
+      gx_stats_free (stats);
+      g_free (values);
+    }
+}
+
+
+static void
+test_fold (void)
+{
+  GXStats    *stats, *stats1;
+  GXIntArray *array;
+  GList      *nums, *ptrs, *cur;
+  gdouble    *values;
+  gsize       u;
+
+  nums  = gx_list_iota (10000, -5000, 1);
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+  g_assert (gx_list_fold (nums, (GXTernaryFunc)gx_stats_fold_int, stats,
+                          NULL, NULL) == stats);
+  g_assert_cmpuint (gx_stats_get_count (stats), ==, 10000);
+  g_assert_cmpfloat (gx_stats_get_sum (stats), ==, -5000);
+  g_assert_cmpfloat (gx_stats_get_min (stats), ==, -5000);
+  g_assert_cmpfloat (gx_stats_get_max (stats), ==, 4999);
+  assert_close (gx_stats_get_mean (stats), -0.5, 1e-12);
+  gx_stats_free (stats);
+
+  /* the plain function, rather than the kernel */
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+  for (cur = nums; cur; cur = cur->next)
+    gx_stats_fold_int (stats, cur->data, NULL);
+  assert_close (gx_stats_get_mean (stats), -0.5, 1e-12);
+  gx_stats_free (stats);
+  g_list_free (nums);
+
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+  g_assert (gx_iter_fold (gx_iter_range (1, 1001, 1),
+                          (GXTernaryFunc)gx_stats_fold_int, stats,
+                          NULL, NULL) == stats);
+  g_assert_cmpfloat (gx_stats_get_sum (stats), ==, 500500);
+  gx_stats_free (stats);
+
+  values = random_values (5000, 0);
+  for (ptrs = NULL, u = 0; u != 5000; ++u)
+    ptrs = g_list_prepend (ptrs, &values[u]);
+  stats  = gx_stats_new (GX_STATS_FLAGS_NONE);
+  stats1 = gx_stats_new (GX_STATS_FLAGS_NONE);
+  g_assert (gx_list_fold (ptrs, (GXTernaryFunc)gx_stats_fold_double, stats,
+                          NULL, NULL) == stats);
+  gx_stats_add_array (stats1, values, 5000);
+  g_assert_cmpuint (gx_stats_get_count (stats), ==, 5000);
+  assert_close (gx_stats_get_sum (stats), gx_stats_get_sum (stats1), 1e-12);
+  assert_close (gx_stats_get_variance (stats),
+                gx_stats_get_variance (stats1), 1e-12);
+  gx_stats_free (stats1);
+  gx_stats_free (stats);
+  g_list_free (ptrs);
+  g_free (values);
+
+  array = gx_int_array_iota (3000, 1, 2);
+  stats = gx_stats_new (GX_STATS_FLAGS_NONE);
+  gx_stats_add_int_array (stats, array);
+  g_assert_cmpfloat (gx_stats_get_sum (stats), ==, 3000.0 * 3000);
+  g_assert_cmpfloat (gx_stats_get_max (stats), ==, 5999);
+  gx_stats_free (stats);
+  gx_int_array_free (array);
+}
+
+
+static void
+test_merge (void)
+{
+  GXStats *stats, *parts[3];
+  gdouble *values, mean, variance;
+  gsize    n, u;
+
+  n      = 30000;
+  values = random_values (n, 50);
+  naive_stats (values, n, &mean, &variance);
+
+  for (u = 0; u != 3; ++u)
+    parts[u] = gx_stats_new (GX_STATS_FLAGS_PERCENTILES);
+  gx_stats_add_array (parts[0], values, 1000);
+  gx_stats_add_array (parts[1], values + 1000, 20000);
+  for (u = 21000; u != n; ++u)
+    gx_stats_add (parts[2], values[u]);
+
+  stats = gx_stats_new (GX_STATS_FLAGS_PERCENTILES);
+  for (u = 0; u != 3; ++u)
+    {
+      gx_stats_merge (stats, parts[u]);
+      gx_stats_free (parts[u]);
+    }
+  /* an empty one */
+  parts[0] = gx_stats_new (GX_STATS_FLAGS_PERCENTILES);
+  gx_stats_merge (stats, parts[0]);
+  gx_stats_free (parts[0]);
+
+  g_assert_cmpuint (gx_stats_get_count (stats), ==, n);
+  assert_close (gx_stats_get_mean (stats), mean, 1e-12);
+  assert_close (gx_stats_get_variance (stats), variance, 1e-9);
+  /* compare with the exact percentiles, in rank */
+  qsort (values, n, sizeof (gdouble), cmp_double);
+  for (u = 1; u != 100; ++u)
+    {
+      gdouble estimate;
+      gsize   rank;
+
+      estimate = gx_stats_get_percentile (stats, u);
+      for (rank = 0; rank != n && values[rank] < estimate; ++rank);
+      g_assert_cmpfloat (fabs ((gdouble)rank / n - u / 100.0), <=, 0.02);
+    }
+
+  gx_stats_free (stats);
+  g_free (values);
+}
+
+
+static void
+test_percentile (void)
+{
+  GXStats *stats;
+  gsize    n, u;
+  gdouble  percentiles[] = { 0.1, 1, 10, 25, 50, 75, 90, 99, 99.9 };
+
+  /* small: exact */
+  stats = gx_stats_new (GX_STATS_FLAGS_PERCENTILES);
+  g_assert (isnan (gx_stats_get_percentile (stats, 50)));
+  gx_stats_add (stats, 3);
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 0), ==, 3);
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 50), ==, 3);
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 100), ==, 3);
+  for (u = 1; u != 500; ++u)
+    gx_stats_add (stats, 3 + u);
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 0), ==, 3);
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 50), ==, 252.5);
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 100), ==, 502);
+  gx_stats_free (stats);
+
+  /* a shuffled 0 .. n - 1 */
+  n     = 1000000;
+  stats = gx_stats_new (GX_STATS_FLAGS_PERCENTILES);
+  for (u = 0; u != n; ++u)
+    gx_stats_add (stats, (u * 7919) % n);
+
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 0), ==, 0);
+  g_assert_cmpfloat (gx_stats_get_percentile (stats, 100), ==, n - 1);
+  for (u = 0; u != G_N_ELEMENTS (percentiles); ++u)
+    {
+      gdouble expected, err;
+
+      expected = percentiles[u] / 100 * n;
+      err      = fabs (gx_stats_get_percentile (stats, percentiles[u]) -
+                       expected) / n;
+      /* the error in rank is much smaller at the tails */
+      g_assert_cmpfloat (err, <=,
+                         0.03 * sqrt (percentiles[u] / 100 *
+                                      (1 - percentiles[u] / 100)) + 1e-4);
+    }
+
+  gx_stats_free (stats);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-stats/basic", test_basic);
+  g_test_add_func ("/gx-stats/precision", test_precision);
+  g_test_add_func ("/gx-stats/array", test_array);
+  g_test_add_func ("/gx-stats/fold", test_fold);
+  g_test_add_func ("/gx-stats/merge", test_merge);
+  g_test_add_func ("/gx-stats/percentile", test_percentile);
+
+  return g_test_run ();
+}
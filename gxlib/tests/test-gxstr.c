@@ -97,6 +97,8 @@ test_utf8_flatten (void)
       { "Αναφορές", "αναφορες"},
       { "Му (кириллицей)", "му (кириллицеи)" }
     };
+  const char *invalid[] = { "ab\xc0\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80",
+                            "\xe2\x82", "\xe2\x82z", "\x80", "\xf8\x88\x80\x80\x80" };
 
   setlocale (LC_ALL, "");
 
@@ -115,8 +117,381 @@ test_utf8_flatten (void)
   buf[0]=0xff;
   buf[1]=0x00;
   g_assert (!gx_utf8_flatten (buf, 1));
+
+  /* overlong, surrogate, beyond U+10FFFF, truncated */
+  for (u = 0; u != G_N_ELEMENTS (invalid); ++u)
+    g_assert (!gx_utf8_flatten (invalid[u], -1));
+  g_assert (!gx_utf8_flatten ("\xc3\xa9", 1));
+}
+
+
+/* the straightforward implementation gx_utf8_flatten() must agree with */
+static gchar*
+reference_flatten (const gchar *str, gssize len)
+{
+  GString *gstr;
+  char    *norm, *cur;
+
+  norm = g_utf8_normalize (str, len, G_NORMALIZE_ALL);
+  if (!norm)
+    return NULL;
+
+  gstr = g_string_sized_new (strlen (norm));
+  for (cur = norm; *cur; cur = g_utf8_next_char (cur))
+    {
+      gunichar gc;
+
+      gc = g_utf8_get_char (cur);
+      if (g_unichar_combining_class (gc) == 0)
+        g_string_append_unichar (gstr, g_unichar_tolower (gc));
+    }
+
+  g_free (norm);
+
+  return g_string_free (gstr, FALSE);
+}
+
+/* check that flattening into a buffer of buf_size bytes gives flat, and
+ * does not write beyond the buffer */
+static void
+assert_flatten_into (const gchar *str, gssize len, const gchar *flat,
+                     gsize buf_size)
+{
+  gchar  buf[1024];
+  gsize  u;
+  gssize flat_len;
+
+  g_assert_cmpuint (buf_size, <, sizeof (buf));
+  memset (buf, 0x55, sizeof (buf));
+
+  flat_len = gx_utf8_flatten_into (str, len, buf, buf_size);
+  if (!flat)
+    g_assert_cmpint (flat_len, ==, -1);
+  else
+    {
+      g_assert_cmpint (flat_len, ==, (gssize)strlen (flat));
+      if ((gsize)flat_len < buf_size)
+        g_assert_cmpstr (buf, ==, flat);
+    }
+
+  for (u = buf_size; u != sizeof (buf); ++u)
+    g_assert_cmpint (buf[u], ==, 0x55);
+}
+
+static void
+assert_flatten_as_reference (const gchar *str, gssize len)
+{
+  gchar   *flat, *ref;
+  GString *gstr;
+  gsize    flat_len;
+
+  flat = gx_utf8_flatten (str, len);
+  ref  = reference_flatten (str, len);
+  g_assert_cmpstr (flat, ==, ref);
+
+  /* appending, and flattening into buffers that are too small, just right
+   * and roomy */
+  gstr = g_string_new ("prefix");
+  g_assert_cmpint (gx_utf8_flatten_append (gstr, str, len), ==, flat != NULL);
+  g_assert_cmpstr (gstr->str + strlen ("prefix"), ==, flat ? flat : "");
+  g_assert_cmpuint (gstr->len, ==, strlen (gstr->str));
+  g_string_free (gstr, TRUE);
+
+  flat_len = flat ? strlen (flat) : 0;
+  assert_flatten_into (str, len, flat, 0);
+  assert_flatten_into (str, len, flat, flat_len / 2);
+  assert_flatten_into (str, len, flat, flat_len);
+  assert_flatten_into (str, len, flat, flat_len + 1);
+  assert_flatten_into (str, len, flat, flat_len + 100);
+
+  /* flattening on the fly */
+  if (flat && len < 0)
+    g_assert_cmpuint (gx_utf8_flatten_hash (str), ==, g_str_hash (flat));
+
+  g_free (flat);
+  g_free (ref);
+}
+
+static void
+test_utf8_flatten_reference (void)
+{
+  const char *ascii =
+    "The Quick Brown Fox Jumps Over The Lazy Dog @[`{ 0123456789 AZaz";
+  GString    *gstr;
+  gunichar    uc;
+  guint       u, v;
+
+  /* every character, also between ASCII to see that we get back and forth
+   * between the ASCII and the Unicode paths */
+  gstr = g_string_new (NULL);
+  for (uc = 1; uc <= 0x10ffff; ++uc)
+    {
+      if (uc >= 0xd800 && uc <= 0xdfff)
+        continue;
+
+      g_string_truncate (gstr, 0);
+      g_string_append_unichar (gstr, uc);
+      assert_flatten_as_reference (gstr->str, -1);
+
+      g_string_prepend (gstr, "Ab");
+      g_string_append (gstr, "Cd");
+      assert_flatten_as_reference (gstr->str, -1);
+    }
+
+  /* all the ASCII characters, at all offsets and lengths around the vector
+   * sizes */
+  for (u = 0; u != 128; ++u)
+    {
+      g_string_truncate (gstr, 0);
+      for (v = 0; v != 80; ++v)
+        g_string_append_c (gstr, (gchar)(1 + (u + v) % 127));
+
+      for (v = 0; v <= gstr->len; ++v)
+        assert_flatten_as_reference (gstr->str, v);
+    }
+
+  /* random mixes of ASCII and other text */
+  for (u = 0; u != 10000; ++u)
+    {
+      g_string_truncate (gstr, 0);
+      while (gstr->len < 200)
+        if (g_test_rand_int_range (0, 4) == 0)
+          {
+            gunichar max;
+
+            /* mostly from the first few scripts */
+            max = g_test_rand_int_range (0, 4) == 0 ? 0x110000 : 0x3000;
+            do
+              uc = (gunichar)g_test_rand_int_range (0x80, (gint32)max);
+            while (uc >= 0xd800 && uc <= 0xdfff);
+
+            g_string_append_unichar (gstr, uc);
+          }
+        else
+          g_string_append_len (gstr, ascii + g_test_rand_int_range (0, 32),
+                               g_test_rand_int_range (1, 32));
+
+      assert_flatten_as_reference (gstr->str, -1);
+    }
+
+  g_string_free (gstr, TRUE);
+
+  /* stop at the first '\0' */
+  assert_flatten_as_reference ("Ab\0Cd", 5);
+}
+
+
+static void
+test_utf8_flatten_into (void)
+{
+  const char *strs[] = { "Mötley Crüe", "ÆRØSKØBING", "ﷺ and ﬃ", "한국어",
+                         "plain ASCII that is longer than a vector or two",
+                         "", "ab\xc0\x80" "cd" };
+  GString    *gstr;
+  gchar      *flat, buf[8];
+  gsize       u, v;
+
+  /* all the buffer sizes, to split characters at every byte */
+  for (u = 0; u != G_N_ELEMENTS (strs); ++u)
+    {
+      flat = gx_utf8_flatten (strs[u], -1);
+      for (v = 0; v <= (flat ? strlen (flat) : 0) + 2; ++v)
+        assert_flatten_into (strs[u], -1, flat, v);
+      g_free (flat);
+    }
+
+  g_assert_cmpint (gx_utf8_flatten_into ("ÀÉÎ", -1, NULL, 0), ==, 3);
+  g_assert_cmpint (gx_utf8_flatten_into ("ÀÉÎ", 4, buf, sizeof (buf)), ==, 2);
+  g_assert_cmpstr (buf, ==, "ae");
+
+  /* a reused string; invalid input leaves it alone */
+  gstr = g_string_new (NULL);
+  for (u = 0; u != G_N_ELEMENTS (strs); ++u)
+    {
+      g_string_truncate (gstr, 0);
+      flat = gx_utf8_flatten (strs[u], -1);
+      g_assert_cmpint (gx_utf8_flatten_append (gstr, strs[u], -1), ==,
+                       flat != NULL);
+      g_assert_cmpstr (gstr->str, ==, flat ? flat : "");
+      g_free (flat);
+    }
+
+  g_string_assign (gstr, "Crüe");
+  g_assert (!gx_utf8_flatten_append (gstr, "\xe2\x82", -1));
+  g_assert (gx_utf8_flatten_append (gstr, " Mötley", -1));
+  g_assert (gx_utf8_flatten_append (gstr, "ÜÜÜ", 2));
+  g_assert_cmpstr (gstr->str, ==, "Crüe motleyu");
+  g_string_free (gstr, TRUE);
+}
+
+
+static gint
+sign (gint n)
+{
+  return n < 0 ? -1 : n > 0 ? 1 : 0;
+}
+
+static void
+test_utf8_flatten_cmp (void)
+{
+  const char *parts[] = { "", "a", "A", "á", "Á", "b", "B", "z", "e\xcc\x81",
+                          "\xcc\x81", "é", "æ", "ﬃ", "ffi", "한", "ᄒ", "Ω",
+                          "ω", "\xff", "\xc3", "~", "Ab" };
+  const char *names[] = { "Crème Brûlée", "creme brulee", "CRÉME BRULEE",
+                          "Mötley Crüe", "motley crue", "Motley" };
+  guint       u, v;
+
+  /* random strings of the parts, that often flatten the same */
+  for (u = 0; u != 20000; ++u)
+    {
+      GString *gstr1, *gstr2;
+      gchar   *flat1, *flat2;
+
+      gstr1 = g_string_new (NULL);
+      gstr2 = g_string_new (NULL);
+      for (v = g_test_rand_int_range (0, 5); v != 0; --v)
+        g_string_append (gstr1, parts[g_test_rand_int_range
+                                      (0, G_N_ELEMENTS (parts))]);
+      for (v = g_test_rand_int_range (0, 5); v != 0; --v)
+        g_string_append (gstr2, parts[g_test_rand_int_range
+                                      (0, G_N_ELEMENTS (parts))]);
+
+      flat1 = gx_utf8_flatten (gstr1->str, -1);
+      flat2 = gx_utf8_flatten (gstr2->str, -1);
+      if (flat1 && flat2)
+        {
+          g_assert_cmpint (sign (gx_utf8_flatten_cmp (gstr1->str, gstr2->str)),
+                           ==, sign (strcmp (flat1, flat2)));
+          g_assert_cmpint (gx_utf8_flatten_equal (gstr1->str, gstr2->str), ==,
+                           g_str_equal (flat1, flat2));
+          g_assert_cmpuint (gx_utf8_flatten_hash (gstr1->str), ==,
+                            g_str_hash (flat1));
+        }
+      g_assert_cmpint (sign (gx_utf8_flatten_cmp (gstr1->str, gstr2->str)), ==,
+                       -sign (gx_utf8_flatten_cmp (gstr2->str, gstr1->str)));
+      g_assert_cmpint (gx_utf8_flatten_cmp (gstr1->str, gstr1->str), ==, 0);
+      if (gx_utf8_flatten_equal (gstr1->str, gstr2->str))
+        g_assert_cmpuint (gx_utf8_flatten_hash (gstr1->str), ==,
+                          gx_utf8_flatten_hash (gstr2->str));
+
+      g_free (flat1);
+      g_free (flat2);
+      g_string_free (gstr1, TRUE);
+      g_string_free (gstr2, TRUE);
+    }
+
+  /* bytes that are not UTF-8 compare as themselves */
+  g_assert (gx_utf8_flatten_equal ("Ab\xff", "aB\xff"));
+  g_assert_cmpint (gx_utf8_flatten_cmp ("a\xff", "A\xfe"), >, 0);
+  g_assert_cmpint (gx_utf8_flatten_cmp ("\xe2\x82", "\xe2\x82z"), <, 0);
+
+  for (u = 0; u != G_N_ELEMENTS (names); ++u)
+    for (v = 0; v != G_N_ELEMENTS (names); ++v)
+      g_assert_cmpint (gx_utf8_flatten_equal (names[u], names[v]), ==,
+                       (u < 3) == (v < 3) && (u < 5) == (v < 5));
+}
+
+static void
+test_utf8_flatten_keys (void)
+{
+  const char *names[] = { "Ærøskøbing", "Crème", "ærøskøbing", "CREME",
+                          "creme", "Motley", "ÆRØSKØBING" };
+  GHashTable *table;
+  GList      *lst, *uniq;
+  guint       u;
+
+  table = g_hash_table_new (gx_utf8_flatten_hash, gx_utf8_flatten_equal);
+  for (u = 0; u != G_N_ELEMENTS (names); ++u)
+    g_hash_table_insert (table, (gpointer)names[u], NULL);
+  g_assert_cmpuint (g_hash_table_size (table), ==, 3);
+  g_assert (g_hash_table_contains (table, "MÖTLEY"));
+  g_assert (!g_hash_table_contains (table, "Mötley Crüe"));
+  g_hash_table_destroy (table);
+
+  lst  = gx_strv_to_list ((gchar**)names, G_N_ELEMENTS (names));
+  uniq = gx_list_uniq (lst, gx_utf8_flatten_hash, gx_utf8_flatten_equal);
+  g_assert_cmpuint (g_list_length (uniq), ==, 3);
+  g_assert_cmpstr (g_list_nth_data (uniq, 0), ==, "Ærøskøbing");
+  g_assert_cmpstr (g_list_nth_data (uniq, 1), ==, "Crème");
+  g_assert_cmpstr (g_list_nth_data (uniq, 2), ==, "Motley");
+  g_list_free (uniq);
+
+  lst  = g_list_sort (lst, gx_utf8_flatten_cmp);
+  uniq = gx_list_sorted_uniq (lst, gx_utf8_flatten_cmp);
+  g_assert_cmpuint (g_list_length (uniq), ==, 3);
+  g_assert_cmpint (gx_utf8_flatten_cmp (uniq->data, "CRÉME"), ==, 0);
+  g_list_free (uniq);
+  g_list_free (lst);
+}
+
+
+static void
+assert_flatten_strv (gchar **strv, gchar **flat)
+{
+  gsize u;
+
+  for (u = 0; strv[u]; ++u)
+    {
+      gchar *expected;
+
+      expected = gx_utf8_flatten (strv[u], -1);
+      g_assert_cmpstr (flat[u], ==, expected ? expected : "");
+      g_free (expected);
+    }
+  g_assert (flat[u] == NULL);
 }
 
+static void
+test_utf8_flatten_strv (void)
+{
+  const char *samples[] = { "Mötley Crüe", "README", "", "ÆRØSKØBING",
+                            "ab\xc0\x80", "한국어", "Crème Brûlée" };
+  gsize       sizes[] = { 0, 1, 7, 2049, 100000 };
+  gint        threads[] = { 1, 3, -1 };
+  guint       u, v, w;
+
+  for (u = 0; u != G_N_ELEMENTS (sizes); ++u)
+    {
+      gchar **strv;
+      GList  *lst;
+
+      strv = g_new0 (gchar*, sizes[u] + 1);
+      for (v = 0; v != sizes[u]; ++v)
+        strv[v] = g_strdup_printf
+          ("%s %u", samples[g_test_rand_int_range (0, G_N_ELEMENTS (samples))],
+           v);
+      lst = gx_strv_to_list (strv, -1);
+
+      for (w = 0; w != G_N_ELEMENTS (threads); ++w)
+        {
+          gchar **flat;
+
+          flat = gx_utf8_flatten_strv (strv, -1, threads[w]);
+          assert_flatten_strv (strv, flat);
+          g_free (flat);
+
+          flat = gx_utf8_flatten_list (lst, threads[w]);
+          assert_flatten_strv (strv, flat);
+          g_free (flat);
+        }
+
+      /* just the first few */
+      if (sizes[u] >= 2)
+        {
+          gchar **flat, *str;
+
+          flat = gx_utf8_flatten_strv (strv, 2, -1);
+          str  = strv[2];
+          strv[2] = NULL;
+          assert_flatten_strv (strv, flat);
+          strv[2] = str;
+          g_free (flat);
+        }
+
+      g_list_free (lst);
+      g_strfreev (strv);
+    }
+}
 
 
 int
@@ -127,6 +502,12 @@ main (int argc, char *argv[])
   g_test_add_func ("/gx-str/strv-to-list", test_strv_to_list);
   g_test_add_func ("/gx-str/strv-to-list-copy", test_strv_to_list_copy);
   g_test_add_func ("/gx-str/utf8-flatten", test_utf8_flatten);
+  g_test_add_func ("/gx-str/utf8-flatten-reference",
+                   test_utf8_flatten_reference);
+  g_test_add_func ("/gx-str/utf8-flatten-into", test_utf8_flatten_into);
+  g_test_add_func ("/gx-str/utf8-flatten-cmp", test_utf8_flatten_cmp);
+  g_test_add_func ("/gx-str/utf8-flatten-keys", test_utf8_flatten_keys);
+  g_test_add_func ("/gx-str/utf8-flatten-strv", test_utf8_flatten_strv);
 
   return g_test_run ();
 }
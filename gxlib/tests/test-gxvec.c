@@ -0,0 +1,366 @@
+/*
+** Copyright (C) 2017 Dirk-Jan C. Binnema <djcb@djcbsoftware.nl>
+**
+**  This library is free software; you can redistribute it and/or
+**  modify it under the terms of the GNU Lesser General Public License
+**  as published by the Free Software Foundation; either version 2.1
+**  of the License, or (at your option) any later version.
+**
+**  This library is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+**  Lesser General Public License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License along with this library; if not, write to the Free
+**  Software Foundation, 51 Franklin Street, Fifth Floor, Boston, MA
+**  02110-1301, USA.
+*/
+
+#include <gxlib/gxlib.h>
+#include <string.h>
+
+static void
+test_new (void)
+{
+  GXVec *vec;
+  gint   x;
+
+  vec = gx_vec_new ();
+  g_assert_cmpuint (vec->len, ==, 0);
+
+  for (x = 0; x != 1000; ++x)
+    gx_vec_append (vec, GINT_TO_POINTER(x));
+
+  g_assert_cmpuint (vec->len, ==, 1000);
+  for (x = 0; x != 1000; ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (vec, x)), ==, x);
+
+  gx_vec_free (vec, NULL);
+  gx_vec_free (NULL, NULL);
+}
+
+
+static void
+test_convert (void)
+{
+  GList     *lst, *lst2, *cur;
+  GPtrArray *array;
+  GXVec     *vec, *vec2;
+  gint       x;
+
+  lst = gx_list_iota (100, 0, 1);
+  vec = gx_vec_from_list (lst);
+  g_assert_cmpuint (vec->len, ==, 100);
+
+  lst2 = gx_vec_to_list (vec);
+  g_assert_cmpuint (g_list_length (lst2), ==, 100);
+  for (x = 0, cur = lst2; cur; cur = g_list_next (cur), ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(cur->data), ==, x);
+
+  array = gx_vec_to_ptr_array (vec);
+  g_assert_cmpuint (array->len, ==, 100);
+  vec2 = gx_vec_from_ptr_array (array);
+  g_assert_cmpuint (vec2->len, ==, 100);
+  for (x = 0; x != 100; ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (vec2, x)), ==, x);
+
+  g_ptr_array_free (array, TRUE);
+  gx_vec_free (vec, NULL);
+  gx_vec_free (vec2, NULL);
+  g_list_free (lst);
+  g_list_free (lst2);
+
+  vec = gx_vec_from_list (NULL);
+  g_assert_cmpuint (vec->len, ==, 0);
+  g_assert (!gx_vec_to_list (vec));
+  gx_vec_free (vec, NULL);
+}
+
+
+static void
+test_filter (void)
+{
+  GXVec *vec, *even;
+  gint   x;
+
+  vec  = gx_vec_iota (1000, 0, 1);
+  even = gx_vec_filter (vec, (GXPred)gx_is_even, NULL);
+  g_assert_cmpuint (even->len, ==, 500);
+  for (x = 0; x != 500; ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (even, x)), ==, 2 * x);
+
+  gx_vec_free (even, NULL);
+
+  g_assert (gx_vec_filter_in_place (vec, (GXPred)gx_is_even, NULL, NULL) == vec);
+  g_assert_cmpuint (vec->len, ==, 500);
+  for (x = 0; x != 500; ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (vec, x)), ==, 2 * x);
+
+  gx_vec_free (vec, NULL);
+}
+
+
+static gboolean
+even_length (const char *s)
+{
+  return strlen (s) % 2 == 0 ? TRUE : FALSE;
+}
+
+static void
+test_filter_in_place_free (void)
+{
+  GXVec      *vec;
+  gint        x;
+  const char *str;
+
+  str = "Hello, world!";
+  for (x = 0, vec = gx_vec_new (); x != 10; ++x)
+    gx_vec_append (vec, g_strndup (str, x));
+
+  gx_vec_filter_in_place (vec, (GXPred)even_length, NULL, g_free);
+  g_assert_cmpuint (vec->len, ==, 5);
+
+  gx_vec_free (vec, g_free);
+}
+
+
+static void
+test_every_any (void)
+{
+  GXVec *nums;
+
+  nums = gx_vec_new ();
+  g_assert_true (gx_vec_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_vec_any (nums, (GXPred)gx_is_odd, NULL));
+  gx_vec_free (nums, NULL);
+
+  nums = gx_vec_iota (20, 1, 2);
+  g_assert_true (gx_vec_every (nums, (GXPred)gx_is_odd, NULL));
+  g_assert_false (gx_vec_any (nums, (GXPred)gx_is_even, NULL));
+  gx_vec_free (nums, NULL);
+
+  nums = gx_vec_iota (20, 1, 1);
+  gx_vec_filter_in_place (nums, (GXPred)gx_is_prime, NULL, NULL);
+  g_assert_true (gx_vec_any (nums, (GXPred)gx_is_even, NULL));
+  g_assert_false (gx_vec_every (nums, (GXPred)gx_is_odd, NULL));
+  gx_vec_free (nums, NULL);
+}
+
+
+static void
+test_take_skip (void)
+{
+  GXVec *vec, *vec2;
+  gint   x;
+
+  vec = gx_vec_iota (100, 0, 1);
+
+  vec2 = gx_vec_take (vec, 0);
+  g_assert_cmpuint (vec2->len, ==, 0);
+  gx_vec_free (vec2, NULL);
+
+  vec2 = gx_vec_take (vec, 15);
+  g_assert_cmpuint (vec2->len, ==, 15);
+  for (x = 0; x != 15; ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (vec2, x)), ==, x);
+  gx_vec_free (vec2, NULL);
+
+  vec2 = gx_vec_take (vec, 1000);
+  g_assert_cmpuint (vec2->len, ==, 100);
+  gx_vec_free (vec2, NULL);
+
+  vec2 = gx_vec_skip (vec, 15);
+  g_assert_cmpuint (vec2->len, ==, 85);
+  for (x = 0; x != 85; ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (vec2, x)), ==, x + 15);
+  gx_vec_free (vec2, NULL);
+
+  vec2 = gx_vec_skip (vec, 1000);
+  g_assert_cmpuint (vec2->len, ==, 0);
+  gx_vec_free (vec2, NULL);
+
+  gx_vec_skip_in_place (vec, 10, NULL);
+  g_assert_cmpuint (vec->len, ==, 90);
+  g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (vec, 0)), ==, 10);
+
+  gx_vec_take_in_place (vec, 5, NULL);
+  g_assert_cmpuint (vec->len, ==, 5);
+  g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (vec, 4)), ==, 14);
+
+  gx_vec_free (vec, NULL);
+}
+
+
+static void
+test_take_skip_in_place_free (void)
+{
+  GXVec      *vec;
+  guint       u;
+  const char *words[] = { "butter", "bread", "green", "cheese" };
+
+  vec = gx_vec_new ();
+  for (u = 0; u != G_N_ELEMENTS(words); ++u)
+    gx_vec_append (vec, g_strdup (words[u]));
+
+  gx_vec_skip_in_place (vec, 1, g_free);
+  gx_vec_take_in_place (vec, 2, g_free);
+  g_assert_cmpuint (vec->len, ==, 2);
+  g_assert_cmpstr (gx_vec_index (vec, 0), ==, "bread");
+  g_assert_cmpstr (gx_vec_index (vec, 1), ==, "green");
+
+  gx_vec_free (vec, g_free);
+}
+
+
+static int
+square (gint num)
+{
+  return num * num;
+}
+
+static char*
+upcase (char *s)
+{
+  return g_ascii_strup (s, -1);
+}
+
+static void
+test_map (void)
+{
+  GXVec      *vec, *squares;
+  gint        x;
+  const char *letters;
+
+  vec     = gx_vec_iota (1000, 0, 1);
+  squares = gx_vec_map (vec, (GXBinaryFunc)square, NULL);
+  g_assert_cmpuint (squares->len, ==, 1000);
+  for (x = 0; x != 1000; ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (squares, x)), ==, x * x);
+  gx_vec_free (squares, NULL);
+
+  g_assert (gx_vec_map_in_place (vec, (GXBinaryFunc)square, NULL, NULL) == vec);
+  for (x = 0; x != 1000; ++x)
+    g_assert_cmpint (GPOINTER_TO_INT(gx_vec_index (vec, x)), ==, x * x);
+  gx_vec_free (vec, NULL);
+
+  for (vec = gx_vec_new (), x = 0; x != 10; ++x)
+    {
+      char buf[2];
+      buf [0] = 'a' + x;
+      buf [1] = '\0';
+      gx_vec_append (vec, g_strdup (buf));
+    }
+
+  gx_vec_map_in_place (vec, (GXBinaryFunc)upcase, NULL, g_free);
+  letters = "ABCDEFGHIJ";
+  for (x = 0; x != 10; ++x)
+    g_assert_cmpint (((char*)gx_vec_index (vec, x))[0], ==, letters[x]);
+
+  gx_vec_free (vec, g_free);
+}
+
+
+static void
+test_fold (void)
+{
+  GXVec *vec;
+  char  *str;
+  const char* cities[] = { "Amsterdam", "San Francisco", "Helsinki" };
+
+  vec = gx_vec_iota (100, 1, 1);
+  g_assert_cmpint (GPOINTER_TO_INT(gx_vec_fold (vec, (GXTernaryFunc)gx_plus,
+                                                GINT_TO_POINTER(0), NULL, NULL)),
+                   ==, 5050);
+  gx_vec_free (vec, NULL);
+
+  vec = gx_vec_new ();
+  g_assert (!gx_vec_fold (vec, (GXTernaryFunc)gx_plus, GINT_TO_POINTER(1),
+                          NULL, NULL));
+  gx_vec_append (vec, (gpointer)cities[0]);
+  gx_vec_append (vec, (gpointer)cities[1]);
+  gx_vec_append (vec, (gpointer)cities[2]);
+
+  str = gx_vec_fold (vec, (GXTernaryFunc)gx_str_chain, NULL, "; ", g_free);
+  g_assert_cmpstr (str, ==, "Amsterdam; San Francisco; Helsinki");
+  g_free (str);
+
+  gx_vec_free (vec, NULL);
+}
+
+
+static void
+test_sum_product (void)
+{
+  GXVec *vec;
+
+  vec = gx_vec_iota (100, 1, 1);
+  g_assert_cmpint (gx_vec_sum (vec), ==, 5050);
+  gx_vec_free (vec, NULL);
+
+  vec = gx_vec_iota (7, 1, 1);
+  g_assert_cmpint (gx_vec_product (vec), ==, 5040);
+  gx_vec_free (vec, NULL);
+
+  vec = gx_vec_new ();
+  g_assert_cmpint (gx_vec_sum (vec), ==, 0);
+  g_assert_cmpint (gx_vec_product (vec), ==, 1);
+  gx_vec_free (vec, NULL);
+}
+
+
+static void
+test_perf_filter (void)
+{
+  const gsize n = 1000 * 1000;
+  GList      *lst, *filtered;
+  GXVec      *vec, *vfiltered;
+  GTimer     *timer;
+  gdouble     list_secs, vec_secs;
+
+  if (!g_test_perf ())
+    return;
+
+  timer = g_timer_new ();
+
+  g_timer_start (timer);
+  lst      = gx_list_iota (n, 0, 1);
+  filtered = gx_list_filter (lst, (GXPred)gx_is_even, NULL);
+  g_list_free (filtered);
+  g_list_free (lst);
+  list_secs = g_timer_elapsed (timer, NULL);
+
+  g_timer_start (timer);
+  vec       = gx_vec_iota (n, 0, 1);
+  vfiltered = gx_vec_filter (vec, (GXPred)gx_is_even, NULL);
+  gx_vec_free (vfiltered, NULL);
+  gx_vec_free (vec, NULL);
+  vec_secs = g_timer_elapsed (timer, NULL);
+
+  g_test_minimized_result (list_secs, "GList iota+filter: %.3fs", list_secs);
+  g_test_minimized_result (vec_secs, "GXVec iota+filter: %.3fs", vec_secs);
+
+  g_timer_destroy (timer);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/gx-vec/new", test_new);
+  g_test_add_func ("/gx-vec/convert", test_convert);
+  g_test_add_func ("/gx-vec/filter", test_filter);
+  g_test_add_func ("/gx-vec/filter-in-place-free", test_filter_in_place_free);
+  g_test_add_func ("/gx-vec/every-any", test_every_any);
+  g_test_add_func ("/gx-vec/take-skip", test_take_skip);
+  g_test_add_func ("/gx-vec/take-skip-in-place-free",
+                   test_take_skip_in_place_free);
+  g_test_add_func ("/gx-vec/map", test_map);
+  g_test_add_func ("/gx-vec/fold", test_fold);
+  g_test_add_func ("/gx-vec/sum-product", test_sum_product);
+  g_test_add_func ("/gx-vec/perf-filter", test_perf_filter);
+
+  return g_test_run ();
+}